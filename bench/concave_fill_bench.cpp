@@ -0,0 +1,244 @@
+// Measures ImDrawList::AddConcavePolyFilled() on coastline-like outlines of
+// 100, 1k and 10k points, the way a world map would fill its regions: with
+// the reflex grid, with the triangulation cache on top, and with the plain
+// ear clipper it replaced ("reference", a copy of the previous ImTriangulator
+// timed in the same build). No window or GPU needed.
+//
+// The fuzz check triangulates random polygons (star shaped, with repeated and
+// collinear points, either winding) both ways and compares every triangle,
+// with and without the cache.
+//
+//   concave_fill_bench [seconds per row] [fuzz polygons]
+
+#include "imgui.h"
+#include "imgui_internal.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <chrono>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// The ear clipper as it was before the grid: every ear test walks all the reflex vertices
+struct RefTriangulator {
+    enum Type { Convex, Ear, Reflex };
+    struct Node {
+        Type type;
+        int index;
+        ImVec2 pos;
+        Node* next;
+        Node* prev;
+    };
+
+    std::vector<Node> storage;
+    std::vector<Node*> ears, reflexes;
+    Node* nodes = nullptr;
+    int trianglesLeft = 0;
+
+    void init(const ImVec2* points, int count) {
+        storage.resize(count);
+        ears.clear();
+        reflexes.clear();
+        for (int i = 0; i < count; i++) storage[i] = { Convex, i, points[i], &storage[(i + 1) % count], &storage[(i + count - 1) % count] };
+        nodes = storage.data();
+        trianglesLeft = count - 2;
+        buildReflexes();
+        buildEars();
+    }
+    void buildReflexes() {
+        Node* n = nodes;
+        for (int i = trianglesLeft; i >= 0; i--, n = n->next) {
+            if (ImTriangleIsClockwise(n->prev->pos, n->pos, n->next->pos)) continue;
+            n->type = Reflex;
+            reflexes.push_back(n);
+        }
+    }
+    void buildEars() {
+        Node* n = nodes;
+        for (int i = trianglesLeft; i >= 0; i--, n = n->next) {
+            if (n->type != Convex || !isEar(n->prev->index, n->index, n->next->index, n->prev->pos, n->pos, n->next->pos)) continue;
+            n->type = Ear;
+            ears.push_back(n);
+        }
+    }
+    bool isEar(int i0, int i1, int i2, ImVec2 v0, ImVec2 v1, ImVec2 v2) const {
+        for (Node* r : reflexes)
+            if (r->index != i0 && r->index != i1 && r->index != i2 && ImTriangleContainsPoint(v0, v1, v2, r->pos)) return false;
+        return true;
+    }
+    static void findErase(std::vector<Node*>& list, int index) {
+        for (int i = (int)list.size() - 1; i >= 0; i--)
+            if (list[i]->index == index) { list[i] = list.back(); list.pop_back(); return; }
+    }
+    void reclassify(Node* n1) {
+        Node* n0 = n1->prev;
+        Node* n2 = n1->next;
+        Type type = !ImTriangleIsClockwise(n0->pos, n1->pos, n2->pos) ? Reflex
+                  : isEar(n0->index, n1->index, n2->index, n0->pos, n1->pos, n2->pos) ? Ear : Convex;
+        if (type == n1->type) return;
+        if (n1->type == Reflex) findErase(reflexes, n1->index);
+        else if (n1->type == Ear) findErase(ears, n1->index);
+        if (type == Reflex) reflexes.push_back(n1);
+        else if (type == Ear) ears.push_back(n1);
+        n1->type = type;
+    }
+    void flip() {
+        Node* prev = nodes;
+        Node* current = nodes->next;
+        prev->next = prev;
+        prev->prev = prev;
+        while (current != nodes) {
+            Node* temp = current->next;
+            current->next = prev;
+            prev->prev = current;
+            nodes->next = current;
+            current->prev = nodes;
+            prev = current;
+            current = temp;
+        }
+        nodes = prev;
+    }
+    void next(unsigned int out[3]) {
+        if (ears.empty()) {
+            flip();
+            Node* n = nodes;
+            for (int i = trianglesLeft; i >= 0; i--, n = n->next) n->type = Convex;
+            reflexes.clear();
+            buildReflexes();
+            buildEars();
+            if (ears.empty()) ears.push_back(nodes);
+        }
+        Node* ear = ears.back();
+        ears.pop_back();
+        out[0] = ear->prev->index;
+        out[1] = ear->index;
+        out[2] = ear->next->index;
+        ear->next->prev = ear->prev;
+        ear->prev->next = ear->next;
+        if (ear == nodes) nodes = ear->next;
+        reclassify(ear->prev);
+        reclassify(ear->next);
+        trianglesLeft--;
+    }
+};
+
+static RefTriangulator refTriangulator;
+
+// AddConcavePolyFilled() without anti-aliasing, on the reference triangulator
+static void referenceFill(ImDrawList* dl, const ImVec2* points, int count, ImU32 col) {
+    dl->PrimReserve((count - 2) * 3, count);
+    for (int i = 0; i < count; i++) {
+        dl->_VtxWritePtr->pos = points[i];
+        dl->_VtxWritePtr->uv = dl->_Data->TexUvWhitePixel;
+        dl->_VtxWritePtr->col = col;
+        dl->_VtxWritePtr++;
+    }
+    refTriangulator.init(points, count);
+    unsigned int tri[3];
+    while (refTriangulator.trianglesLeft > 0) {
+        refTriangulator.next(tri);
+        for (unsigned int i : tri) *dl->_IdxWritePtr++ = (ImDrawIdx)(dl->_VtxCurrentIdx + i);
+    }
+    dl->_VtxCurrentIdx += count;
+}
+
+// A coastline: a circle pushed in and out by a few harmonics and some jitter, star shaped so it never crosses itself
+static void coastline(std::vector<ImVec2>& out, int count, ImVec2 center, float radius, std::mt19937& rng) {
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    float phase[4], amp[4];
+    for (int k = 0; k < 4; k++) { phase[k] = unit(rng) * 6.2831853f; amp[k] = 0.05f + 0.15f * unit(rng); }
+    out.resize(count);
+    for (int i = 0; i < count; i++) {
+        float a = i * 6.2831853f / count;
+        float r = 1.0f + 0.08f * (unit(rng) - 0.5f);
+        for (int k = 0; k < 4; k++) r += amp[k] * sinf(a * (3 + k * 5) + phase[k]);
+        out[i] = ImVec2(center.x + cosf(a) * radius * std::max(r, 0.1f), center.y + sinf(a) * radius * std::max(r, 0.1f));
+    }
+}
+
+// Fills per second: as many fills as fit in 'seconds', at least 3
+template<typename F>
+static double fillsPerSecond(double seconds, F&& fill) {
+    int fills = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    double elapsed = 0.0;
+    do {
+        ImGui::NewFrame();
+        fill(ImGui::GetForegroundDrawList());
+        ImGui::EndFrame();
+        fills++;
+        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    } while (elapsed < seconds || fills < 3);
+    return fills / elapsed;
+}
+
+static bool sameIndices(ImDrawList* a, ImDrawList* b) {
+    return a->IdxBuffer.Size == b->IdxBuffer.Size && memcmp(a->IdxBuffer.Data, b->IdxBuffer.Data, a->IdxBuffer.size_in_bytes()) == 0;
+}
+
+int main(int argc, char** argv) {
+    double seconds = argc > 1 ? std::max(0.05, atof(argv[1])) : 1.0;
+    int fuzzPolygons = argc > 2 ? std::max(0, atoi(argv[2])) : 20000;
+
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(1920, 1080);
+    io.DeltaTime = 1.0f / 60.0f;
+    io.IniFilename = nullptr;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures | ImGuiBackendFlags_RendererHasVtxOffset;
+    ImDrawListSharedData* shared = ImGui::GetDrawListSharedData();
+
+    printf("%-8s %14s %14s %14s %12s\n", "points", "fills/s", "cached", "reference", "speedup");
+    std::mt19937 rng(1234);
+    std::vector<ImVec2> points;
+    const ImU32 col = IM_COL32(90, 140, 70, 255);
+    for (int count : { 100, 1000, 10000 }) {
+        coastline(points, count, ImVec2(960, 540), 500.0f, rng);
+        shared->TriangulationCacheCapacity = 0;
+        double grid = fillsPerSecond(seconds, [&](ImDrawList* dl) { dl->AddConcavePolyFilled(points.data(), count, col); });
+        shared->TriangulationCacheCapacity = 8;
+        double cached = fillsPerSecond(seconds, [&](ImDrawList* dl) { dl->AddConcavePolyFilled(points.data(), count, col); });
+        shared->TriangulationCacheCapacity = 0;
+        double reference = fillsPerSecond(seconds, [&](ImDrawList* dl) { dl->Flags &= ~ImDrawListFlags_AntiAliasedFill; referenceFill(dl, points.data(), count, col); });
+        double plain = fillsPerSecond(seconds, [&](ImDrawList* dl) { dl->Flags &= ~ImDrawListFlags_AntiAliasedFill; dl->AddConcavePolyFilled(points.data(), count, col); });
+        printf("%-8d %14.0f %14.0f %14.1f %11.1fx\n", count, grid, cached, reference, plain / reference);
+    }
+    printf("(fills/s and cached include the anti-aliased fringe; reference and speedup compare the triangulation alone)\n");
+
+    // Random polygons both ways, then again through the cache
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    int mismatches = 0;
+    for (int i = 0; i < fuzzPolygons; i++) {
+        int count = 3 + (int)(rng() % 200);
+        coastline(points, count, ImVec2(unit(rng) * 1920, unit(rng) * 1080), 5.0f + unit(rng) * 800.0f, rng);
+        if (rng() % 2) std::reverse(points.begin(), points.end());
+        for (int k = (int)(rng() % 4); k > 0; k--) {
+            int a = (int)(rng() % count), b = (a + 1) % count, c = (a + 2) % count;
+            if (rng() % 2) points[b] = points[a];                                                  // repeated point
+            else points[b] = ImVec2((points[a].x + points[c].x) * 0.5f, (points[a].y + points[c].y) * 0.5f); // collinear point
+        }
+        shared->TriangulationCacheCapacity = (i % 3 == 0) ? 4 : 0;
+        bool ok = true;
+        for (int pass = 0; pass < ((i % 3 == 0) ? 2 : 1); pass++) { // twice with the cache: a miss, then a hit
+            ImGui::NewFrame();
+            ImDrawList* a = ImGui::GetForegroundDrawList();
+            ImDrawList* b = ImGui::GetBackgroundDrawList();
+            a->Flags &= ~ImDrawListFlags_AntiAliasedFill;
+            b->Flags &= ~ImDrawListFlags_AntiAliasedFill;
+            a->AddConcavePolyFilled(points.data(), count, col);
+            referenceFill(b, points.data(), count, col);
+            ok &= sameIndices(a, b);
+            ImGui::EndFrame();
+        }
+        if (!ok) {
+            if (mismatches < 10) printf("mismatch on polygon %d (%d points)\n", i, count);
+            mismatches++;
+        }
+    }
+    printf("\nfuzz: %d random polygons, %d mismatches against the reference; cache %d hits, %d misses\n", fuzzPolygons, mismatches, shared->TriangulationCacheHits, shared->TriangulationCacheMisses);
+
+    ImGui::DestroyContext();
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,110 @@
+// Measures the mixer's DSP kernels at a 128-frame block and reports how many
+// voices one core could mix in real time, plus resampler throughput.
+//
+//   mix_bench [seconds per test]
+
+#include "AudioDsp.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+
+static const int RATE = 44100;
+static const int BLOCK = 128;
+static const int VOICES = 32;
+static const int SOUND_FRAMES = RATE * 2;
+
+static volatile float sink;
+
+// The loop AudioEngine::mixBlock used before the kernels, for comparison.
+static void mixGainPlain(float* dst, const float* src, int count, float gain) {
+    for (int i = 0; i < count; i++) dst[i] += src[i] * gain;
+}
+
+// Runs 'mixVoice' over VOICES distinct sounds per block until 'seconds' pass.
+// Returns nanoseconds per voice per block.
+template <typename F>
+static double timeVoices(double seconds, const std::vector<std::vector<float>>& sounds, F mixVoice) {
+    std::vector<float> out(BLOCK * 2);
+    long long blocks = 0;
+    int position = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    double elapsed = 0.0;
+    while (elapsed < seconds) {
+        for (int rep = 0; rep < 64; rep++) {
+            std::fill(out.begin(), out.end(), 0.0f);
+            for (int v = 0; v < VOICES; v++) mixVoice(out.data(), sounds[v].data() + (size_t)position * 2, v);
+            position = (position + BLOCK) % (SOUND_FRAMES - BLOCK);
+            blocks++;
+        }
+        sink = out[0];
+        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    }
+    return elapsed * 1e9 / ((double)blocks * VOICES);
+}
+
+static void report(const char* name, double nsPerVoice) {
+    double blockNs = BLOCK * 1e9 / RATE;
+    printf("%-28s %10.1f %14.0f\n", name, nsPerVoice, blockNs / nsPerVoice);
+}
+
+static double resampleRealtime(int inRate, int outRate, double seconds, const std::vector<float>& input) {
+    PolyphaseResampler resampler;
+    resampler.setup(inRate, outRate, 2);
+    std::vector<float> out;
+    int inFrames = (int)(input.size() / 2);
+    double audio = 0.0, elapsed = 0.0;
+    auto t0 = std::chrono::steady_clock::now();
+    while (elapsed < seconds) {
+        for (int offset = 0; offset + 2048 <= inFrames; offset += 2048) {
+            out.clear();
+            resampler.process(input.data() + (size_t)offset * 2, 2048, out);
+            audio += 2048.0 / inRate;
+        }
+        sink = out.empty() ? 0.0f : out[0];
+        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    }
+    return audio / elapsed;
+}
+
+int main(int argc, char** argv) {
+    double seconds = argc > 1 ? std::max(0.1, atof(argv[1])) : 1.0;
+
+    std::vector<std::vector<float>> sounds(VOICES, std::vector<float>((size_t)SOUND_FRAMES * 2));
+    unsigned int seed = 12345;
+    for (auto& s : sounds)
+        for (float& x : s) { seed = seed * 1664525u + 1013904223u; x = ((seed >> 8) / 16777216.0f - 0.5f) * 0.5f; }
+
+    printf("SIMD path: %s, %d-frame stereo blocks at %d Hz, %d voices\n\n", dspSimdPath(), BLOCK, RATE, VOICES);
+    printf("%-28s %10s %14s\n", "kernel", "ns/voice", "voices/core");
+
+    // Warm up clocks and caches so the first row isn't penalised.
+    timeVoices(seconds * 0.5, sounds, [](float* out, const float* src, int) {
+        dspMixGain(out, src, BLOCK * 2, 0.5f);
+    });
+
+    report("plain loop", timeVoices(seconds, sounds, [](float* out, const float* src, int v) {
+        mixGainPlain(out, src, BLOCK * 2, 0.5f + v * 0.01f);
+    }));
+    report("dspMixGain", timeVoices(seconds, sounds, [](float* out, const float* src, int v) {
+        dspMixGain(out, src, BLOCK * 2, 0.5f + v * 0.01f);
+    }));
+    report("dspMixRampStereo", timeVoices(seconds, sounds, [](float* out, const float* src, int v) {
+        dspMixRampStereo(out, src, BLOCK, 0.5f, (v - 16) * 1e-5f);
+    }));
+    report("dspMixGain + dspSoftClip", timeVoices(seconds, sounds, [](float* out, const float* src, int v) {
+        dspMixGain(out, src, BLOCK * 2, 0.5f + v * 0.01f);
+        if (v == VOICES - 1) dspSoftClip(out, BLOCK * 2);
+    }));
+
+    printf("\n%-28s %10s\n", "resampler (stereo)", "x realtime");
+    const int rates[][2] = { { 44100, 48000 }, { 48000, 44100 }, { 22050, 44100 }, { 24000, 44100 } };
+    for (const auto& r : rates) {
+        char label[64];
+        snprintf(label, sizeof(label), "%d -> %d", r[0], r[1]);
+        printf("%-28s %10.0f\n", label, resampleRealtime(r[0], r[1], seconds, sounds[0]));
+    }
+    return 0;
+}
@@ -0,0 +1,61 @@
+// Decodes every MP3 in a directory (default: Assets/Sounds) with the in-tree
+// decoder and reports the real-time factor: seconds of audio per second of CPU.
+//
+//   mp3_decode_bench [dir] [iterations]
+
+#include "Mp3Decoder.h"
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <filesystem>
+
+namespace fs = std::filesystem;
+
+int main(int argc, char** argv) {
+    std::string dir = argc > 1 ? argv[1] : "Assets/Sounds";
+    int iterations = argc > 2 ? std::max(1, atoi(argv[2])) : 3;
+
+    std::vector<std::string> files;
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(dir, ec)) {
+        std::string ext = entry.path().extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+        if (ext == ".mp3") files.push_back(entry.path().string());
+    }
+    if (files.empty()) {
+        printf("No .mp3 files in %s\n", dir.c_str());
+        return 1;
+    }
+    std::sort(files.begin(), files.end());
+
+    printf("SIMD path: %s, best of %d runs\n\n", mp3SimdPath(), iterations);
+    printf("%-24s %6s %3s %9s %10s %10s\n", "file", "rate", "ch", "audio s", "decode ms", "x realtime");
+
+    double totalAudio = 0.0, totalDecode = 0.0;
+    for (const std::string& path : files) {
+        std::vector<float> samples;
+        int rate = 0, channels = 0;
+        double best = 1e30;
+        bool ok = true;
+        for (int i = 0; i < iterations && ok; i++) {
+            auto t0 = std::chrono::steady_clock::now();
+            ok = mp3DecodeFile(path, samples, rate, channels);
+            double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+            best = std::min(best, elapsed);
+        }
+        std::string name = fs::path(path).filename().string();
+        if (!ok) {
+            printf("%-24s decode failed\n", name.c_str());
+            continue;
+        }
+        double seconds = (double)(samples.size() / channels) / rate;
+        totalAudio += seconds;
+        totalDecode += best;
+        printf("%-24s %6d %3d %9.2f %10.2f %10.1f\n", name.c_str(), rate, channels, seconds, best * 1000.0, seconds / best);
+    }
+    printf("\n%-24s %6s %3s %9.2f %10.2f %10.1f\n", "total", "", "", totalAudio, totalDecode * 1000.0, totalAudio / totalDecode);
+    return 0;
+}
@@ -0,0 +1,287 @@
+// Measures the anti-aliased tessellation in ImDrawList: AddPolyline() on thin,
+// textured and thick lines, open and closed, and AddConvexPolyFilled(), and
+// reports points per microsecond. No window or GPU needed.
+//
+// "reference" is the per-point scalar code the SSE2 path replaced, timed in
+// the same build. The fuzz check then draws random shapes (short ones,
+// repeated points, hairpin turns) both ways and compares every vertex and
+// index bit for bit. Building with -DIMGUI_DISABLE_SSE (every imgui source
+// needs the same setting) times the scalar loops on both sides.
+//
+//   polyline_bench [iterations] [fuzz shapes]
+
+#include "imgui.h"
+#include "imgui_internal.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <chrono>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#define NORMALIZE2F_OVER_ZERO(VX,VY)    { float d2 = VX*VX + VY*VY; if (d2 > 0.0f) { float inv_len = ImRsqrt(d2); VX *= inv_len; VY *= inv_len; } } (void)0
+#define FIXNORMAL2F(VX,VY)              { float d2 = VX*VX + VY*VY; if (d2 > 0.000001f) { float inv_len2 = 1.0f / d2; if (inv_len2 > 100.0f) inv_len2 = 100.0f; VX *= inv_len2; VY *= inv_len2; } } (void)0
+
+static void writeVertex(ImDrawList* dl, ImVec2 pos, ImVec2 uv, ImU32 col) {
+    dl->_VtxWritePtr->pos = pos;
+    dl->_VtxWritePtr->uv = uv;
+    dl->_VtxWritePtr->col = col;
+    dl->_VtxWritePtr++;
+}
+
+static void writeIndices(ImDrawList* dl, std::initializer_list<unsigned int> idx) {
+    for (unsigned int i : idx) *dl->_IdxWritePtr++ = (ImDrawIdx)i;
+}
+
+// The anti-aliased part of AddPolyline() as it was before the SSE2 path: normals, averaged normals, then vertices, one point at a time
+static void referencePolyline(ImDrawList* dl, const ImVec2* points, int pointsCount, ImU32 col, bool closed, float thickness) {
+    ImDrawListSharedData* data = dl->_Data;
+    const ImVec2 opaqueUv = data->TexUvWhitePixel;
+    const int count = closed ? pointsCount : pointsCount - 1;
+    const bool thickLine = thickness > dl->_FringeScale;
+    const float aaSize = dl->_FringeScale;
+    const ImU32 colTrans = col & ~IM_COL32_A_MASK;
+    thickness = std::max(thickness, 1.0f);
+    const int integerThickness = (int)thickness;
+    const bool useTexture = (dl->Flags & ImDrawListFlags_AntiAliasedLinesUseTex) && integerThickness < IM_DRAWLIST_TEX_LINES_WIDTH_MAX &&
+                            thickness - integerThickness <= 0.00001f && aaSize == 1.0f;
+    const int vtxPerPoint = useTexture ? 2 : (thickLine ? 4 : 3);
+    dl->PrimReserve(count * (useTexture ? 6 : (thickLine ? 18 : 12)), pointsCount * vtxPerPoint);
+
+    data->TempBuffer.reserve_discard(pointsCount * 5);
+    ImVec2* normals = data->TempBuffer.Data;
+    ImVec2* edges = normals + pointsCount;
+    for (int i1 = 0; i1 < count; i1++) {
+        const int i2 = (i1 + 1) == pointsCount ? 0 : i1 + 1;
+        float dx = points[i2].x - points[i1].x;
+        float dy = points[i2].y - points[i1].y;
+        NORMALIZE2F_OVER_ZERO(dx, dy);
+        normals[i1] = ImVec2(dy, -dx);
+    }
+    if (!closed) normals[pointsCount - 1] = normals[pointsCount - 2];
+
+    const float halfInner = (thickness - aaSize) * 0.5f;
+    const float halfDraw = useTexture ? (thickness * 0.5f) + 1 : aaSize;
+    auto edgeVertices = [&](int i, float dmX, float dmY) {
+        ImVec2* out = &edges[i * 4];
+        if (thickLine && !useTexture) {
+            out[0] = ImVec2(points[i].x + dmX * (halfInner + aaSize), points[i].y + dmY * (halfInner + aaSize));
+            out[1] = ImVec2(points[i].x + dmX * halfInner, points[i].y + dmY * halfInner);
+            out[2] = ImVec2(points[i].x - dmX * halfInner, points[i].y - dmY * halfInner);
+            out[3] = ImVec2(points[i].x - dmX * (halfInner + aaSize), points[i].y - dmY * (halfInner + aaSize));
+        } else {
+            out[0] = ImVec2(points[i].x + dmX * halfDraw, points[i].y + dmY * halfDraw);
+            out[1] = ImVec2(points[i].x - dmX * halfDraw, points[i].y - dmY * halfDraw);
+        }
+    };
+    if (!closed) {
+        edgeVertices(0, normals[0].x, normals[0].y);
+        edgeVertices(pointsCount - 1, normals[pointsCount - 1].x, normals[pointsCount - 1].y);
+    }
+
+    unsigned int idx1 = dl->_VtxCurrentIdx;
+    for (int i1 = 0; i1 < count; i1++) {
+        const int i2 = (i1 + 1) == pointsCount ? 0 : i1 + 1;
+        const unsigned int idx2 = (i1 + 1) == pointsCount ? dl->_VtxCurrentIdx : idx1 + vtxPerPoint;
+        float dmX = (normals[i1].x + normals[i2].x) * 0.5f;
+        float dmY = (normals[i1].y + normals[i2].y) * 0.5f;
+        FIXNORMAL2F(dmX, dmY);
+        edgeVertices(i2, dmX, dmY);
+        if (useTexture)
+            writeIndices(dl, { idx2, idx1, idx1 + 1, idx2 + 1, idx1 + 1, idx2 });
+        else if (!thickLine)
+            writeIndices(dl, { idx2, idx1, idx1 + 2, idx1 + 2, idx2 + 2, idx2, idx2 + 1, idx1 + 1, idx1, idx1, idx2, idx2 + 1 });
+        else
+            writeIndices(dl, { idx2 + 1, idx1 + 1, idx1 + 2, idx1 + 2, idx2 + 2, idx2 + 1, idx2 + 1, idx1 + 1, idx1, idx1, idx2, idx2 + 1,
+                               idx2 + 2, idx1 + 2, idx1 + 3, idx1 + 3, idx2 + 3, idx2 + 2 });
+        idx1 = idx2;
+    }
+
+    const ImVec4 texUvs = data->TexUvLines[std::min(integerThickness, IM_DRAWLIST_TEX_LINES_WIDTH_MAX)];
+    for (int i = 0; i < pointsCount; i++) {
+        const ImVec2* e = &edges[i * 4];
+        if (useTexture) {
+            writeVertex(dl, e[0], ImVec2(texUvs.x, texUvs.y), col);
+            writeVertex(dl, e[1], ImVec2(texUvs.z, texUvs.w), col);
+        } else if (!thickLine) {
+            writeVertex(dl, points[i], opaqueUv, col);
+            writeVertex(dl, e[0], opaqueUv, colTrans);
+            writeVertex(dl, e[1], opaqueUv, colTrans);
+        } else {
+            writeVertex(dl, e[0], opaqueUv, colTrans);
+            writeVertex(dl, e[1], opaqueUv, col);
+            writeVertex(dl, e[2], opaqueUv, col);
+            writeVertex(dl, e[3], opaqueUv, colTrans);
+        }
+    }
+    dl->_VtxCurrentIdx += pointsCount * vtxPerPoint;
+}
+
+// The anti-aliased part of AddConvexPolyFilled() as it was before the SSE2 path
+static void referenceConvexFill(ImDrawList* dl, const ImVec2* points, int pointsCount, ImU32 col) {
+    const ImVec2 uv = dl->_Data->TexUvWhitePixel;
+    const float aaSize = dl->_FringeScale;
+    const ImU32 colTrans = col & ~IM_COL32_A_MASK;
+    dl->PrimReserve((pointsCount - 2) * 3 + pointsCount * 6, pointsCount * 2);
+    const unsigned int inner = dl->_VtxCurrentIdx, outer = dl->_VtxCurrentIdx + 1;
+    for (int i = 2; i < pointsCount; i++)
+        writeIndices(dl, { inner, inner + ((i - 1) << 1), inner + (i << 1) });
+    dl->_Data->TempBuffer.reserve_discard(pointsCount);
+    ImVec2* normals = dl->_Data->TempBuffer.Data;
+    for (int i0 = pointsCount - 1, i1 = 0; i1 < pointsCount; i0 = i1++) {
+        float dx = points[i1].x - points[i0].x;
+        float dy = points[i1].y - points[i0].y;
+        NORMALIZE2F_OVER_ZERO(dx, dy);
+        normals[i0] = ImVec2(dy, -dx);
+    }
+    for (int i0 = pointsCount - 1, i1 = 0; i1 < pointsCount; i0 = i1++) {
+        float dmX = (normals[i0].x + normals[i1].x) * 0.5f;
+        float dmY = (normals[i0].y + normals[i1].y) * 0.5f;
+        FIXNORMAL2F(dmX, dmY);
+        dmX *= aaSize * 0.5f;
+        dmY *= aaSize * 0.5f;
+        writeVertex(dl, ImVec2(points[i1].x - dmX, points[i1].y - dmY), uv, col);
+        writeVertex(dl, ImVec2(points[i1].x + dmX, points[i1].y + dmY), uv, colTrans);
+        const unsigned int a = (unsigned int)(i1 << 1), b = (unsigned int)(i0 << 1);
+        writeIndices(dl, { inner + a, inner + b, outer + b, outer + b, outer + a, inner + a });
+    }
+    dl->_VtxCurrentIdx += pointsCount * 2;
+}
+
+struct Case {
+    const char* name;
+    float thickness;
+    bool useTexture;
+    bool closed;
+    bool fill;
+};
+
+static void draw(ImDrawList* dl, const Case& c, const ImVec2* points, int count, ImU32 col, bool reference) {
+    dl->Flags = ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedFill | (c.useTexture ? ImDrawListFlags_AntiAliasedLinesUseTex : 0);
+    if (c.fill)
+        reference ? referenceConvexFill(dl, points, count, col) : dl->AddConvexPolyFilled(points, count, col);
+    else
+        reference ? referencePolyline(dl, points, count, col, c.closed, c.thickness) : dl->AddPolyline(points, count, col, c.closed ? ImDrawFlags_Closed : 0, c.thickness);
+}
+
+static unsigned int hashBytes(unsigned int h, const void* data, size_t size) {
+    const unsigned char* p = (const unsigned char*)data;
+    for (size_t i = 0; i < size; i++) h = (h ^ p[i]) * 16777619u;
+    return h;
+}
+
+static bool sameOutput(ImDrawList* a, ImDrawList* b) {
+    return a->VtxBuffer.Size == b->VtxBuffer.Size && a->IdxBuffer.Size == b->IdxBuffer.Size &&
+           memcmp(a->VtxBuffer.Data, b->VtxBuffer.Data, a->VtxBuffer.size_in_bytes()) == 0 &&
+           memcmp(a->IdxBuffer.Data, b->IdxBuffer.Data, a->IdxBuffer.size_in_bytes()) == 0;
+}
+
+// A wobbly closed outline around (cx, cy), clockwise on screen as AddConvexPolyFilled() expects
+static void shape(std::vector<ImVec2>& out, int count, float cx, float cy, float radius, float wobble, unsigned int seed) {
+    out.resize(count);
+    for (int i = 0; i < count; i++) {
+        float a = i * 6.2831853f / count;
+        float r = radius * (1.0f + wobble * sinf(a * 7.0f + seed));
+        out[i] = ImVec2(cx + cosf(a) * r, cy + sinf(a) * r);
+    }
+}
+
+int main(int argc, char** argv) {
+    int iterations = argc > 1 ? std::max(1, atoi(argv[1])) : 2000;
+    int fuzzShapes = argc > 2 ? std::max(0, atoi(argv[2])) : 20000;
+
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(1920, 1080);
+    io.DeltaTime = 1.0f / 60.0f;
+    io.IniFilename = nullptr;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;
+
+#if defined(IMGUI_ENABLE_SSE) && !defined(IMGUI_USE_COMPACT_DRAWVERT)
+    const char* path = "SSE2";
+#else
+    const char* path = "scalar";
+#endif
+    printf("%s tessellation, %d iterations of 100 shapes x 64 points\n\n", path, iterations);
+    printf("%-16s %12s %12s %14s\n", "case", "points/us", "reference", "output hash");
+
+    const Case cases[] = {
+        { "thin open", 1.0f, false, false, false },
+        { "thin closed", 1.0f, false, true, false },
+        { "textured open", 3.0f, true, false, false },
+        { "textured closed", 3.0f, true, true, false },
+        { "thick open", 4.5f, false, false, false },
+        { "thick closed", 4.5f, false, true, false },
+        { "convex fill", 1.0f, false, true, true },
+    };
+    const int SHAPES = 100, POINTS = 64;
+    std::vector<std::vector<ImVec2>> shapes(SHAPES);
+    for (int s = 0; s < SHAPES; s++)
+        shape(shapes[s], POINTS, 100.0f + (s % 10) * 170.0f, 100.0f + (s / 10) * 95.0f, 40.0f, 0.1f, s);
+
+    for (const Case& c : cases) {
+        double seconds[2] = { 0.0, 0.0 };
+        unsigned int hash = 2166136261u;
+        for (int side = 0; side < 2; side++) {
+            for (int it = -10; it < iterations; it++) {
+                ImGui::NewFrame();
+                ImDrawList* dl = ImGui::GetForegroundDrawList();
+                auto t0 = std::chrono::steady_clock::now();
+                for (const std::vector<ImVec2>& s : shapes)
+                    draw(dl, c, s.data(), POINTS, IM_COL32(230, 225, 210, 255), side == 1);
+                auto t1 = std::chrono::steady_clock::now();
+                if (it >= 0) seconds[side] += std::chrono::duration<double>(t1 - t0).count();
+                if (it == 0 && side == 0) {
+                    hash = hashBytes(hash, dl->VtxBuffer.Data, dl->VtxBuffer.size_in_bytes());
+                    hash = hashBytes(hash, dl->IdxBuffer.Data, dl->IdxBuffer.size_in_bytes());
+                }
+                ImGui::EndFrame();
+            }
+        }
+        double points = (double)SHAPES * POINTS * iterations;
+        char hashText[16];
+        snprintf(hashText, sizeof(hashText), "%08x", hash);
+        printf("%-16s %12.1f %12.1f %14s\n", c.name, points / (seconds[0] * 1e6), points / (seconds[1] * 1e6), hashText);
+    }
+
+    // Random shapes of every length around the 4-point blocks, with repeated points and hairpins, drawn both ways
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> coord(-50.0f, 2000.0f);
+    const float thicknesses[] = { 0.5f, 1.0f, 1.5f, 2.0f, 3.0f, 4.5f, 7.0f, 40.0f };
+    std::vector<ImVec2> points;
+    int mismatches = 0;
+    for (int i = 0; i < fuzzShapes; i++) {
+        int count = 2 + (int)(rng() % 19);
+        if (rng() % 2) {
+            shape(points, count, coord(rng), coord(rng), 1.0f + (float)(rng() % 300), (float)(rng() % 100) * 0.01f, rng());
+        } else {
+            points.resize(count);
+            for (ImVec2& p : points) p = ImVec2(coord(rng), coord(rng));
+        }
+        for (int k = (int)(rng() % 3); k > 0; k--) {
+            int a = (int)(rng() % count), b = (int)(rng() % count);
+            points[a] = (rng() % 2) ? points[b] : ImVec2(points[b].x + 0.0001f, points[b].y);
+        }
+        Case c = { "fuzz", thicknesses[rng() % 8], rng() % 2 == 0, rng() % 2 == 0, rng() % 5 == 0 };
+        if (c.fill && count < 3) continue;
+
+        ImGui::NewFrame();
+        ImDrawList* a = ImGui::GetForegroundDrawList();
+        ImDrawList* b = ImGui::GetBackgroundDrawList();
+        a->_FringeScale = b->_FringeScale = (rng() % 4 == 0) ? 0.5f : 1.0f;
+        draw(a, c, points.data(), count, IM_COL32(255, 0, 0, 200), false);
+        draw(b, c, points.data(), count, IM_COL32(255, 0, 0, 200), true);
+        if (!sameOutput(a, b)) {
+            if (mismatches < 10) printf("mismatch on shape %d (%d points, thickness %.1f%s%s%s)\n", i, count, c.thickness,
+                                        c.useTexture ? ", texture" : "", c.closed ? ", closed" : "", c.fill ? ", fill" : "");
+            mismatches++;
+        }
+        ImGui::EndFrame();
+    }
+    printf("\nfuzz: %d random shapes, %d mismatches against the reference\n", fuzzShapes, mismatches);
+
+    ImGui::DestroyContext();
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,257 @@
+// Renders a text-heavy story screen (full-screen background, typewriter story
+// box, choices, stat bars and a journal) through the OpenGL3 backend in a
+// hidden window and reports how much vertex data a frame uploads and what it
+// costs. Build it twice, with and without -DIMGUI_USE_COMPACT_DRAWVERT (every
+// imgui source needs the same setting), to compare the two vertex layouts.
+// --wrap-cache turns on the font atlas' word-wrap layout cache (the game's
+// default), so the journal's unchanging paragraphs skip their line breaking.
+//
+// --discard-check needs no window: it draws wrapped text with the cache on
+// into a small atlas, at sizes that change every frame, so the atlas keeps
+// discarding bakes, also while a layout is being built or drawn. Every text
+// is drawn again with the cache off and the vertex positions compared.
+//
+//   story_text_bench [frames] [--wrap-cache]
+//   story_text_bench --discard-check [frames]
+
+#include "imgui.h"
+#include "imgui_internal.h"
+#include "imgui_impl_opengl3.h"
+#include <glfw3.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <algorithm>
+#include <vector>
+
+static const int WIDTH = 1920;
+static const int HEIGHT = 1080;
+
+static const char* STORY_PARAGRAPHS[] = {
+    "The snow had not stopped for three days. Alex pressed on through the pines, ears flat against the wind, "
+    "following a scent that was fading faster than the light.",
+    "Somewhere past the frozen river the pack had made its last stand, and somewhere beyond that lay the mountain "
+    "pass nobody had crossed since the long winter. The old wolves said the pass remembered every set of paws.",
+    "A crow watched from a broken branch, head tilted, as if it already knew which way Alex would choose. "
+    "Below, the tracks split in two: one line toward the smoke of the village, one toward the silent ridge.",
+    "Hunger gnawed at every step. The last rabbit had been two sunsets ago, and the cold was starting to win.",
+};
+static const int PARAGRAPHS = (int)(sizeof(STORY_PARAGRAPHS) / sizeof(STORY_PARAGRAPHS[0]));
+
+static ImTextureID background;
+
+static void createBackground() {
+    std::vector<unsigned char> pixels(256 * 256 * 4);
+    for (int p = 0; p < 256 * 256; p++) {
+        pixels[p * 4 + 0] = (unsigned char)(p % 256);
+        pixels[p * 4 + 1] = (unsigned char)(p / 256);
+        pixels[p * 4 + 2] = 90;
+        pixels[p * 4 + 3] = 255;
+    }
+    GLuint tex = 0;
+    glGenTextures(1, &tex);
+    glBindTexture(GL_TEXTURE_2D, tex);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 256, 256, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    background = (ImTextureID)(intptr_t)tex;
+}
+
+// Same windows and styling as the in-game story state, with a journal of past
+// paragraphs for extra text. The typewriter reveals a few characters per frame.
+static void buildFrame(int frame) {
+    ImGui::NewFrame();
+    ImGui::GetBackgroundDrawList()->AddImage(background, ImVec2(0, 0), ImVec2((float)WIDTH, (float)HEIGHT));
+
+    ImGui::SetNextWindowPos(ImVec2(20, 20));
+    ImGui::SetNextWindowSize(ImVec2(350, 200));
+    if (ImGui::Begin("Stats", nullptr, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize)) {
+        const char* names[] = { "Health", "Energy", "Hunger", "Reputation" };
+        for (int i = 0; i < 4; i++) {
+            int value = (frame / 5 + i * 21) % 100;
+            char buf[16];
+            snprintf(buf, sizeof(buf), "%d", value);
+            ImGui::Text("%s", names[i]);
+            ImGui::SameLine(110);
+            ImGui::ProgressBar(value / 100.0f, ImVec2(200, 24), buf);
+        }
+    }
+    ImGui::End();
+
+    ImGui::SetNextWindowPos(ImVec2((float)WIDTH - 520, 20));
+    ImGui::SetNextWindowSize(ImVec2(500, 560));
+    if (ImGui::Begin("Journal", nullptr, ImGuiWindowFlags_NoResize)) {
+        for (int i = 0; i < 12; i++) {
+            ImGui::TextDisabled("Day %d", 40 - i);
+            ImGui::TextWrapped("%s", STORY_PARAGRAPHS[i % PARAGRAPHS]);
+        }
+    }
+    ImGui::End();
+
+    const char* story = STORY_PARAGRAPHS[(frame / 240) % PARAGRAPHS];
+    int shown = std::min((int)strlen(story), (frame % 240) * 2);
+    ImGui::SetNextWindowPos(ImVec2(50, HEIGHT - 250.0f));
+    ImGui::SetNextWindowSize(ImVec2(WIDTH - 100.0f, 200));
+    ImGui::PushStyleColor(ImGuiCol_WindowBg, ImVec4(0, 0, 0, 0.85f));
+    if (ImGui::Begin("StoryBox", nullptr, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize)) {
+        ImGui::PushFont(nullptr, 32.0f);
+        ImGui::TextWrapped("%.*s", shown, story);
+        ImGui::PopFont();
+        ImGui::Spacing(); ImGui::Separator(); ImGui::Spacing();
+        const char* choices[] = { "Follow the smoke", "Climb the ridge", "Rest in the hollow" };
+        for (int i = 0; i < 3; i++) {
+            ImGui::Button(choices[i], ImVec2(0, 40));
+            if (i < 2) ImGui::SameLine();
+        }
+    }
+    ImGui::End();
+    ImGui::PopStyleColor();
+
+    ImGui::Render();
+}
+
+// The whole renderer for --discard-check: textures are accepted and forgotten
+static void acceptTextures() {
+    static ImTextureID nextTexID = 1;
+    if (ImGui::GetDrawData()->Textures == nullptr) return;
+    for (ImTextureData* tex : *ImGui::GetDrawData()->Textures) {
+        if (tex->Status == ImTextureStatus_WantCreate) {
+            tex->SetTexID(nextTexID++);
+            tex->SetStatus(ImTextureStatus_OK);
+        } else if (tex->Status == ImTextureStatus_WantUpdates) {
+            tex->SetStatus(ImTextureStatus_OK);
+        } else if (tex->Status == ImTextureStatus_WantDestroy && tex->UnusedFrames > 0) {
+            tex->SetTexID(ImTextureID_Invalid);
+            tex->SetStatus(ImTextureStatus_Destroyed);
+        }
+    }
+}
+
+// Returns the number of texts whose vertices differ between the cached and the uncached layout
+static int discardCheck(int frames) {
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2((float)WIDTH, (float)HEIGHT);
+    io.DeltaTime = 1.0f / 60.0f;
+    io.IniFilename = nullptr;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;
+    io.Fonts->TexMaxWidth = io.Fonts->TexMaxHeight = 1024;
+    io.Fonts->WrapCacheCapacity = 64;
+    ImFont* font = io.Fonts->AddFontFromFileTTF("Assets/Fonts/pixel_font.ttf", 32.0f);
+    if (!font) font = io.Fonts->AddFontDefault();
+
+    int mismatches = 0, texts = 0, discards = 0;
+    for (int f = 0; f < frames; f++) {
+        ImGui::NewFrame();
+        ImDrawList* cached = ImGui::GetForegroundDrawList();
+        ImDrawList* uncached = ImGui::GetBackgroundDrawList();
+        for (int k = 0; k < 4; k++) {
+            // 16 sizes, four a frame: each comes back every fourth frame, after the atlas may have dropped it
+            float size = 16.0f + ((f * 4 + k) % 16) * 2.0f;
+            float wrapWidth = 300.0f + k * 50.0f;
+            const char* text = STORY_PARAGRAPHS[(f + k) % PARAGRAPHS];
+            int cachedFrom = cached->VtxBuffer.Size, uncachedFrom = uncached->VtxBuffer.Size;
+            io.Fonts->WrapCacheCapacity = 64;
+            cached->AddText(font, size, ImVec2(0, 0), IM_COL32_WHITE, text, nullptr, wrapWidth);
+            ImVec2 cachedSize = font->CalcTextSizeA(size, FLT_MAX, wrapWidth, text);
+            io.Fonts->WrapCacheCapacity = 0;
+            uncached->AddText(font, size, ImVec2(0, 0), IM_COL32_WHITE, text, nullptr, wrapWidth);
+            ImVec2 uncachedSize = font->CalcTextSizeA(size, FLT_MAX, wrapWidth, text);
+
+            bool same = cachedSize.x == uncachedSize.x && cachedSize.y == uncachedSize.y
+                && cached->VtxBuffer.Size - cachedFrom == uncached->VtxBuffer.Size - uncachedFrom;
+            for (int v = 0; same && v < cached->VtxBuffer.Size - cachedFrom; v++)
+                same = cached->VtxBuffer[cachedFrom + v].pos.x == uncached->VtxBuffer[uncachedFrom + v].pos.x
+                    && cached->VtxBuffer[cachedFrom + v].pos.y == uncached->VtxBuffer[uncachedFrom + v].pos.y;
+            if (!same) {
+                if (mismatches < 10) printf("mismatch: frame %d, size %.0f, wrap width %.0f\n", f, size, wrapWidth);
+                mismatches++;
+            }
+            texts++;
+        }
+        ImGui::Render();
+        acceptTextures();
+        discards += io.Fonts->Builder->BakedDiscardedCount;   // reset by the next NewFrame()
+    }
+    printf("discard check: %d frames, %d texts, %d bakes discarded, %d layouts reused, %d computed, %d mismatches\n",
+           frames, texts, discards, io.Fonts->WrapCacheHits, io.Fonts->WrapCacheMisses, mismatches);
+    ImGui::DestroyContext();
+    return mismatches;
+}
+
+int main(int argc, char** argv) {
+    int frames = 600;
+    bool wrapCache = false, checkDiscards = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--wrap-cache") == 0) wrapCache = true;
+        else if (strcmp(argv[i], "--discard-check") == 0) checkDiscards = true;
+        else frames = std::max(1, atoi(argv[i]));
+    }
+    if (checkDiscards) return discardCheck(frames) == 0 ? 0 : 1;
+
+    if (!glfwInit()) return 1;
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    GLFWwindow* window = glfwCreateWindow(WIDTH, HEIGHT, "story_text_bench", nullptr, nullptr);
+    if (!window) { glfwTerminate(); return 1; }
+    glfwMakeContextCurrent(window);
+    glfwSwapInterval(0);
+
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2((float)WIDTH, (float)HEIGHT);
+    io.DeltaTime = 1.0f / 60.0f;
+    io.IniFilename = nullptr;
+    io.Fonts->WrapCacheCapacity = wrapCache ? 64 : 0;
+    ImGui_ImplOpenGL3_Init("#version 130");
+    createBackground();
+
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+    const char* layout = "compact";
+#else
+    const char* layout = "default";
+#endif
+    printf("GL_RENDERER: %s\n%s vertex layout, sizeof(ImDrawVert) = %d, wrap cache %s, %d frames\n\n", (const char*)glGetString(GL_RENDERER), layout, (int)sizeof(ImDrawVert), wrapCache ? "on" : "off", frames);
+
+    double renderMs = 0.0, uploadMs = 0.0, frameMs = 0.0, buildMs = 0.0;
+    long long vtxBytes = 0, idxBytes = 0, vertices = 0;
+    for (int f = -60; f < frames; f++) {   // the first 60 frames warm up the atlas and driver
+        auto t0 = std::chrono::steady_clock::now();
+        ImGui_ImplOpenGL3_NewFrame();
+        buildFrame(f + 60);
+        auto t1 = std::chrono::steady_clock::now();
+        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        glfwSwapBuffers(window);
+        auto t2 = std::chrono::steady_clock::now();
+        if (f < 0) {
+            io.Fonts->WrapCacheHits = io.Fonts->WrapCacheMisses = 0;
+            continue;
+        }
+        const ImGui_ImplOpenGL3_FrameStats& stats = ImGui_ImplOpenGL3_GetFrameStats();
+        renderMs += stats.RenderCpuMs;
+        uploadMs += stats.UploadCpuMs;
+        vtxBytes += stats.VtxBytes;
+        idxBytes += stats.IdxBytes;
+        vertices += ImGui::GetDrawData()->TotalVtxCount;
+        buildMs += std::chrono::duration<double, std::milli>(t1 - t0).count();
+        frameMs += std::chrono::duration<double, std::milli>(t2 - t0).count();
+    }
+
+    printf("%-24s %10.0f\n", "vertices / frame", (double)vertices / frames);
+    printf("%-24s %10.1f\n", "vertex KB / frame", vtxBytes / 1024.0 / frames);
+    printf("%-24s %10.1f\n", "index KB / frame", idxBytes / 1024.0 / frames);
+    printf("%-24s %10.3f\n", "build ms", buildMs / frames);
+    printf("%-24s %10.3f\n", "render ms", renderMs / frames);
+    printf("%-24s %10.3f\n", "upload ms", uploadMs / frames);
+    printf("%-24s %10.3f\n", "frame ms", frameMs / frames);
+    if (wrapCache) {
+        printf("%-24s %10.1f\n", "wrap layouts reused", (double)io.Fonts->WrapCacheHits / frames);
+        printf("%-24s %10.1f\n", "wrap layouts computed", (double)io.Fonts->WrapCacheMisses / frames);
+    }
+
+    ImGui_ImplOpenGL3_Shutdown();
+    ImGui::DestroyContext();
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    return 0;
+}
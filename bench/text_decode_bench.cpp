@@ -0,0 +1,213 @@
+// Measures the text loops that walk UTF-8 one character at a time (text
+// sizing with and without wrapping, character counting, conversion to
+// ImWchar) on the game's own story text, and checks them against the plain
+// per-character decoder on random byte strings: ASCII, multi-byte sequences,
+// truncated and invalid ones, control characters and embedded NULs. No window
+// or GPU needed. Start it from the workspace folder so the font is found.
+//
+// "reference" rows are the per-character loops the ASCII fast path replaced,
+// timed in the same build. Building with -DIMGUI_DISABLE_SSE (every imgui
+// source needs the same setting) times the fast path without the 16-byte
+// scan.
+//
+//   text_decode_bench [iterations] [fuzz strings]
+
+#include "imgui.h"
+#include "imgui_internal.h"
+#include "GameEngine.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+static GameEngine engine;
+
+// The loops as they were before the fast path, one ImTextCharFromUtf8() per character
+static int referenceCountChars(const char* text, const char* textEnd) {
+    int count = 0;
+    while ((!textEnd || text < textEnd) && *text) {
+        unsigned int c;
+        text += ImTextCharFromUtf8(&c, text, textEnd);
+        count++;
+    }
+    return count;
+}
+
+static int referenceStrFromUtf8(ImWchar* buf, int bufSize, const char* text, const char* textEnd, const char** remaining) {
+    ImWchar* out = buf;
+    ImWchar* bufEnd = buf + bufSize;
+    while (out < bufEnd - 1 && (!textEnd || text < textEnd) && *text) {
+        unsigned int c;
+        text += ImTextCharFromUtf8(&c, text, textEnd);
+        *out++ = (ImWchar)c;
+    }
+    *out = 0;
+    if (remaining) *remaining = text;
+    return (int)(out - buf);
+}
+
+// CalcTextSizeA() without wrapping
+static ImVec2 referenceTextSize(ImFont* font, float size, float maxWidth, const char* text, const char* textEnd, const char** remaining) {
+    ImFontBaked* baked = font->GetFontBaked(size);
+    const float scale = size / baked->Size;
+    ImVec2 textSize(0, 0);
+    float lineWidth = 0.0f;
+    const char* s = text;
+    while (s < textEnd) {
+        const char* prev = s;
+        unsigned int c = (unsigned int)*s;
+        if (c < 0x80) s += 1;
+        else s += ImTextCharFromUtf8(&c, s, textEnd);
+        if (c == '\n') {
+            textSize.x = std::max(textSize.x, lineWidth);
+            textSize.y += size;
+            lineWidth = 0.0f;
+            continue;
+        }
+        if (c == '\r') continue;
+        float charWidth = baked->GetCharAdvance((ImWchar)c) * scale;
+        if (lineWidth + charWidth >= maxWidth) {
+            s = prev;
+            break;
+        }
+        lineWidth += charWidth;
+    }
+    if (textSize.x < lineWidth) textSize.x = lineWidth;
+    if (lineWidth > 0 || textSize.y == 0.0f) textSize.y += size;
+    if (remaining) *remaining = s;
+    return textSize;
+}
+
+static std::string randomText(std::mt19937& rng) {
+    static const char* pieces[] = {
+        "wolf", " ", "The snow had not stopped. ", "\n", "\r\n", "\t", "!?", "0123456789abcdefghij",
+        "\xc3\xa9", "\xe2\x80\x94", "\xf0\x9f\x90\xba", "\xe3\x80\x82",             // 2, 3 and 4 byte sequences
+        "\xc3", "\xe2\x80", "\x80", "\xbf\xbf", "\xff", "\xed\xa0\x80", "\xc0\xaf", // truncated, stray, invalid, surrogate, overlong
+        "\x01", "\x7f",
+    };
+    const int pieceCount = (int)(sizeof(pieces) / sizeof(pieces[0]));
+    std::string text;
+    int n = (int)(rng() % 40);
+    for (int i = 0; i < n; i++) text += pieces[rng() % pieceCount];
+    if (rng() % 8 == 0 && !text.empty()) text[rng() % text.size()] = '\0';
+    return text;
+}
+
+// Returns the number of mismatches
+static int fuzz(ImFont* font, int strings) {
+    std::mt19937 rng(1234);
+    std::vector<ImWchar> a, b;
+    int mismatches = 0;
+    for (int i = 0; i < strings; i++) {
+        std::string text = randomText(rng);
+        const char* begin = text.c_str();
+        const char* end = begin + text.size();
+        bool ok = true;
+
+        ok &= ImTextCountCharsFromUtf8(begin, end) == referenceCountChars(begin, end);
+        ok &= ImTextCountCharsFromUtf8(begin, nullptr) == referenceCountChars(begin, nullptr);
+
+        int bufSize = 1 + (int)(rng() % (text.size() + 2));
+        a.resize(bufSize);
+        b.resize(bufSize);
+        const char* remA = nullptr;
+        const char* remB = nullptr;
+        int countA = ImTextStrFromUtf8(a.data(), bufSize, begin, end, &remA);
+        int countB = referenceStrFromUtf8(b.data(), bufSize, begin, end, &remB);
+        ok &= countA == countB && remA == remB && memcmp(a.data(), b.data(), (countA + 1) * sizeof(ImWchar)) == 0;
+        countA = ImTextStrFromUtf8(a.data(), bufSize, begin, nullptr, &remA);
+        countB = referenceStrFromUtf8(b.data(), bufSize, begin, nullptr, &remB);
+        ok &= countA == countB && remA == remB && memcmp(a.data(), b.data(), (countA + 1) * sizeof(ImWchar)) == 0;
+
+        float maxWidth = (rng() % 2) ? FLT_MAX : (float)(rng() % 600);
+        remA = remB = nullptr;
+        ImVec2 sizeA = font->CalcTextSizeA(32.0f, maxWidth, 0.0f, begin, end, &remA);
+        ImVec2 sizeB = referenceTextSize(font, 32.0f, maxWidth, begin, end, &remB);
+        ok &= sizeA.x == sizeB.x && sizeA.y == sizeB.y && remA == remB;
+
+        if (!ok) {
+            if (mismatches < 10) printf("mismatch on string %d (%d bytes)\n", i, (int)text.size());
+            mismatches++;
+        }
+    }
+    return mismatches;
+}
+
+template<typename F>
+static double megabytesPerSecond(size_t bytes, int iterations, F&& f) {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) f();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    return bytes * (double)iterations / seconds / (1024.0 * 1024.0);
+}
+
+int main(int argc, char** argv) {
+    int iterations = argc > 1 ? std::max(1, atoi(argv[1])) : 200;
+    int fuzzStrings = argc > 2 ? std::max(0, atoi(argv[2])) : 200000;
+
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(1920, 1080);
+    io.DeltaTime = 1.0f / 60.0f;
+    io.IniFilename = nullptr;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;
+    ImFont* font = io.Fonts->AddFontFromFileTTF("Assets/Fonts/pixel_font.ttf", 32.0f);
+    if (!font) font = io.Fonts->AddFontDefault();
+    ImGui::NewFrame();
+
+    // Every story node and intro line, one paragraph each
+    engine.headless = true;
+    engine.rngSeed = 1;
+    engine.initGame();
+    std::vector<std::string> paragraphs(engine.introLines.begin(), engine.introLines.end());
+    for (const auto& node : engine.storyMap)
+        if (node.second && !node.second->text.empty()) paragraphs.push_back(node.second->text);
+    size_t bytes = 0, asciiBytes = 0;
+    for (const std::string& p : paragraphs) {
+        bytes += p.size();
+        for (char ch : p) asciiBytes += (unsigned char)ch < 0x80;
+    }
+
+#ifdef IMGUI_DISABLE_SSE
+    const char* path = "byte loop";
+#else
+    const char* path = "16-byte SSE2 scan where available";
+#endif
+    printf("ASCII runs: %s\n", path);
+    printf("story text: %d paragraphs, %d bytes, %.1f%% ASCII, %d iterations\n\n", (int)paragraphs.size(), (int)bytes, 100.0 * asciiBytes / std::max<size_t>(bytes, 1), iterations);
+
+    std::vector<ImWchar> wide(4096);
+    for (const std::string& p : paragraphs)    // loads the glyphs, so the timings below don't rasterize any
+        font->CalcTextSizeA(32.0f, FLT_MAX, 0.0f, p.data(), p.data() + p.size());
+    volatile float sink = 0.0f;
+    volatile int isink = 0;
+    struct Row { const char* name; double mbps; };
+    std::vector<Row> rows;
+    rows.push_back({ "CalcTextSizeA", megabytesPerSecond(bytes, iterations, [&] {
+        for (const std::string& p : paragraphs) sink = sink + font->CalcTextSizeA(32.0f, FLT_MAX, 0.0f, p.data(), p.data() + p.size()).x; }) });
+    rows.push_back({ "  reference", megabytesPerSecond(bytes, iterations, [&] {
+        for (const std::string& p : paragraphs) sink = sink + referenceTextSize(font, 32.0f, FLT_MAX, p.data(), p.data() + p.size(), nullptr).x; }) });
+    rows.push_back({ "CalcTextSizeA wrapped", megabytesPerSecond(bytes, iterations, [&] {
+        for (const std::string& p : paragraphs) sink = sink + font->CalcTextSizeA(32.0f, FLT_MAX, 1720.0f, p.data(), p.data() + p.size()).y; }) });
+    rows.push_back({ "CountCharsFromUtf8", megabytesPerSecond(bytes, iterations, [&] {
+        for (const std::string& p : paragraphs) isink = isink + ImTextCountCharsFromUtf8(p.data(), p.data() + p.size()); }) });
+    rows.push_back({ "  reference", megabytesPerSecond(bytes, iterations, [&] {
+        for (const std::string& p : paragraphs) isink = isink + referenceCountChars(p.data(), p.data() + p.size()); }) });
+    rows.push_back({ "StrFromUtf8", megabytesPerSecond(bytes, iterations, [&] {
+        for (const std::string& p : paragraphs) isink = isink + ImTextStrFromUtf8(wide.data(), (int)wide.size(), p.data(), p.data() + p.size()); }) });
+    rows.push_back({ "  reference", megabytesPerSecond(bytes, iterations, [&] {
+        for (const std::string& p : paragraphs) isink = isink + referenceStrFromUtf8(wide.data(), (int)wide.size(), p.data(), p.data() + p.size(), nullptr); }) });
+    printf("%-24s %10s\n", "", "MB/s");
+    for (const Row& row : rows) printf("%-24s %10.0f\n", row.name, row.mbps);
+
+    int mismatches = fuzz(font, fuzzStrings);
+    printf("\nfuzz: %d random strings, %d mismatches against the per-character decoder\n", fuzzStrings, mismatches);
+
+    ImGui::EndFrame();
+    ImGui::DestroyContext();
+    return mismatches == 0 ? 0 : 1;
+}
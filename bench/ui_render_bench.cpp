@@ -0,0 +1,326 @@
+// Renders a synthetic copy of the in-game HUD (stats, action bar, story box,
+// inventory) through the OpenGL3 backend in a hidden window and reports the
+// CPU time RenderDrawData() spends in the driver, per upload path, along with
+// how many draw calls and state changes a frame costs. Then streams 1080p
+// scene textures in 16-row strips the way GameEngine does, with and without
+// the pixel-buffer upload ring. Finally times the frames on the GPU with the
+// backend's timer queries and reports how late their results come back, and
+// compares compiling the shader program with loading it from the binary cache.
+// Set MESA_SHADER_CACHE_DISABLE=true (or clear the driver's shader cache) for
+// numbers close to a cold start.
+//
+//   ui_render_bench [frames]
+
+#include "imgui.h"
+#include "imgui_impl_opengl3.h"
+#include <glfw3.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <algorithm>
+#include <vector>
+
+static const int WIDTH = 1920;
+static const int HEIGHT = 1080;
+
+static const char* STORY_TEXT =
+    "The snow had not stopped for three days. Alex pressed on through the pines, ears flat against the wind, "
+    "following a scent that was fading faster than the light. Somewhere past the frozen river the pack had "
+    "made its last stand, and somewhere beyond that lay the mountain pass nobody had crossed since the long winter.";
+
+// Stand-ins for the stat and action bar icons; the game loads one texture per icon.
+static ImTextureID icons[8];
+
+static void createIcons() {
+    unsigned char pixels[16 * 16 * 4];
+    for (int i = 0; i < 8; i++) {
+        for (int p = 0; p < 16 * 16; p++) {
+            pixels[p * 4 + 0] = (unsigned char)(i * 30);
+            pixels[p * 4 + 1] = (unsigned char)(255 - i * 30);
+            pixels[p * 4 + 2] = (unsigned char)(p & 0xFF);
+            pixels[p * 4 + 3] = 255;
+        }
+        GLuint tex = 0;
+        glGenTextures(1, &tex);
+        glBindTexture(GL_TEXTURE_2D, tex);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 16, 16, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+        icons[i] = (ImTextureID)(intptr_t)tex;
+    }
+}
+
+static void buildFrame(int frame) {
+    ImGui::NewFrame();
+    ImGui::GetBackgroundDrawList()->AddRectFilled(ImVec2(0, 0), ImVec2((float)WIDTH, (float)HEIGHT), IM_COL32(20, 20, 20, 255));
+
+    ImGui::SetNextWindowPos(ImVec2(20, 20));
+    ImGui::SetNextWindowSize(ImVec2(350, 220));
+    if (ImGui::Begin("Stats", nullptr, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize)) {
+        ImGui::TextColored(ImVec4(1, 0.8f, 0, 1), "Day: %d", 3 + frame / 600);
+        ImGui::Separator();
+        const char* labels[] = { "HP ", "EN ", "FD ", "REP" };
+        for (int i = 0; i < 4; i++) {
+            ImGui::Image(icons[i], ImVec2(24, 24));
+            ImGui::SameLine();
+            ImGui::Text("%s", labels[i]);
+            ImGui::SameLine();
+            char buf[16];
+            snprintf(buf, sizeof(buf), "%d", (frame / 7 + i * 23) % 100);
+            ImGui::ProgressBar(((frame / 7 + i * 23) % 100) / 100.0f, ImVec2(200, 24), buf);
+        }
+        ImGui::Text("Rank: Lone Wanderer");
+    }
+    ImGui::End();
+
+    ImGui::SetNextWindowPos(ImVec2(WIDTH - 480.0f, 20));
+    ImGui::SetNextWindowSize(ImVec2(460, 80));
+    if (ImGui::Begin("Actions", nullptr, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize)) {
+        const char* actions[] = { "INV", "MAP", "HUNT", "REST", "UNDO", "SAVE", "MUTE" };
+        for (int i = 0; i < 7; i++) {
+            if (i) ImGui::SameLine();
+            if (i < 4) ImGui::ImageButton(actions[i], icons[4 + i], ImVec2(40, 40));
+            else ImGui::Button(actions[i], ImVec2(55, 40));
+        }
+    }
+    ImGui::End();
+
+    ImGui::SetNextWindowPos(ImVec2(50, HEIGHT - 250.0f));
+    ImGui::SetNextWindowSize(ImVec2(WIDTH - 100.0f, 200));
+    if (ImGui::Begin("StoryBox", nullptr, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize)) {
+        int shown = std::min((int)strlen(STORY_TEXT), frame * 2);
+        ImGui::TextWrapped("%.*s", shown, STORY_TEXT);
+        ImGui::Separator();
+        ImGui::Button("Follow the river", ImVec2(0, 40)); ImGui::SameLine();
+        ImGui::Button("Climb the ridge", ImVec2(0, 40)); ImGui::SameLine();
+        ImGui::Button("Wait for nightfall", ImVec2(0, 40));
+    }
+    ImGui::End();
+
+    ImGui::SetNextWindowPos(ImVec2(WIDTH / 2 - 200.0f, HEIGHT / 2 - 200.0f));
+    ImGui::SetNextWindowSize(ImVec2(400, 400));
+    if (ImGui::Begin("Backpack")) {
+        for (int i = 0; i < 12; i++) {
+            ImGui::PushID(i);
+            ImGui::Text("Item %d x%d", i, 1 + i % 4);
+            ImGui::SameLine(300);
+            ImGui::Button("USE");
+            ImGui::PopID();
+        }
+    }
+    ImGui::End();
+
+    ImGui::Render();
+}
+
+struct PathResult {
+    double renderMs = 0.0, uploadMs = 0.0, frameMs = 0.0;
+    int fenceWaits = 0;
+    bool persistent = false;
+    int drawCmds = 0, drawCalls = 0, stateChanges = 0, skipped = 0;    // last frame
+};
+
+static PathResult runPath(GLFWwindow* window, int frames) {
+    PathResult r;
+    for (int f = -60; f < frames; f++) {   // the first 60 frames warm up the atlas and driver
+        auto t0 = std::chrono::steady_clock::now();
+        ImGui_ImplOpenGL3_NewFrame();
+        buildFrame(f + 60);
+        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        glfwSwapBuffers(window);
+        double frameMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        if (f < 0) continue;
+        const ImGui_ImplOpenGL3_FrameStats& stats = ImGui_ImplOpenGL3_GetFrameStats();
+        r.renderMs += stats.RenderCpuMs;
+        r.uploadMs += stats.UploadCpuMs;
+        r.fenceWaits += stats.FenceWaits;
+        r.persistent = stats.PersistentBuffers;
+        r.drawCmds = stats.DrawCmds;
+        r.drawCalls = stats.DrawCalls;
+        r.stateChanges = stats.ScissorChanges + stats.TextureBinds + stats.ProgramBinds;
+        r.skipped = stats.RedundantSkipped;
+        r.frameMs += frameMs;
+    }
+    r.renderMs /= frames;
+    r.uploadMs /= frames;
+    r.frameMs /= frames;
+    return r;
+}
+
+struct UploadResult {
+    double submitMs = 0.0;      // CPU time in the upload calls, per texture
+    double loadFrameMs = 0.0;   // frame that loads the texture, per texture
+    double framesToReady = 0.0; // frames until the texture is complete, per texture
+};
+
+static void renderFrame(GLFWwindow* window, int frame) {
+    ImGui_ImplOpenGL3_NewFrame();
+    buildFrame(frame);
+    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    glfwSwapBuffers(window);
+}
+
+// Loads 'count' 1920x1080 RGB textures strip by strip like
+// GameEngine::streamTextureFromPng (a node change), keeps rendering the HUD
+// until each one is complete, then moves on to the next.
+static UploadResult streamTextures(GLFWwindow* window, int count) {
+    const int W = 1920, H = 1080, STRIP_ROWS = 16;
+    std::vector<unsigned char> image((size_t)W * H * 3);
+    for (size_t i = 0; i < image.size(); i++) image[i] = (unsigned char)(i * 31 + i / 4096);
+
+    UploadResult r;
+    int frame = 0;
+    for (int n = 0; n < count; n++) {
+        for (int settle = 0; settle < 4; settle++) renderFrame(window, frame++);
+
+        auto t0 = std::chrono::steady_clock::now();
+        ImGui_ImplOpenGL3_NewFrame();
+        buildFrame(frame++);
+        GLuint tex = 0;
+        glGenTextures(1, &tex);
+        glBindTexture(GL_TEXTURE_2D, tex);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, W, H, 0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
+        auto s0 = std::chrono::steady_clock::now();
+        for (int y = 0; y < H; y += STRIP_ROWS)
+            ImGui_ImplOpenGL3_UploadTextureRegion((ImTextureID)(intptr_t)tex, 0, y, W, std::min(STRIP_ROWS, H - y), 3, image.data() + (size_t)y * W * 3);
+        r.submitMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - s0).count();
+        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        glfwSwapBuffers(window);
+        r.loadFrameMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+
+        int frames = 1;
+        while (ImGui_ImplOpenGL3_IsTextureUploadPending((ImTextureID)(intptr_t)tex)) {
+            renderFrame(window, frame++);
+            frames++;
+        }
+        r.framesToReady += frames;
+        glDeleteTextures(1, &tex);
+    }
+    r.submitMs /= count;
+    r.loadFrameMs /= count;
+    r.framesToReady /= count;
+    return r;
+}
+
+struct GpuTimerResult {
+    double renderCpuMs = 0.0;   // RenderDrawData() CPU time with the queries issued
+    double renderGpuMs = 0.0;   // resolved GL_TIME_ELAPSED, per frame
+    double latency = 0.0;       // frames between recording and readback
+    int resolved = 0, dropped = 0;
+    ImVector<ImGui_ImplOpenGL3_GpuListTiming> lists;    // last resolved frame
+};
+
+static GpuTimerResult runGpuTimers(GLFWwindow* window, int frames) {
+    GpuTimerResult r;
+    int lastSeen = -1;
+    for (int f = 0; f < frames; f++) {
+        renderFrame(window, f);
+        r.renderCpuMs += ImGui_ImplOpenGL3_GetFrameStats().RenderCpuMs;
+        const ImGui_ImplOpenGL3_GpuTimings* t = ImGui_ImplOpenGL3_GetGpuTimings();
+        if (!t || t->FrameIndex == lastSeen) continue;
+        lastSeen = t->FrameIndex;
+        r.renderGpuMs += t->RenderGpuMs;
+        r.latency += f - t->FrameIndex;
+        r.resolved++;
+        r.dropped = t->DroppedFrames;
+        r.lists = t->Lists;
+    }
+    r.renderCpuMs /= frames;
+    if (r.resolved) { r.renderGpuMs /= r.resolved; r.latency /= r.resolved; }
+    return r;
+}
+
+// Recreates the device objects 'runs' times and returns the average time spent getting the
+// shader program ready. The first run with a fresh cache file compiles and fills it.
+static double programSetupMs(int runs, bool* fromCache) {
+    double total = 0.0;
+    for (int i = 0; i < runs; i++) {
+        ImGui_ImplOpenGL3_DestroyDeviceObjects();
+        ImGui_ImplOpenGL3_CreateDeviceObjects();
+        total += ImGui_ImplOpenGL3_GetProgramSetupMs(fromCache);
+    }
+    return total / runs;
+}
+
+int main(int argc, char** argv) {
+    int frames = argc > 1 ? std::max(1, atoi(argv[1])) : 600;
+
+    if (!glfwInit()) return 1;
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    GLFWwindow* window = glfwCreateWindow(WIDTH, HEIGHT, "ui_render_bench", nullptr, nullptr);
+    if (!window) { glfwTerminate(); return 1; }
+    glfwMakeContextCurrent(window);
+    glfwSwapInterval(0);
+
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2((float)WIDTH, (float)HEIGHT);
+    io.DeltaTime = 1.0f / 60.0f;
+    io.IniFilename = nullptr;
+    ImGui_ImplOpenGL3_Init("#version 130");
+    createIcons();
+
+    printf("GL_RENDERER: %s\nGL_VERSION:  %s\n%d frames per path\n\n", (const char*)glGetString(GL_RENDERER), (const char*)glGetString(GL_VERSION), frames);
+    printf("%-22s %12s %12s %12s %12s\n", "upload path", "render ms", "upload ms", "frame ms", "fence waits");
+
+    ImGui_ImplOpenGL3_SetPersistentBuffers(false);
+    PathResult legacy = runPath(window, frames);
+    printf("%-22s %12.3f %12.3f %12.3f %12d\n", "glBufferData", legacy.renderMs, legacy.uploadMs, legacy.frameMs, legacy.fenceWaits);
+
+    if (ImGui_ImplOpenGL3_SetPersistentBuffers(true)) {
+        PathResult ring = runPath(window, frames);
+        printf("%-22s %12.3f %12.3f %12.3f %12d\n", "persistent ring", ring.renderMs, ring.uploadMs, ring.frameMs, ring.fenceWaits);
+    } else {
+        printf("%-22s not supported by this context\n", "persistent ring");
+    }
+
+    printf("\nper frame: %d draw commands -> %d draw calls, %d state changes, %d redundant changes skipped\n",
+           legacy.drawCmds, legacy.drawCalls, legacy.stateChanges, legacy.skipped);
+
+    const int SCENES = 8;
+    printf("\n%d scene textures, 1920x1080 RGB in 16-row strips\n", SCENES);
+    printf("%-22s %12s %12s %12s\n", "texture uploads", "submit ms", "load frame", "frames");
+    ImGui_ImplOpenGL3_SetAsyncTextureUploads(false);
+    UploadResult direct = streamTextures(window, SCENES);
+    printf("%-22s %12.2f %12.2f %12.1f\n", "glTexSubImage2D", direct.submitMs, direct.loadFrameMs, direct.framesToReady);
+    if (ImGui_ImplOpenGL3_SetAsyncTextureUploads(true, 4 * 1024 * 1024)) {
+        UploadResult ring = streamTextures(window, SCENES);
+        printf("%-22s %12.2f %12.2f %12.1f\n", "PBO ring, 4 MB/frame", ring.submitMs, ring.loadFrameMs, ring.framesToReady);
+    } else {
+        printf("%-22s not supported by this context\n", "PBO ring");
+    }
+
+    printf("\n%-22s %12s %12s %12s %12s\n", "GPU timer queries", "render ms", "GPU ms", "latency", "dropped");
+    ImGui_ImplOpenGL3_SetPersistentBuffers(false);
+    if (ImGui_ImplOpenGL3_SetGpuTimers(true)) {
+        GpuTimerResult timed = runGpuTimers(window, frames);
+        ImGui_ImplOpenGL3_SetGpuTimers(false);
+        printf("%-22s %12.3f %12.3f %12.1f %12d\n", "enabled", timed.renderCpuMs, timed.renderGpuMs, timed.latency, timed.dropped);
+        for (const ImGui_ImplOpenGL3_GpuListTiming& list : timed.lists)
+            printf("  %-20s %12s %12.3f %9d idx\n", list.Name[0] ? list.Name : "(no owner)", "", list.GpuMs, list.ElemCount);
+    } else {
+        printf("%-22s not supported by this context\n", "enabled");
+    }
+
+    const char* cachePath = "ui_render_bench_program.bin";
+    bool fromCache = false;
+    remove(cachePath);
+    printf("\n%-22s %12s\n", "shader program", "setup ms");
+    printf("%-22s %12.3f\n", "compile + link", programSetupMs(20, &fromCache));
+    if (ImGui_ImplOpenGL3_SetProgramCache(cachePath)) {
+        programSetupMs(1, &fromCache);   // writes the cache
+        double cached = programSetupMs(20, &fromCache);
+        printf("%-22s %12.3f%s\n", "program binary cache", cached, fromCache ? "" : " (driver rejected the binary)");
+        ImGui_ImplOpenGL3_SetProgramCache(nullptr);
+        remove(cachePath);
+    } else {
+        printf("%-22s not supported by this context\n", "program binary cache");
+    }
+
+    ImGui_ImplOpenGL3_Shutdown();
+    ImGui::DestroyContext();
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    return 0;
+}
@@ -0,0 +1,259 @@
+// Builds every game screen through the real GameUI code with no window, GL
+// context or audio device, and reports per screen what a frame costs on the
+// CPU and how much geometry it hands to the renderer. The renderer is a null
+// backend: it accepts texture requests and counts the draw data. Runs on any
+// machine, GPU or not. Start it from the workspace folder so the fonts,
+// icons and save files are found.
+//
+// With --replay it instead plays back a session recorded with ATW_RECORD,
+// frame by frame at full speed, and reports the frame-time distribution and
+// heap allocations per frame. Optionally writes one CSV row per frame. The
+// game state at the end is checked against the one the recording ended with.
+//
+//   ui_state_bench [frames]
+//   ui_state_bench --replay <recording> [frames.csv]
+
+#include "imgui.h"
+#include "GameEngine.h"
+#include "GameUI.h"
+#include "SaveCatalog.h"
+#include "AllocTracker.h"
+#include "InputRecording.h"
+#include "SimClock.h"
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include <thread>
+
+static const int WIDTH = 1920;
+static const int HEIGHT = 1080;
+static const int WARMUP_FRAMES = 30;
+
+static GameEngine engine;
+static SaveCatalog saveCatalog;
+static GameUI ui(engine, saveCatalog);
+static SimClock simClock;
+
+// The main loop's per-frame game work: simulation steps, then the screens
+static void runFrame(int displayW, int displayH, float deltaTime) {
+    int steps = simClock.advance(deltaTime);
+    for (int i = 0; i < steps; i++) ui.update((float)simClock.stepSeconds());
+    ui.drawFrame(displayW, displayH, (float)simClock.alpha());
+}
+
+struct DrawCounts {
+    long long vertices;
+    long long indices;
+    long long commands;
+    long long lists;
+};
+
+// The whole renderer: textures are "uploaded" by handing out IDs, draw data is only counted.
+static void nullRenderDrawData(ImDrawData* drawData, DrawCounts& counts) {
+    static ImTextureID nextTexID = 1;
+    if (drawData->Textures != nullptr) {
+        for (ImTextureData* tex : *drawData->Textures) {
+            if (tex->Status == ImTextureStatus_WantCreate) {
+                tex->SetTexID(nextTexID++);
+                tex->SetStatus(ImTextureStatus_OK);
+            } else if (tex->Status == ImTextureStatus_WantUpdates) {
+                tex->SetStatus(ImTextureStatus_OK);
+            } else if (tex->Status == ImTextureStatus_WantDestroy && tex->UnusedFrames > 0) {
+                tex->SetTexID(ImTextureID_Invalid);
+                tex->SetStatus(ImTextureStatus_Destroyed);
+            }
+        }
+    }
+    counts.vertices += drawData->TotalVtxCount;
+    counts.indices += drawData->TotalIdxCount;
+    counts.lists += drawData->CmdListsCount;
+    for (const ImDrawList* drawList : drawData->CmdLists)
+        counts.commands += drawList->CmdBuffer.Size;
+}
+
+static void enterGameplay() {
+    engine.currentState = STATE_GAMEPLAY;
+    if (engine.currentNode) engine.startTypewriter(engine.currentNode->text);
+}
+
+struct Scenario {
+    const char* name;
+    void (*setup)();
+};
+
+static const Scenario SCENARIOS[] = {
+    { "Menu",               [] { engine.currentState = STATE_MENU; } },
+    { "Intro",              [] { engine.currentState = STATE_INTRO; engine.introLineIndex = 0; engine.startTypewriter(engine.introLines[0]); } },
+    { "Gameplay",           [] { enterGameplay(); } },
+    { "Gameplay + backpack", [] { enterGameplay(); ui.showInventory = true; } },
+    { "Gameplay + map",     [] { enterGameplay(); ui.showMap = true; } },
+    { "Rest",               [] { engine.performGlobalRest(); engine.currentState = STATE_REST; } },
+    { "Scavenge",           [] { engine.performGlobalScavenge(); engine.currentState = STATE_SCAVENGE; } },
+    { "Save popup",         [] { enterGameplay(); ui.showSavePopup = true; } },
+    { "Load popup",         [] { enterGameplay(); ui.showLoadPopup = true; } },
+};
+
+static double percentile(const std::vector<double>& sorted, double p) {
+    return sorted[std::min(sorted.size() - 1, (size_t)(p * (sorted.size() - 1) + 0.5))];
+}
+
+static int replay(InputReplayer& replayer, const char* csvPath) {
+    ImGuiIO& io = ImGui::GetIO();
+    FILE* csv = nullptr;
+    if (csvPath) {
+        csv = fopen(csvPath, "w");
+        if (!csv) printf("Couldn't create %s\n", csvPath);
+        else fprintf(csv, "frame,cpu_ms,allocs,alloc_bytes,vertices,indices,cmds\n");
+    }
+
+    std::vector<double> frameMs;
+    long long totalAllocs = 0, totalBytes = 0, framesWithAllocs = 0;
+    DrawCounts counts = {};
+    int displayW = WIDTH, displayH = HEIGHT;
+    while (true) {
+        AllocCounts before = AllocTracker::current();
+        DrawCounts frameCounts = {};
+        auto t0 = std::chrono::steady_clock::now();
+        if (!replayer.applyFrame(&displayW, &displayH)) break;
+        ImGui::NewFrame();
+        runFrame(displayW, displayH, io.DeltaTime);
+        ImGui::Render();
+        nullRenderDrawData(ImGui::GetDrawData(), frameCounts);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        AllocCounts after = AllocTracker::current();
+
+        long long allocs = after.allocs - before.allocs, bytes = after.bytes - before.bytes;
+        frameMs.push_back(ms);
+        totalAllocs += allocs;
+        totalBytes += bytes;
+        if (allocs > 0) framesWithAllocs++;
+        counts.vertices += frameCounts.vertices;
+        counts.indices += frameCounts.indices;
+        counts.commands += frameCounts.commands;
+        if (csv) fprintf(csv, "%d,%.4f,%lld,%lld,%lld,%lld,%lld\n", (int)frameMs.size() - 1, ms, allocs, bytes,
+                         frameCounts.vertices, frameCounts.indices, frameCounts.commands);
+    }
+    if (csv) fclose(csv);
+
+    int frames = (int)frameMs.size();
+    if (frames == 0) {
+        printf("The recording holds no frames\n");
+        return 1;
+    }
+    double totalMs = 0.0;
+    for (double ms : frameMs) totalMs += ms;
+    std::vector<double> sorted = frameMs;
+    std::sort(sorted.begin(), sorted.end());
+    printf("%d frames replayed in %.1f ms\n\n", frames, totalMs);
+    printf("cpu ms/frame: avg %.3f  p50 %.3f  p95 %.3f  p99 %.3f  max %.3f\n", totalMs / frames,
+           percentile(sorted, 0.50), percentile(sorted, 0.95), percentile(sorted, 0.99), sorted.back());
+    printf("allocations:  %.2f per frame, %.0f bytes per frame, %lld of %d frames allocate\n",
+           (double)totalAllocs / frames, (double)totalBytes / frames, framesWithAllocs, frames);
+    printf("geometry:     %lld vertices, %lld indices, %lld cmds per frame\n\n",
+           counts.vertices / frames, counts.indices / frames, counts.commands / frames);
+
+    if (!replayer.hasTrailer()) {
+        printf("The recording has no trailer (the game didn't exit cleanly); end state not checked\n");
+        return 0;
+    }
+    bool match = replayer.recordedChecksum() == engine.stateChecksum();
+    printf("End state %s the recording (%08x vs %08x)\n", match ? "matches" : "DIFFERS from",
+           engine.stateChecksum(), replayer.recordedChecksum());
+    return match ? 0 : 2;
+}
+
+int main(int argc, char** argv) {
+    const char* replayPath = nullptr;
+    const char* csvPath = nullptr;
+    if (argc > 2 && strcmp(argv[1], "--replay") == 0) {
+        replayPath = argv[2];
+        csvPath = argc > 3 ? argv[3] : nullptr;
+    }
+    int frames = (!replayPath && argc > 1) ? std::max(1, atoi(argv[1])) : 600;
+
+    // Allocation counts are only reported for replays, but hooking ImGui has to happen before its context exists
+    if (replayPath) AllocTracker::install();
+
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2((float)WIDTH, (float)HEIGHT);
+    io.DeltaTime = 1.0f / 60.0f;
+    io.IniFilename = nullptr;
+    io.BackendRendererName = "null";
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;
+
+    ImFont* titleFont = io.Fonts->AddFontFromFileTTF("Assets/Fonts/pixel_font.ttf", 32.0f);
+    ImFont* bodyFont = io.Fonts->AddFontFromFileTTF("Assets/Fonts/pixel_font.ttf", 16.0f);
+    if (!titleFont || !bodyFont) printf("Assets/Fonts/pixel_font.ttf not found, using the default font (run from the workspace folder)\n");
+    if (!titleFont) titleFont = io.Fonts->AddFontDefault();
+    if (!bodyFont) bodyFont = io.Fonts->AddFontDefault();
+    setupImGuiStyle();
+
+    InputReplayer replayer;
+    if (replayPath && !replayer.open(replayPath)) {
+        printf("Couldn't read a recording from %s\n", replayPath);
+        return 1;
+    }
+
+    engine.headless = true;
+    engine.rngSeed = replayer.seed();
+    if (replayer.simRate() > 0.0) simClock.setRate(replayer.simRate());
+    engine.initGame();
+    // Something to list in the backpack (a replay starts from the game's own new-game state)
+    if (!replayPath) {
+        engine.inventory.addItem(Item("Meat", FOOD, 20, 3));
+        engine.inventory.addItem(Item("Healing Herb", HERB, 15, 2));
+        engine.inventory.addItem(Item("Sharp Stone", WEAPON, 0, 1));
+    }
+    saveCatalog.start(".");
+    ui.init(titleFont, bodyFont);
+    for (int i = 0; i < 200 && !saveCatalog.isScanned(); i++) {
+        saveCatalog.update();
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    if (replayPath) {
+        AllocTracker::setEnabled(true);
+        int result = replay(replayer, csvPath);
+        saveCatalog.stop();
+        ImGui::DestroyContext();
+        return result;
+    }
+
+    printf("%d x %d, %d frames per screen (+%d warm-up)\n\n", WIDTH, HEIGHT, frames, WARMUP_FRAMES);
+    printf("%-22s %9s %9s %9s %8s %8s %7s\n", "screen", "cpu ms", "max ms", "vertices", "indices", "cmds", "lists");
+
+    for (const Scenario& scenario : SCENARIOS) {
+        ui.showInventory = ui.showMap = ui.showSavePopup = ui.showLoadPopup = false;
+        scenario.setup();
+
+        DrawCounts counts = {};
+        double totalMs = 0.0, maxMs = 0.0;
+        for (int f = -WARMUP_FRAMES; f < frames; f++) {
+            DrawCounts frameCounts = {};
+            auto t0 = std::chrono::steady_clock::now();
+            ImGui::NewFrame();
+            runFrame(WIDTH, HEIGHT, io.DeltaTime);
+            ImGui::Render();
+            nullRenderDrawData(ImGui::GetDrawData(), frameCounts);
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+            if (f < 0) continue;
+            totalMs += ms;
+            maxMs = std::max(maxMs, ms);
+            counts.vertices += frameCounts.vertices;
+            counts.indices += frameCounts.indices;
+            counts.commands += frameCounts.commands;
+            counts.lists += frameCounts.lists;
+        }
+        printf("%-22s %9.3f %9.3f %9lld %8lld %8lld %7lld\n", scenario.name, totalMs / frames, maxMs,
+               counts.vertices / frames, counts.indices / frames, counts.commands / frames, counts.lists / frames);
+    }
+
+    saveCatalog.stop();
+    ImGui::DestroyContext();
+    return 0;
+}
@@ -0,0 +1,65 @@
+#ifndef ALLOCTRACKER_H
+#define ALLOCTRACKER_H
+
+#include <cstddef>
+
+// ==========================================
+// ALLOCATION TRACKER
+// ==========================================
+// Debug counters for heap allocations made by the main thread. The tracker
+// replaces global operator new/delete and, once install() has run, Dear
+// ImGui's allocator. While it is disabled the hooks only check a flag.
+// Frames and scopes are measured as differences of the running totals, so
+// the tracker itself never allocates.
+
+struct AllocCounts {
+    long long allocs;
+    long long frees;
+    long long bytes;                    // requested by allocations; frees aren't sized
+};
+
+namespace AllocTracker {
+    const int MAX_SCOPES = 16;
+    const int HISTORY = 240;
+
+    struct ScopeStats {
+        const char* name;               // string literal, matched by address
+        AllocCounts thisFrame;          // still collecting
+        bool ranThisFrame;
+        AllocCounts lastFrame;
+        AllocCounts total;
+        int frames;                     // frames the scope ran in
+        int framesWithAllocs;
+    };
+
+    void install();                     // before ImGui::CreateContext(): counts ImGui allocations too
+    void setEnabled(bool on);
+    bool isEnabled();
+
+    AllocCounts current();              // running totals for this thread
+    void beginFrame();                  // closes the previous frame's numbers
+    const AllocCounts& lastFrame();
+    const float* frameHistory(int* count, int* offset);   // allocations per frame, ring of HISTORY
+
+    void addScope(const char* name, const AllocCounts& delta);
+    int scopeCount();
+    const ScopeStats& scope(int i);
+    void reset();
+
+    void drawOverlay(bool* open);
+}
+
+// Counts what the enclosing block allocates under 'name' (a string literal)
+class AllocScope {
+public:
+    explicit AllocScope(const char* name);
+    ~AllocScope();
+    AllocScope(const AllocScope&) = delete;
+    AllocScope& operator=(const AllocScope&) = delete;
+
+private:
+    const char* name;
+    AllocCounts start;
+};
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef AUDIODSP_H
+#define AUDIODSP_H
+
+#include <vector>
+#include <cstddef>
+
+// ==========================================
+// DSP KERNELS
+// ==========================================
+// Block kernels used by the mixer. They use SSE2, AVX2 or NEON when the compiler
+// targets them and plain loops otherwise. Counts are in samples (frames * channels)
+// unless the name says stereo.
+
+// dst[i] += src[i] * gain
+void dspMixGain(float* dst, const float* src, int count, float gain);
+
+// Interleaved stereo: frame i is scaled by (gain + i * step) before accumulating.
+void dspMixRampStereo(float* dst, const float* src, int frames, float gain, float step);
+
+// Samples within +/-DSP_SOFT_CLIP_KNEE pass unchanged; above it they bend smoothly
+// toward +/-1 instead of hard clipping at the output stage.
+static const float DSP_SOFT_CLIP_KNEE = 0.8f;
+void dspSoftClip(float* buf, int count);
+
+// "avx2", "sse2", "neon" or "scalar".
+const char* dspSimdPath();
+
+// ==========================================
+// POLYPHASE RESAMPLER
+// ==========================================
+// Windowed-sinc resampler for any rate pair. The ratio is reduced to L/M and the
+// filter is split into L phases of TAPS coefficients, so each output sample is a
+// single TAPS-long dot product. Streams: history carries over between calls.
+// Ratios needing more than MAX_PHASES phases are rounded (pitch error < 0.5%).
+
+class PolyphaseResampler {
+public:
+    static const int TAPS = 32;
+    static const int MAX_PHASES = 1024;
+
+    PolyphaseResampler();
+    void setup(int inRate, int outRate, int channels);
+    void reset();
+
+    // Appends the output for 'frames' interleaved input frames to 'out'.
+    void process(const float* in, int frames, std::vector<float>& out);
+    // End of stream: emits the frames still held back by the filter's look-ahead.
+    void flush(std::vector<float>& out);
+
+    bool isPassthrough() const { return phases == 1 && step == 1; }
+
+private:
+    int phases;            // L
+    int step;              // M
+    int channels;
+    std::vector<float> coefs;                   // phases * TAPS
+    std::vector<std::vector<float>> history;    // per channel, deinterleaved
+    size_t base;           // history index of the first tap for the next output
+    int phase;
+    long long received;    // input frames seen
+    long long position;    // input frame the next output is centred on
+
+    void run(std::vector<float>& out, bool draining);
+};
+
+#endif
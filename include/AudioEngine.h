@@ -0,0 +1,180 @@
+#ifndef AUDIOENGINE_H
+#define AUDIOENGINE_H
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <cstdio>
+
+class MusicStream;
+
+// ==========================================
+// PCM DATA
+// ==========================================
+
+// A fully decoded sound, converted to the engine's output format
+// (interleaved stereo float at AudioEngine::SAMPLE_RATE).
+struct PcmBuffer {
+    std::vector<float> samples;
+    int frames = 0;
+};
+
+// Decodes a sound file from disk into engine format. Returns false for
+// formats we can't decode in-process.
+bool decodeAudioFile(const std::string& path, PcmBuffer& out);
+
+// ==========================================
+// OUTPUT SINKS
+// ==========================================
+
+class AudioSink {
+public:
+    virtual ~AudioSink() {}
+    virtual bool open(int sampleRate, int channels) = 0;
+    // Consumes 'frames' interleaved frames. Blocks until the device has room,
+    // which is what paces the mixer thread.
+    virtual void write(const float* samples, int frames) = 0;
+    virtual void close() {}
+};
+
+// Discards output but keeps real-time pacing, so the mixer behaves as it
+// would on a device. Used headless and when no device can be opened.
+class NullAudioSink : public AudioSink {
+public:
+    bool open(int sampleRate, int channels) override;
+    void write(const float* samples, int frames) override;
+private:
+    int rate = 44100;
+    double nextDeadline = 0.0;
+};
+
+// Writes 16-bit PCM to a .wav file (header patched on close).
+class WavFileAudioSink : public AudioSink {
+public:
+    explicit WavFileAudioSink(const std::string& path, bool realTime = false);
+    ~WavFileAudioSink();
+    bool open(int sampleRate, int channels) override;
+    void write(const float* samples, int frames) override;
+    void close() override;
+private:
+    std::string path;
+    FILE* file = nullptr;
+    int channels = 2;
+    unsigned int dataBytes = 0;
+    bool realTime;
+    NullAudioSink pacer;
+    std::vector<short> scratch;
+};
+
+// Picks a sink for this platform. ATW_AUDIO_OUT=null or ATW_AUDIO_OUT=wav:<file>
+// overrides the device sink (handy on Linux and for automated runs).
+AudioSink* createDefaultAudioSink();
+
+// ==========================================
+// MIXER
+// ==========================================
+
+enum AudioBus { BUS_MUSIC, BUS_SFX, BUS_COUNT };
+
+class AudioEngine {
+public:
+    static const int SAMPLE_RATE = 44100;
+    static const int CHANNELS = 2;
+    static const int BLOCK_FRAMES = 256;
+    static const int MAX_VOICES = 32;
+    static const int QUEUE_SIZE = 256;
+
+    AudioEngine();
+    ~AudioEngine();
+
+    // Takes ownership of the sink and starts the mixer thread.
+    bool start(AudioSink* sink);
+    void stop();
+    bool isRunning() const { return running; }
+
+    // Decodes once and caches by path. Returns a sound ID, or -1 if the file can't be decoded.
+    int loadSound(const std::string& path);
+    int findSound(const std::string& path) const;
+
+    // Triggers are allocation-free: they only push a command to the mixer's queue.
+    // Must be called from a single thread (the game thread).
+    bool play(int soundID, int bus, float gain = 1.0f, bool loop = false);
+    void stopBus(int bus);
+    void setBusGain(int bus, float gain);
+
+    // Streams a music track from disk, crossfading out whatever music is playing over
+    // 'fadeSeconds'. Returns false if the file can't be streamed.
+    bool playMusic(const std::string& path, float fadeSeconds, bool loop = true);
+    void stopMusic(float fadeSeconds);
+
+    // Mixer statistics (read from any thread)
+    std::atomic<unsigned int> blocksMixed;
+    std::atomic<unsigned int> activeVoices;
+    std::atomic<unsigned int> droppedCommands;
+
+private:
+    enum CommandType { CMD_PLAY, CMD_STOP_BUS, CMD_BUS_GAIN, CMD_MUSIC_PLAY, CMD_MUSIC_STOP };
+    struct Command {
+        CommandType type = CMD_PLAY;
+        const PcmBuffer* pcm = nullptr;
+        int bus = 0;
+        float gain = 1.0f;
+        bool loop = false;
+        MusicStream* stream = nullptr;
+        int fadeFrames = 0;
+    };
+    struct Voice {
+        const PcmBuffer* pcm = nullptr;
+        int position = 0;
+        int bus = 0;
+        float gain = 1.0f;
+        bool loop = false;
+    };
+
+    // Single-producer / single-consumer ring: game thread pushes, mixer thread pops.
+    Command queue[QUEUE_SIZE];
+    std::atomic<unsigned int> queueHead; // next slot to read (mixer)
+    std::atomic<unsigned int> queueTail; // next slot to write (game)
+    bool pushCommand(const Command& cmd);
+    void drainCommands();
+
+    // A music stream being faded in/out by the mixer. Gain ramps per sample toward 'target'.
+    struct MusicDeck {
+        MusicStream* stream = nullptr;
+        float gain = 0.0f;
+        float target = 0.0f;
+        float step = 0.0f;
+    };
+    static const int MAX_MUSIC_DECKS = 4;
+
+    // Mixer-thread state
+    Voice voices[MAX_VOICES];
+    MusicDeck decks[MAX_MUSIC_DECKS];
+    std::vector<float> streamBuffer;
+    void retireDeck(MusicDeck& deck);
+    float busGain[BUS_COUNT];
+    std::vector<float> mixBuffer;
+    void mixBlock(float* out, int frames);
+    void mixerThreadMain();
+
+    // Cache owned by the game thread; deque keeps element addresses stable so the
+    // mixer can hold raw pointers while new sounds are loaded.
+    std::deque<PcmBuffer> sounds;
+    std::map<std::string, int> soundIndex;
+
+    // Streams are created and destroyed on the game thread; the mixer flags them
+    // 'retired' once faded out and they're reclaimed on the next playMusic() or
+    // stopMusic(), never on the sound effect path: each one joins a decode thread.
+    std::vector<std::unique_ptr<MusicStream>> musicStreams;
+    void collectRetiredStreams();
+
+    std::unique_ptr<AudioSink> sink;
+    std::thread mixerThread;
+    std::atomic<bool> running;
+};
+
+#endif
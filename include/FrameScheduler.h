@@ -0,0 +1,46 @@
+#ifndef FRAMESCHEDULER_H
+#define FRAMESCHEDULER_H
+
+// ==========================================
+// IDLE RENDERING
+// ==========================================
+// Decides whether the main loop needs to draw another frame or can sleep in
+// glfwWaitEventsTimeout() until input arrives or the next animation step is
+// due. Every wake-up draws one frame. Each frame, the loop reports what is
+// still moving: dirty state, upcoming animation deadlines, or things that
+// need frames back to back (pending uploads, debug overlays).
+
+class FrameScheduler {
+public:
+    static const int SETTLE_FRAMES = 3;         // ImGui needs a couple of frames to settle hover, layout and popups after input...
+    static constexpr double SETTLE_TIME = 0.25; // ...and short fades (modal dimming, nav highlight) play out over this long
+    static constexpr double MAX_SLEEP = 0.5;    // wake up at least this often even with nothing scheduled
+
+    FrameScheduler();
+
+    void enable(bool on);
+    bool isEnabled() const { return enabled; }
+
+    // Blocks until the next frame is due, handling events that arrive meanwhile. Call right before the frame's event poll.
+    void waitForNextFrame();
+
+    // Reported while building a frame, they decide how long the next wait may be
+    void inputReceived(double time);            // settle frames after input
+    void markDirty();                           // something changed: draw a few more frames
+    void animateIn(double seconds);             // something changes on its own after 'seconds'
+    void keepAwake();                           // need the next frame right away
+
+    long long framesDrawn() const { return frames; }
+    double idleSeconds() const { return idle; }
+
+private:
+    bool enabled;
+    int settleFrames;                           // frames still owed to the last input or dirty mark
+    double settleUntil;
+    double deadline;                            // earliest animateIn() target for the current frame, 0 when none
+    bool awake;
+    long long frames;
+    double idle;                                // total time spent waiting
+};
+
+#endif
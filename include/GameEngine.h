@@ -5,8 +5,10 @@
 #define NOMINMAX
 #ifndef GAMEENGINE_H
 #define GAMEENGINE_H
+#ifdef _WIN32
 #include <windows.h> 
 #include <mmsystem.h> 
+#endif
 #include <string>
 #include <vector>
 #include <map>
@@ -14,6 +16,7 @@
 #include <algorithm>
 #include <deque>
 #include "Inventory.h" 
+#include "AudioEngine.h"
 
 enum GameState {
     STATE_MENU,      
@@ -107,12 +110,26 @@ public:
     bool gameOver = false;
     bool gameWon = false;
 
-    // Typewriter Data
-    std::string currentDisplayedText;
+    // Typewriter Data: targetText[0, textRevealed) is on screen, always ending on a UTF-8 character boundary
     std::string targetText;
-    int textCharIndex = 0;
+    size_t textRevealed = 0;
+    int textVersion = 0;                  // bumped by startTypewriter(), keys the UI's cached wrap layout
     float textTimer = 0.0f;
     bool textFinished = false;
+    static constexpr float TYPEWRITER_CHAR_TIME = 0.02f;
+
+    // Redraw tracking: engine calls that change what's on screen set this, the main loop clears it
+    bool uiDirty = true;
+    // Bumped when stats, node, inventory or state change; cached views compare against it
+    int stateVersion = 0;
+    void markStateChanged() { uiDirty = true; stateVersion++; }
+
+    // No GL context and no audio device (benchmarks): textures get placeholder IDs, sounds are skipped
+    bool headless = false;
+
+    // initGame() seeds rand() with this; 0 picks one from the clock. Input replays set the recorded seed.
+    unsigned int rngSeed = 0;
+    unsigned int stateChecksum() const;     // hash of the game state, to check a replay ended where its recording did
 
     std::vector<std::string> introLines;
     int introLineIndex = 0;
@@ -123,14 +140,19 @@ public:
     // Audio Data
     std::string currentMusicAlias = "";
     bool isMuted = false;
+    AudioEngine audio;
+    std::map<std::string, int> soundIDs;      // filename -> AudioEngine sound ID (-1 = not decodable)
+    std::map<std::string, bool> mciAliasOpen; // aliases currently held by the MCI fallback
 
     void initGame();
     void cleanup();
     
     void makeChoice(int choiceIndex);
     void checkForRandomEvents(int nextNodeID);
+    void startTypewriter(const std::string& text);
     void updateTypewriter(float deltaTime); 
     void skipTypewriter(); 
+    float typewriterTimeToNextChar() const;   // seconds until updateTypewriter() reveals more text, -1 when finished
     
     bool performGlobalRest();
     bool performGlobalScavenge();
@@ -145,11 +167,16 @@ public:
     unsigned int getNodeTexture(std::string path);
     unsigned int getGeneralTexture(std::string filename); 
     unsigned int loadTextureFromFile(const char* filename); 
+    unsigned int streamTextureFromPng(const std::string& path, int& width, int& height);
     std::pair<int, int> getTextureSize(std::string path);
+    bool isTextureReady(unsigned int textureID) const;   // false while a streamed texture is still uploading
 
     // Audio Functions
-    void playSound(std::string filename, std::string alias, bool loop = false);
-    void stopSound(std::string alias);
+    void initAudio();
+    void shutdownAudio();
+    std::string resolveSoundPath(const std::string& filename);
+    void playSound(const std::string& filename, const std::string& alias, bool loop = false);
+    void stopSound(const std::string& alias);
     void playBackgroundMusic(std::string trackName);
     void updateMusicSystem();
     void toggleMute();
@@ -157,6 +184,8 @@ public:
     std::string getFinalTitle();
 
 private:
+    void playSoundMci(const std::string& filename, const std::string& alias, bool loop);
+    void closeMciAlias(const std::string& alias);
     void addNode(int id, std::string text, std::string img, int h=0, int e=0, int hu=0, int r=0, int d=0, std::string req="None", std::string rew="None");
     void connect(int parentID, std::string choiceText, int childID);
 };
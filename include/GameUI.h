@@ -0,0 +1,91 @@
+#ifndef GAMEUI_H
+#define GAMEUI_H
+
+#include <string>
+#include "HudView.h"
+#include "TypewriterText.h"
+
+class GameEngine;
+class SaveCatalog;
+struct ImFont;
+
+// ==========================================
+// GAME SCREENS
+// ==========================================
+// Every screen of the game: one function per GameState, plus the save and
+// load popups. update() advances the game's timers by one SimClock step.
+// drawFrame() runs between ImGui::NewFrame() and ImGui::Render() and draws
+// whatever engine.currentState calls for. The screens only use
+// ImGui and the engine, so they also run without a window or renderer (see
+// bench/ui_state_bench.cpp). Anything the main loop has to act on is left in
+// 'requests'.
+
+struct UiFrameRequests {
+    bool dirty;                 // FrameScheduler::markDirty()
+    bool keepAwake;             // FrameScheduler::keepAwake()
+    double animateIn;           // FrameScheduler::animateIn(), -1 when nothing is due
+    bool choiceMade;            // InputLatencyOverlay::choiceMade()
+    bool quit;                  // QUIT on the main menu
+
+    void clear() { dirty = keepAwake = choiceMade = quit = false; animateIn = -1.0; }
+    void animate(double seconds) { if (animateIn < 0.0 || seconds < animateIn) animateIn = seconds; }
+};
+
+void setupImGuiStyle();
+
+class GameUI {
+public:
+    static constexpr float STATUS_TIME = 3.0f;      // status message lifetime
+    static constexpr float STATUS_FADE = 0.5f;      // ...the last part of it fading out
+    static constexpr float SLIDE_TIME = 1.5f;       // per slideshow image
+
+    GameUI(GameEngine& engine, SaveCatalog& saveCatalog);
+
+    void init(ImFont* titleFont, ImFont* bodyFont);     // after GameEngine::initGame(), loads the screens' textures
+    // One fixed simulation step: typewriter, slideshow, status message. True when something on screen changed.
+    bool update(float stepSeconds);
+    // 'stepAlpha' is SimClock::alpha(), how far the clock is between the last step and the next
+    void drawFrame(int displayW, int displayH, float stepAlpha);
+
+    // The screens drawFrame() picks from
+    void drawMenu();
+    void drawIntro();
+    void drawGameplay();
+    void drawRestScavenge();
+    void drawSavePopup();
+    void drawLoadPopup();
+
+    bool showInventory;
+    bool showMap;
+    bool showSavePopup;
+    bool showLoadPopup;
+    char saveFileNameBuffer[128];
+    std::string statusMessage;
+    float statusTimer;
+    UiFrameRequests requests;   // collected by the last drawFrame()
+
+private:
+    GameEngine& engine;
+    SaveCatalog& saveCatalog;
+    HudView hud;
+    TypewriterText typewriter;  // intro and story box, laid out once per text
+    ImFont* titleFont;
+    ImFont* bodyFont;
+    int displayW, displayH;
+    float stepSeconds;          // length of the last update() step
+    float stepAlpha;
+
+    // Textures (0 when the file is missing; the screens fall back to text)
+    unsigned int menuBg;
+    unsigned int iconMap, overlayMap, iconInventory, iconScavenge, iconRest, iconUndo, iconSave, iconMute;
+    unsigned int iconHealth, iconEnergy, iconHunger, iconRep;
+
+    // Gameplay background slideshow
+    std::string cachedImageName;
+    unsigned int cachedTextureID;
+    int slideIndex;
+    float slideTimer;
+    int lastNodeID;
+};
+
+#endif
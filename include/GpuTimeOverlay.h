@@ -0,0 +1,67 @@
+#ifndef GPUTIMEOVERLAY_H
+#define GPUTIMEOVERLAY_H
+
+#include <string>
+#include <vector>
+
+// ==========================================
+// GPU FRAME-TIME OVERLAY
+// ==========================================
+// Keeps a rolling history of the OpenGL3 backend's GPU timer results and draws
+// it as a debug window. The backend resolves a frame a few frames after it was
+// drawn, so collect() records each resolved frame once, whenever it shows up.
+
+class GpuTimeOverlay {
+public:
+    static const int HISTORY = 300;   // resolved frames kept
+    static const int BUCKETS = 24;    // histogram bins from 0 to the slowest frame in the history
+
+    GpuTimeOverlay();
+
+    // Turns the backend's timer queries on or off. False when the context has none.
+    bool enable(bool on);
+    bool isEnabled() const { return enabled; }
+    void clear();
+
+    void collect();                   // once per frame, after RenderDrawData()
+    void draw(bool* open);            // inside the ImGui frame
+
+    // Long format: one row per frame and scope ("render", "interval" or a draw list's window).
+    bool exportCsv(const std::string& path) const;
+    bool exportJson(const std::string& path) const;
+
+private:
+    struct ListSample {
+        std::string name;
+        float gpuMs;
+        int elemCount;
+    };
+    struct FrameSample {
+        int frame;
+        float renderMs;
+        float intervalMs;             // 0 when the previous frame was dropped
+        std::vector<ListSample> lists;
+    };
+    struct ListSummary {
+        std::string name;
+        float lastMs, avgMs, maxMs;
+        int frames;
+    };
+
+    bool enabled;
+    std::vector<FrameSample> samples; // ring of HISTORY
+    int head;                         // next slot to write
+    int count;
+    int lastFrame;                    // backend FrameIndex last recorded
+    int dropped;
+    std::string exportStatus;
+
+    // Scratch for draw(), kept to avoid reallocating every frame
+    std::vector<float> plotValues;
+    std::vector<float> sorted;
+    std::vector<ListSummary> summaries;
+
+    const FrameSample& at(int i) const { return samples[(head - count + i + HISTORY) % HISTORY]; }   // 0 = oldest
+};
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef HUDVIEW_H
+#define HUDVIEW_H
+
+#include <string>
+#include <vector>
+
+class GameEngine;
+
+// ==========================================
+// HUD VIEW CACHE
+// ==========================================
+// Text the gameplay HUD and backpack draw every frame, formatted once per
+// engine state change (GameEngine::stateVersion) so drawing it doesn't touch
+// the heap.
+
+struct HudView {
+    struct ItemRow {
+        std::string name;              // passed to GameEngine::useItem()
+        char label[64];                // "Meat x2"
+        bool usable;
+    };
+
+    int version;
+    char health[8];
+    char energy[8];
+    char hunger[8];
+    char reputation[8];
+    char rank[32];
+    std::vector<ItemRow> items;        // only grows, 'itemCount' rows are current
+    int itemCount;
+
+    HudView() : version(-1), itemCount(0) { health[0] = energy[0] = hunger[0] = reputation[0] = rank[0] = 0; }
+
+    void refresh(GameEngine& engine);  // no-op while the engine's state version matches
+};
+
+#endif
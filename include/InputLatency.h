@@ -0,0 +1,87 @@
+#ifndef INPUTLATENCY_H
+#define INPUTLATENCY_H
+
+#include <string>
+#include <vector>
+
+// ==========================================
+// CLICK-TO-PRESENT LATENCY
+// ==========================================
+// Measures how long a left click takes to show up on screen: from the time the
+// GLFW backend stamped the button release (the edge ImGui buttons fire on) to
+// glfwSwapBuffers() returning for the frame that reacted to it. Clicks that
+// picked a story choice are tracked separately.
+
+class InputLatencyOverlay {
+public:
+    static const int HISTORY = 500;      // clicks kept
+    static const int BUCKETS = 25;
+    static constexpr float BUCKET_MS = 4.0f;   // histogram covers 0-100 ms, slower clicks land in the last bin
+
+    InputLatencyOverlay();
+
+    void clear();
+
+    // Once per frame, right after ImGui::NewFrame(): picks up a click handed to this frame, if any.
+    void frameStarted(double frameStartTime);
+    void choiceMade();                   // the pending click picked a story choice
+    void presented(double presentTime);  // after glfwSwapBuffers()
+
+    void draw(bool* open, bool lateLatch);
+    bool exportCsv(const std::string& path) const;
+
+    int sampleCount() const { return count; }
+    void summary(bool choicesOnly, float* avgMs, float* p95Ms) const;
+
+private:
+    struct Sample {
+        float totalMs;                   // release -> present
+        float queueMs;                   // release -> NewFrame() that consumed it
+        bool choice;
+    };
+
+    std::vector<Sample> samples;         // ring of HISTORY
+    int head;
+    int count;
+    double pendingInput;                 // arrival time of the click being measured, 0 when none
+    double pendingFrameStart;
+    bool pendingChoice;
+    std::string exportStatus;
+
+    mutable std::vector<float> sorted;   // scratch for percentiles
+
+    const Sample& at(int i) const { return samples[(head - count + i + HISTORY) % HISTORY]; }   // 0 = oldest
+    void stats(bool choicesOnly, float* avg, float* p50, float* p95, float* worst, int* n) const;
+};
+
+// ==========================================
+// LATE LATCH
+// ==========================================
+// With vsync on, input that arrives while glfwSwapBuffers() blocks waits for
+// the next frame, which is then built as early as possible and sits finished
+// until the following vblank. Late latching syncs with the swap, then waits
+// (still delivering events) until just enough time is left to build and draw
+// the next frame before its vblank, and only then polls and builds.
+
+class LateLatch {
+public:
+    static constexpr double MARGIN = 0.002;   // seconds kept in hand for GPU work and wake-up jitter
+
+    LateLatch();
+
+    void enable(bool on, int refreshHz);
+    bool isEnabled() const { return enabled; }
+
+    void pollEvents();                   // replaces glfwPollEvents() at the top of the frame
+    void frameSubmitted();               // right before glfwSwapBuffers()
+    void presented();                    // right after glfwSwapBuffers()
+
+private:
+    bool enabled;
+    double period;
+    double lastPresent;                  // glFinish() after the last swap returned, 0 before the first
+    double pollTime;
+    double workEstimate;                 // poll -> swap, rises at once and decays slowly
+};
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef INPUTRECORDING_H
+#define INPUTRECORDING_H
+
+#include <cstdio>
+#include <vector>
+
+// ==========================================
+// INPUT RECORDING / REPLAY
+// ==========================================
+// A recording holds what reaches Dear ImGui each frame:
+// - the input events the platform backend queued (mouse, keys, text, focus)
+// - the display and framebuffer size
+// - io.DeltaTime
+// It also stores the seed the engine's RNG ran with and the simulation rate
+// (ATW_SIM_HZ), which decides how many steps each frame's delta time makes.
+// Played back through the ImGui IO API with the same seed and rate, a session
+// takes the same path through the game. It replays in the game window (ATW_REPLAY) or headless and as fast as
+// possible (ui_state_bench --replay).
+//
+// Both sides hook in after the backends' NewFrame() and before
+// ImGui::NewFrame(). Only the game itself is deterministic: the save list in
+// the Load popup comes from disk, so sessions that load a save need the same
+// save folder.
+//
+// File layout, little-endian:
+//   "ATWR" u8 version u32 seed f64 simRate              (version 1 has no simRate)
+//   per frame: [SIZE u16 displayW u16 displayH u16 framebufferW u16 framebufferH] FRAME f32 deltaTime varint eventCount events...
+//   END u32 frames u32 engineChecksum
+
+class InputRecorder {
+public:
+    InputRecorder();
+    ~InputRecorder();
+
+    // 'simRate' is the rate passed to SimClock::setRate() for this session
+    bool start(const char* path, unsigned int seed, double simRate);
+    bool isRecording() const { return file != nullptr; }
+    // Takes this frame's new events from ImGui's queue, plus the IO's delta time and display size
+    void recordFrame(int framebufferW, int framebufferH);
+    void stop(unsigned int engineChecksum);
+    int frameCount() const { return frames; }
+
+private:
+    FILE* file;
+    std::vector<unsigned char> buffer;      // one frame, reused
+    unsigned int lastEventId;               // events up to here are already in the log
+    int lastSize[4];
+    int frames;
+};
+
+class InputReplayer {
+public:
+    InputReplayer();
+
+    bool open(const char* path);
+    bool isOpen() const { return !data.empty(); }
+    unsigned int seed() const { return rngSeed; }
+    // The simulation rate to replay at, or 0 for a version 1 recording, which doesn't say (most ran at the default rate)
+    double simRate() const { return recordedSimRate; }
+
+    // Replaces the input the backend queued this frame with the next recorded frame and sets the IO's delta time and
+    // display size. False once the recording is used up.
+    bool applyFrame(int* framebufferW, int* framebufferH);
+    int framesPlayed() const { return frames; }
+
+    // Read from the log's trailer, available once the last frame has been applied
+    bool hasTrailer() const { return trailerFound; }
+    int recordedFrames() const { return trailerFrames; }
+    unsigned int recordedChecksum() const { return trailerChecksum; }
+
+private:
+    std::vector<unsigned char> data;
+    size_t pos;
+    unsigned int rngSeed;
+    double recordedSimRate;
+    unsigned int liveFrom;                  // events queued at or after this ID came from the live backend
+    int size[4];
+    int frames;
+    bool trailerFound;
+    int trailerFrames;
+    unsigned int trailerChecksum;
+};
+
+#endif
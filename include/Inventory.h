@@ -52,6 +52,8 @@ public:
 
     // Helper: Converts List to Vector so GUI can read it
     std::vector<Item> toVector() const;
+    // Walk the list in place: for (const InventoryNode* n = inventory.first(); n; n = n->next)
+    const InventoryNode* first() const { return head; }
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,168 @@
+#ifndef MP3DECODER_H
+#define MP3DECODER_H
+
+#include <string>
+#include <vector>
+#include <cstdio>
+
+// ==========================================
+// MP3 FRAME DECODER
+// ==========================================
+// In-tree MPEG-1/2/2.5 Layer III decoder. The IMDCT and the polyphase synthesis
+// filterbank use SSE2, AVX2 or NEON when the compiler targets them and fall back
+// to scalar code otherwise (see mp3SimdPath()).
+//
+// decodeFrame() works one frame at a time and keeps the bit reservoir between
+// calls, so callers can feed it straight from a file buffer.
+
+struct Mp3FrameInfo {
+    int sampleRate = 0;
+    int channels = 0;
+    int bitrateKbps = 0;
+    int frameBytes = 0;
+};
+
+// Xing/Info + LAME header found in the first frame of most encoder output.
+// 'delay'/'padding' are the encoder's priming and tail samples (gapless playback).
+struct Mp3InfoTag {
+    bool present = false;
+    long frames = -1;
+    int delay = 0;
+    int padding = 0;
+};
+
+struct Mp3HuffLookup;
+
+class Mp3Decoder {
+public:
+    static const int MAX_FRAME_SAMPLES = 1152;   // per channel (MPEG-2/2.5 frames hold 576)
+    static const int DECODER_DELAY = 529;        // filterbank delay, in samples
+
+    Mp3Decoder();
+    void reset();
+
+    // Decodes the first frame found in [data, data + size) into interleaved samples.
+    // Returns frames written per channel; 0 for frames with no audio (the Info tag).
+    // 'consumed' is how many bytes were used, including any skipped junk. When it is
+    // 0 the buffer doesn't hold a whole frame yet and more input is needed.
+    int decodeFrame(const unsigned char* data, int size, float* pcm, int& consumed, Mp3FrameInfo& info);
+    int decodeFrame(const unsigned char* data, int size, short* pcm, int& consumed, Mp3FrameInfo& info);
+
+    Mp3InfoTag infoTag;
+
+private:
+    struct Header {
+        int version;        // 1 = MPEG-1, 2 = MPEG-2, 25 = MPEG-2.5
+        int bitrateKbps;
+        int sampleRate;
+        int rateIndex;      // row in SFB_LONG/SFB_SHORT
+        int channels;
+        int mode;           // 0 stereo, 1 joint, 2 dual, 3 mono
+        int modeExt;
+        bool crc;
+        int frameBytes;
+    };
+    struct Granule {
+        int part23Length;
+        int bigValues;
+        int globalGain;
+        int scalefacCompress;
+        int blockType;      // 0 normal, 1 start, 2 short, 3 stop
+        bool mixed;
+        int tableSelect[3];
+        int subblockGain[3];
+        int region1Start, region2Start;
+        int preflag;
+        int scalefacScale;
+        int count1Table;
+    };
+    struct Channel {
+        int scfsi[4];
+        unsigned char sfLong[22];
+        unsigned char sfShort[13][3];
+        unsigned char isMaxLong[22];    // MPEG-2 intensity stereo: illegal position per band
+        unsigned char isMaxShort[13][3];
+        int nonzero;                    // lines past this are zero
+        float xr[576];
+        float overlap[32][18];
+        float synth[16][64];            // V vector history, one 64-sample slot per step
+        int synthPos;
+    };
+
+    bool parseHeader(const unsigned char* p, Header& h) const;
+    int findFrame(const unsigned char* data, int size, Header& h) const;
+    int sideInfoBytes() const;
+    bool readSideInfo(const unsigned char* p);
+    bool readInfoTag(const unsigned char* frame, int size);
+
+    // Main data bit reader
+    std::vector<unsigned char> mainData;
+    std::vector<unsigned char> reservoir;
+    int bitPos;
+    unsigned int peekBits(int n) const;
+    unsigned int readBits(int n);
+    int decodeHuffman(const Mp3HuffLookup& table);
+
+    void readScalefactors(int gr, int ch);
+    void readScalefactorsLsf(int ch);
+    void readSpectrum(int ch, int endBit, int* values);
+    void requantize(int ch, const int* values);
+    void stereo();
+    void reorderShort(int ch);
+    void antialias(int ch);
+    void hybridSynthesis(int ch, float* sbSamples);
+    void polyphaseSynthesis(int ch, const float* sbSamples, float* pcm, int stride);
+
+    Header header;
+    Header lastHeader;
+    bool haveLastHeader;
+    bool firstFrame;
+    int mainDataBegin;
+    int granules;
+    Granule gran[2][2];
+    Channel chan[2];
+    int curGr;
+    std::vector<float> floatScratch;
+};
+
+// Pulls frames from an MP3 file: skips ID3v2 tags, drops the Info frame and trims
+// encoder delay/padding from the LAME tag so loops are gapless.
+class Mp3FileDecoder {
+public:
+    Mp3FileDecoder();
+    ~Mp3FileDecoder();
+
+    bool open(const std::string& path);
+    void close();
+    int sampleRate() const { return rate; }
+    int channels() const { return numChannels; }
+    // Reads up to 'frames' interleaved frames; returns 0 at end of file.
+    int read(float* out, int frames);
+    bool rewind();
+
+private:
+    FILE* file;
+    long dataStart;
+    Mp3Decoder decoder;
+    std::vector<unsigned char> input;
+    int inputPos, inputLen;
+    bool eof;
+    float pcm[Mp3Decoder::MAX_FRAME_SAMPLES * 2];
+    int pcmPos, pcmLen;
+    int rate, numChannels;
+    long long position;      // decoded samples per channel, before trimming
+    long long skipUntil;     // trim everything before this position
+    long long endAt;         // and from here on (-1 when unknown)
+
+    bool fillInput();
+    bool decodeNext();
+};
+
+// Whole-file helpers. Output is interleaved at the file's native rate/channel count.
+bool mp3DecodeFile(const std::string& path, std::vector<float>& samples, int& sampleRate, int& channels);
+bool mp3DecodeFile(const std::string& path, std::vector<short>& samples, int& sampleRate, int& channels);
+
+// Which kernel set this build uses: "avx2", "sse2", "neon" or "scalar".
+const char* mp3SimdPath();
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef MUSICSTREAM_H
+#define MUSICSTREAM_H
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include "AudioDsp.h"
+
+// ==========================================
+// INCREMENTAL DECODERS
+// ==========================================
+
+// Pull-style decoder used for streaming. Produces interleaved float frames in the
+// file's native rate/channel layout; MusicStream converts to engine format.
+class AudioStreamDecoder {
+public:
+    virtual ~AudioStreamDecoder() {}
+    virtual int sampleRate() const = 0;
+    virtual int channels() const = 0;
+    // Decodes up to 'frames' frames. Returns 0 at end of stream.
+    virtual int read(float* out, int frames) = 0;
+    // Seeks back to the first audible frame (used for gapless looping).
+    virtual bool rewind() = 0;
+};
+
+// Opens a streaming decoder for 'path', or nullptr if the format isn't supported.
+AudioStreamDecoder* openAudioStream(const std::string& path);
+
+// ==========================================
+// MUSIC STREAM
+// ==========================================
+// One playing track. A background thread decodes ahead into a fixed-size ring of
+// engine-format frames; the mixer thread drains it. Memory per stream is bounded
+// by RING_FRAMES regardless of track length. When 'loop' is set, the decoder is
+// rewound the moment it hits the end so the ring never sees a gap.
+
+class MusicStream {
+public:
+    static const int RING_FRAMES = 32768;   // ~0.75 s at 44.1 kHz
+    static const int DECODE_CHUNK = 2048;
+
+    MusicStream(AudioStreamDecoder* decoder, bool loop);
+    ~MusicStream();
+
+    // Mixer thread: copies up to 'frames' frames into 'out'; returns frames copied.
+    // A short count means the decoder fell behind (or the track ended).
+    int readFrames(float* out, int frames);
+
+    bool isFinished() const { return finished && available() == 0; }
+
+    // Set by the mixer once the stream has faded out and won't be touched again.
+    std::atomic<bool> retired;
+
+private:
+    std::unique_ptr<AudioStreamDecoder> decoder;
+    bool loop;
+
+    // SPSC ring: decoder thread writes, mixer thread reads.
+    std::vector<float> ring;
+    std::atomic<unsigned int> readPos;
+    std::atomic<unsigned int> writePos;
+    unsigned int available() const { return writePos.load(std::memory_order_acquire) - readPos.load(std::memory_order_relaxed); }
+
+    // Decoder-thread conversion state (native -> stereo @ engine rate)
+    std::vector<float> nativeBuf, stereoBuf, convertedBuf;
+    PolyphaseResampler resampler;
+    int convertChunk(int maxFrames);
+
+    std::thread decodeThread;
+    std::atomic<bool> quit;
+    std::atomic<bool> finished;
+    void decodeThreadMain();
+};
+
+#endif
@@ -0,0 +1,106 @@
+#ifndef PNGSTREAM_H
+#define PNGSTREAM_H
+
+#include <string>
+#include <vector>
+#include <functional>
+// stb_image's implementation section has no include guard, so only pull in the
+// declarations when the including file hasn't already done so.
+#ifndef STBI_INCLUDE_STB_IMAGE_H
+#include "stb_image.h"
+#endif
+
+// ==========================================
+// STREAMING PNG DECODER
+// ==========================================
+// Decodes a PNG pulled through stbi_io_callbacks without ever holding the
+// whole file or the whole inflated image in memory. Disk reads, inflate and
+// row unfiltering are interleaved: every time the inflater needs input it pulls
+// the next IDAT bytes, and every completed scanline is unfiltered and handed to
+// the row sink straight away.
+//
+// Memory held per decode: one read buffer, the 32 KB inflate window and two
+// scanlines (previous + current) plus one converted output row.
+//
+// Supported: 8-bit greyscale, grey+alpha, RGB, RGBA and palette images,
+// non-interlaced, with tRNS transparency expanded to RGBA. Anything else fails in decode() before the header sink is
+// called, so callers can fall back to stbi_load().
+
+class PngStreamDecoder {
+public:
+    // Called once after IHDR/PLTE are parsed. Output is always 3 (RGB) or 4 (RGBA)
+    // channels. Return false to abort the decode.
+    typedef std::function<bool(int width, int height, int channels)> HeaderSink;
+    // Called once per scanline, top to bottom. 'row' holds width * channels bytes
+    // and is only valid for the duration of the call.
+    typedef std::function<void(int y, const unsigned char* row)> RowSink;
+
+    PngStreamDecoder();
+
+    bool decode(const stbi_io_callbacks& io, void* user, HeaderSink onHeader, RowSink onRow);
+
+    // Set when decode() returns false. 'headerSent' tells whether the sinks already saw data.
+    std::string errorMessage;
+    bool headerSent;
+
+private:
+    // --- Input (chunk stream) ---
+    const stbi_io_callbacks* io;
+    void* ioUser;
+    std::vector<unsigned char> readBuf;
+    int readPos, readLen;
+    unsigned int idatRemaining;
+    bool idatDone;
+
+    bool fillReadBuffer();
+    bool readBytes(unsigned char* dst, int n);
+    bool skipBytes(unsigned int n);
+    bool readU32(unsigned int& out);
+    bool nextIdatChunk();
+    int nextIdatByte();
+
+    // --- Inflate ---
+    struct Huffman {
+        unsigned short fast[1 << 9];
+        unsigned short firstCode[16];
+        int maxCode[17];
+        unsigned short firstSymbol[17];
+        unsigned char size[288];
+        unsigned short value[288];
+    };
+    unsigned int bitBuffer;
+    int bitCount;
+    std::vector<unsigned char> window;
+    unsigned int outPos, flushedPos;
+    Huffman litLen, dist;
+
+    bool fillBits(int n);
+    int readBits(int n);
+    bool buildHuffman(Huffman& h, const unsigned char* sizes, int count);
+    int decodeSymbol(const Huffman& h);
+    bool inflateStored();
+    bool inflateCodes();
+    bool readDynamicTables();
+    bool inflateAll();
+    void putByte(unsigned char b);
+    void flushWindow();
+
+    // --- Scanlines ---
+    int width, height, colorType, srcChannels, outChannels;
+    size_t stride;
+    std::vector<unsigned char> prevRow, curRow, outRow;
+    size_t curFill;
+    int rowY;
+    unsigned char palette[256 * 4];
+    int paletteSize;
+    unsigned char colorKey[3];  // tRNS sample for greyscale/RGB images
+    bool hasTransparency;
+    RowSink rowSink;
+
+    void feedRows(const unsigned char* data, size_t len);
+    void finishRow();
+
+    bool fail(const char* msg);
+};
+
+#endif
@@ -0,0 +1,126 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+// ==========================================
+// CPU PROFILER
+// ==========================================
+// Scoped timing zones, compiled in only when ATW_PROFILE is defined (see the
+// "Build game (profiler)" task). Without it every macro below expands to
+// nothing and this header pulls in no code.
+//
+//   ATW_PROFILE_ZONE("makeChoice");         // times the rest of the enclosing block
+//   ATW_PROFILE_THREAD("Audio mixer");      // names the calling thread's lane
+//   ATW_PROFILE_FRAME();                     // once per frame on the main thread
+//
+// A zone reads the CPU timestamp counter when it opens and again when it
+// closes, then appends one event to its thread's ring. Each thread owns its
+// ring, so writers never lock. Readers copy a ring and drop any entries the
+// writer may have overwritten meanwhile. The overlay and the Chrome trace
+// export both work from these copies. A thread that exits hands its ring to
+// the next thread registered, so short-lived threads (one per music track)
+// don't pile up rings and lanes.
+
+#ifdef ATW_PROFILE
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace Profiler {
+    const int RING_EVENTS = 1 << 16;        // per thread, 2 MB
+    const int FRAME_HISTORY = 256;
+
+    struct Event {
+        const char* name;                    // string literal
+        uint64_t start;                      // ticks()
+        uint64_t end;
+        int depth;                           // nesting level within the thread
+    };
+
+    struct ThreadRing {
+        Event events[RING_EVENTS];
+        std::atomic<uint64_t> written;       // events ever written; slot = index % RING_EVENTS
+        std::atomic<uint64_t> firstEvent;    // index of the current owner's first event; older ones belong to an exited thread
+        int depth;
+        int id;
+        char name[32];
+    };
+
+    // Timestamp counter where there is one (a few ns to read), steady_clock elsewhere
+    inline uint64_t ticks() {
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return (uint64_t)std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+    }
+    double ticksToMs(uint64_t t);            // calibrated against steady_clock over the profiler's lifetime
+
+    ThreadRing* registerThread();
+    extern thread_local ThreadRing* currentRing;
+    inline ThreadRing& threadRing() {        // the calling thread's ring, created on first use
+        ThreadRing* ring = currentRing;
+        return ring ? *ring : *registerThread();
+    }
+    void setThreadName(const char* name);
+
+    void frameMark();
+    // Frame 'back' frames ago (0 = last finished frame). False when the history doesn't go back that far.
+    bool frameRange(int back, uint64_t* start, uint64_t* end);
+
+    // Copies every thread's events that fall in [start, end), oldest first per thread
+    struct ThreadEvents {
+        int id;
+        std::string name;
+        std::vector<Event> events;
+    };
+    void collect(uint64_t start, uint64_t end, std::vector<ThreadEvents>& out);
+
+    bool exportChromeTrace(const char* path); // everything still in the rings, as trace_event JSON
+    void drawOverlay(bool* open);
+
+    inline void emit(ThreadRing& ring, const char* name, uint64_t start, uint64_t end) {
+        uint64_t index = ring.written.load(std::memory_order_relaxed);
+        Event& e = ring.events[index % RING_EVENTS];
+        e.name = name;
+        e.start = start;
+        e.end = end;
+        e.depth = ring.depth;
+        ring.written.store(index + 1, std::memory_order_release);
+    }
+
+    class Zone {
+    public:
+        explicit Zone(const char* name) : ring(threadRing()), name(name) { ring.depth++; start = ticks(); }
+        ~Zone() { uint64_t end = ticks(); ring.depth--; emit(ring, name, start, end); }
+        Zone(const Zone&) = delete;
+        Zone& operator=(const Zone&) = delete;
+    private:
+        ThreadRing& ring;
+        const char* name;
+        uint64_t start;
+    };
+}
+
+#define ATW_PROFILE_CONCAT2(a, b) a##b
+#define ATW_PROFILE_CONCAT(a, b) ATW_PROFILE_CONCAT2(a, b)
+#define ATW_PROFILE_ZONE(name) Profiler::Zone ATW_PROFILE_CONCAT(atwProfileZone, __LINE__)(name)
+#define ATW_PROFILE_THREAD(name) Profiler::setThreadName(name)
+#define ATW_PROFILE_FRAME() Profiler::frameMark()
+
+#else
+
+#define ATW_PROFILE_ZONE(name) ((void)0)
+#define ATW_PROFILE_THREAD(name) ((void)0)
+#define ATW_PROFILE_FRAME() ((void)0)
+
+#endif
+
+#endif
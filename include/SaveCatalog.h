@@ -0,0 +1,102 @@
+#ifndef SAVECATALOG_H
+#define SAVECATALOG_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+// ==========================================
+// SAVE HEADER
+// ==========================================
+// First line of every save written by GameEngine::saveGameToFile():
+//   #ATW 1 day=12 node=34 health=80 energy=55 hunger=20 reputation=40 time=1718000000
+// Loaders skip lines starting with '#'. Older saves have no header; their
+// node and stats are read from the body instead and 'savedAt' stays 0.
+
+struct SaveHeader {
+    int day = 0;
+    int node = 0;
+    int health = 0;
+    int energy = 0;
+    int hunger = 0;
+    int reputation = 0;
+    long long savedAt = 0;      // seconds since the epoch
+};
+
+// Reads the header (or the legacy body) of the save at 'path'. False if the file can't be read or parsed.
+bool readSaveHeader(const std::string& path, SaveHeader& out);
+
+// ==========================================
+// SAVE CATALOG
+// ==========================================
+// Keeps the list of save files in a directory so the Load popup never
+// touches the disk. A worker thread scans the directory once, then rescans
+// when Windows reports a change (FindFirstChangeNotification), or elsewhere
+// every POLL_INTERVAL while update() is being called, i.e. while the Load
+// popup is open. Headers are read on the worker when the UI asks for them,
+// which it does for visible rows only, so thousands of saves cost one
+// directory listing. Between jobs the worker sleeps without a timeout.
+
+struct SaveInfo {
+    std::string path;           // as passed to GameEngine::loadGameFromFile()
+    std::string name;           // file name shown in the list
+    long long modified = 0;     // the list is sorted newest first
+    long long size = 0;
+    bool headerRequested = false;
+    bool headerRead = false;    // 'header' is valid
+    bool headerOk = false;      // false when the file couldn't be parsed
+    SaveHeader header;
+};
+
+class SaveCatalog {
+public:
+    static const int POLL_INTERVAL_MS = 1000;
+
+    SaveCatalog();
+    ~SaveCatalog();
+
+    void start(const std::string& directory);
+    void stop();
+
+    // UI thread, once per frame while the list is shown: takes the worker's latest listing and finished
+    // headers, and asks for a rescan when polling is due. True when the list changed.
+    bool update();
+    const std::vector<SaveInfo>& saves() const { return list; }
+    bool isScanned() const { return scanned; }
+    bool isWatching() const { return watching.load(); }   // false: polling
+
+    // UI thread: row 'index' is on screen, read its header soon
+    void requestHeader(int index);
+
+private:
+    // UI thread
+    std::vector<SaveInfo> list;
+    std::unordered_map<std::string, int> indexByPath;
+    bool scanned;
+    std::chrono::steady_clock::time_point lastPoll;
+
+    // Shared with the worker
+    std::mutex mutex;
+    std::condition_variable wake;            // elsewhere than Windows
+    void* wakeEvent;                         // Windows: auto-reset event, waited on with the change handle
+    std::vector<SaveInfo> published;         // newest listing, taken by update()
+    bool hasPublished;
+    std::vector<std::string> requests;       // header reads wanted, newest last
+    std::vector<SaveInfo> results;           // finished header reads
+    bool rescanRequested;
+    bool quit;
+
+    std::string directory;
+    std::thread worker;
+    std::atomic<bool> watching;
+    void workerMain();
+    void wakeWorker();
+    std::vector<SaveInfo> scan();
+};
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef SIMCLOCK_H
+#define SIMCLOCK_H
+
+// ==========================================
+// SIMULATION CLOCK
+// ==========================================
+// Fixed-timestep clock for the game's timers: the typewriter, the slideshow
+// and the status message. Each rendered frame adds its real duration to an
+// accumulator, and the game is stepped in whole steps of stepSeconds(). So
+// game timing doesn't depend on the frame rate: it is the same at 30 Hz,
+// 240 Hz, or after the idle scheduler slept for half a second. The
+// simulation rate is independent of the presentation rate (ATW_SIM_HZ).
+//
+// Between steps, alpha() says how far the clock has got towards the next
+// step. Anything drawn from a timer can use it to interpolate.
+
+class SimClock {
+public:
+    static constexpr double DEFAULT_RATE = 100.0;   // the typewriter's 0.02 s per character is two steps
+    static constexpr double MAX_FRAME_TIME = 1.0;   // longer frames (a stall, a dragged window) drop the excess
+
+    explicit SimClock(double rate = DEFAULT_RATE);
+
+    void setRate(double hz);
+    double rate() const { return 1.0 / step; }
+    double stepSeconds() const { return step; }
+
+    // Adds one frame's real time, returns how many steps to run now
+    int advance(double frameSeconds);
+    double alpha() const { return accumulator / step; }
+
+    // Real time until the step in which 'simSeconds' of simulated time will have passed
+    double timeUntil(double simSeconds) const;
+
+    long long stepCount() const { return steps; }
+    double simTime() const { return steps * step; }
+
+private:
+    double step;
+    double accumulator;         // real time not yet simulated, always < step after advance()
+    long long steps;
+};
+
+#endif
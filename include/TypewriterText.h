@@ -0,0 +1,40 @@
+#ifndef TYPEWRITERTEXT_H
+#define TYPEWRITERTEXT_H
+
+#include <string>
+#include <vector>
+
+struct ImFont;
+
+// ==========================================
+// TYPEWRITER TEXT
+// ==========================================
+// Draws the revealed part of the typewriter text with a word-wrap layout built
+// once for the whole text. The layout is rebuilt only when the text
+// (GameEngine::textVersion), font, size or wrap width changes. So a word
+// never starts on one line and jumps to the next as it types out. Each frame
+// only touches the revealed glyphs, and it doesn't allocate. The space for
+// the unrevealed lines is reserved, so whatever follows stays put too.
+
+class TypewriterText {
+public:
+    TypewriterText();
+
+    // Like TextWrapped() over text[0, revealedBytes), at the cursor, with the current font
+    void draw(const std::string& text, int textVersion, size_t revealedBytes);
+
+private:
+    struct Line {
+        size_t begin, end;      // byte offsets; end excludes the blanks the wrap trimmed
+    };
+
+    void build(const std::string& text, ImFont* font, float size, float width);
+
+    std::vector<Line> lines;    // reused between texts
+    int version;
+    ImFont* font;
+    float fontSize;
+    float wrapWidth;
+};
+
+#endif
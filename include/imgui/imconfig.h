@@ -120,6 +120,17 @@
 // Read about ImGuiBackendFlags_RendererHasVtxOffset for details.
 //#define ImDrawIdx unsigned int
 
+//---- Use a 12-byte ImDrawVert (fixed-point position, 16-bit UV, packed color) instead of the default 20-byte one, to cut vertex upload bandwidth.
+// Positions must stay within -4096..+4095 pixels of the display origin. Your renderer backend needs to support it (the OpenGL3 backend does). See ImDrawVertCompactPos in imgui.h.
+//#define IMGUI_USE_COMPACT_DRAWVERT
+
+//---- Scoped CPU profiling zones inside the backends, e.g. #define IMGUI_IMPL_PROFILE_ZONE(_NAME) MyProfiler::Zone zone(_NAME)
+// Builds with ATW_PROFILE route them to the game's profiler (include/Profiler.h).
+#ifdef ATW_PROFILE
+#include "Profiler.h"
+#define IMGUI_IMPL_PROFILE_ZONE(_NAME) ATW_PROFILE_ZONE(_NAME)
+#endif
+
 //---- Override ImDrawCallback signature (will need to modify renderer backends accordingly)
 //struct ImDrawList;
 //struct ImDrawCmd;
@@ -3162,6 +3162,29 @@ struct ImDrawCmd
     inline ImTextureID GetTexID() const;    // == (TexRef._TexData ? TexRef._TexData->TexID : TexRef._TexID)
 };
 
+// Compact vertex layout (12 bytes instead of 20), enabled with IMGUI_USE_COMPACT_DRAWVERT in imconfig.h
+// - pos: 16-bit fixed point with IM_DRAWVERT_POS_SUBPIXELS steps per pixel, so -4096..+4095 pixels around the display origin. Values outside are clamped.
+// - uv: 16-bit normalized, 0..1. Values outside are clamped, so texture repeat through UV > 1 doesn't work.
+// Both convert from/to ImVec2 on assignment so ImDrawList code writes them like the default layout. Backends must know about it (the OpenGL3 one does).
+#if defined(IMGUI_USE_COMPACT_DRAWVERT) && !defined(IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
+#define IM_DRAWVERT_POS_SUBPIXELS   8
+struct ImDrawVertCompactPos
+{
+    ImS16   X, Y;   // Position * IM_DRAWVERT_POS_SUBPIXELS
+    ImDrawVertCompactPos& operator=(const ImVec2& v) { X = Pack(v.x); Y = Pack(v.y); return *this; }
+    operator ImVec2() const { return ImVec2(X * (1.0f / IM_DRAWVERT_POS_SUBPIXELS), Y * (1.0f / IM_DRAWVERT_POS_SUBPIXELS)); }
+    static ImS16 Pack(float f) { f = f * IM_DRAWVERT_POS_SUBPIXELS + (f >= 0.0f ? 0.5f : -0.5f); return (ImS16)(f < -32768.0f ? -32768.0f : f > 32767.0f ? 32767.0f : f); }
+};
+struct ImDrawVertCompactUV
+{
+    ImU16   U, V;   // UV * 65535
+    ImDrawVertCompactUV& operator=(const ImVec2& v) { U = Pack(v.x); V = Pack(v.y); return *this; }
+    operator ImVec2() const { return ImVec2(U * (1.0f / 65535.0f), V * (1.0f / 65535.0f)); }
+    static ImU16 Pack(float f) { return (ImU16)(f <= 0.0f ? 0 : f >= 1.0f ? 65535 : (int)(f * 65535.0f + 0.5f)); }
+};
+#define IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT struct ImDrawVert { ImDrawVertCompactPos pos; ImDrawVertCompactUV uv; ImU32 col; }
+#endif
+
 // Vertex layout
 #ifndef IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT
 struct ImDrawVert
@@ -3734,6 +3757,7 @@ struct ImFontAtlas
     int                         TexMaxWidth;        // Maximum desired texture width. Must be a power of two. Default to 8192.
     int                         TexMaxHeight;       // Maximum desired texture height. Must be a power of two. Default to 8192.
     void*                       UserData;           // Store your own atlas related user-data (if e.g. you have multiple font atlas).
+    int                         WrapCacheCapacity;  // 0       // Word-wrap layout cache: number of wrapped texts (font, size, wrap width, text) whose line breaks are remembered, least recently used dropped first. 0 disables it. Helps when the same long paragraphs are drawn with TextWrapped() every frame.
 
     // Output
     // - Because textures are dynamically created/resized, the current texture identifier may changed at *ANY TIME* during the frame.
@@ -3744,6 +3768,8 @@ struct ImFontAtlas
     union { ImTextureRef TexRef; ImTextureRef TexID; }; // Latest texture identifier == TexData->GetTexRef(). // RENAMED TexID to TexRef in 1.92.0.
 #endif
     ImTextureData*              TexData;            // Latest texture.
+    int                         WrapCacheHits;      // Word-wrap layout cache: wrapped texts measured or drawn from a cached layout (running total)...
+    int                         WrapCacheMisses;    // ...and layouts computed. Compare between frames.
 
     // [Internal]
     ImVector<ImTextureData*>    TexList;            // Texture list (most often TexList.Size == 1). TexData is always == TexList.back(). DO NOT USE DIRECTLY, USE GetDrawData().Textures[]/GetPlatformIO().Textures[] instead!
@@ -62,6 +62,17 @@ IMGUI_IMPL_API void     ImGui_ImplGlfw_KeyCallback(GLFWwindow* window, int key,
 IMGUI_IMPL_API void     ImGui_ImplGlfw_CharCallback(GLFWwindow* window, unsigned int c);
 IMGUI_IMPL_API void     ImGui_ImplGlfw_MonitorCallback(GLFWmonitor* monitor, int event);
 
+// (Optional) Arrival times of input events in glfwGetTime() seconds, taken by the callbacks when GLFW delivers each event instead of at NewFrame().
+// On Windows the time a message spent in the queue before glfwPollEvents() dispatched it is subtracted (message clock resolution, usually ~16 ms). 0 = no event yet.
+struct ImGui_ImplGlfw_InputTimes
+{
+    double  LastEvent;                              // Any mouse, key or character event
+    double  MouseButton[ImGuiMouseButton_COUNT];    // Last press or release of each button
+    double  Key;                                    // Last key press or release
+    double  OldestThisFrame;                        // Oldest event that arrived between the previous NewFrame() and the current one
+};
+IMGUI_IMPL_API const ImGui_ImplGlfw_InputTimes& ImGui_ImplGlfw_GetInputTimes();
+
 // GLFW helpers
 IMGUI_IMPL_API void     ImGui_ImplGlfw_Sleep(int milliseconds);
 IMGUI_IMPL_API float    ImGui_ImplGlfw_GetContentScaleForWindow(GLFWwindow* window);
@@ -43,6 +43,71 @@ IMGUI_IMPL_API void     ImGui_ImplOpenGL3_DestroyDeviceObjects();
 // (Advanced) Use e.g. if you need to precisely control the timing of texture updates (e.g. for staged rendering), by setting ImDrawData::Textures = NULL to handle this manually.
 IMGUI_IMPL_API void     ImGui_ImplOpenGL3_UpdateTexture(ImTextureData* tex);
 
+// (Optional) Stream vertex/index data through one triple-buffered, persistently mapped ring instead of calling glBufferData() per draw list.
+// Needs GL 4.4 or ARB_buffer_storage. Returns false (and keeps the glBufferData() path) when the context can't do it. Call after Init().
+IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_SetPersistentBuffers(bool enable);
+
+// (Optional) CPU-side statistics for the most recent ImGui_ImplOpenGL3_RenderDrawData() call.
+struct ImGui_ImplOpenGL3_FrameStats
+{
+    float   RenderCpuMs;        // Time spent inside RenderDrawData(), driver calls included
+    float   UploadCpuMs;        // Part of RenderCpuMs spent handing vertex/index data to the driver
+    int     VtxBytes;
+    int     IdxBytes;
+    int     FenceWaits;         // Ring segments still in use by the GPU when we came back to them
+    bool    PersistentBuffers;  // Frame went through the persistent-mapped ring
+    int     DrawCmds;           // ImDrawCmd submitted, user callbacks excluded
+    int     DrawCalls;          // glDrawElements*() issued after merging adjacent compatible commands
+    int     ScissorChanges;     // glScissor() calls issued
+    int     TextureBinds;       // glBindTexture() calls issued
+    int     ProgramBinds;       // glUseProgram() calls issued
+    int     RedundantSkipped;   // Scissor/texture/program changes skipped because the value was already current
+    int     TexUploadBytes;     // Texture bytes sent since the previous frame (font atlas + ImGui_ImplOpenGL3_UploadTextureRegion())
+    int     TexUploadRingBytes; // Part of TexUploadBytes that went through the pixel unpack ring
+    int     TexUploadQueuedBytes; // App uploads still waiting for budget when the frame ended
+    float   TexUploadCpuMs;     // Time spent copying and submitting texture data
+};
+IMGUI_IMPL_API const ImGui_ImplOpenGL3_FrameStats& ImGui_ImplOpenGL3_GetFrameStats();
+
+// (Optional) Upload texture data through a ring of pixel unpack buffers (GL 3.2 / GL ES 3.0) so glTexSubImage2D() copies asynchronously.
+// Used for font atlas updates and for ImGui_ImplOpenGL3_UploadTextureRegion(). Each frame may put up to 'budget_bytes' through the ring:
+// font atlas updates beyond that go out directly (glyphs are needed by the frame that asked for them), app uploads wait for a later frame.
+// Returns false (and keeps direct uploads) when the context can't do it. Call after Init().
+IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_SetAsyncTextureUploads(bool enable, int budget_bytes = 4 * 1024 * 1024);
+
+// (Optional) Upload tightly packed RGB/RGBA pixels ('channels' = 3 or 4) to a region of a GL texture created by the app.
+// Copies 'pixels' before returning. With async uploads enabled the data may reach the texture a few frames later, in submission order.
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_UploadTextureRegion(ImTextureID tex_id, int x, int y, int w, int h, int channels, const void* pixels);
+IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_IsTextureUploadPending(ImTextureID tex_id);  // Some of the texture's data is still queued
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_CancelTextureUploads(ImTextureID tex_id);    // Call before deleting a texture that may still have queued data
+
+// (Optional) Time RenderDrawData() on the GPU with GL_TIME_ELAPSED and GL_TIMESTAMP queries (desktop GL 3.3 or ARB_timer_query).
+// Results are read back a few frames later, only once the GPU reports them ready, so the CPU never waits. A frame whose queries are
+// still pending when its query set comes round again is dropped. Returns false when the context can't do it. Call after Init().
+IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_SetGpuTimers(bool enable);
+
+struct ImGui_ImplOpenGL3_GpuListTiming
+{
+    char    Name[32];           // ImDrawList::_OwnerName, truncated ("" for lists without an owner window)
+    float   GpuMs;              // Between the GL_TIMESTAMP before and after this list's draws
+    int     ElemCount;          // Indices drawn
+};
+struct ImGui_ImplOpenGL3_GpuTimings
+{
+    int     FrameIndex;         // RenderDrawData() call these results belong to, counted from SetGpuTimers(true). Changes when a new frame resolves.
+    float   RenderGpuMs;        // GL_TIME_ELAPSED around the whole RenderDrawData(), texture uploads included
+    float   FrameIntervalGpuMs; // GL_TIMESTAMP distance from the previous frame's end, 0 when that frame was dropped
+    int     DroppedFrames;      // Frames not resolved in time since SetGpuTimers(true)
+    ImVector<ImGui_ImplOpenGL3_GpuListTiming> Lists; // In draw order
+};
+IMGUI_IMPL_API const ImGui_ImplOpenGL3_GpuTimings* ImGui_ImplOpenGL3_GetGpuTimings(); // Most recently resolved frame, nullptr until there is one
+
+// (Optional) Keep the linked shader program as a driver binary in the file at 'path' (GL 4.1 / ARB_get_program_binary / GL ES 3.0), so later launches skip compiling.
+// The file is keyed by GL vendor, renderer, version and the shader sources. A mismatch, a damaged file or a binary the driver rejects falls back to compiling and rewrites it.
+// Call after Init() and before the first NewFrame(); nullptr turns it off. Returns false when the context can't do it.
+IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_SetProgramCache(const char* path);
+IMGUI_IMPL_API float    ImGui_ImplOpenGL3_GetProgramSetupMs(bool* out_from_cache = nullptr);   // Time CreateDeviceObjects() spent getting the shader program ready
+
 // Configuration flags to add in your imconfig file:
 //#define IMGUI_IMPL_OPENGL_ES2     // Enable ES 2 (Auto-detected on Emscripten)
 //#define IMGUI_IMPL_OPENGL_ES3     // Enable ES 3 (Auto-detected on iOS/Android)
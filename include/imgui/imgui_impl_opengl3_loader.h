@@ -171,9 +171,11 @@ typedef khronos_uint8_t GLubyte;
 #define GL_MAX_TEXTURE_SIZE               0x0D33
 #define GL_TEXTURE_2D                     0x0DE1
 #define GL_UNSIGNED_BYTE                  0x1401
+#define GL_SHORT                          0x1402
 #define GL_UNSIGNED_SHORT                 0x1403
 #define GL_UNSIGNED_INT                   0x1405
 #define GL_FLOAT                          0x1406
+#define GL_RGB                            0x1907
 #define GL_RGBA                           0x1908
 #define GL_FILL                           0x1B02
 #define GL_VENDOR                         0x1F00
@@ -271,17 +273,31 @@ typedef khronos_intptr_t GLintptr;
 #define GL_ARRAY_BUFFER_BINDING           0x8894
 #define GL_ELEMENT_ARRAY_BUFFER_BINDING   0x8895
 #define GL_STREAM_DRAW                    0x88E0
+#define GL_QUERY_RESULT                   0x8866
+#define GL_QUERY_RESULT_AVAILABLE         0x8867
 typedef void (APIENTRYP PFNGLBINDBUFFERPROC) (GLenum target, GLuint buffer);
 typedef void (APIENTRYP PFNGLDELETEBUFFERSPROC) (GLsizei n, const GLuint *buffers);
 typedef void (APIENTRYP PFNGLGENBUFFERSPROC) (GLsizei n, GLuint *buffers);
 typedef void (APIENTRYP PFNGLBUFFERDATAPROC) (GLenum target, GLsizeiptr size, const void *data, GLenum usage);
 typedef void (APIENTRYP PFNGLBUFFERSUBDATAPROC) (GLenum target, GLintptr offset, GLsizeiptr size, const void *data);
+typedef GLboolean (APIENTRYP PFNGLUNMAPBUFFERPROC) (GLenum target);
+typedef void (APIENTRYP PFNGLGENQUERIESPROC) (GLsizei n, GLuint *ids);
+typedef void (APIENTRYP PFNGLDELETEQUERIESPROC) (GLsizei n, const GLuint *ids);
+typedef void (APIENTRYP PFNGLBEGINQUERYPROC) (GLenum target, GLuint id);
+typedef void (APIENTRYP PFNGLENDQUERYPROC) (GLenum target);
+typedef void (APIENTRYP PFNGLGETQUERYOBJECTIVPROC) (GLuint id, GLenum pname, GLint *params);
 #ifdef GL_GLEXT_PROTOTYPES
 GLAPI void APIENTRY glBindBuffer (GLenum target, GLuint buffer);
 GLAPI void APIENTRY glDeleteBuffers (GLsizei n, const GLuint *buffers);
 GLAPI void APIENTRY glGenBuffers (GLsizei n, GLuint *buffers);
 GLAPI void APIENTRY glBufferData (GLenum target, GLsizeiptr size, const void *data, GLenum usage);
 GLAPI void APIENTRY glBufferSubData (GLenum target, GLintptr offset, GLsizeiptr size, const void *data);
+GLAPI GLboolean APIENTRY glUnmapBuffer (GLenum target);
+GLAPI void APIENTRY glGenQueries (GLsizei n, GLuint *ids);
+GLAPI void APIENTRY glDeleteQueries (GLsizei n, const GLuint *ids);
+GLAPI void APIENTRY glBeginQuery (GLenum target, GLuint id);
+GLAPI void APIENTRY glEndQuery (GLenum target);
+GLAPI void APIENTRY glGetQueryObjectiv (GLuint id, GLenum pname, GLint *params);
 #endif
 #endif /* GL_VERSION_1_5 */
 #ifndef GL_VERSION_2_0
@@ -368,17 +384,22 @@ typedef khronos_uint16_t GLhalf;
 #define GL_NUM_EXTENSIONS                 0x821D
 #define GL_FRAMEBUFFER_SRGB               0x8DB9
 #define GL_VERTEX_ARRAY_BINDING           0x85B5
+#define GL_MAP_WRITE_BIT                  0x0002
+#define GL_MAP_INVALIDATE_RANGE_BIT       0x0004
+#define GL_MAP_UNSYNCHRONIZED_BIT         0x0020
 typedef void (APIENTRYP PFNGLGETBOOLEANI_VPROC) (GLenum target, GLuint index, GLboolean *data);
 typedef void (APIENTRYP PFNGLGETINTEGERI_VPROC) (GLenum target, GLuint index, GLint *data);
 typedef const GLubyte *(APIENTRYP PFNGLGETSTRINGIPROC) (GLenum name, GLuint index);
 typedef void (APIENTRYP PFNGLBINDVERTEXARRAYPROC) (GLuint array);
 typedef void (APIENTRYP PFNGLDELETEVERTEXARRAYSPROC) (GLsizei n, const GLuint *arrays);
 typedef void (APIENTRYP PFNGLGENVERTEXARRAYSPROC) (GLsizei n, GLuint *arrays);
+typedef void *(APIENTRYP PFNGLMAPBUFFERRANGEPROC) (GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
 #ifdef GL_GLEXT_PROTOTYPES
 GLAPI const GLubyte *APIENTRY glGetStringi (GLenum name, GLuint index);
 GLAPI void APIENTRY glBindVertexArray (GLuint array);
 GLAPI void APIENTRY glDeleteVertexArrays (GLsizei n, const GLuint *arrays);
 GLAPI void APIENTRY glGenVertexArrays (GLsizei n, GLuint *arrays);
+GLAPI void *APIENTRY glMapBufferRange (GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
 #endif
 #endif /* GL_VERSION_3_0 */
 #ifndef GL_VERSION_3_1
@@ -392,33 +413,73 @@ typedef khronos_uint64_t GLuint64;
 typedef khronos_int64_t GLint64;
 #define GL_CONTEXT_COMPATIBILITY_PROFILE_BIT 0x00000002
 #define GL_CONTEXT_PROFILE_MASK           0x9126
+#define GL_SYNC_GPU_COMMANDS_COMPLETE     0x9117
+#define GL_ALREADY_SIGNALED               0x911A
+#define GL_TIMEOUT_EXPIRED                0x911B
+#define GL_CONDITION_SATISFIED            0x911C
+#define GL_WAIT_FAILED                    0x911D
+#define GL_SYNC_FLUSH_COMMANDS_BIT        0x00000001
 typedef void (APIENTRYP PFNGLDRAWELEMENTSBASEVERTEXPROC) (GLenum mode, GLsizei count, GLenum type, const void *indices, GLint basevertex);
 typedef void (APIENTRYP PFNGLGETINTEGER64I_VPROC) (GLenum target, GLuint index, GLint64 *data);
+typedef GLsync (APIENTRYP PFNGLFENCESYNCPROC) (GLenum condition, GLbitfield flags);
+typedef void (APIENTRYP PFNGLDELETESYNCPROC) (GLsync sync);
+typedef GLenum (APIENTRYP PFNGLCLIENTWAITSYNCPROC) (GLsync sync, GLbitfield flags, GLuint64 timeout);
 #ifdef GL_GLEXT_PROTOTYPES
 GLAPI void APIENTRY glDrawElementsBaseVertex (GLenum mode, GLsizei count, GLenum type, const void *indices, GLint basevertex);
+GLAPI GLsync APIENTRY glFenceSync (GLenum condition, GLbitfield flags);
+GLAPI void APIENTRY glDeleteSync (GLsync sync);
+GLAPI GLenum APIENTRY glClientWaitSync (GLsync sync, GLbitfield flags, GLuint64 timeout);
 #endif
 #endif /* GL_VERSION_3_2 */
 #ifndef GL_VERSION_3_3
 #define GL_VERSION_3_3 1
 #define GL_SAMPLER_BINDING                0x8919
+#define GL_TIME_ELAPSED                   0x88BF
+#define GL_TIMESTAMP                      0x8E28
 typedef void (APIENTRYP PFNGLGENSAMPLERSPROC) (GLsizei count, GLuint *samplers);
 typedef void (APIENTRYP PFNGLDELETESAMPLERSPROC) (GLsizei count, const GLuint *samplers);
 typedef void (APIENTRYP PFNGLBINDSAMPLERPROC) (GLuint unit, GLuint sampler);
 typedef void (APIENTRYP PFNGLSAMPLERPARAMETERIPROC) (GLuint sampler, GLenum pname, GLint param);
+typedef void (APIENTRYP PFNGLQUERYCOUNTERPROC) (GLuint id, GLenum target);
+typedef void (APIENTRYP PFNGLGETQUERYOBJECTUI64VPROC) (GLuint id, GLenum pname, GLuint64 *params);
 #ifdef GL_GLEXT_PROTOTYPES
 GLAPI void APIENTRY glGenSamplers (GLsizei count, GLuint *samplers);
 GLAPI void APIENTRY glDeleteSamplers (GLsizei count, const GLuint *samplers);
 GLAPI void APIENTRY glBindSampler (GLuint unit, GLuint sampler);
 GLAPI void APIENTRY glSamplerParameteri (GLuint sampler, GLenum pname, GLint param);
+GLAPI void APIENTRY glQueryCounter (GLuint id, GLenum target);
+GLAPI void APIENTRY glGetQueryObjectui64v (GLuint id, GLenum pname, GLuint64 *params);
 #endif
 #endif /* GL_VERSION_3_3 */
 #ifndef GL_VERSION_4_1
+#define GL_VERSION_4_1 1
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#define GL_PROGRAM_BINARY_LENGTH          0x8741
+#define GL_NUM_PROGRAM_BINARY_FORMATS     0x87FE
 typedef void (APIENTRYP PFNGLGETFLOATI_VPROC) (GLenum target, GLuint index, GLfloat *data);
 typedef void (APIENTRYP PFNGLGETDOUBLEI_VPROC) (GLenum target, GLuint index, GLdouble *data);
+typedef void (APIENTRYP PFNGLGETPROGRAMBINARYPROC) (GLuint program, GLsizei bufSize, GLsizei *length, GLenum *binaryFormat, void *binary);
+typedef void (APIENTRYP PFNGLPROGRAMBINARYPROC) (GLuint program, GLenum binaryFormat, const void *binary, GLsizei length);
+typedef void (APIENTRYP PFNGLPROGRAMPARAMETERIPROC) (GLuint program, GLenum pname, GLint value);
+#ifdef GL_GLEXT_PROTOTYPES
+GLAPI void APIENTRY glGetProgramBinary (GLuint program, GLsizei bufSize, GLsizei *length, GLenum *binaryFormat, void *binary);
+GLAPI void APIENTRY glProgramBinary (GLuint program, GLenum binaryFormat, const void *binary, GLsizei length);
+GLAPI void APIENTRY glProgramParameteri (GLuint program, GLenum pname, GLint value);
+#endif
 #endif /* GL_VERSION_4_1 */
 #ifndef GL_VERSION_4_3
 typedef void (APIENTRY  *GLDEBUGPROC)(GLenum source,GLenum type,GLuint id,GLenum severity,GLsizei length,const GLchar *message,const void *userParam);
 #endif /* GL_VERSION_4_3 */
+#ifndef GL_VERSION_4_4
+#define GL_VERSION_4_4 1
+#define GL_MAP_PERSISTENT_BIT             0x0040
+#define GL_MAP_COHERENT_BIT               0x0080
+#define GL_DYNAMIC_STORAGE_BIT            0x0100
+typedef void (APIENTRYP PFNGLBUFFERSTORAGEPROC) (GLenum target, GLsizeiptr size, const void *data, GLbitfield flags);
+#ifdef GL_GLEXT_PROTOTYPES
+GLAPI void APIENTRY glBufferStorage (GLenum target, GLsizeiptr size, const void *data, GLbitfield flags);
+#endif
+#endif /* GL_VERSION_4_4 */
 #ifndef GL_VERSION_4_5
 #define GL_CLIP_ORIGIN                    0x935C
 typedef void (APIENTRYP PFNGLGETTRANSFORMFEEDBACKI_VPROC) (GLuint xfb, GLenum pname, GLuint index, GLint *param);
@@ -490,10 +551,11 @@ GL3W_API GL3WglProc imgl3wGetProcAddress(const char *proc);
 
 /* gl3w internal state */
 union ImGL3WProcs {
-    GL3WglProc ptr[63];
+    GL3WglProc ptr[79];
     struct {
         PFNGLACTIVETEXTUREPROC            ActiveTexture;
         PFNGLATTACHSHADERPROC             AttachShader;
+        PFNGLBEGINQUERYPROC               BeginQuery;
         PFNGLBINDBUFFERPROC               BindBuffer;
         PFNGLBINDSAMPLERPROC              BindSampler;
         PFNGLBINDTEXTUREPROC              BindTexture;
@@ -502,16 +564,20 @@ union ImGL3WProcs {
         PFNGLBLENDEQUATIONSEPARATEPROC    BlendEquationSeparate;
         PFNGLBLENDFUNCSEPARATEPROC        BlendFuncSeparate;
         PFNGLBUFFERDATAPROC               BufferData;
+        PFNGLBUFFERSTORAGEPROC            BufferStorage;
         PFNGLBUFFERSUBDATAPROC            BufferSubData;
         PFNGLCLEARPROC                    Clear;
         PFNGLCLEARCOLORPROC               ClearColor;
+        PFNGLCLIENTWAITSYNCPROC           ClientWaitSync;
         PFNGLCOMPILESHADERPROC            CompileShader;
         PFNGLCREATEPROGRAMPROC            CreateProgram;
         PFNGLCREATESHADERPROC             CreateShader;
         PFNGLDELETEBUFFERSPROC            DeleteBuffers;
         PFNGLDELETEPROGRAMPROC            DeleteProgram;
+        PFNGLDELETEQUERIESPROC            DeleteQueries;
         PFNGLDELETESAMPLERSPROC           DeleteSamplers;
         PFNGLDELETESHADERPROC             DeleteShader;
+        PFNGLDELETESYNCPROC               DeleteSync;
         PFNGLDELETETEXTURESPROC           DeleteTextures;
         PFNGLDELETEVERTEXARRAYSPROC       DeleteVertexArrays;
         PFNGLDETACHSHADERPROC             DetachShader;
@@ -521,16 +587,22 @@ union ImGL3WProcs {
         PFNGLDRAWELEMENTSBASEVERTEXPROC   DrawElementsBaseVertex;
         PFNGLENABLEPROC                   Enable;
         PFNGLENABLEVERTEXATTRIBARRAYPROC  EnableVertexAttribArray;
+        PFNGLENDQUERYPROC                 EndQuery;
+        PFNGLFENCESYNCPROC                FenceSync;
         PFNGLFLUSHPROC                    Flush;
         PFNGLGENBUFFERSPROC               GenBuffers;
+        PFNGLGENQUERIESPROC               GenQueries;
         PFNGLGENSAMPLERSPROC              GenSamplers;
         PFNGLGENTEXTURESPROC              GenTextures;
         PFNGLGENVERTEXARRAYSPROC          GenVertexArrays;
         PFNGLGETATTRIBLOCATIONPROC        GetAttribLocation;
         PFNGLGETERRORPROC                 GetError;
         PFNGLGETINTEGERVPROC              GetIntegerv;
+        PFNGLGETPROGRAMBINARYPROC         GetProgramBinary;
         PFNGLGETPROGRAMINFOLOGPROC        GetProgramInfoLog;
         PFNGLGETPROGRAMIVPROC             GetProgramiv;
+        PFNGLGETQUERYOBJECTIVPROC         GetQueryObjectiv;
+        PFNGLGETQUERYOBJECTUI64VPROC      GetQueryObjectui64v;
         PFNGLGETSHADERINFOLOGPROC         GetShaderInfoLog;
         PFNGLGETSHADERIVPROC              GetShaderiv;
         PFNGLGETSTRINGPROC                GetString;
@@ -541,8 +613,12 @@ union ImGL3WProcs {
         PFNGLISENABLEDPROC                IsEnabled;
         PFNGLISPROGRAMPROC                IsProgram;
         PFNGLLINKPROGRAMPROC              LinkProgram;
+        PFNGLMAPBUFFERRANGEPROC           MapBufferRange;
         PFNGLPIXELSTOREIPROC              PixelStorei;
         PFNGLPOLYGONMODEPROC              PolygonMode;
+        PFNGLPROGRAMBINARYPROC            ProgramBinary;
+        PFNGLPROGRAMPARAMETERIPROC        ProgramParameteri;
+        PFNGLQUERYCOUNTERPROC             QueryCounter;
         PFNGLREADPIXELSPROC               ReadPixels;
         PFNGLSAMPLERPARAMETERIPROC        SamplerParameteri;
         PFNGLSCISSORPROC                  Scissor;
@@ -552,6 +628,7 @@ union ImGL3WProcs {
         PFNGLTEXSUBIMAGE2DPROC            TexSubImage2D;
         PFNGLUNIFORM1IPROC                Uniform1i;
         PFNGLUNIFORMMATRIX4FVPROC         UniformMatrix4fv;
+        PFNGLUNMAPBUFFERPROC              UnmapBuffer;
         PFNGLUSEPROGRAMPROC               UseProgram;
         PFNGLVERTEXATTRIBPOINTERPROC      VertexAttribPointer;
         PFNGLVIEWPORTPROC                 Viewport;
@@ -563,6 +640,7 @@ GL3W_API extern union ImGL3WProcs imgl3wProcs;
 /* OpenGL functions */
 #define glActiveTexture                   imgl3wProcs.gl.ActiveTexture
 #define glAttachShader                    imgl3wProcs.gl.AttachShader
+#define glBeginQuery                      imgl3wProcs.gl.BeginQuery
 #define glBindBuffer                      imgl3wProcs.gl.BindBuffer
 #define glBindSampler                     imgl3wProcs.gl.BindSampler
 #define glBindTexture                     imgl3wProcs.gl.BindTexture
@@ -571,16 +649,20 @@ GL3W_API extern union ImGL3WProcs imgl3wProcs;
 #define glBlendEquationSeparate           imgl3wProcs.gl.BlendEquationSeparate
 #define glBlendFuncSeparate               imgl3wProcs.gl.BlendFuncSeparate
 #define glBufferData                      imgl3wProcs.gl.BufferData
+#define glBufferStorage                   imgl3wProcs.gl.BufferStorage
 #define glBufferSubData                   imgl3wProcs.gl.BufferSubData
 #define glClear                           imgl3wProcs.gl.Clear
 #define glClearColor                      imgl3wProcs.gl.ClearColor
+#define glClientWaitSync                  imgl3wProcs.gl.ClientWaitSync
 #define glCompileShader                   imgl3wProcs.gl.CompileShader
 #define glCreateProgram                   imgl3wProcs.gl.CreateProgram
 #define glCreateShader                    imgl3wProcs.gl.CreateShader
 #define glDeleteBuffers                   imgl3wProcs.gl.DeleteBuffers
 #define glDeleteProgram                   imgl3wProcs.gl.DeleteProgram
+#define glDeleteQueries                   imgl3wProcs.gl.DeleteQueries
 #define glDeleteSamplers                  imgl3wProcs.gl.DeleteSamplers
 #define glDeleteShader                    imgl3wProcs.gl.DeleteShader
+#define glDeleteSync                      imgl3wProcs.gl.DeleteSync
 #define glDeleteTextures                  imgl3wProcs.gl.DeleteTextures
 #define glDeleteVertexArrays              imgl3wProcs.gl.DeleteVertexArrays
 #define glDetachShader                    imgl3wProcs.gl.DetachShader
@@ -590,16 +672,22 @@ GL3W_API extern union ImGL3WProcs imgl3wProcs;
 #define glDrawElementsBaseVertex          imgl3wProcs.gl.DrawElementsBaseVertex
 #define glEnable                          imgl3wProcs.gl.Enable
 #define glEnableVertexAttribArray         imgl3wProcs.gl.EnableVertexAttribArray
+#define glEndQuery                        imgl3wProcs.gl.EndQuery
+#define glFenceSync                       imgl3wProcs.gl.FenceSync
 #define glFlush                           imgl3wProcs.gl.Flush
 #define glGenBuffers                      imgl3wProcs.gl.GenBuffers
+#define glGenQueries                      imgl3wProcs.gl.GenQueries
 #define glGenSamplers                     imgl3wProcs.gl.GenSamplers
 #define glGenTextures                     imgl3wProcs.gl.GenTextures
 #define glGenVertexArrays                 imgl3wProcs.gl.GenVertexArrays
 #define glGetAttribLocation               imgl3wProcs.gl.GetAttribLocation
 #define glGetError                        imgl3wProcs.gl.GetError
 #define glGetIntegerv                     imgl3wProcs.gl.GetIntegerv
+#define glGetProgramBinary                imgl3wProcs.gl.GetProgramBinary
 #define glGetProgramInfoLog               imgl3wProcs.gl.GetProgramInfoLog
 #define glGetProgramiv                    imgl3wProcs.gl.GetProgramiv
+#define glGetQueryObjectiv                imgl3wProcs.gl.GetQueryObjectiv
+#define glGetQueryObjectui64v             imgl3wProcs.gl.GetQueryObjectui64v
 #define glGetShaderInfoLog                imgl3wProcs.gl.GetShaderInfoLog
 #define glGetShaderiv                     imgl3wProcs.gl.GetShaderiv
 #define glGetString                       imgl3wProcs.gl.GetString
@@ -610,8 +698,12 @@ GL3W_API extern union ImGL3WProcs imgl3wProcs;
 #define glIsEnabled                       imgl3wProcs.gl.IsEnabled
 #define glIsProgram                       imgl3wProcs.gl.IsProgram
 #define glLinkProgram                     imgl3wProcs.gl.LinkProgram
+#define glMapBufferRange                  imgl3wProcs.gl.MapBufferRange
 #define glPixelStorei                     imgl3wProcs.gl.PixelStorei
 #define glPolygonMode                     imgl3wProcs.gl.PolygonMode
+#define glProgramBinary                   imgl3wProcs.gl.ProgramBinary
+#define glProgramParameteri               imgl3wProcs.gl.ProgramParameteri
+#define glQueryCounter                    imgl3wProcs.gl.QueryCounter
 #define glReadPixels                      imgl3wProcs.gl.ReadPixels
 #define glSamplerParameteri               imgl3wProcs.gl.SamplerParameteri
 #define glScissor                         imgl3wProcs.gl.Scissor
@@ -621,6 +713,7 @@ GL3W_API extern union ImGL3WProcs imgl3wProcs;
 #define glTexSubImage2D                   imgl3wProcs.gl.TexSubImage2D
 #define glUniform1i                       imgl3wProcs.gl.Uniform1i
 #define glUniformMatrix4fv                imgl3wProcs.gl.UniformMatrix4fv
+#define glUnmapBuffer                     imgl3wProcs.gl.UnmapBuffer
 #define glUseProgram                      imgl3wProcs.gl.UseProgram
 #define glVertexAttribPointer             imgl3wProcs.gl.VertexAttribPointer
 #define glViewport                        imgl3wProcs.gl.Viewport
@@ -873,6 +966,7 @@ GL3WglProc imgl3wGetProcAddress(const char *proc) { return get_proc(proc); }
 static const char *proc_names[] = {
     "glActiveTexture",
     "glAttachShader",
+    "glBeginQuery",
     "glBindBuffer",
     "glBindSampler",
     "glBindTexture",
@@ -881,16 +975,20 @@ static const char *proc_names[] = {
     "glBlendEquationSeparate",
     "glBlendFuncSeparate",
     "glBufferData",
+    "glBufferStorage",
     "glBufferSubData",
     "glClear",
     "glClearColor",
+    "glClientWaitSync",
     "glCompileShader",
     "glCreateProgram",
     "glCreateShader",
     "glDeleteBuffers",
     "glDeleteProgram",
+    "glDeleteQueries",
     "glDeleteSamplers",
     "glDeleteShader",
+    "glDeleteSync",
     "glDeleteTextures",
     "glDeleteVertexArrays",
     "glDetachShader",
@@ -900,16 +998,22 @@ static const char *proc_names[] = {
     "glDrawElementsBaseVertex",
     "glEnable",
     "glEnableVertexAttribArray",
+    "glEndQuery",
+    "glFenceSync",
     "glFlush",
     "glGenBuffers",
+    "glGenQueries",
     "glGenSamplers",
     "glGenTextures",
     "glGenVertexArrays",
     "glGetAttribLocation",
     "glGetError",
     "glGetIntegerv",
+    "glGetProgramBinary",
     "glGetProgramInfoLog",
     "glGetProgramiv",
+    "glGetQueryObjectiv",
+    "glGetQueryObjectui64v",
     "glGetShaderInfoLog",
     "glGetShaderiv",
     "glGetString",
@@ -920,8 +1024,12 @@ static const char *proc_names[] = {
     "glIsEnabled",
     "glIsProgram",
     "glLinkProgram",
+    "glMapBufferRange",
     "glPixelStorei",
     "glPolygonMode",
+    "glProgramBinary",
+    "glProgramParameteri",
+    "glQueryCounter",
     "glReadPixels",
     "glSamplerParameteri",
     "glScissor",
@@ -931,6 +1039,7 @@ static const char *proc_names[] = {
     "glTexSubImage2D",
     "glUniform1i",
     "glUniformMatrix4fv",
+    "glUnmapBuffer",
     "glUseProgram",
     "glVertexAttribPointer",
     "glViewport",
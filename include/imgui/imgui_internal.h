@@ -141,9 +141,11 @@ struct ImGuiTextIndex;              // Maintain a line index for a text buffer.
 // ImDrawList/ImFontAtlas
 struct ImDrawDataBuilder;           // Helper to build a ImDrawData instance
 struct ImDrawListSharedData;        // Data shared between all ImDrawList instances
+struct ImDrawListTriangulation;     // Cached triangles of a concave polygon (see ImDrawListSharedData::TriangulationCache)
 struct ImFontAtlasBuilder;          // Internal storage for incrementally packing and building a ImFontAtlas
 struct ImFontAtlasPostProcessData;  // Data available to potential texture post-processing functions
 struct ImFontAtlasRectEntry;        // Packed rectangle lookup entry
+struct ImFontWrapLayout;            // Cached word-wrap layout of a text (see ImFontAtlasBuilder::WrapCache)
 
 // ImGui
 struct ImGuiBoxSelectState;         // Box-selection state (currently used by multi-selection, could potentially be used by others)
@@ -428,6 +430,7 @@ IMGUI_API int           ImTextCountUtf8BytesFromStr(const ImWchar* in_text, cons
 IMGUI_API const char*   ImTextFindPreviousUtf8Codepoint(const char* in_text_start, const char* in_p);                           // return previous UTF-8 code-point.
 IMGUI_API const char*   ImTextFindValidUtf8CodepointEnd(const char* in_text_start, const char* in_text_end, const char* in_p);  // return previous UTF-8 code-point if 'in_p' is not the end of a valid one.
 IMGUI_API int           ImTextCountLines(const char* in_text, const char* in_text_end);                                         // return number of lines taken by text. trailing carriage return doesn't count as an extra line.
+IMGUI_API const char*   ImTextFindAsciiRunEnd(const char* in_text, const char* in_text_end, int min_char);                      // return end of the run of characters in [min_char, 0x80) starting at in_text, which need no UTF-8 decoding. min_char >= 1.
 
 // Helpers: High-level text functions (DO NOT USE!!! THIS IS A MINIMAL SUBSET OF LARGER UPCOMING CHANGES)
 enum ImDrawTextFlags_
@@ -439,6 +442,7 @@ enum ImDrawTextFlags_
 };
 IMGUI_API ImVec2        ImFontCalcTextSizeEx(ImFont* font, float size, float max_width, float wrap_width, const char* text_begin, const char* text_end_display, const char* text_end, const char** out_remaining, ImVec2* out_offset, ImDrawTextFlags flags);
 IMGUI_API const char*   ImFontCalcWordWrapPositionEx(ImFont* font, float size, const char* text, const char* text_end, float wrap_width, ImDrawTextFlags flags = 0);
+IMGUI_API const ImFontWrapLayout* ImFontGetWrapLayout(ImFont* font, float size, float wrap_width, const char* text_begin, const char* text_end, ImDrawTextFlags flags, bool create); // NULL when the cache is disabled, or on a miss with create == false
 IMGUI_API const char*   ImTextCalcWordWrapNextLineStart(const char* text, const char* text_end, ImDrawTextFlags flags = 0); // trim trailing space and find beginning of next line
 
 // Character classification for word-wrapping logic
@@ -785,6 +789,77 @@ struct ImPool
     T*          TryGetMapData(ImPoolIdx n)          { int idx = Map.Data[n].val_i; if (idx == -1) return NULL; return GetByIndex(idx); }
 };
 
+// Helper: ImLruCache<>
+// Keep results that are expensive to compute (T) per input, dropping the least recently used first when full.
+// An input is a fixed-size 'params' block plus 'data' of any size, both copied into the entry and compared in full, so a hit is always for the exact same input.
+// Entries are allocated one by one and never move: a pointer stays valid until the next Add() or Clear(). Code that may run while a caller holds an entry must only Kill() entries.
+template<typename T>
+struct ImLruCache
+{
+    struct Entry
+    {
+        T               Value;
+        ImVector<char>  Key;            // Params then data
+        int             ParamsSize;
+        unsigned int    LastUse;        // 0: dead, never found and reused first
+    };
+    ImVector<Entry*>    Entries;        // Scanned linearly
+    unsigned int        UseCounter;
+
+    ImLruCache()        { UseCounter = 0; }
+    ~ImLruCache()       { Clear(); }
+    void    Clear()                     { for (Entry* entry : Entries) IM_DELETE(entry); Entries.clear(); }
+    void    Kill(Entry* entry)          { entry->LastUse = 0; }
+
+    T*      Find(const void* params, int params_size, const void* data, int data_size)
+    {
+        for (Entry* entry : Entries)
+        {
+            if (entry->LastUse == 0 || entry->ParamsSize != params_size || entry->Key.Size != params_size + data_size)
+                continue;
+            if (params_size > 0 && memcmp(entry->Key.Data, params, (size_t)params_size) != 0)
+                continue;
+            if (data_size > 0 && memcmp(entry->Key.Data + params_size, data, (size_t)data_size) != 0)
+                continue;
+            entry->LastUse = ++UseCounter;
+            return &entry->Value;
+        }
+        return NULL;
+    }
+
+    // Take a new slot, or the least recently used one when full. The returned value keeps whatever the reused entry held: caller recomputes it.
+    T*      Add(int capacity, const void* params, int params_size, const void* data, int data_size)
+    {
+        IM_ASSERT(capacity > 0);
+        while (Entries.Size > capacity)
+        {
+            IM_DELETE(Entries.back());
+            Entries.pop_back();
+        }
+        Entry* entry;
+        if (Entries.Size < capacity)
+        {
+            entry = IM_NEW(Entry)();
+            Entries.push_back(entry);
+        }
+        else
+        {
+            entry = Entries[0];
+            for (Entry* other : Entries)
+                if (other->LastUse < entry->LastUse)
+                    entry = other;
+        }
+        entry->Key.resize(params_size + data_size);
+        if (params_size > 0)
+            memcpy(entry->Key.Data, params, (size_t)params_size);
+        if (data_size > 0)
+            memcpy(entry->Key.Data + params_size, data, (size_t)data_size);
+        entry->ParamsSize = params_size;
+        entry->LastUse = ++UseCounter;
+        return &entry->Value;
+    }
+};
+
 // Helper: ImChunkStream<>
 // Build and iterate a contiguous stream of variable-sized structures.
 // This is used by Settings to store persistent data while reducing allocation count.
@@ -854,6 +929,14 @@ IMGUI_API ImGuiStoragePair* ImLowerBound(ImGuiStoragePair* in_begin, ImGuiStorag
 #endif
 #define IM_DRAWLIST_ARCFAST_SAMPLE_MAX                          IM_DRAWLIST_ARCFAST_TABLE_SIZE // Sample index _PathArcToFastEx() for 360 angle.
 
+// Concave fill triangulation cache (enabled by ImDrawListSharedData::TriangulationCacheCapacity > 0)
+// The triangles AddConcavePolyFilled() found for a polygon, reused while the exact same points are filled again (e.g. static outlines drawn every frame).
+// Entries are keyed on the points themselves, so a polygon moved or scaled is a new entry.
+struct ImDrawListTriangulation
+{
+    ImVector<unsigned int>      Triangles;              // 3 point indices per triangle, in the order ImTriangulator produced them
+};
+
 // Data shared between all ImDrawList instances
 // Conceptually this could have been called e.g. ImDrawListSharedContext
 // Typically one ImGui context would create and maintain one of this.
@@ -875,6 +958,12 @@ struct IMGUI_API ImDrawListSharedData
     ImVector<ImDrawList*> DrawLists;            // All draw lists associated to this ImDrawListSharedData
     ImGuiContext*   Context;                    // [OPTIONAL] Link to Dear ImGui context. 99% of ImDrawList/ImFontAtlas can function without an ImGui context, but this facilitate handling one legacy edge case.
 
+    // Concave fill triangulation cache
+    int             TriangulationCacheCapacity; // 0       // Number of polygons whose AddConcavePolyFilled() triangles are remembered, least recently used dropped first. 0 disables it.
+    int             TriangulationCacheHits;     // Polygons filled from cached triangles (running total)...
+    int             TriangulationCacheMisses;   // ...and polygons triangulated while the cache is enabled.
+    ImLruCache<ImDrawListTriangulation> TriangulationCache; // Keyed on the points
+
     // Lookup tables
     ImVec2          ArcFastVtx[IM_DRAWLIST_ARCFAST_TABLE_SIZE]; // Sample points on the quarter of the circle.
     float           ArcFastRadiusCutoff;                        // Cutoff radius after which arc drawing will fallback to slower PathArcTo()
@@ -3845,6 +3934,32 @@ typedef stbrp_node stbrp_node_im;
 #endif
 struct stbrp_context_opaque { char data[80]; };
 
+// Word-wrap layout cache (enabled by ImFontAtlas::WrapCacheCapacity > 0)
+// Where a wrapped text breaks and how wide each line is, computed once and reused by CalcTextSizeA(), RenderText() and
+// CalcWordWrapPosition() while the same text is drawn with the same baked font, size, wrap width and flags.
+// Entries are keyed on ImFontWrapParams and the text itself, so a text edited in place is a new entry. Dropped whenever a font or baked size is discarded.
+struct ImFontWrapLine
+{
+    int                         Begin;                  // Byte offset of the first character
+    int                         End;                    // Byte offset of the wrap point (== what ImFontCalcWordWrapPositionEx() returns for this line)
+    float                       Width;                  // Sum of advances over [Begin, End)
+};
+
+struct ImFontWrapParams
+{
+    ImGuiID                     BakedId;                // Not the ImFontBaked*: the baked pool moves its elements when compacting
+    float                       Size;
+    float                       WrapWidth;
+    ImDrawTextFlags             Flags;
+};
+
+struct ImFontWrapLayout
+{
+    ImFontWrapParams            Params;
+    ImVec2                      TextSize;               // == CalcTextSizeA() over the whole text
+    ImVector<ImFontWrapLine>    Lines;
+};
+
 // Internal storage for incrementally packing and building a ImFontAtlas
 struct ImFontAtlasBuilder
 {
@@ -3873,6 +3988,9 @@ struct ImFontAtlasBuilder
     ImFontAtlasRectId           PackIdMouseCursors;     // White pixel + mouse cursors. Also happen to be fallback in case of packing failure.
     ImFontAtlasRectId           PackIdLinesTexData;
 
+    // Word-wrap layouts
+    ImLruCache<ImFontWrapLayout> WrapCache;             // Keyed on ImFontWrapParams + text
+
     ImFontAtlasBuilder()        { memset(this, 0, sizeof(*this)); FrameCount = -1; RectsIndexFreeListStart = -1; PackIdMouseCursors = PackIdLinesTexData = -1; }
 };
 
@@ -3884,6 +4002,7 @@ IMGUI_API void              ImFontAtlasBuildNotifySetFont(ImFontAtlas* atlas, Im
 IMGUI_API void              ImFontAtlasBuildUpdatePointers(ImFontAtlas* atlas);
 IMGUI_API void              ImFontAtlasBuildRenderBitmapFromString(ImFontAtlas* atlas, int x, int y, int w, int h, const char* in_str, char in_marker_char);
 IMGUI_API void              ImFontAtlasBuildClear(ImFontAtlas* atlas); // Clear output and custom rects
+IMGUI_API void              ImFontAtlasWrapCacheClear(ImFontAtlas* atlas);
 
 IMGUI_API ImTextureData*    ImFontAtlasTextureAdd(ImFontAtlas* atlas, int w, int h);
 IMGUI_API void              ImFontAtlasTextureMakeSpace(ImFontAtlas* atlas);
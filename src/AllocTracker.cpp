@@ -0,0 +1,197 @@
+#include "AllocTracker.h"
+#include "imgui.h"
+#include <atomic>
+#include <cstdlib>
+#include <cstdio>
+#include <new>
+
+static std::atomic<bool> g_enabled(false);
+static thread_local AllocCounts t_counts = { 0, 0, 0 };
+
+static inline void countAlloc(std::size_t size) {
+    if (!g_enabled.load(std::memory_order_relaxed)) return;
+    t_counts.allocs++;
+    t_counts.bytes += (long long)size;
+}
+
+static inline void countFree(void* ptr) {
+    if (ptr && g_enabled.load(std::memory_order_relaxed)) t_counts.frees++;
+}
+
+// ==========================================
+// GLOBAL OPERATOR NEW / DELETE
+// ==========================================
+
+void* operator new(std::size_t size) {
+    countAlloc(size);
+    if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+    countAlloc(size);
+    if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    countAlloc(size);
+    return std::malloc(size ? size : 1);
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    countAlloc(size);
+    return std::malloc(size ? size : 1);
+}
+void operator delete(void* ptr) noexcept { countFree(ptr); std::free(ptr); }
+void operator delete[](void* ptr) noexcept { countFree(ptr); std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { countFree(ptr); std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { countFree(ptr); std::free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { countFree(ptr); std::free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { countFree(ptr); std::free(ptr); }
+
+// ==========================================
+// FRAMES AND SCOPES
+// ==========================================
+
+namespace AllocTracker {
+
+static AllocCounts frameStart = { 0, 0, 0 };
+static AllocCounts previousFrame = { 0, 0, 0 };
+static float history[HISTORY];
+static int historyHead = 0;
+static int historyCount = 0;
+static ScopeStats scopes[MAX_SCOPES];
+static int numScopes = 0;
+
+static AllocCounts difference(const AllocCounts& a, const AllocCounts& b) {
+    AllocCounts d = { a.allocs - b.allocs, a.frees - b.frees, a.bytes - b.bytes };
+    return d;
+}
+
+static void accumulate(AllocCounts& into, const AllocCounts& d) {
+    into.allocs += d.allocs;
+    into.frees += d.frees;
+    into.bytes += d.bytes;
+}
+
+void install() {
+    ImGui::SetAllocatorFunctions(
+        [](size_t size, void*) -> void* { countAlloc(size); return std::malloc(size); },
+        [](void* ptr, void*) { countFree(ptr); std::free(ptr); });
+}
+
+void setEnabled(bool on) {
+    g_enabled.store(on, std::memory_order_relaxed);
+    frameStart = current();
+}
+
+bool isEnabled() {
+    return g_enabled.load(std::memory_order_relaxed);
+}
+
+AllocCounts current() {
+    return t_counts;
+}
+
+void beginFrame() {
+    AllocCounts now = current();
+    previousFrame = difference(now, frameStart);
+    frameStart = now;
+    history[historyHead] = (float)previousFrame.allocs;
+    historyHead = (historyHead + 1) % HISTORY;
+    if (historyCount < HISTORY) historyCount++;
+
+    for (int i = 0; i < numScopes; i++) {
+        ScopeStats& s = scopes[i];
+        if (!s.ranThisFrame) continue;
+        s.lastFrame = s.thisFrame;
+        s.frames++;
+        if (s.thisFrame.allocs > 0) s.framesWithAllocs++;
+        s.thisFrame = AllocCounts{ 0, 0, 0 };
+        s.ranThisFrame = false;
+    }
+}
+
+const AllocCounts& lastFrame() {
+    return previousFrame;
+}
+
+const float* frameHistory(int* count, int* offset) {
+    *count = historyCount;
+    *offset = historyCount < HISTORY ? 0 : historyHead;
+    return history;
+}
+
+void addScope(const char* name, const AllocCounts& delta) {
+    int i = 0;
+    while (i < numScopes && scopes[i].name != name) i++;
+    if (i == numScopes) {
+        if (numScopes == MAX_SCOPES) return;
+        scopes[numScopes++] = ScopeStats{ name, { 0, 0, 0 }, false, { 0, 0, 0 }, { 0, 0, 0 }, 0, 0 };
+    }
+    accumulate(scopes[i].thisFrame, delta);
+    accumulate(scopes[i].total, delta);
+    scopes[i].ranThisFrame = true;
+}
+
+int scopeCount() {
+    return numScopes;
+}
+
+const ScopeStats& scope(int i) {
+    return scopes[i];
+}
+
+void reset() {
+    numScopes = 0;
+    historyHead = 0;
+    historyCount = 0;
+    frameStart = current();
+}
+
+void drawOverlay(bool* open) {
+    ImGui::SetNextWindowSize(ImVec2(460, 360), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowPos(ImVec2(20, 560), ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("Allocations", open)) {
+        ImGui::End();
+        return;
+    }
+    if (!isEnabled()) {
+        ImGui::TextWrapped("Allocation tracking is off. Start with ATW_ALLOC_STATS=1 to count allocations.");
+        ImGui::End();
+        return;
+    }
+
+    ImGui::Text("Last frame: %lld allocations, %lld frees, %lld bytes", previousFrame.allocs, previousFrame.frees, previousFrame.bytes);
+    int count, offset;
+    const float* values = frameHistory(&count, &offset);
+    ImGui::PlotHistogram("##allocs", values, count, offset, "allocations per frame", 0.0f, FLT_MAX, ImVec2(-1, 60));
+
+    if (ImGui::BeginTable("scopes", 5, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV)) {
+        ImGui::TableSetupColumn("Scope");
+        ImGui::TableSetupColumn("allocs");
+        ImGui::TableSetupColumn("bytes");
+        ImGui::TableSetupColumn("avg allocs");
+        ImGui::TableSetupColumn("frames allocating");
+        ImGui::TableHeadersRow();
+        for (int i = 0; i < numScopes; i++) {
+            const ScopeStats& s = scopes[i];
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::TextUnformatted(s.name);
+            ImGui::TableNextColumn(); ImGui::Text("%lld", s.lastFrame.allocs);
+            ImGui::TableNextColumn(); ImGui::Text("%lld", s.lastFrame.bytes);
+            ImGui::TableNextColumn(); ImGui::Text("%.2f", s.frames ? (double)s.total.allocs / s.frames : 0.0);
+            ImGui::TableNextColumn(); ImGui::Text("%d / %d", s.framesWithAllocs, s.frames);
+        }
+        ImGui::EndTable();
+    }
+    if (ImGui::Button("Reset")) reset();
+
+    ImGui::End();
+}
+
+}
+
+AllocScope::AllocScope(const char* name) : name(name), start(AllocTracker::current()) {}
+
+AllocScope::~AllocScope() {
+    if (AllocTracker::isEnabled()) AllocTracker::addScope(name, AllocTracker::difference(AllocTracker::current(), start));
+}
@@ -0,0 +1,251 @@
+#include "AudioDsp.h"
+#include <cmath>
+#include <algorithm>
+
+#if defined(__AVX2__)
+#define DSP_SIMD_AVX2 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DSP_SIMD_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define DSP_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+// =========================================================
+// KERNELS
+// =========================================================
+
+const char* dspSimdPath() {
+#if DSP_SIMD_AVX2
+    return "avx2";
+#elif DSP_SIMD_SSE2
+    return "sse2";
+#elif DSP_SIMD_NEON
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+void dspMixGain(float* dst, const float* src, int count, float gain) {
+    int i = 0;
+#if DSP_SIMD_AVX2
+    __m256 g8 = _mm256_set1_ps(gain);
+    for (; i + 8 <= count; i += 8)
+        _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(dst + i), _mm256_mul_ps(_mm256_loadu_ps(src + i), g8)));
+#endif
+#if DSP_SIMD_AVX2 || DSP_SIMD_SSE2
+    __m128 g4 = _mm_set1_ps(gain);
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_loadu_ps(src + i), g4)));
+#elif DSP_SIMD_NEON
+    float32x4_t g4 = vdupq_n_f32(gain);
+    for (; i + 4 <= count; i += 4)
+        vst1q_f32(dst + i, vmlaq_f32(vld1q_f32(dst + i), vld1q_f32(src + i), g4));
+#endif
+    for (; i < count; i++) dst[i] += src[i] * gain;
+}
+
+void dspMixRampStereo(float* dst, const float* src, int frames, float gain, float step) {
+    int i = 0;
+    // Two stereo frames per 128-bit register: gains {g, g, g+s, g+s}, advancing by 2s.
+#if DSP_SIMD_AVX2 || DSP_SIMD_SSE2
+    __m128 g = _mm_setr_ps(gain, gain, gain + step, gain + step);
+    __m128 inc = _mm_set1_ps(2.0f * step);
+    for (; i + 2 <= frames; i += 2) {
+        _mm_storeu_ps(dst + i * 2, _mm_add_ps(_mm_loadu_ps(dst + i * 2), _mm_mul_ps(_mm_loadu_ps(src + i * 2), g)));
+        g = _mm_add_ps(g, inc);
+    }
+#elif DSP_SIMD_NEON
+    float init[4] = { gain, gain, gain + step, gain + step };
+    float32x4_t g = vld1q_f32(init);
+    float32x4_t inc = vdupq_n_f32(2.0f * step);
+    for (; i + 2 <= frames; i += 2) {
+        vst1q_f32(dst + i * 2, vmlaq_f32(vld1q_f32(dst + i * 2), vld1q_f32(src + i * 2), g));
+        g = vaddq_f32(g, inc);
+    }
+#endif
+    for (; i < frames; i++) {
+        float fg = gain + i * step;
+        dst[i * 2] += src[i * 2] * fg;
+        dst[i * 2 + 1] += src[i * 2 + 1] * fg;
+    }
+}
+
+// Above the knee: y = knee + (1 - knee) * d / (1 + d), d = (|x| - knee) / (1 - knee).
+// Slope is 1 at the knee and the curve approaches 1 asymptotically.
+static inline float softClipScalar(float x) {
+    float a = std::fabs(x);
+    if (a <= DSP_SOFT_CLIP_KNEE) return x;
+    float d = (a - DSP_SOFT_CLIP_KNEE) / (1.0f - DSP_SOFT_CLIP_KNEE);
+    float y = DSP_SOFT_CLIP_KNEE + (1.0f - DSP_SOFT_CLIP_KNEE) * d / (1.0f + d);
+    return x < 0 ? -y : y;
+}
+
+void dspSoftClip(float* buf, int count) {
+    int i = 0;
+#if DSP_SIMD_AVX2 || DSP_SIMD_SSE2
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    const __m128 knee = _mm_set1_ps(DSP_SOFT_CLIP_KNEE);
+    const __m128 range = _mm_set1_ps(1.0f - DSP_SOFT_CLIP_KNEE);
+    const __m128 invRange = _mm_set1_ps(1.0f / (1.0f - DSP_SOFT_CLIP_KNEE));
+    const __m128 one = _mm_set1_ps(1.0f);
+    for (; i + 4 <= count; i += 4) {
+        __m128 x = _mm_loadu_ps(buf + i);
+        __m128 sign = _mm_and_ps(x, signMask);
+        __m128 a = _mm_andnot_ps(signMask, x);
+        __m128 d = _mm_mul_ps(_mm_max_ps(_mm_sub_ps(a, knee), _mm_setzero_ps()), invRange);
+        __m128 y = _mm_add_ps(_mm_min_ps(a, knee), _mm_mul_ps(range, _mm_div_ps(d, _mm_add_ps(one, d))));
+        _mm_storeu_ps(buf + i, _mm_or_ps(y, sign));
+    }
+#elif DSP_SIMD_NEON
+    const float32x4_t knee = vdupq_n_f32(DSP_SOFT_CLIP_KNEE);
+    const float32x4_t range = vdupq_n_f32(1.0f - DSP_SOFT_CLIP_KNEE);
+    const float32x4_t invRange = vdupq_n_f32(1.0f / (1.0f - DSP_SOFT_CLIP_KNEE));
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t x = vld1q_f32(buf + i);
+        float32x4_t a = vabsq_f32(x);
+        float32x4_t d = vmulq_f32(vmaxq_f32(vsubq_f32(a, knee), vdupq_n_f32(0.0f)), invRange);
+        float32x4_t den = vaddq_f32(one, d);
+        float32x4_t r = vrecpeq_f32(den);
+        r = vmulq_f32(r, vrecpsq_f32(den, r));
+        r = vmulq_f32(r, vrecpsq_f32(den, r));
+        float32x4_t y = vaddq_f32(vminq_f32(a, knee), vmulq_f32(range, vmulq_f32(d, r)));
+        uint32x4_t neg = vcltq_f32(x, vdupq_n_f32(0.0f));
+        vst1q_f32(buf + i, vbslq_f32(neg, vnegq_f32(y), y));
+    }
+#endif
+    for (; i < count; i++) buf[i] = softClipScalar(buf[i]);
+}
+
+static inline float dot(const float* a, const float* b, int n) {
+    int i = 0;
+    float sum = 0.0f;
+#if DSP_SIMD_AVX2
+    __m256 acc8 = _mm256_setzero_ps();
+    for (; i + 8 <= n; i += 8) acc8 = _mm256_add_ps(acc8, _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+    __m128 acc = _mm_add_ps(_mm256_castps256_ps128(acc8), _mm256_extractf128_ps(acc8, 1));
+#elif DSP_SIMD_SSE2
+    __m128 acc = _mm_setzero_ps();
+    for (; i + 4 <= n; i += 4) acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+#endif
+#if DSP_SIMD_AVX2 || DSP_SIMD_SSE2
+    acc = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+    acc = _mm_add_ss(acc, _mm_shuffle_ps(acc, acc, 1));
+    sum = _mm_cvtss_f32(acc);
+#elif DSP_SIMD_NEON
+    float32x4_t acc = vdupq_n_f32(0.0f);
+    for (; i + 4 <= n; i += 4) acc = vmlaq_f32(acc, vld1q_f32(a + i), vld1q_f32(b + i));
+    float32x2_t half = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+    sum = vget_lane_f32(vpadd_f32(half, half), 0);
+#endif
+    for (; i < n; i++) sum += a[i] * b[i];
+    return sum;
+}
+
+// =========================================================
+// POLYPHASE RESAMPLER
+// =========================================================
+
+static int gcd(int a, int b) {
+    while (b) { int t = a % b; a = b; b = t; }
+    return a;
+}
+
+// Zeroth-order modified Bessel function, for the Kaiser window.
+static double besselI0(double x) {
+    double sum = 1.0, term = 1.0;
+    for (int k = 1; k < 32; k++) {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum += term;
+    }
+    return sum;
+}
+
+PolyphaseResampler::PolyphaseResampler()
+    : phases(1), step(1), channels(2), base(0), phase(0), received(0), position(0) {}
+
+void PolyphaseResampler::setup(int inRate, int outRate, int numChannels) {
+    channels = std::max(1, numChannels);
+    int g = gcd(inRate, outRate);
+    phases = g > 0 ? outRate / g : 1;
+    step = g > 0 ? inRate / g : 1;
+    if (phases > MAX_PHASES) {
+        step = std::max(1, (int)std::lround((double)inRate * MAX_PHASES / outRate));
+        phases = MAX_PHASES;
+    }
+
+    coefs.assign((size_t)phases * TAPS, 0.0f);
+    if (!isPassthrough()) {
+        const double PI = 3.14159265358979323846;
+        const double beta = 8.0;
+        // Cutoff in cycles per input sample: just under the lower of the two Nyquists.
+        double cutoff = 0.5 * std::min(1.0, (double)phases / step) * 0.95;
+        double half = TAPS / 2.0;
+        for (int p = 0; p < phases; p++) {
+            float* c = &coefs[(size_t)p * TAPS];
+            double sum = 0.0;
+            for (int k = 0; k < TAPS; k++) {
+                // Distance from the output position (input index + p/L) to tap k.
+                double t = (double)p / phases + (TAPS / 2 - 1) - k;
+                double x = 2.0 * cutoff * t;
+                double sinc = std::fabs(x) < 1e-9 ? 1.0 : std::sin(PI * x) / (PI * x);
+                double w = t / half;
+                double window = std::fabs(w) >= 1.0 ? 0.0 : besselI0(beta * std::sqrt(1.0 - w * w)) / besselI0(beta);
+                c[k] = (float)(sinc * window);
+                sum += c[k];
+            }
+            // Unity DC gain per phase, so constant input never ripples.
+            for (int k = 0; k < TAPS; k++) c[k] = (float)(c[k] / sum);
+        }
+    }
+    reset();
+}
+
+void PolyphaseResampler::reset() {
+    history.assign(channels, std::vector<float>(TAPS / 2 - 1, 0.0f));
+    base = 0;
+    phase = 0;
+    received = 0;
+    position = 0;
+}
+
+void PolyphaseResampler::process(const float* in, int frames, std::vector<float>& out) {
+    if (isPassthrough()) {
+        out.insert(out.end(), in, in + (size_t)frames * channels);
+        return;
+    }
+    for (int c = 0; c < channels; c++) {
+        std::vector<float>& h = history[c];
+        size_t used = h.size();
+        h.resize(used + frames);
+        for (int i = 0; i < frames; i++) h[used + i] = in[(size_t)i * channels + c];
+    }
+    received += frames;
+    run(out, false);
+}
+
+void PolyphaseResampler::flush(std::vector<float>& out) {
+    if (isPassthrough()) return;
+    for (int c = 0; c < channels; c++) history[c].resize(history[c].size() + TAPS / 2, 0.0f);
+    run(out, true);
+}
+
+void PolyphaseResampler::run(std::vector<float>& out, bool draining) {
+    size_t available = history[0].size();
+    while (base + TAPS <= available && (!draining || position < received)) {
+        const float* c = &coefs[(size_t)phase * TAPS];
+        for (int ch = 0; ch < channels; ch++) out.push_back(dot(&history[ch][base], c, TAPS));
+        phase += step;
+        base += phase / phases;
+        position += phase / phases;
+        phase %= phases;
+    }
+    // Drop consumed history so it stays at most one call's worth plus the taps.
+    size_t drop = std::min(base, available);
+    for (int ch = 0; ch < channels; ch++) history[ch].erase(history[ch].begin(), history[ch].begin() + drop);
+    base -= drop;
+}
@@ -0,0 +1,485 @@
+#include "AudioEngine.h"
+#include "MusicStream.h"
+#include "Mp3Decoder.h"
+#include "AudioDsp.h"
+#include "Profiler.h"
+#include <cstring>
+#include <cstdlib>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <mmsystem.h>
+#endif
+
+static double nowSeconds() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static short floatToPcm16(float v) {
+    if (v > 1.0f) v = 1.0f;
+    if (v < -1.0f) v = -1.0f;
+    return (short)(v * 32767.0f);
+}
+
+// =========================================================
+// DECODING
+// =========================================================
+
+static unsigned int readLE32(const unsigned char* p) { return p[0] | (p[1] << 8) | (p[2] << 16) | ((unsigned int)p[3] << 24); }
+static unsigned short readLE16(const unsigned char* p) { return (unsigned short)(p[0] | (p[1] << 8)); }
+
+// Converts decoded interleaved samples at any rate/channel count into engine format.
+static void convertToEngineFormat(const std::vector<float>& in, int channels, int rate, PcmBuffer& out) {
+    int inFrames = channels > 0 ? (int)(in.size() / channels) : 0;
+    if (inFrames == 0) { out.samples.clear(); out.frames = 0; return; }
+
+    // Mono is duplicated, extra channels past the first two are dropped.
+    std::vector<float> stereo((size_t)inFrames * 2);
+    for (int i = 0; i < inFrames; i++) {
+        stereo[(size_t)i * 2] = in[(size_t)i * channels];
+        stereo[(size_t)i * 2 + 1] = in[(size_t)i * channels + std::min(1, channels - 1)];
+    }
+
+    PolyphaseResampler resampler;
+    resampler.setup(rate, AudioEngine::SAMPLE_RATE, 2);
+    if (resampler.isPassthrough()) {
+        out.samples.swap(stereo);
+    } else {
+        out.samples.clear();
+        out.samples.reserve((size_t)((double)inFrames * AudioEngine::SAMPLE_RATE / rate + 2) * 2);
+        resampler.process(stereo.data(), inFrames, out.samples);
+        resampler.flush(out.samples);
+    }
+    out.frames = (int)(out.samples.size() / 2);
+}
+
+static bool decodeWav(const std::string& path, PcmBuffer& out) {
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) return false;
+    std::vector<unsigned char> data;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if (size > 12) {
+        data.resize(size);
+        if (fread(data.data(), 1, size, f) != (size_t)size) data.clear();
+    }
+    fclose(f);
+    if (data.size() < 12 || memcmp(data.data(), "RIFF", 4) != 0 || memcmp(data.data() + 8, "WAVE", 4) != 0) return false;
+
+    int format = 0, channels = 0, rate = 0, bits = 0;
+    const unsigned char* pcm = nullptr;
+    size_t pcmBytes = 0;
+    size_t pos = 12;
+    while (pos + 8 <= data.size()) {
+        const unsigned char* chunk = data.data() + pos;
+        size_t len = readLE32(chunk + 4);
+        if (pos + 8 + len > data.size()) len = data.size() - pos - 8;
+        if (memcmp(chunk, "fmt ", 4) == 0 && len >= 16) {
+            format = readLE16(chunk + 8);
+            channels = readLE16(chunk + 10);
+            rate = (int)readLE32(chunk + 12);
+            bits = readLE16(chunk + 22);
+            if (format == 0xFFFE && len >= 26) format = readLE16(chunk + 32); // WAVE_FORMAT_EXTENSIBLE sub-format
+        } else if (memcmp(chunk, "data", 4) == 0) {
+            pcm = chunk + 8;
+            pcmBytes = len;
+        }
+        pos += 8 + len + (len & 1);
+    }
+    if (!pcm || channels <= 0 || rate <= 0) return false;
+
+    std::vector<float> samples;
+    if (format == 1 && bits == 16) {
+        samples.resize(pcmBytes / 2);
+        for (size_t i = 0; i < samples.size(); i++) samples[i] = (short)readLE16(pcm + i * 2) / 32768.0f;
+    } else if (format == 1 && bits == 8) {
+        samples.resize(pcmBytes);
+        for (size_t i = 0; i < samples.size(); i++) samples[i] = (pcm[i] - 128) / 128.0f;
+    } else if (format == 3 && bits == 32) {
+        samples.resize(pcmBytes / 4);
+        memcpy(samples.data(), pcm, samples.size() * 4);
+    } else {
+        return false;
+    }
+    convertToEngineFormat(samples, channels, rate, out);
+    return true;
+}
+
+bool decodeAudioFile(const std::string& path, PcmBuffer& out) {
+    std::string ext = path.size() > 4 ? path.substr(path.size() - 4) : "";
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+    if (ext == ".wav") return decodeWav(path, out);
+    if (ext == ".mp3") {
+        std::vector<float> samples;
+        int rate = 0, channels = 0;
+        if (!mp3DecodeFile(path, samples, rate, channels)) return false;
+        convertToEngineFormat(samples, channels, rate, out);
+        return true;
+    }
+    return false;
+}
+
+// =========================================================
+// SINKS
+// =========================================================
+
+bool NullAudioSink::open(int sampleRate, int) {
+    rate = sampleRate;
+    nextDeadline = nowSeconds();
+    return true;
+}
+
+void NullAudioSink::write(const float*, int frames) {
+    nextDeadline += (double)frames / rate;
+    double wait = nextDeadline - nowSeconds();
+    if (wait > 0) std::this_thread::sleep_for(std::chrono::duration<double>(wait));
+    else if (wait < -0.25) nextDeadline = nowSeconds(); // fell far behind (e.g. debugger), don't try to catch up
+}
+
+WavFileAudioSink::WavFileAudioSink(const std::string& p, bool rt) : path(p), realTime(rt) {}
+
+WavFileAudioSink::~WavFileAudioSink() { close(); }
+
+bool WavFileAudioSink::open(int sampleRate, int ch) {
+    file = fopen(path.c_str(), "wb");
+    if (!file) return false;
+    channels = ch;
+    dataBytes = 0;
+    pacer.open(sampleRate, ch);
+
+    unsigned char header[44] = { 0 };
+    memcpy(header, "RIFF", 4); memcpy(header + 8, "WAVEfmt ", 8);
+    header[16] = 16; header[20] = 1; header[22] = (unsigned char)ch;
+    unsigned int byteRate = sampleRate * ch * 2;
+    for (int i = 0; i < 4; i++) { header[24 + i] = (sampleRate >> (8 * i)) & 255; header[28 + i] = (byteRate >> (8 * i)) & 255; }
+    header[32] = (unsigned char)(ch * 2); header[34] = 16;
+    memcpy(header + 36, "data", 4);
+    fwrite(header, 1, 44, file);
+    return true;
+}
+
+void WavFileAudioSink::write(const float* samples, int frames) {
+    if (!file) return;
+    size_t count = (size_t)frames * channels;
+    scratch.resize(count);
+    for (size_t i = 0; i < count; i++) scratch[i] = floatToPcm16(samples[i]);
+    fwrite(scratch.data(), 2, count, file);
+    dataBytes += (unsigned int)(count * 2);
+    if (realTime) pacer.write(samples, frames);
+}
+
+void WavFileAudioSink::close() {
+    if (!file) return;
+    unsigned int riffSize = 36 + dataBytes;
+    unsigned char le[4];
+    for (int i = 0; i < 4; i++) le[i] = (riffSize >> (8 * i)) & 255;
+    fseek(file, 4, SEEK_SET); fwrite(le, 1, 4, file);
+    for (int i = 0; i < 4; i++) le[i] = (dataBytes >> (8 * i)) & 255;
+    fseek(file, 40, SEEK_SET); fwrite(le, 1, 4, file);
+    fclose(file);
+    file = nullptr;
+}
+
+#ifdef _WIN32
+// waveOut device with a small ring of buffers; write() waits for the oldest one to drain.
+class WaveOutAudioSink : public AudioSink {
+public:
+    static const int BUFFER_COUNT = 4;
+
+    bool open(int sampleRate, int ch) override {
+        channels = ch;
+        WAVEFORMATEX fmt = {};
+        fmt.wFormatTag = WAVE_FORMAT_PCM;
+        fmt.nChannels = (WORD)ch;
+        fmt.nSamplesPerSec = sampleRate;
+        fmt.wBitsPerSample = 16;
+        fmt.nBlockAlign = (WORD)(ch * 2);
+        fmt.nAvgBytesPerSec = sampleRate * fmt.nBlockAlign;
+        doneEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+        if (waveOutOpen(&device, WAVE_MAPPER, &fmt, (DWORD_PTR)doneEvent, 0, CALLBACK_EVENT) != MMSYSERR_NOERROR) {
+            CloseHandle(doneEvent); doneEvent = NULL; device = NULL;
+            return false;
+        }
+        for (int i = 0; i < BUFFER_COUNT; i++) {
+            buffers[i].resize((size_t)AudioEngine::BLOCK_FRAMES * ch);
+            headers[i] = WAVEHDR();
+            headers[i].lpData = (LPSTR)buffers[i].data();
+            headers[i].dwBufferLength = (DWORD)(buffers[i].size() * 2);
+            waveOutPrepareHeader(device, &headers[i], sizeof(WAVEHDR));
+            headers[i].dwFlags |= WHDR_DONE; // free for the first write
+        }
+        return true;
+    }
+
+    void write(const float* samples, int frames) override {
+        WAVEHDR& hdr = headers[next];
+        while (!(hdr.dwFlags & WHDR_DONE)) WaitForSingleObject(doneEvent, 50);
+        size_t count = (size_t)frames * channels;
+        if (count > buffers[next].size()) count = buffers[next].size();
+        for (size_t i = 0; i < count; i++) buffers[next][i] = floatToPcm16(samples[i]);
+        hdr.dwBufferLength = (DWORD)(count * 2);
+        hdr.dwFlags &= ~WHDR_DONE;
+        waveOutWrite(device, &hdr, sizeof(WAVEHDR));
+        next = (next + 1) % BUFFER_COUNT;
+    }
+
+    void close() override {
+        if (!device) return;
+        waveOutReset(device);
+        for (int i = 0; i < BUFFER_COUNT; i++) waveOutUnprepareHeader(device, &headers[i], sizeof(WAVEHDR));
+        waveOutClose(device);
+        CloseHandle(doneEvent);
+        device = NULL;
+        doneEvent = NULL;
+    }
+
+    ~WaveOutAudioSink() { close(); }
+
+private:
+    HWAVEOUT device = NULL;
+    HANDLE doneEvent = NULL;
+    WAVEHDR headers[BUFFER_COUNT];
+    std::vector<short> buffers[BUFFER_COUNT];
+    int next = 0;
+    int channels = 2;
+};
+#endif
+
+AudioSink* createDefaultAudioSink() {
+    const char* out = getenv("ATW_AUDIO_OUT");
+    if (out && strcmp(out, "null") == 0) return new NullAudioSink();
+    if (out && strncmp(out, "wav:", 4) == 0) return new WavFileAudioSink(out + 4, true);
+#ifdef _WIN32
+    return new WaveOutAudioSink();
+#else
+    return new NullAudioSink();
+#endif
+}
+
+// =========================================================
+// ENGINE
+// =========================================================
+
+AudioEngine::AudioEngine()
+    : blocksMixed(0), activeVoices(0), droppedCommands(0), queueHead(0), queueTail(0), running(false) {
+    for (int i = 0; i < BUS_COUNT; i++) busGain[i] = 1.0f;
+}
+
+AudioEngine::~AudioEngine() { stop(); }
+
+bool AudioEngine::start(AudioSink* newSink) {
+    stop();
+    sink.reset(newSink);
+    if (!sink || !sink->open(SAMPLE_RATE, CHANNELS)) {
+        // No device: keep the mixer alive on a null sink so callers don't need special cases.
+        sink.reset(new NullAudioSink());
+        sink->open(SAMPLE_RATE, CHANNELS);
+    }
+    mixBuffer.assign((size_t)BLOCK_FRAMES * CHANNELS, 0.0f);
+    streamBuffer.assign((size_t)BLOCK_FRAMES * CHANNELS, 0.0f);
+    running = true;
+    mixerThread = std::thread(&AudioEngine::mixerThreadMain, this);
+    return true;
+}
+
+void AudioEngine::stop() {
+    if (!running) return;
+    running = false;
+    if (mixerThread.joinable()) mixerThread.join();
+    if (sink) sink->close();
+    sink.reset();
+    for (Voice& v : voices) v.pcm = nullptr;
+    for (MusicDeck& d : decks) d = MusicDeck();
+    musicStreams.clear();
+}
+
+int AudioEngine::findSound(const std::string& path) const {
+    auto it = soundIndex.find(path);
+    return it != soundIndex.end() ? it->second : -1;
+}
+
+int AudioEngine::loadSound(const std::string& path) {
+    int existing = findSound(path);
+    if (existing >= 0) return existing;
+    PcmBuffer pcm;
+    if (!decodeAudioFile(path, pcm)) return -1;
+    sounds.push_back(std::move(pcm));
+    int id = (int)sounds.size() - 1;
+    soundIndex[path] = id;
+    return id;
+}
+
+bool AudioEngine::pushCommand(const Command& cmd) {
+    unsigned int tail = queueTail.load(std::memory_order_relaxed);
+    if (tail - queueHead.load(std::memory_order_acquire) >= QUEUE_SIZE) {
+        droppedCommands++;
+        return false;
+    }
+    queue[tail % QUEUE_SIZE] = cmd;
+    queueTail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+bool AudioEngine::play(int soundID, int bus, float gain, bool loop) {
+    if (soundID < 0 || soundID >= (int)sounds.size() || bus < 0 || bus >= BUS_COUNT) return false;
+    Command cmd = { CMD_PLAY, &sounds[soundID], bus, gain, loop };
+    return pushCommand(cmd);
+}
+
+void AudioEngine::stopBus(int bus) {
+    Command cmd = { CMD_STOP_BUS, nullptr, bus, 0.0f, false };
+    pushCommand(cmd);
+}
+
+void AudioEngine::setBusGain(int bus, float gain) {
+    Command cmd = { CMD_BUS_GAIN, nullptr, bus, gain, false };
+    pushCommand(cmd);
+}
+
+bool AudioEngine::playMusic(const std::string& path, float fadeSeconds, bool loop) {
+    collectRetiredStreams();
+    AudioStreamDecoder* decoder = openAudioStream(path);
+    if (!decoder) return false;
+    musicStreams.emplace_back(new MusicStream(decoder, loop));
+    Command cmd = { CMD_MUSIC_PLAY, nullptr, BUS_MUSIC, 1.0f, loop, musicStreams.back().get(), (int)(fadeSeconds * SAMPLE_RATE) };
+    if (!pushCommand(cmd)) {
+        musicStreams.pop_back();
+        return false;
+    }
+    return true;
+}
+
+void AudioEngine::stopMusic(float fadeSeconds) {
+    collectRetiredStreams();
+    Command cmd = { CMD_MUSIC_STOP, nullptr, BUS_MUSIC, 0.0f, false, nullptr, (int)(fadeSeconds * SAMPLE_RATE) };
+    pushCommand(cmd);
+}
+
+void AudioEngine::collectRetiredStreams() {
+    musicStreams.erase(std::remove_if(musicStreams.begin(), musicStreams.end(),
+        [](const std::unique_ptr<MusicStream>& s) { return s->retired.load(); }), musicStreams.end());
+}
+
+void AudioEngine::retireDeck(MusicDeck& deck) {
+    if (deck.stream) deck.stream->retired = true;
+    deck = MusicDeck();
+}
+
+// Ramps a deck from its current gain to 'newTarget' over 'fadeFrames' samples.
+static void startFade(float& gain, float& target, float& step, float newTarget, int fadeFrames) {
+    target = newTarget;
+    if (fadeFrames <= 0) { gain = newTarget; step = 0.0f; }
+    else step = (newTarget - gain) / fadeFrames;
+}
+
+void AudioEngine::drainCommands() {
+    unsigned int head = queueHead.load(std::memory_order_relaxed);
+    unsigned int tail = queueTail.load(std::memory_order_acquire);
+    for (; head != tail; head++) {
+        const Command& cmd = queue[head % QUEUE_SIZE];
+        if (cmd.type == CMD_PLAY) {
+            // Take a free voice; if all are busy, steal the one closest to finishing.
+            Voice* slot = nullptr;
+            int bestRemaining = 0x7FFFFFFF;
+            for (Voice& v : voices) {
+                if (!v.pcm) { slot = &v; break; }
+                int remaining = v.loop ? 0x7FFFFFFE : v.pcm->frames - v.position;
+                if (remaining < bestRemaining) { bestRemaining = remaining; slot = &v; }
+            }
+            slot->pcm = cmd.pcm;
+            slot->position = 0;
+            slot->bus = cmd.bus;
+            slot->gain = cmd.gain;
+            slot->loop = cmd.loop;
+        } else if (cmd.type == CMD_STOP_BUS) {
+            for (Voice& v : voices)
+                if (v.pcm && v.bus == cmd.bus) v.pcm = nullptr;
+            if (cmd.bus == BUS_MUSIC)
+                for (MusicDeck& d : decks) retireDeck(d);
+        } else if (cmd.type == CMD_MUSIC_PLAY || cmd.type == CMD_MUSIC_STOP) {
+            for (MusicDeck& d : decks)
+                if (d.stream) startFade(d.gain, d.target, d.step, 0.0f, cmd.fadeFrames);
+            if (cmd.type == CMD_MUSIC_STOP) continue;
+
+            MusicDeck* slot = nullptr;
+            for (MusicDeck& d : decks)
+                if (!d.stream) { slot = &d; break; }
+            if (!slot) {
+                // Too many overlapping fades: drop the quietest one.
+                slot = &decks[0];
+                for (MusicDeck& d : decks)
+                    if (d.gain < slot->gain) slot = &d;
+                retireDeck(*slot);
+            }
+            slot->stream = cmd.stream;
+            slot->gain = 0.0f;
+            startFade(slot->gain, slot->target, slot->step, 1.0f, cmd.fadeFrames);
+        } else if (cmd.type == CMD_BUS_GAIN) {
+            if (cmd.bus >= 0 && cmd.bus < BUS_COUNT) busGain[cmd.bus] = cmd.gain;
+        }
+    }
+    queueHead.store(head, std::memory_order_release);
+}
+
+void AudioEngine::mixBlock(float* out, int frames) {
+    memset(out, 0, sizeof(float) * frames * CHANNELS);
+    unsigned int active = 0;
+    for (Voice& v : voices) {
+        if (!v.pcm) continue;
+        active++;
+        float gain = v.gain * busGain[v.bus];
+        int written = 0;
+        while (written < frames && v.pcm) {
+            int count = std::min(frames - written, v.pcm->frames - v.position);
+            const float* src = v.pcm->samples.data() + (size_t)v.position * CHANNELS;
+            float* dst = out + (size_t)written * CHANNELS;
+            dspMixGain(dst, src, count * CHANNELS, gain);
+            written += count;
+            v.position += count;
+            if (v.position >= v.pcm->frames) {
+                if (v.loop && v.pcm->frames > 0) v.position = 0;
+                else v.pcm = nullptr;
+            }
+        }
+    }
+
+    for (MusicDeck& d : decks) {
+        if (!d.stream) continue;
+        active++;
+        int got = d.stream->readFrames(streamBuffer.data(), frames);
+        float bus = busGain[BUS_MUSIC];
+        // Frames [0, rampFrames) are still on the ramp; from there on the deck sits at
+        // its target. The ramp advances for every output frame, even ones the decoder
+        // couldn't supply, so fade timing stays exact.
+        int rampFrames = 0;
+        if (d.step != 0.0f) rampFrames = std::max(0, (int)std::ceil((d.target - d.gain) / d.step));
+        int ramped = std::min(rampFrames, frames);
+        dspMixRampStereo(out, streamBuffer.data(), std::min(ramped, got), d.gain * bus, d.step * bus);
+        if (rampFrames <= frames) {
+            if (d.step != 0.0f) { d.gain = d.target; d.step = 0.0f; }
+            if (got > ramped) dspMixGain(out + ramped * 2, streamBuffer.data() + ramped * 2, (got - ramped) * 2, d.gain * bus);
+        } else {
+            d.gain += d.step * frames;
+        }
+        if ((d.target == 0.0f && d.gain == 0.0f) || d.stream->isFinished()) retireDeck(d);
+    }
+    activeVoices = active;
+}
+
+void AudioEngine::mixerThreadMain() {
+    ATW_PROFILE_THREAD("Audio mixer");
+    while (running) {
+        {
+            ATW_PROFILE_ZONE("Mix block");
+            drainCommands();
+            mixBlock(mixBuffer.data(), BLOCK_FRAMES);
+            dspSoftClip(mixBuffer.data(), BLOCK_FRAMES * CHANNELS);
+        }
+        sink->write(mixBuffer.data(), BLOCK_FRAMES);
+        blocksMixed++;
+    }
+}
@@ -0,0 +1,47 @@
+#include "FrameScheduler.h"
+#include <glfw3.h>
+#include <algorithm>
+
+FrameScheduler::FrameScheduler()
+    : enabled(false), settleFrames(SETTLE_FRAMES), settleUntil(0.0), deadline(0.0), awake(true), frames(0), idle(0.0) {}
+
+void FrameScheduler::enable(bool on) {
+    enabled = on;
+    settleFrames = SETTLE_FRAMES;
+}
+
+void FrameScheduler::waitForNextFrame() {
+    double now = glfwGetTime();
+    bool busy = !enabled || awake || settleFrames > 0 || now < settleUntil;
+    if (!busy) {
+        double timeout = deadline > 0.0 ? std::min(deadline - now, MAX_SLEEP) : MAX_SLEEP;
+        if (timeout > 0.0) {
+            glfwWaitEventsTimeout(timeout);
+            idle += glfwGetTime() - now;
+        }
+    }
+
+    // Start collecting this frame's requests
+    if (settleFrames > 0) settleFrames--;
+    deadline = 0.0;
+    awake = false;
+    frames++;
+}
+
+void FrameScheduler::inputReceived(double time) {
+    settleFrames = SETTLE_FRAMES;
+    settleUntil = std::max(settleUntil, time + SETTLE_TIME);
+}
+
+void FrameScheduler::markDirty() {
+    settleFrames = SETTLE_FRAMES;
+}
+
+void FrameScheduler::animateIn(double seconds) {
+    double t = glfwGetTime() + std::max(0.0, seconds);
+    if (deadline == 0.0 || t < deadline) deadline = t;
+}
+
+void FrameScheduler::keepAwake() {
+    awake = true;
+}
@@ -1,12 +1,17 @@
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 #include "GameEngine.h"
+#include "PngStream.h"
+#include "Profiler.h"
+#include "imgui_impl_opengl3.h"
 #include <iostream>
 #include <algorithm>
 #include <vector>
 #include <fstream> 
 #include <glfw3.h> 
+#ifdef _WIN32
 #include <windows.h> 
+#endif
 
 #ifndef GL_CLAMP_TO_EDGE
 #define GL_CLAMP_TO_EDGE 0x812F
@@ -19,6 +24,7 @@
 unsigned int GameEngine::getNodeTexture(std::string path) {
     if (path.empty()) return 0;
     if (textureCache.find(path) != textureCache.end()) return textureCache[path];
+    ATW_PROFILE_ZONE("Load node texture");
     unsigned int texID = loadTextureFromFile(path.c_str());
     textureCache[path] = texID;
     return texID;
@@ -27,6 +33,7 @@ unsigned int GameEngine::getNodeTexture(std::string path) {
 unsigned int GameEngine::getGeneralTexture(std::string filename) {
      if (filename.empty()) return 0;
      if (textureCache.find(filename) != textureCache.end()) return textureCache[filename];
+     ATW_PROFILE_ZONE("Load texture");
      unsigned int texID = loadTextureFromFile(filename.c_str());
      textureCache[filename] = texID;
      return texID;
@@ -44,7 +51,16 @@ unsigned int GameEngine::loadTextureFromFile(const char* filename) {
         if (check.good()) { validPath = path; break; }
     }
     if (validPath.empty()) return 0;
+    if (headless) return (unsigned int)textureCache.size() + 1;
+
+    // Scene PNGs stream straight into the texture; anything the streaming decoder
+    // doesn't handle (interlaced, 16-bit, not a PNG) goes through stbi_load below.
     int width, height, nrChannels;
+    unsigned int streamedID = streamTextureFromPng(validPath, width, height);
+    if (streamedID) {
+        textureSizeCache[filename] = {width, height};
+        return streamedID;
+    }
     unsigned char* data = stbi_load(validPath.c_str(), &width, &height, &nrChannels, 0);
     if (!data) return 0; 
     textureSizeCache[filename] = {width, height};
@@ -55,16 +71,80 @@ unsigned int GameEngine::loadTextureFromFile(const char* filename) {
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    if (nrChannels == 3) glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
-    else if (nrChannels == 4) glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+    if (nrChannels == 3 || nrChannels == 4) {
+        GLenum format = (nrChannels == 4) ? GL_RGBA : GL_RGB;
+        glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, nullptr);
+        ImGui_ImplOpenGL3_UploadTextureRegion((ImTextureID)(intptr_t)textureID, 0, 0, width, height, nrChannels, data);
+    }
     stbi_image_free(data);
     return textureID;
 }
 
+bool GameEngine::isTextureReady(unsigned int textureID) const {
+    return headless || !ImGui_ImplOpenGL3_IsTextureUploadPending((ImTextureID)(intptr_t)textureID);
+}
+
+// stbi_io_callbacks over a plain FILE*, so the decoder pulls from disk as it inflates
+static int pngFileRead(void* user, char* data, int size) { return (int)fread(data, 1, size, (FILE*)user); }
+static void pngFileSkip(void* user, int n) { fseek((FILE*)user, n, SEEK_CUR); }
+static int pngFileEof(void* user) { return feof((FILE*)user); }
+
+unsigned int GameEngine::streamTextureFromPng(const std::string& path, int& width, int& height) {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) return 0;
+
+    // Rows are batched into small strips so the driver sees a handful of uploads
+    // instead of one per scanline, while memory stays at a few rows per decode.
+    // Strips go through the backend's upload ring and may land a frame or two later;
+    // ImGui_ImplOpenGL3_IsTextureUploadPending() tells when the texture is complete.
+    const int STRIP_ROWS = 16;
+    std::vector<unsigned char> strip;
+    int channels = 0, stripStart = 0, stripRows = 0;
+    unsigned int textureID = 0;
+
+    auto flushStrip = [&]() {
+        ImGui_ImplOpenGL3_UploadTextureRegion((ImTextureID)(intptr_t)textureID, 0, stripStart, width, stripRows, channels, strip.data());
+        stripStart += stripRows;
+        stripRows = 0;
+    };
+
+    stbi_io_callbacks callbacks = { pngFileRead, pngFileSkip, pngFileEof };
+    PngStreamDecoder decoder;
+    bool ok = decoder.decode(callbacks, file,
+        [&](int w, int h, int c) {
+            width = w; height = h; channels = c;
+            GLenum format = (channels == 4) ? GL_RGBA : GL_RGB;
+            glGenTextures(1, &textureID);
+            glBindTexture(GL_TEXTURE_2D, textureID);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, nullptr);
+            strip.resize((size_t)width * channels * STRIP_ROWS);
+            return true;
+        },
+        [&](int, const unsigned char* row) {
+            size_t rowBytes = (size_t)width * channels;
+            memcpy(strip.data() + rowBytes * stripRows, row, rowBytes);
+            if (++stripRows == STRIP_ROWS) flushStrip();
+        });
+    if (ok && stripRows > 0) flushStrip();
+    fclose(file);
+
+    if (!ok && textureID) {
+        ImGui_ImplOpenGL3_CancelTextureUploads((ImTextureID)(intptr_t)textureID);
+        glDeleteTextures(1, &textureID);
+        textureID = 0;
+    }
+    return textureID;
+}
+
 // --- AUDIO SYSTEM ---
 
 void GameEngine::toggleMute() {
     isMuted = !isMuted;
+    markStateChanged();
     if (isMuted) {
         stopSound("bgm"); 
     } else {
@@ -73,30 +153,95 @@ void GameEngine::toggleMute() {
     }
 }
 
-void GameEngine::playSound(std::string filename, std::string alias, bool loop) {
-    std::string stopCmd = "close " + alias; mciSendString(stopCmd.c_str(), NULL, 0, NULL);
+static const char* SFX_FILES[] = {
+    "howl_sfx.mp3", "fight_sfx.mp3", "wind_sfx.mp3", "bear_sfx.mp3", "ice_sfx.mp3", "snake_sfx.mp3"
+};
+
+void GameEngine::initAudio() {
+    if (headless || audio.isRunning()) return;
+    audio.start(createDefaultAudioSink());
+    // Decode every SFX once up front so triggers in makeChoice only queue a command.
+    for (const char* name : SFX_FILES) soundIDs[name] = audio.loadSound(resolveSoundPath(name));
+}
+
+void GameEngine::shutdownAudio() {
+    audio.stop();
+    for (auto& entry : mciAliasOpen) {
+        if (entry.second) stopSound(entry.first);
+    }
+}
+
+std::string GameEngine::resolveSoundPath(const std::string& filename) {
     std::string path = "Sounds/" + filename;
-    std::ifstream check(path); if (!check.good()) path = "Assets/Sounds/" + filename; 
-    std::string openCmd = "open \"" + path + "\" type mpegvideo alias " + alias;
+    std::ifstream check(path);
+    if (!check.good()) path = "Assets/Sounds/" + filename;
+    return path;
+}
+
+void GameEngine::playSound(const std::string& filename, const std::string& alias, bool loop) {
+    if (headless) return;
+    int bus = (alias == "bgm") ? BUS_MUSIC : BUS_SFX;
+    auto cached = soundIDs.find(filename);
+    int soundID = (cached != soundIDs.end()) ? cached->second : (soundIDs[filename] = audio.loadSound(resolveSoundPath(filename)));
+    if (soundID >= 0) {
+        audio.stopBus(bus);
+        audio.play(soundID, bus, 1.0f, loop);
+        return;
+    }
+
+    // Anything the in-process decoders reject still goes through MCI.
+    playSoundMci(filename, alias, loop);
+}
+
+void GameEngine::playSoundMci(const std::string& filename, const std::string& alias, bool loop) {
+#ifdef _WIN32
+    std::string stopCmd = "close " + alias; mciSendString(stopCmd.c_str(), NULL, 0, NULL);
+    std::string openCmd = "open \"" + resolveSoundPath(filename) + "\" type mpegvideo alias " + alias;
     mciSendString(openCmd.c_str(), NULL, 0, NULL);
     std::string playCmd = "play " + alias;
     if (loop) playCmd += " repeat";
     mciSendString(playCmd.c_str(), NULL, 0, NULL);
+    mciAliasOpen[alias] = true;
+#else
+    (void)filename; (void)alias; (void)loop;
+#endif
+}
+
+void GameEngine::stopSound(const std::string& alias) {
+    audio.stopBus(alias == "bgm" ? BUS_MUSIC : BUS_SFX);
+    closeMciAlias(alias);
 }
 
-void GameEngine::stopSound(std::string alias) {
-    std::string cmd = "close " + alias; mciSendString(cmd.c_str(), NULL, 0, NULL);
+void GameEngine::closeMciAlias(const std::string& alias) {
+    auto it = mciAliasOpen.find(alias);
+    if (it != mciAliasOpen.end() && it->second) {
+#ifdef _WIN32
+        std::string cmd = "close " + alias; mciSendString(cmd.c_str(), NULL, 0, NULL);
+#endif
+        it->second = false;
+    }
 }
 
+static const float MUSIC_CROSSFADE_SECONDS = 1.5f;
+
 void GameEngine::playBackgroundMusic(std::string trackName) {
-    if (isMuted) return; 
+    if (isMuted || headless) return; 
     if (currentMusicAlias == trackName) return; 
-    if (!currentMusicAlias.empty()) stopSound("bgm");
     currentMusicAlias = trackName;
-    if (!trackName.empty()) playSound(trackName, "bgm", true);
+    if (trackName.empty()) { stopSound("bgm"); return; }
+
+    // Music is streamed from disk (never decoded whole) and crossfades out of the
+    // previous track; only the MCI fallback needs a hard stop first.
+    if (audio.playMusic(resolveSoundPath(trackName), MUSIC_CROSSFADE_SECONDS)) {
+        closeMciAlias("bgm");
+        return;
+    }
+    stopSound("bgm");
+    playSoundMci(trackName, "bgm", true);
 }
 
 void GameEngine::updateMusicSystem() {
+    ATW_PROFILE_ZONE("updateMusicSystem");
     if (isMuted) return;
 
     std::string desiredTrack = "";
@@ -124,24 +269,43 @@ void GameEngine::updateMusicSystem() {
 // TYPEWRITER
 // =========================================================
 
+void GameEngine::startTypewriter(const std::string& text) {
+    targetText = text;
+    textRevealed = 0;
+    textFinished = false;
+    textVersion++;
+}
+
 void GameEngine::updateTypewriter(float deltaTime) {
+    ATW_PROFILE_ZONE("updateTypewriter");
     if (textFinished) return;
     textTimer += deltaTime;
-    if (textTimer > 0.02f) { 
-        textTimer = 0.0f;
-        if (textCharIndex < targetText.length()) {
-            textCharIndex++;
-            currentDisplayedText = targetText.substr(0, textCharIndex);
+    // One character per TYPEWRITER_CHAR_TIME however long the step was; the remainder carries over
+    if (textTimer >= TYPEWRITER_CHAR_TIME) { 
+        int chars = (int)(textTimer / TYPEWRITER_CHAR_TIME);
+        textTimer -= chars * TYPEWRITER_CHAR_TIME;
+        if (textRevealed < targetText.size()) {
+            // Characters, not bytes: "—" is three bytes and appears whole
+            for (int i = 0; i < chars && textRevealed < targetText.size(); i++) {
+                textRevealed++;
+                while (textRevealed < targetText.size() && ((unsigned char)targetText[textRevealed] & 0xC0) == 0x80) textRevealed++;
+            }
         } else {
             textFinished = true;
         }
+        uiDirty = true;
     }
 }
 
 void GameEngine::skipTypewriter() {
-    textCharIndex = targetText.length();
-    currentDisplayedText = targetText;
+    textRevealed = targetText.size();
     textFinished = true;
+    uiDirty = true;
+}
+
+float GameEngine::typewriterTimeToNextChar() const {
+    if (textFinished) return -1.0f;
+    return std::max(0.0f, TYPEWRITER_CHAR_TIME - textTimer);
 }
 
 // =========================================================
@@ -149,6 +313,7 @@ void GameEngine::skipTypewriter() {
 // =========================================================
 
 void GameEngine::toggleMap() {
+    markStateChanged();
     if (currentState == STATE_GAMEPLAY) currentState = STATE_MAP;
     else if (currentState == STATE_MAP) currentState = STATE_GAMEPLAY;
 }
@@ -168,6 +333,7 @@ void GameEngine::undoLastAction() {
     if (undoStack.empty()) { gameLog.push_back(">> Cannot Undo"); return; }
     GameStateData state = undoStack.back();
     undoStack.pop_back();
+    markStateChanged();
     if (storyMap.count(state.currentNodeID)) currentNode = storyMap[state.currentNodeID];
     returnToNodeID = state.returnToNodeID;
     currentStats = state.stats;
@@ -175,16 +341,21 @@ void GameEngine::undoLastAction() {
     inventory.clear();
     for (const auto& item : state.inventorySnapshot) inventory.addItem(item);
     
-    targetText = currentNode->text; textCharIndex = 0; currentDisplayedText = ""; textFinished = false;
+    startTypewriter(currentNode->text);
     gameOver = false; gameWon = false;
     updateMusicSystem(); 
 }
 
 void GameEngine::saveGameToFile(std::string filename) {
+    ATW_PROFILE_ZONE("saveGameToFile");
     if (filename.empty()) filename = "savegame";
     if (filename.find(".txt") == std::string::npos) filename += ".txt";
     std::ofstream file(filename);
     if (!file.is_open()) return;
+    // Metadata line for the Load screen's save catalog (see SaveCatalog.h); loaders skip '#' lines
+    file << "#ATW 1 day=" << currentStats.dayCount << " node=" << (currentNode ? currentNode->id : 1)
+         << " health=" << currentStats.health << " energy=" << currentStats.energy << " hunger=" << currentStats.hunger
+         << " reputation=" << currentStats.reputation << " time=" << (long long)time(nullptr) << "\n";
     file << (currentNode ? currentNode->id : 1) << "\n";
     file << currentStats.health << " " << currentStats.hunger << " " << currentStats.energy << " " << currentStats.reputation << " " << currentStats.dayCount << "\n";
     file << currentStats.eventHappened << "\n"; 
@@ -198,8 +369,11 @@ void GameEngine::saveGameToFile(std::string filename) {
 }
 
 void GameEngine::loadGameFromFile(std::string filename) {
+    ATW_PROFILE_ZONE("loadGameFromFile");
     std::ifstream file(filename);
     if (!file.is_open()) { gameLog.push_back(">> SAVE FILE NOT FOUND"); return; }
+    markStateChanged();
+    while (file.peek() == '#') { std::string skip; std::getline(file, skip); }
     int nodeID; file >> nodeID;
     if (storyMap.count(nodeID)) currentNode = storyMap[nodeID];
     file >> currentStats.health >> currentStats.hunger >> currentStats.energy >> currentStats.reputation >> currentStats.dayCount;
@@ -213,7 +387,7 @@ void GameEngine::loadGameFromFile(std::string filename) {
         inventory.addItem(Item(name, (ItemType)type, val, qty));
     }
     file.close();
-    targetText = currentNode->text; textCharIndex = 0; currentDisplayedText = ""; textFinished = false;
+    startTypewriter(currentNode->text);
     gameLog.push_back(">> GAME LOADED");
     updateMusicSystem(); 
 }
@@ -243,6 +417,7 @@ bool GameEngine::performGlobalRest() {
         return false; 
     }
     currentState = STATE_REST; 
+    markStateChanged();
     saveState();
     currentStats.lastRestLevel = currentNode->id;
     currentStats.energy = std::min(100, currentStats.energy + 40);
@@ -260,6 +435,7 @@ bool GameEngine::performGlobalScavenge() {
     if (currentStats.energy <= 10) { gameLog.push_back("Too tired to scavenge."); return false; }
     
     currentState = STATE_SCAVENGE; 
+    markStateChanged();
     saveState();
     currentStats.lastScavengeLevel = currentNode->id;
     currentStats.energy -= 10;
@@ -289,6 +465,7 @@ bool GameEngine::performGlobalScavenge() {
 void GameEngine::useItem(std::string itemName) {
     if (itemName == "Map") { toggleMap(); return; }
     if (inventory.removeOne(itemName)) {
+        markStateChanged();
         if (itemName == "Meat") {
             currentStats.hunger = std::max(0, currentStats.hunger - 30);
             gameLog.push_back("Ate Meat (-30 Hunger).");
@@ -306,7 +483,9 @@ void GameEngine::useItem(std::string itemName) {
 // =========================================================
 
 void GameEngine::makeChoice(int choiceIndex) {
+    ATW_PROFILE_ZONE("makeChoice");
     if (gameOver || gameWon || !currentNode) return;
+    markStateChanged();
     saveState();
     
     currentStats.hunger += 5; 
@@ -338,7 +517,7 @@ void GameEngine::makeChoice(int choiceIndex) {
             returnToNodeID = -1; 
             gameLog.push_back("You continue on your journey...");
         } else { currentNode = storyMap[1]; }
-        targetText = currentNode->text; textCharIndex = 0; currentDisplayedText = ""; textFinished = false;
+        startTypewriter(currentNode->text);
         updateMusicSystem();
         return; 
     }
@@ -388,7 +567,7 @@ void GameEngine::makeChoice(int choiceIndex) {
              gameLog.push_back(">> GAINED: Meat & Herbs");
         }
 
-        targetText = currentNode->text; textCharIndex = 0; currentDisplayedText = ""; textFinished = false;
+        startTypewriter(currentNode->text);
     }
     
     // SFX
@@ -432,9 +611,32 @@ void GameEngine::cleanup() {
     for(auto const& [key, val] : storyMap) delete val; storyMap.clear(); 
 }
 
+unsigned int GameEngine::stateChecksum() const {
+    // FNV-1a over everything a replayed session can change
+    unsigned int h = 2166136261u;
+    auto mix = [&h](int v) { for (int i = 0; i < 4; i++) { h = (h ^ ((unsigned int)v & 0xFF)) * 16777619u; v >>= 8; } };
+    auto mixString = [&h](const std::string& s) { for (unsigned char c : s) h = (h ^ c) * 16777619u; h = (h ^ 0xFF) * 16777619u; };
+    const WolfStats& s = currentStats;
+    int stats[] = { s.health, s.energy, s.hunger, s.reputation, s.dayCount, s.packSize, s.lastRestLevel, s.lastScavengeLevel,
+                    s.crossedRiverIce, s.hasPack, s.blizzardTriggered, s.bearTriggered, s.eventHappened };
+    for (int v : stats) mix(v);
+    mix((int)currentState);
+    mix(currentNode ? currentNode->id : -1);
+    mix(gameOver);
+    mix(gameWon);
+    for (const InventoryNode* n = inventory.first(); n; n = n->next) {
+        mixString(n->data.name);
+        mix(n->data.quantity);
+    }
+    mix((int)gameLog.size());
+    mix((int)undoStack.size());
+    return h;
+}
+
 void GameEngine::initGame() {
     cleanup();
-    srand(time(0));
+    initAudio();
+    srand(rngSeed ? rngSeed : (unsigned int)time(0));
     
     currentStats = WolfStats(); 
     currentStats.lastRestLevel = -10; 
@@ -452,6 +654,7 @@ void GameEngine::initGame() {
     gameLog.push_back("--- NEW GAME STARTED ---");
     gameOver = false;
     gameWon = false;
+    markStateChanged();
     
     // Set State to MENU initially
     currentState = STATE_MENU; 
@@ -716,6 +919,6 @@ void GameEngine::initGame() {
     connect(9022, "Catch your breath...", -99);
     
     currentNode = storyMap[1];
-    targetText = currentNode->text;
+    startTypewriter(currentNode->text);
     updateMusicSystem();
 }
\ No newline at end of file
@@ -0,0 +1,613 @@
+#include "GameUI.h"
+#include "GameEngine.h"
+#include "SaveCatalog.h"
+#include "AllocTracker.h"
+#include "Profiler.h"
+#include "imgui.h"
+#include <ctime>
+#include <algorithm>
+
+void setupImGuiStyle() {
+    ImGuiStyle& style = ImGui::GetStyle();
+    style.Colors[ImGuiCol_WindowBg] = ImVec4(0.1f, 0.1f, 0.15f, 0.95f);
+    style.Colors[ImGuiCol_Text] = ImVec4(0.9f, 0.9f, 0.9f, 1.0f);
+    style.Colors[ImGuiCol_Button] = ImVec4(0.3f, 0.3f, 0.4f, 1.0f);
+    style.FrameRounding = 5.0f;
+}
+
+static void DrawBackgroundCover(unsigned int texID, int screenW, int screenH) {
+    if (texID == 0) {
+        ImGui::GetBackgroundDrawList()->AddRectFilled(ImVec2(0,0), ImVec2((float)screenW, (float)screenH), IM_COL32(20,20,20,255));
+        return;
+    }
+    ImTextureID my_tex_id = (ImTextureID)(intptr_t)texID;
+    
+    // Maintain Aspect Ratio
+    float imgW = 1920.0f; 
+    float imgH = 1080.0f;
+    float screenAspect = (float)screenW / (float)screenH;
+    float imgAspect = imgW / imgH;
+    float drawW, drawH;
+
+    if (screenAspect > imgAspect) {
+        drawW = (float)screenW;
+        drawH = drawW / imgAspect;
+    } else {
+        drawH = (float)screenH;
+        drawW = drawH * imgAspect;
+    }
+
+    float x = (screenW - drawW) * 0.5f;
+    float y = (screenH - drawH) * 0.5f;
+
+    ImGui::GetBackgroundDrawList()->AddImage(my_tex_id, 
+        ImVec2(x, y), 
+        ImVec2(x + drawW, y + drawH), 
+        ImVec2(0, 0), ImVec2(1, 1), 
+        IM_COL32(255, 255, 255, 255));
+}
+
+GameUI::GameUI(GameEngine& engine, SaveCatalog& saveCatalog)
+    : showInventory(false), showMap(false), showSavePopup(false), showLoadPopup(false),
+      saveFileNameBuffer("savegame"), statusTimer(0.0f),
+      engine(engine), saveCatalog(saveCatalog), titleFont(nullptr), bodyFont(nullptr), displayW(0), displayH(0), stepSeconds(0.0f), stepAlpha(0.0f),
+      menuBg(0), iconMap(0), overlayMap(0), iconInventory(0), iconScavenge(0), iconRest(0), iconUndo(0), iconSave(0), iconMute(0),
+      iconHealth(0), iconEnergy(0), iconHunger(0), iconRep(0),
+      cachedTextureID(0), slideIndex(0), slideTimer(0.0f), lastNodeID(-1) {
+    requests.clear();
+}
+
+void GameUI::init(ImFont* title, ImFont* body) {
+    titleFont = title;
+    bodyFont = body;
+
+    menuBg = engine.getGeneralTexture("start_screen.png");
+
+    // UI Icons
+    iconMap = engine.getGeneralTexture("map_icon.png");
+    overlayMap = engine.getGeneralTexture("map.png");
+    iconInventory = engine.getGeneralTexture("inventory.png");
+    iconScavenge = engine.getGeneralTexture("scavenge.png");
+    iconRest = engine.getGeneralTexture("rest.png");
+    iconUndo = engine.getGeneralTexture("undo.png");
+    iconSave = engine.getGeneralTexture("save.png");
+    iconMute = engine.getGeneralTexture("mute.png");
+
+    // Stat Icons
+    iconHealth = engine.getGeneralTexture("health.png");
+    iconEnergy = engine.getGeneralTexture("energy.png");
+    iconHunger = engine.getGeneralTexture("hunger.png");
+    iconRep = engine.getGeneralTexture("reputation.png");
+}
+
+bool GameUI::update(float step) {
+    stepSeconds = step;
+    bool changed = false;
+    engine.updateTypewriter(step);
+
+    // Status Message Timer
+    if (!statusMessage.empty()) {
+        statusTimer += step;
+        if (statusTimer > STATUS_TIME) { statusMessage = ""; statusTimer = 0; changed = true; }
+    }
+
+    // Slideshow Timer (drawGameplay() restarts it when the node changes)
+    bool inGameplay = engine.currentState == STATE_GAMEPLAY || engine.currentState == STATE_OUTRO;
+    if (inGameplay && engine.currentNode && engine.currentNode->id == lastNodeID && !engine.currentNode->slideshow.empty()) {
+        slideTimer += step;
+        if (slideTimer > SLIDE_TIME) {
+            slideTimer = 0.0f;
+            slideIndex = (slideIndex + 1) % engine.currentNode->slideshow.size();
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+void GameUI::drawFrame(int width, int height, float alpha) {
+    displayW = width;
+    displayH = height;
+    stepAlpha = alpha;
+    requests.clear();
+
+    // Deadlines are in simulated time; the main loop turns them into real time with SimClock::timeUntil()
+    if (!statusMessage.empty()) {
+        // Fades out over its last STATUS_FADE seconds, drawn at the time between steps
+        if (statusTimer + stepAlpha * stepSeconds > STATUS_TIME - STATUS_FADE) requests.keepAwake = true;
+        else requests.animate(STATUS_TIME - STATUS_FADE - statusTimer);
+    }
+
+    if (engine.currentState == STATE_MENU) drawMenu();
+    else if (engine.currentState == STATE_INTRO) drawIntro();
+    else if (engine.currentState == STATE_GAMEPLAY || engine.currentState == STATE_OUTRO) drawGameplay();
+    else if (engine.currentState == STATE_REST || engine.currentState == STATE_SCAVENGE) drawRestScavenge();
+
+    drawSavePopup();
+    drawLoadPopup();
+}
+
+// ==========================================
+// 1. MENU STATE
+// ==========================================
+void GameUI::drawMenu() {
+    ATW_PROFILE_ZONE("Menu");
+    DrawBackgroundCover(menuBg, displayW, displayH);
+
+    ImGui::SetNextWindowPos(ImVec2(displayW/2 - 150, displayH/2 - 100));
+    ImGui::SetNextWindowSize(ImVec2(300, 250));
+    ImGui::PushStyleColor(ImGuiCol_WindowBg, ImVec4(0, 0, 0, 0.8f));
+    
+    if (ImGui::Begin("MainMenu", nullptr, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize)) {
+        ImGui::PushFont(titleFont);
+        float textW = ImGui::CalcTextSize("ALEX THE WOLF").x;
+        ImGui::SetCursorPosX((300 - textW) * 0.5f);
+        ImGui::Text("ALEX THE WOLF");
+        ImGui::PopFont();
+        ImGui::Spacing(); ImGui::Separator(); ImGui::Spacing();
+
+        if (ImGui::Button("NEW GAME", ImVec2(280, 50))) {
+            engine.initGame(); 
+            engine.currentState = STATE_INTRO;
+            
+            // Setup Intro Text
+            engine.introLineIndex = 0;
+            if (!engine.introLines.empty()) engine.startTypewriter(engine.introLines[0]);
+            engine.updateMusicSystem();
+        }
+        ImGui::Spacing();
+        
+        if (ImGui::Button("LOAD GAME", ImVec2(280, 50))) {
+            showLoadPopup = true; 
+        }
+        ImGui::Spacing();
+
+        if (ImGui::Button("QUIT", ImVec2(280, 50))) {
+            requests.quit = true;
+        }
+    }
+    ImGui::End();
+    ImGui::PopStyleColor();
+}
+
+// ==========================================
+// 2. INTRO STORY (With Typewriter)
+// ==========================================
+void GameUI::drawIntro() {
+    ATW_PROFILE_ZONE("Intro");
+    DrawBackgroundCover(menuBg, displayW, displayH);
+    
+    ImGui::SetNextWindowPos(ImVec2(50, displayH - 250));
+    ImGui::SetNextWindowSize(ImVec2(displayW - 100, 200));
+    ImGui::PushStyleColor(ImGuiCol_WindowBg, ImVec4(0, 0, 0, 0.9f));
+    
+    if (ImGui::Begin("IntroBox", nullptr, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize)) {
+        
+        ImGui::PushFont(bodyFont);
+        typewriter.draw(engine.targetText, engine.textVersion, engine.textRevealed);
+        ImGui::PopFont();
+
+        ImGui::SetCursorPosY(150);
+        
+        // Next Button
+        if (ImGui::Button("NEXT >>", ImVec2(100, 30))) {
+            if (!engine.textFinished) {
+                engine.skipTypewriter(); 
+            } else {
+                engine.introLineIndex++;
+                if (engine.introLineIndex >= engine.introLines.size()) {
+                    engine.currentState = STATE_GAMEPLAY;
+                    engine.updateMusicSystem();
+                    
+                    if(engine.currentNode) engine.startTypewriter(engine.currentNode->text);
+                } else {
+                    engine.startTypewriter(engine.introLines[engine.introLineIndex]);
+                }
+            }
+        }
+    }
+    ImGui::End();
+    ImGui::PopStyleColor();
+}
+
+// ==========================================
+// 3. GAMEPLAY
+// ==========================================
+void GameUI::drawGameplay() {
+    ATW_PROFILE_ZONE("Gameplay");
+    hud.refresh(engine);
+    
+    // --- BACKGROUND LOGIC ---
+    if (engine.currentNode) {
+        // 1. Reset logic when moving to a new node
+        if (engine.currentNode->id != lastNodeID) {
+            slideIndex = 0;      // Reset index
+            slideTimer = 0.0f;   // Reset timer
+            lastNodeID = engine.currentNode->id;
+            cachedImageName = engine.currentNode->mainImage; // Default to main image
+        }
+
+        // 2. Safety Check: Does this node actually have a slideshow?
+        bool hasSlides = !engine.currentNode->slideshow.empty();
+
+        if (hasSlides) {
+            // update() advances the timer
+            requests.animate(SLIDE_TIME - slideTimer);
+
+            // Safe Access
+            if (slideIndex < engine.currentNode->slideshow.size()) {
+                cachedImageName = engine.currentNode->slideshow[slideIndex];
+            } else {
+                // Fallback if index somehow went out of bounds
+                slideIndex = 0;
+                if (!engine.currentNode->slideshow.empty())
+                    cachedImageName = engine.currentNode->slideshow[0];
+            }
+        } 
+        else {
+            // 3. Fallback: No slideshow, ensure we show the main image
+            if (cachedImageName != engine.currentNode->mainImage) {
+                cachedImageName = engine.currentNode->mainImage;
+            }
+        }
+        
+        // 4. Load and Draw (the previous picture stays up until the new one has finished uploading)
+        unsigned int nodeTexture = engine.getNodeTexture(cachedImageName);
+        if (engine.isTextureReady(nodeTexture))
+            cachedTextureID = nodeTexture;
+        else
+            requests.keepAwake = true;
+        DrawBackgroundCover(cachedTextureID, displayW, displayH);
+    }
+
+    // --- HUD (STATS) ---
+    {
+        AllocScope allocScope("HUD");
+        ATW_PROFILE_ZONE("HUD");
+        ImGui::SetNextWindowPos(ImVec2(20, 20));
+        ImGui::SetNextWindowSize(ImVec2(350, 220));
+        ImGui::PushStyleColor(ImGuiCol_WindowBg, ImVec4(0, 0, 0, 0.5f));
+        if (ImGui::Begin("Stats", nullptr, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize)) {
+            ImGui::PushFont(bodyFont);
+        
+            ImGui::TextColored(ImVec4(1, 0.8f, 0, 1), "Day: %d", engine.currentStats.dayCount);
+        
+            if(!statusMessage.empty()) {
+                float shownFor = statusTimer + stepAlpha * stepSeconds;
+                float fade = std::min(1.0f, std::max(0.0f, (STATUS_TIME - shownFor) / STATUS_FADE));
+                ImGui::TextColored(ImVec4(0.2f, 1.0f, 0.2f, fade), ">> %s", statusMessage.c_str());
+            }
+            else 
+                ImGui::Spacing();
+
+            ImGui::Separator(); 
+
+            // HEALTH
+            if(iconHealth) ImGui::Image((ImTextureID)(intptr_t)iconHealth, ImVec2(24,24)); 
+            else ImGui::Text("HP ");
+            ImGui::SameLine(); 
+            ImGui::ProgressBar(engine.currentStats.health / 100.0f, ImVec2(200, 24), hud.health);
+
+            // ENERGY
+            if(iconEnergy) ImGui::Image((ImTextureID)(intptr_t)iconEnergy, ImVec2(24,24)); 
+            else ImGui::Text("EN ");
+            ImGui::SameLine(); 
+            ImGui::PushStyleColor(ImGuiCol_PlotHistogram, ImVec4(0.2f, 0.7f, 0.9f, 1.0f)); 
+            ImGui::ProgressBar(engine.currentStats.energy / 100.0f, ImVec2(200, 24), hud.energy);
+            ImGui::PopStyleColor();
+
+            // HUNGER
+            if(iconHunger) ImGui::Image((ImTextureID)(intptr_t)iconHunger, ImVec2(24,24)); 
+            else ImGui::Text("FD ");
+            ImGui::SameLine(); 
+            ImGui::PushStyleColor(ImGuiCol_PlotHistogram, ImVec4(0.8f, 0.4f, 0.1f, 1.0f)); 
+            ImGui::ProgressBar(engine.currentStats.hunger / 100.0f, ImVec2(200, 24), hud.hunger);
+            ImGui::PopStyleColor();
+
+            ImGui::Spacing();
+        
+            // REPUTATION
+            if(iconRep) ImGui::Image((ImTextureID)(intptr_t)iconRep, ImVec2(24,24)); 
+            else ImGui::Text("REP");
+            ImGui::SameLine();
+            ImGui::PushStyleColor(ImGuiCol_PlotHistogram, ImVec4(0.6f, 0.2f, 0.8f, 1.0f)); 
+            ImGui::ProgressBar(engine.currentStats.reputation / 100.0f, ImVec2(200, 24), hud.reputation);
+            ImGui::PopStyleColor();
+        
+            ImGui::SetCursorPosX(55);
+            ImGui::Text("Rank: %s", hud.rank);
+
+            ImGui::PopFont();
+        }
+        ImGui::End();
+        ImGui::PopStyleColor();
+    }
+
+    // --- ACTION BAR ---
+    {
+        AllocScope allocScope("Action bar");
+        ATW_PROFILE_ZONE("Action bar");
+        ImGui::SetNextWindowPos(ImVec2(displayW - 480, 20)); // WIDENED
+        ImGui::SetNextWindowSize(ImVec2(460, 80));           // WIDENED
+        ImGui::PushStyleColor(ImGuiCol_WindowBg, ImVec4(0,0,0,0));
+        if (ImGui::Begin("Actions", nullptr, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize)) {
+            float iconSize = 48.0f;
+            ImVec2 btnSize = ImVec2(50, 40);
+
+            // Inventory
+            if (iconInventory && ImGui::ImageButton("inv_btn", (ImTextureID)(intptr_t)iconInventory, ImVec2(iconSize, iconSize))) showInventory = !showInventory;
+            else if (!iconInventory && ImGui::Button("INV", btnSize)) showInventory = !showInventory;
+            ImGui::SameLine();
+
+            // Map
+            if (iconMap && ImGui::ImageButton("map_btn", (ImTextureID)(intptr_t)iconMap, ImVec2(iconSize, iconSize))) showMap = !showMap;
+            else if (!iconMap && ImGui::Button("MAP", btnSize)) showMap = !showMap;
+            ImGui::SameLine();
+
+            // Scavenge
+            if (iconScavenge && ImGui::ImageButton("scav_btn", (ImTextureID)(intptr_t)iconScavenge, ImVec2(iconSize, iconSize))) engine.performGlobalScavenge();
+            else if (!iconScavenge && ImGui::Button("HUNT", btnSize)) engine.performGlobalScavenge();
+            ImGui::SameLine();
+
+            // Rest
+            if (iconRest && ImGui::ImageButton("rest_btn", (ImTextureID)(intptr_t)iconRest, ImVec2(iconSize, iconSize))) engine.performGlobalRest();
+            else if (!iconRest && ImGui::Button("REST", btnSize)) engine.performGlobalRest();
+            ImGui::SameLine();
+
+            // Undo
+            if (iconUndo && ImGui::ImageButton("undo_btn", (ImTextureID)(intptr_t)iconUndo, ImVec2(iconSize, iconSize))) { 
+                engine.undoLastAction(); 
+                statusMessage = "Undo Performed";
+                statusTimer = 0.0f;
+            } 
+            else if (!iconUndo && ImGui::Button("UNDO", btnSize)) { 
+                engine.undoLastAction(); 
+                statusMessage = "Undo Performed";
+                statusTimer = 0.0f;
+            }
+            ImGui::SameLine();
+
+            // Save
+            if (iconSave && ImGui::ImageButton("save_btn", (ImTextureID)(intptr_t)iconSave, ImVec2(iconSize, iconSize))) showSavePopup = true;
+            else if (!iconSave && ImGui::Button("SAVE", btnSize)) showSavePopup = true;
+
+            // --- MUTE BUTTON ---
+            ImGui::SameLine();
+            // Check if we have the icon
+            if (iconMute) {
+                // Tint red if muted
+                ImVec4 tint = engine.isMuted ? ImVec4(1, 0.5f, 0.5f, 1) : ImVec4(1, 1, 1, 1);
+                if (ImGui::ImageButton("mute_btn", (ImTextureID)(intptr_t)iconMute, ImVec2(iconSize, iconSize), ImVec2(0,0), ImVec2(1,1), ImVec4(0,0,0,0), tint)) {
+                    engine.toggleMute();
+                }
+            } else {
+                // Fallback Text Button
+                const char* muteLabel = engine.isMuted ? "UNMUTE" : "MUTE";
+                if (ImGui::Button(muteLabel, ImVec2(60, 40))) engine.toggleMute();
+            }
+        }
+        ImGui::End();
+        ImGui::PopStyleColor();
+    }
+
+    // --- STORY BOX (TYPEWRITER) ---
+    {
+        AllocScope allocScope("Story box");
+        ATW_PROFILE_ZONE("Story box");
+        ImGui::SetNextWindowPos(ImVec2(50, displayH - 250));
+        ImGui::SetNextWindowSize(ImVec2(displayW - 100, 200));
+        ImGui::PushStyleColor(ImGuiCol_WindowBg, ImVec4(0, 0, 0, 0.85f)); 
+        if (ImGui::Begin("StoryBox", nullptr, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize)) {
+        
+            ImGui::PushFont(titleFont);
+            typewriter.draw(engine.targetText, engine.textVersion, engine.textRevealed);
+            ImGui::PopFont();
+        
+            ImGui::Spacing(); ImGui::Separator(); ImGui::Spacing();
+
+            // Choices
+            if (engine.currentNode) {
+                ImGui::PushFont(bodyFont);
+                for (int i = 0; i < engine.currentNode->children.size(); i++) {
+                    ImGui::PushID(i); 
+                    if (ImGui::Button(engine.currentNode->children[i].first.c_str(), ImVec2(0, 40))) {
+                        requests.choiceMade = true;
+                        engine.makeChoice(i);
+                    }
+                    ImGui::PopID();
+                    if (i < engine.currentNode->children.size() - 1) ImGui::SameLine();
+                }
+                ImGui::PopFont();
+            }
+        }
+        ImGui::End();
+        ImGui::PopStyleColor();
+    }
+
+    // --- INVENTORY OVERLAY ---
+    if (showInventory) {
+        AllocScope allocScope("Backpack");
+        ATW_PROFILE_ZONE("Backpack");
+        ImGui::SetNextWindowPos(ImVec2(displayW/2 - 200, displayH/2 - 200));
+        ImGui::SetNextWindowSize(ImVec2(400, 400));
+        ImGui::PushStyleColor(ImGuiCol_WindowBg, ImVec4(0.05f, 0.05f, 0.05f, 0.98f));
+        
+        if (ImGui::Begin("Backpack", &showInventory, ImGuiWindowFlags_NoCollapse)) {
+            ImGui::PushFont(titleFont); 
+            ImGui::Text("Pack Contents"); 
+            ImGui::PopFont(); 
+            ImGui::Separator();
+            
+            ImGui::PushFont(bodyFont);
+            // Rows come from the HUD cache, so using an item (which changes the inventory) doesn't disturb this loop
+            if (hud.itemCount == 0) {
+                ImGui::TextDisabled("Empty.");
+            } else {
+                for (int i = 0; i < hud.itemCount; i++) {
+                    const HudView::ItemRow& item = hud.items[i];
+                    ImGui::PushID(i);
+                    ImGui::TextUnformatted(item.label); 
+                    ImGui::SameLine(300);
+                    
+                    // HERB Logic Added Here
+                    if (item.usable) { 
+                        if (ImGui::Button("USE")) engine.useItem(item.name); 
+                    } else {
+                        ImGui::TextDisabled("[TOOL]");
+                    }
+                    ImGui::PopID();
+                }
+            }
+            ImGui::PopFont();
+        }
+        ImGui::End();
+        ImGui::PopStyleColor();
+    }
+
+    // --- MAP OVERLAY ---
+    if (showMap) {
+        AllocScope allocScope("Map");
+        ATW_PROFILE_ZONE("Map");
+        ImGui::SetNextWindowPos(ImVec2(50, 50));
+        ImGui::SetNextWindowSize(ImVec2(displayW - 100, displayH - 100));
+        ImGui::PushStyleColor(ImGuiCol_WindowBg, ImVec4(0,0,0,0.95f));
+        
+        if (ImGui::Begin("MapOverlay", &showMap, ImGuiWindowFlags_NoDecoration)) {
+            ImGui::PushFont(titleFont);
+            ImGui::Text("World Map");
+            ImGui::SameLine(displayW - 400);
+            ImGui::Text("Current Location: %.15s", engine.currentNode ? engine.currentNode->text.c_str() : "Unknown");
+            ImGui::PopFont();
+            ImGui::Separator();
+
+            if (overlayMap) {
+                float mapH = displayH - 200; 
+                float mapW = mapH * (1920.0f/1080.0f); 
+                ImGui::SetCursorPosX((displayW - 100 - mapW) * 0.5f);
+                ImGui::Image((ImTextureID)(intptr_t)overlayMap, ImVec2(mapW, mapH));
+            } else {
+                ImGui::SetCursorPos(ImVec2(displayW/2 - 100, displayH/2));
+                ImGui::Text("Map Image Not Found.");
+            }
+
+            ImGui::SetCursorPosY(displayH - 160);
+            if (ImGui::Button("CLOSE MAP", ImVec2(displayW - 140, 40))) showMap = false;
+        }
+        ImGui::End();
+        ImGui::PopStyleColor();
+    }
+}
+
+// ==========================================
+// 4. REST & SCAVENGE SCREENS
+// ==========================================
+void GameUI::drawRestScavenge() {
+    ATW_PROFILE_ZONE("Rest / scavenge");
+    unsigned int bgTex = 0;
+    if (engine.currentState == STATE_REST) bgTex = engine.getGeneralTexture("resting.png");
+    else bgTex = engine.getGeneralTexture("scavenging.png");
+
+    if (bgTex == 0) bgTex = menuBg; 
+    DrawBackgroundCover(bgTex, displayW, displayH);
+
+    ImGui::GetBackgroundDrawList()->AddRectFilled(ImVec2(0,0), ImVec2((float)displayW, (float)displayH), IM_COL32(0,0,0,100));
+
+    ImGui::SetNextWindowPos(ImVec2(displayW/2 - 200, displayH/2 - 100));
+    ImGui::SetNextWindowSize(ImVec2(400, 200));
+    ImGui::PushStyleColor(ImGuiCol_WindowBg, ImVec4(0.1f, 0.1f, 0.1f, 0.95f));
+    
+    if (ImGui::Begin("Popup", nullptr, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize)) {
+        ImGui::PushFont(titleFont);
+        ImGui::Text(engine.currentState == STATE_REST ? "RESTING..." : "SCAVENGING...");
+        ImGui::PopFont(); 
+        ImGui::Separator();
+        
+        ImGui::PushFont(bodyFont);
+        if (!engine.gameLog.empty()) ImGui::TextWrapped("%s", engine.gameLog.back().c_str());
+        ImGui::PopFont();
+        
+        ImGui::SetCursorPosY(150);
+        if (ImGui::Button("CONTINUE", ImVec2(380, 40))) engine.currentState = STATE_GAMEPLAY;
+    }
+    ImGui::End();
+    ImGui::PopStyleColor();
+}
+
+// ==========================================
+// 5. SAVE POPUP
+// ==========================================
+void GameUI::drawSavePopup() {
+    if (showSavePopup) ImGui::OpenPopup("Save Game");
+    if (ImGui::BeginPopupModal("Save Game", &showSavePopup, ImGuiWindowFlags_AlwaysAutoResize)) {
+        ImGui::Text("Enter name for your save file:");
+        ImGui::InputText("##savename", saveFileNameBuffer, 128);
+        ImGui::Separator();
+        if (ImGui::Button("SAVE", ImVec2(120, 0))) { 
+            engine.saveGameToFile(saveFileNameBuffer); 
+            statusMessage = "Game Saved!";
+            statusTimer = 0.0f;
+            showSavePopup = false; 
+            ImGui::CloseCurrentPopup(); 
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("CANCEL", ImVec2(120, 0))) { showSavePopup = false; ImGui::CloseCurrentPopup(); }
+        ImGui::EndPopup();
+    }
+}
+
+// ==========================================
+// 6. LOAD POPUP
+// ==========================================
+void GameUI::drawLoadPopup() {
+    if (showLoadPopup) ImGui::OpenPopup("Load Game");
+    if (ImGui::BeginPopupModal("Load Game", &showLoadPopup, ImGuiWindowFlags_AlwaysAutoResize)) {
+        // Listing and headers arrive from the catalog's worker thread
+        if (saveCatalog.update()) requests.dirty = true;
+        requests.animate(0.1);
+
+        const std::vector<SaveInfo>& saves = saveCatalog.saves();
+        ImGui::Text("Select a file to load:");
+        ImGui::SameLine();
+        ImGui::TextDisabled("(%d saves)", (int)saves.size());
+        ImGui::Separator();
+        ImGui::BeginChild("FileList", ImVec2(620, 300), true);
+
+        if (!saveCatalog.isScanned()) ImGui::TextDisabled("Scanning...");
+        else if (saves.empty()) ImGui::TextDisabled("No saves found.");
+
+        // Only the visible rows are laid out, and only they ask the catalog for their headers
+        ImGuiListClipper clipper;
+        clipper.Begin((int)saves.size());
+        while (clipper.Step()) {
+            for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++) {
+                const SaveInfo& save = saves[i];
+                saveCatalog.requestHeader(i);
+                ImGui::PushID(i);
+                if (ImGui::Button(save.name.c_str(), ImVec2(220, 0))) {
+                    engine.loadGameFromFile(save.path);
+                    if (engine.currentState == STATE_MENU) engine.currentState = STATE_GAMEPLAY;
+                    statusMessage = "Game Loaded!";
+                    statusTimer = 0.0f;
+                    showLoadPopup = false;
+                    ImGui::CloseCurrentPopup();
+                }
+                ImGui::SameLine();
+                if (!save.headerRead) {
+                    ImGui::TextDisabled("...");
+                } else if (!save.headerOk) {
+                    ImGui::TextColored(ImVec4(1, 0.4f, 0.4f, 1), "unreadable");
+                } else {
+                    const SaveHeader& h = save.header;
+                    time_t when = (time_t)(h.savedAt ? h.savedAt : save.modified);
+                    char date[32] = "";
+                    if (const tm* local = localtime(&when)) strftime(date, sizeof(date), "%Y-%m-%d %H:%M", local);
+                    ImGui::TextDisabled("Day %d  HP %d  EN %d  FD %d  REP %d  %s", h.day, h.health, h.energy, h.hunger, h.reputation, date);
+                }
+                ImGui::PopID();
+            }
+        }
+        ImGui::EndChild();
+        ImGui::Separator();
+        if (ImGui::Button("CANCEL", ImVec2(620, 0))) { showLoadPopup = false; ImGui::CloseCurrentPopup(); }
+        ImGui::EndPopup();
+    }
+}
@@ -0,0 +1,175 @@
+#include "GpuTimeOverlay.h"
+#include "imgui.h"
+#include "imgui_impl_opengl3.h"
+#include <algorithm>
+#include <fstream>
+#include <cstdio>
+
+GpuTimeOverlay::GpuTimeOverlay()
+    : enabled(false), samples(HISTORY), head(0), count(0), lastFrame(-1), dropped(0) {}
+
+bool GpuTimeOverlay::enable(bool on) {
+    enabled = ImGui_ImplOpenGL3_SetGpuTimers(on);
+    clear();
+    return enabled;
+}
+
+void GpuTimeOverlay::clear() {
+    head = 0;
+    count = 0;
+    lastFrame = -1;
+    dropped = 0;
+}
+
+void GpuTimeOverlay::collect() {
+    if (!enabled) return;
+    const ImGui_ImplOpenGL3_GpuTimings* timings = ImGui_ImplOpenGL3_GetGpuTimings();
+    if (!timings || timings->FrameIndex == lastFrame) return;
+    lastFrame = timings->FrameIndex;
+    dropped = timings->DroppedFrames;
+
+    // Reuses the slot's list vector and strings, so steady-state collection doesn't allocate.
+    FrameSample& s = samples[head];
+    s.frame = timings->FrameIndex;
+    s.renderMs = timings->RenderGpuMs;
+    s.intervalMs = timings->FrameIntervalGpuMs;
+    s.lists.resize(timings->Lists.Size);
+    for (int i = 0; i < timings->Lists.Size; i++) {
+        const ImGui_ImplOpenGL3_GpuListTiming& t = timings->Lists[i];
+        s.lists[i].name.assign(t.Name[0] ? t.Name : "(background)");
+        s.lists[i].gpuMs = t.GpuMs;
+        s.lists[i].elemCount = t.ElemCount;
+    }
+    head = (head + 1) % HISTORY;
+    if (count < HISTORY) count++;
+}
+
+void GpuTimeOverlay::draw(bool* open) {
+    ImGui::SetNextWindowSize(ImVec2(420, 520), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowPos(ImVec2(20, 20), ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("GPU Frame Time", open)) {
+        ImGui::End();
+        return;
+    }
+
+    if (!enabled) {
+        ImGui::TextWrapped("GPU timer queries are not available on this OpenGL context.");
+        ImGui::End();
+        return;
+    }
+    if (count == 0) {
+        ImGui::Text("Waiting for the first timed frame...");
+        ImGui::End();
+        return;
+    }
+
+    plotValues.resize(count);
+    float sum = 0.0f, worst = 0.0f;
+    for (int i = 0; i < count; i++) {
+        plotValues[i] = at(i).renderMs;
+        sum += plotValues[i];
+        worst = std::max(worst, plotValues[i]);
+    }
+    sorted = plotValues;
+    std::sort(sorted.begin(), sorted.end());
+    auto pct = [&](float p) { return sorted[std::min(count - 1, (int)(p * count))]; };
+
+    const FrameSample& last = at(count - 1);
+    ImGui::Text("Frame %d   UI render %.3f ms   interval %.2f ms", last.frame, last.renderMs, last.intervalMs);
+    ImGui::Text("avg %.3f   p50 %.3f   p95 %.3f   p99 %.3f   max %.3f", sum / count, pct(0.5f), pct(0.95f), pct(0.99f), worst);
+    ImGui::Text("%d frames, %d dropped (queries not ready in time)", count, dropped);
+
+    ImGui::PlotLines("##render", plotValues.data(), count, 0, "UI render ms", 0.0f, worst * 1.1f, ImVec2(-1, 70));
+
+    float buckets[BUCKETS] = {};
+    float width = worst > 0.0f ? worst / BUCKETS : 1.0f;
+    for (int i = 0; i < count; i++) buckets[std::min(BUCKETS - 1, (int)(plotValues[i] / width))] += 1.0f;
+    char label[48];
+    snprintf(label, sizeof(label), "0 - %.3f ms", worst);
+    ImGui::PlotHistogram("##histogram", buckets, BUCKETS, 0, label, 0.0f, FLT_MAX, ImVec2(-1, 70));
+
+    // Per draw list, matched by window name across the history
+    summaries.clear();
+    for (int i = 0; i < count; i++) {
+        for (const ListSample& l : at(i).lists) {
+            auto it = std::find_if(summaries.begin(), summaries.end(), [&](const ListSummary& s) { return s.name == l.name; });
+            if (it == summaries.end()) {
+                summaries.push_back({ l.name, 0.0f, 0.0f, 0.0f, 0 });
+                it = summaries.end() - 1;
+            }
+            it->lastMs = l.gpuMs;
+            it->avgMs += l.gpuMs;
+            it->maxMs = std::max(it->maxMs, l.gpuMs);
+            it->frames++;
+        }
+    }
+    if (ImGui::BeginTable("lists", 4, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_ScrollY, ImVec2(0, 180))) {
+        ImGui::TableSetupColumn("Draw list");
+        ImGui::TableSetupColumn("last ms");
+        ImGui::TableSetupColumn("avg ms");
+        ImGui::TableSetupColumn("max ms");
+        ImGui::TableHeadersRow();
+        for (const ListSummary& s : summaries) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::TextUnformatted(s.name.c_str());
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", s.lastMs);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", s.avgMs / s.frames);
+            ImGui::TableNextColumn(); ImGui::Text("%.3f", s.maxMs);
+        }
+        ImGui::EndTable();
+    }
+
+    if (ImGui::Button("Export CSV")) exportStatus = exportCsv("gpu_timings.csv") ? "Wrote gpu_timings.csv" : "Could not write gpu_timings.csv";
+    ImGui::SameLine();
+    if (ImGui::Button("Export JSON")) exportStatus = exportJson("gpu_timings.json") ? "Wrote gpu_timings.json" : "Could not write gpu_timings.json";
+    ImGui::SameLine();
+    if (ImGui::Button("Clear")) clear();
+    if (!exportStatus.empty()) ImGui::TextUnformatted(exportStatus.c_str());
+
+    ImGui::End();
+}
+
+bool GpuTimeOverlay::exportCsv(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file.is_open()) return false;
+    file << "frame,scope,gpu_ms,indices\n";
+    for (int i = 0; i < count; i++) {
+        const FrameSample& s = at(i);
+        file << s.frame << ",render," << s.renderMs << ",\n";
+        file << s.frame << ",interval," << s.intervalMs << ",\n";
+        for (const ListSample& l : s.lists) {
+            // Window names can hold commas and quotes; quote and double them as CSV expects.
+            std::string name = l.name;
+            for (size_t p = name.find('"'); p != std::string::npos; p = name.find('"', p + 2)) name.insert(p, 1, '"');
+            file << s.frame << ",\"" << name << "\"," << l.gpuMs << "," << l.elemCount << "\n";
+        }
+    }
+    return file.good();
+}
+
+static std::string jsonEscape(const std::string& text) {
+    std::string out;
+    for (char c : text) {
+        if (c == '"' || c == '\\') { out += '\\'; out += c; }
+        else if ((unsigned char)c < 0x20) { char buf[8]; snprintf(buf, sizeof(buf), "\\u%04x", c); out += buf; }
+        else out += c;
+    }
+    return out;
+}
+
+bool GpuTimeOverlay::exportJson(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file.is_open()) return false;
+    file << "{\n  \"dropped\": " << dropped << ",\n  \"frames\": [\n";
+    for (int i = 0; i < count; i++) {
+        const FrameSample& s = at(i);
+        file << "    { \"frame\": " << s.frame << ", \"render_ms\": " << s.renderMs << ", \"interval_ms\": " << s.intervalMs << ", \"lists\": [";
+        for (size_t l = 0; l < s.lists.size(); l++) {
+            file << (l ? ", " : "") << "{ \"name\": \"" << jsonEscape(s.lists[l].name) << "\", \"ms\": " << s.lists[l].gpuMs
+                 << ", \"indices\": " << s.lists[l].elemCount << " }";
+        }
+        file << "] }" << (i + 1 < count ? "," : "") << "\n";
+    }
+    file << "  ]\n}\n";
+    return file.good();
+}
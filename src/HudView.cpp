@@ -0,0 +1,25 @@
+#include "HudView.h"
+#include "GameEngine.h"
+#include <cstdio>
+
+void HudView::refresh(GameEngine& engine) {
+    if (version == engine.stateVersion) return;
+    version = engine.stateVersion;
+
+    const WolfStats& stats = engine.currentStats;
+    snprintf(health, sizeof(health), "%d", stats.health);
+    snprintf(energy, sizeof(energy), "%d", stats.energy);
+    snprintf(hunger, sizeof(hunger), "%d", stats.hunger);
+    snprintf(reputation, sizeof(reputation), "%d", stats.reputation);
+    snprintf(rank, sizeof(rank), "%s", engine.getFinalTitle().c_str());
+
+    // Rows keep their strings between rebuilds, so assign() reuses their buffers
+    itemCount = 0;
+    for (const InventoryNode* node = engine.inventory.first(); node; node = node->next) {
+        if (itemCount == (int)items.size()) items.emplace_back();
+        ItemRow& row = items[itemCount++];
+        row.name.assign(node->data.name);
+        snprintf(row.label, sizeof(row.label), "%s x%d", node->data.name.c_str(), node->data.quantity);
+        row.usable = node->data.type == FOOD || node->data.type == HERB;
+    }
+}
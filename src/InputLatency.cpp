@@ -0,0 +1,166 @@
+#include "InputLatency.h"
+#include "imgui.h"
+#include "imgui_impl_glfw.h"
+#include <glfw3.h>
+#include <algorithm>
+#include <fstream>
+#include <cstdio>
+#include <cmath>
+
+InputLatencyOverlay::InputLatencyOverlay()
+    : samples(HISTORY), head(0), count(0), pendingInput(0.0), pendingFrameStart(0.0), pendingChoice(false) {}
+
+void InputLatencyOverlay::clear() {
+    head = 0;
+    count = 0;
+    pendingInput = 0.0;
+    pendingChoice = false;
+}
+
+void InputLatencyOverlay::frameStarted(double frameStartTime) {
+    // Mouse events trickle in one per frame, so the release seen here is the newest one the backend stamped.
+    if (!ImGui::IsMouseReleased(ImGuiMouseButton_Left)) return;
+    double arrival = ImGui_ImplGlfw_GetInputTimes().MouseButton[ImGuiMouseButton_Left];
+    if (arrival <= 0.0) return;
+    pendingInput = arrival;
+    pendingFrameStart = frameStartTime;
+    pendingChoice = false;
+}
+
+void InputLatencyOverlay::choiceMade() {
+    if (pendingInput > 0.0) pendingChoice = true;
+}
+
+void InputLatencyOverlay::presented(double presentTime) {
+    if (pendingInput <= 0.0) return;
+    Sample& s = samples[head];
+    s.totalMs = (float)((presentTime - pendingInput) * 1000.0);
+    s.queueMs = (float)(std::max(0.0, pendingFrameStart - pendingInput) * 1000.0);
+    s.choice = pendingChoice;
+    head = (head + 1) % HISTORY;
+    if (count < HISTORY) count++;
+    pendingInput = 0.0;
+    pendingChoice = false;
+}
+
+void InputLatencyOverlay::stats(bool choicesOnly, float* avg, float* p50, float* p95, float* worst, int* n) const {
+    sorted.clear();
+    float sum = 0.0f;
+    for (int i = 0; i < count; i++) {
+        const Sample& s = at(i);
+        if (choicesOnly && !s.choice) continue;
+        sorted.push_back(s.totalMs);
+        sum += s.totalMs;
+    }
+    *n = (int)sorted.size();
+    if (sorted.empty()) { *avg = *p50 = *p95 = *worst = 0.0f; return; }
+    std::sort(sorted.begin(), sorted.end());
+    auto pct = [&](float p) { return sorted[std::min(*n - 1, (int)(p * *n))]; };
+    *avg = sum / *n;
+    *p50 = pct(0.5f);
+    *p95 = pct(0.95f);
+    *worst = sorted.back();
+}
+
+void InputLatencyOverlay::summary(bool choicesOnly, float* avgMs, float* p95Ms) const {
+    float p50, worst;
+    int n;
+    stats(choicesOnly, avgMs, &p50, p95Ms, &worst, &n);
+}
+
+void InputLatencyOverlay::draw(bool* open, bool lateLatch) {
+    ImGui::SetNextWindowSize(ImVec2(400, 330), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowPos(ImVec2(460, 20), ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("Click Latency", open)) {
+        ImGui::End();
+        return;
+    }
+
+    ImGui::Text("Late latch %s (ATW_LATE_LATCH)", lateLatch ? "on" : "off");
+    if (count == 0) {
+        ImGui::TextWrapped("Click anywhere to take a sample. Latency runs from the button release to the swap of the frame that handled it.");
+        ImGui::End();
+        return;
+    }
+
+    float avg, p50, p95, worst;
+    int n;
+    stats(false, &avg, &p50, &p95, &worst, &n);
+    ImGui::Text("all clicks (%d)   avg %.1f   p50 %.1f   p95 %.1f   max %.1f ms", n, avg, p50, p95, worst);
+    stats(true, &avg, &p50, &p95, &worst, &n);
+    if (n > 0) ImGui::Text("choices (%d)      avg %.1f   p50 %.1f   p95 %.1f   max %.1f ms", n, avg, p50, p95, worst);
+    else ImGui::TextDisabled("choices: none yet");
+
+    float queueSum = 0.0f;
+    float buckets[BUCKETS] = {};
+    for (int i = 0; i < count; i++) {
+        const Sample& s = at(i);
+        queueSum += s.queueMs;
+        buckets[std::min(BUCKETS - 1, (int)(s.totalMs / BUCKET_MS))] += 1.0f;
+    }
+    ImGui::Text("waiting for a frame to start: avg %.1f ms", queueSum / count);
+
+    char label[48];
+    snprintf(label, sizeof(label), "0 - %.0f ms", BUCKETS * BUCKET_MS);
+    ImGui::PlotHistogram("##latency", buckets, BUCKETS, 0, label, 0.0f, FLT_MAX, ImVec2(-1, 120));
+
+    if (ImGui::Button("Export CSV")) exportStatus = exportCsv("input_latency.csv") ? "Wrote input_latency.csv" : "Could not write input_latency.csv";
+    ImGui::SameLine();
+    if (ImGui::Button("Clear")) clear();
+    if (!exportStatus.empty()) ImGui::TextUnformatted(exportStatus.c_str());
+
+    ImGui::End();
+}
+
+bool InputLatencyOverlay::exportCsv(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file.is_open()) return false;
+    file << "click,total_ms,queue_ms,choice\n";
+    for (int i = 0; i < count; i++) {
+        const Sample& s = at(i);
+        file << i << "," << s.totalMs << "," << s.queueMs << "," << (s.choice ? 1 : 0) << "\n";
+    }
+    return file.good();
+}
+
+// ==========================================
+// LATE LATCH
+// ==========================================
+
+LateLatch::LateLatch()
+    : enabled(false), period(1.0 / 60.0), lastPresent(0.0), pollTime(0.0), workEstimate(0.0) {}
+
+void LateLatch::enable(bool on, int refreshHz) {
+    enabled = on;
+    period = 1.0 / (refreshHz > 0 ? refreshHz : 60);
+    lastPresent = 0.0;
+    workEstimate = 0.0;
+}
+
+void LateLatch::pollEvents() {
+    if (enabled && lastPresent > 0.0) {
+        // glfwWaitEventsTimeout() dispatches events the moment they arrive, so their timestamps stay exact while we wait.
+        double deadline = lastPresent + period - workEstimate - MARGIN;
+        for (double left = deadline - glfwGetTime(); left > 0.0005; left = deadline - glfwGetTime())
+            glfwWaitEventsTimeout(left);
+    }
+    glfwPollEvents();
+    pollTime = glfwGetTime();
+}
+
+void LateLatch::frameSubmitted() {
+    if (!enabled) return;
+    double work = glfwGetTime() - pollTime;
+    workEstimate = work > workEstimate ? work : workEstimate + (work - workEstimate) * 0.05;
+}
+
+void LateLatch::presented() {
+    if (!enabled) return;
+    // Waiting for the swap to complete lines the CPU up with the vblank, which is what the deadline above counts from.
+    glFinish();
+    double now = glfwGetTime();
+    if (lastPresent <= 0.0) { lastPresent = now; return; }
+    // Wake-ups only ever come late, so trust early readings at once and let late ones pull the vblank estimate slowly.
+    double predicted = lastPresent + period * std::max(1.0, std::floor((now - lastPresent) / period + 0.5));
+    lastPresent = now < predicted ? now : predicted + (now - predicted) * 0.1;
+}
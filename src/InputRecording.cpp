@@ -0,0 +1,275 @@
+#include "InputRecording.h"
+#include "imgui.h"
+#include "imgui_internal.h"
+#include <cstring>
+
+static const char MAGIC[4] = { 'A', 'T', 'W', 'R' };
+static const unsigned char VERSION = 2;     // 2: simulation rate after the seed
+
+enum RecordTag : unsigned char {
+    TAG_END = 0,
+    TAG_FRAME = 1,
+    TAG_SIZE = 2,
+};
+
+// ==========================================
+// ENCODING
+// ==========================================
+
+static void putU8(std::vector<unsigned char>& out, unsigned int v) { out.push_back((unsigned char)v); }
+static void putU16(std::vector<unsigned char>& out, unsigned int v) { putU8(out, v & 0xFF); putU8(out, (v >> 8) & 0xFF); }
+static void putU32(std::vector<unsigned char>& out, unsigned int v) { putU16(out, v & 0xFFFF); putU16(out, v >> 16); }
+static void putF32(std::vector<unsigned char>& out, float f) { unsigned int v; memcpy(&v, &f, 4); putU32(out, v); }
+static void putF64(std::vector<unsigned char>& out, double d) { unsigned long long v; memcpy(&v, &d, 8); putU32(out, (unsigned int)v); putU32(out, (unsigned int)(v >> 32)); }
+static void putVarint(std::vector<unsigned char>& out, unsigned int v) {
+    while (v >= 0x80) { putU8(out, (v & 0x7F) | 0x80); v >>= 7; }
+    putU8(out, v);
+}
+
+// Bounds-checked reads; a truncated log just ends early
+struct Reader {
+    const std::vector<unsigned char>& data;
+    size_t& pos;
+    bool ok;
+
+    bool has(size_t n) { if (pos + n > data.size()) ok = false; return ok; }
+    unsigned int u8() { if (!has(1)) return 0; return data[pos++]; }
+    unsigned int u16() { unsigned int lo = u8(); return lo | (u8() << 8); }
+    unsigned int u32() { unsigned int lo = u16(); return lo | (u16() << 16); }
+    float f32() { unsigned int v = u32(); float f; memcpy(&f, &v, 4); return f; }
+    double f64() { unsigned long long lo = u32(); unsigned long long v = lo | ((unsigned long long)u32() << 32); double d; memcpy(&d, &v, 8); return d; }
+    unsigned int varint() {
+        unsigned int v = 0;
+        for (int shift = 0; shift < 35 && ok; shift += 7) {
+            unsigned int b = u8();
+            v |= (b & 0x7F) << shift;
+            if (!(b & 0x80)) break;
+        }
+        return v;
+    }
+};
+
+// Event header byte: ImGuiInputEventType in the low nibble, mouse source (or 1 for a gamepad key) in the high one
+static void encodeEvent(std::vector<unsigned char>& out, const ImGuiInputEvent& e) {
+    switch (e.Type) {
+    case ImGuiInputEventType_MousePos:
+        putU8(out, e.Type | (e.MousePos.MouseSource << 4));
+        putF32(out, e.MousePos.PosX);
+        putF32(out, e.MousePos.PosY);
+        break;
+    case ImGuiInputEventType_MouseWheel:
+        putU8(out, e.Type | (e.MouseWheel.MouseSource << 4));
+        putF32(out, e.MouseWheel.WheelX);
+        putF32(out, e.MouseWheel.WheelY);
+        break;
+    case ImGuiInputEventType_MouseButton:
+        putU8(out, e.Type | (e.MouseButton.MouseSource << 4));
+        putU8(out, (e.MouseButton.Button & 0x7F) | (e.MouseButton.Down ? 0x80 : 0));
+        break;
+    case ImGuiInputEventType_Key: {
+        bool gamepad = e.Source == ImGuiInputSource_Gamepad;
+        putU8(out, e.Type | (gamepad ? 1 << 4 : 0));
+        putU16(out, (unsigned int)e.Key.Key);
+        putU8(out, e.Key.Down ? 1 : 0);
+        if (gamepad) putF32(out, e.Key.AnalogValue);        // keyboard keys are always 0 or 1
+        break;
+    }
+    case ImGuiInputEventType_Text:
+        putU8(out, e.Type);
+        putVarint(out, e.Text.Char);
+        break;
+    case ImGuiInputEventType_Focus:
+        putU8(out, e.Type);
+        putU8(out, e.AppFocused.Focused ? 1 : 0);
+        break;
+    default:
+        break;
+    }
+}
+
+static bool replayEvent(Reader& in, ImGuiIO& io) {
+    unsigned int header = in.u8();
+    unsigned int type = header & 0x0F, extra = header >> 4;
+    switch (type) {
+    case ImGuiInputEventType_MousePos: {
+        float x = in.f32(), y = in.f32();
+        io.AddMouseSourceEvent((ImGuiMouseSource)extra);
+        io.AddMousePosEvent(x, y);
+        break;
+    }
+    case ImGuiInputEventType_MouseWheel: {
+        float x = in.f32(), y = in.f32();
+        io.AddMouseSourceEvent((ImGuiMouseSource)extra);
+        io.AddMouseWheelEvent(x, y);
+        break;
+    }
+    case ImGuiInputEventType_MouseButton: {
+        unsigned int b = in.u8();
+        io.AddMouseSourceEvent((ImGuiMouseSource)extra);
+        io.AddMouseButtonEvent((int)(b & 0x7F), (b & 0x80) != 0);
+        break;
+    }
+    case ImGuiInputEventType_Key: {
+        ImGuiKey key = (ImGuiKey)in.u16();
+        bool down = in.u8() != 0;
+        float analog = extra ? in.f32() : (down ? 1.0f : 0.0f);
+        if (in.ok) io.AddKeyAnalogEvent(key, down, analog);
+        break;
+    }
+    case ImGuiInputEventType_Text: {
+        unsigned int c = in.varint();
+        if (in.ok) io.AddInputCharacter(c);
+        break;
+    }
+    case ImGuiInputEventType_Focus:
+        io.AddFocusEvent(in.u8() != 0);
+        break;
+    default:
+        in.ok = false;      // unknown event: the rest of the log can't be trusted
+        break;
+    }
+    return in.ok;
+}
+
+// ==========================================
+// RECORDER
+// ==========================================
+
+InputRecorder::InputRecorder() : file(nullptr), lastEventId(0), frames(0) {
+    lastSize[0] = lastSize[1] = lastSize[2] = lastSize[3] = -1;
+}
+
+InputRecorder::~InputRecorder() {
+    if (file) fclose(file);
+}
+
+bool InputRecorder::start(const char* path, unsigned int seed, double simRate) {
+    file = fopen(path, "wb");
+    if (!file) return false;
+    buffer.reserve(256);
+    buffer.assign(MAGIC, MAGIC + 4);
+    putU8(buffer, VERSION);
+    putU32(buffer, seed);
+    putF64(buffer, simRate);
+    fwrite(buffer.data(), 1, buffer.size(), file);
+    lastEventId = GImGui ? GImGui->InputEventsNextEventId - 1 : 0;
+    frames = 0;
+    return true;
+}
+
+void InputRecorder::recordFrame(int framebufferW, int framebufferH) {
+    if (!file) return;
+    ImGuiContext& g = *GImGui;
+    buffer.clear();
+
+    int size[4] = { (int)g.IO.DisplaySize.x, (int)g.IO.DisplaySize.y, framebufferW, framebufferH };
+    if (memcmp(size, lastSize, sizeof(size)) != 0) {
+        putU8(buffer, TAG_SIZE);
+        for (int i = 0; i < 4; i++) putU16(buffer, (unsigned int)size[i]);
+        memcpy(lastSize, size, sizeof(size));
+    }
+
+    // Events ImGui trickled over from the previous frame are still queued but already recorded
+    int newEvents = 0;
+    for (const ImGuiInputEvent& e : g.InputEventsQueue)
+        if (e.EventId > lastEventId) newEvents++;
+    putU8(buffer, TAG_FRAME);
+    putF32(buffer, g.IO.DeltaTime);
+    putVarint(buffer, (unsigned int)newEvents);
+    for (const ImGuiInputEvent& e : g.InputEventsQueue) {
+        if (e.EventId <= lastEventId) continue;
+        encodeEvent(buffer, e);
+        lastEventId = e.EventId;
+    }
+    fwrite(buffer.data(), 1, buffer.size(), file);
+    frames++;
+}
+
+void InputRecorder::stop(unsigned int engineChecksum) {
+    if (!file) return;
+    buffer.clear();
+    putU8(buffer, TAG_END);
+    putU32(buffer, (unsigned int)frames);
+    putU32(buffer, engineChecksum);
+    fwrite(buffer.data(), 1, buffer.size(), file);
+    fclose(file);
+    file = nullptr;
+}
+
+// ==========================================
+// REPLAYER
+// ==========================================
+
+InputReplayer::InputReplayer()
+    : pos(0), rngSeed(0), recordedSimRate(0.0), liveFrom(0), frames(0), trailerFound(false), trailerFrames(0), trailerChecksum(0) {
+    size[0] = size[1] = size[2] = size[3] = 0;
+}
+
+bool InputReplayer::open(const char* path) {
+    data.clear();
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    unsigned char chunk[16384];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0) data.insert(data.end(), chunk, chunk + n);
+    fclose(f);
+
+    pos = 0;
+    Reader in = { data, pos, true };
+    if (!in.has(9) || memcmp(data.data(), MAGIC, 4) != 0) { data.clear(); return false; }
+    pos = 4;
+    unsigned int version = in.u8();
+    if (version < 1 || version > VERSION) { data.clear(); return false; }
+    rngSeed = in.u32();
+    recordedSimRate = version >= 2 ? in.f64() : 0.0;
+    if (!in.ok || !(recordedSimRate >= 0.0)) { data.clear(); return false; }
+    frames = 0;
+    trailerFound = false;
+    liveFrom = GImGui ? GImGui->InputEventsNextEventId : 0;
+    return true;
+}
+
+bool InputReplayer::applyFrame(int* framebufferW, int* framebufferH) {
+    if (data.empty() || trailerFound) return false;
+    ImGuiContext& g = *GImGui;
+    ImGuiIO& io = g.IO;
+
+    // Whatever the live backend queued since the last replayed frame goes; recorded events ImGui trickled over stay.
+    // This has to happen first, since ImGui filters new events against the ones still queued.
+    for (int i = g.InputEventsQueue.Size - 1; i >= 0; i--)
+        if (g.InputEventsQueue[i].EventId >= liveFrom) g.InputEventsQueue.erase(g.InputEventsQueue.Data + i);
+
+    Reader in = { data, pos, true };
+    unsigned int tag = in.u8();
+    if (tag == TAG_SIZE) {
+        for (int i = 0; i < 4; i++) size[i] = (int)in.u16();
+        tag = in.u8();
+    }
+    if (!in.ok || tag != TAG_FRAME) {
+        pos = data.size();
+        return false;
+    }
+
+    io.DeltaTime = in.f32();
+    io.DisplaySize = ImVec2((float)size[0], (float)size[1]);
+    if (size[0] > 0 && size[1] > 0)
+        io.DisplayFramebufferScale = ImVec2((float)size[2] / size[0], (float)size[3] / size[1]);
+    unsigned int count = in.varint();
+    for (unsigned int i = 0; i < count && in.ok; i++)
+        replayEvent(in, io);
+    if (!in.ok) { pos = data.size(); return false; }
+
+    liveFrom = g.InputEventsNextEventId;
+    *framebufferW = size[2];
+    *framebufferH = size[3];
+    frames++;
+
+    // Read the trailer as soon as the last frame is out: a session that ended on QUIT never asks for another frame
+    if (pos < data.size() && data[pos] == TAG_END) {
+        pos++;
+        trailerFrames = (int)in.u32();
+        trailerChecksum = in.u32();
+        trailerFound = in.ok;
+    }
+    return true;
+}
@@ -0,0 +1,998 @@
+#include "Mp3Decoder.h"
+#include "Mp3Tables.h"
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+#if defined(__AVX2__)
+#define MP3_SIMD_AVX2 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MP3_SIMD_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define MP3_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+static const double PI = 3.14159265358979323846;
+static const int POW43_SIZE = 8207;           // 15 + 2^13 - 1: largest value with linbits
+static const int HUFF_PRIMARY_BITS = 10;
+static const int HUFF_MAX_BITS = 19;
+static const int INPUT_BUFFER_SIZE = 16 * 1024;
+static const int MAX_RESERVOIR = 511;
+
+// =========================================================
+// SIMD KERNELS
+// =========================================================
+// Everything hot in the filterbanks reduces to these two. 'n' is always a multiple of 4.
+
+// dst[i] += src[i] * k
+static inline void mulAdd(float* dst, const float* src, float k, int n) {
+    int i = 0;
+#if MP3_SIMD_AVX2
+    __m256 k8 = _mm256_set1_ps(k);
+    for (; i + 8 <= n; i += 8)
+        _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(dst + i), _mm256_mul_ps(_mm256_loadu_ps(src + i), k8)));
+#endif
+#if MP3_SIMD_AVX2 || MP3_SIMD_SSE2
+    __m128 k4 = _mm_set1_ps(k);
+    for (; i < n; i += 4)
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_loadu_ps(src + i), k4)));
+#elif MP3_SIMD_NEON
+    float32x4_t k4 = vdupq_n_f32(k);
+    for (; i < n; i += 4)
+        vst1q_f32(dst + i, vmlaq_f32(vld1q_f32(dst + i), vld1q_f32(src + i), k4));
+#else
+    for (; i < n; i++) dst[i] += src[i] * k;
+#endif
+}
+
+// dst[i] += a[i] * b[i]
+static inline void mulAddVec(float* dst, const float* a, const float* b, int n) {
+    int i = 0;
+#if MP3_SIMD_AVX2
+    for (; i + 8 <= n; i += 8)
+        _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(dst + i), _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i))));
+#endif
+#if MP3_SIMD_AVX2 || MP3_SIMD_SSE2
+    for (; i < n; i += 4)
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i))));
+#elif MP3_SIMD_NEON
+    for (; i < n; i += 4)
+        vst1q_f32(dst + i, vmlaq_f32(vld1q_f32(dst + i), vld1q_f32(a + i), vld1q_f32(b + i)));
+#else
+    for (; i < n; i++) dst[i] += a[i] * b[i];
+#endif
+}
+
+const char* mp3SimdPath() {
+#if MP3_SIMD_AVX2
+    return "avx2";
+#elif MP3_SIMD_SSE2
+    return "sse2";
+#elif MP3_SIMD_NEON
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+// =========================================================
+// DERIVED TABLES
+// =========================================================
+
+// Two-level lookup: the first HUFF_PRIMARY_BITS bits index 'entries'. Codes longer
+// than that land on a link (length 0) whose 'symbol' is the sub-table width.
+struct Mp3HuffEntry {
+    unsigned char symbol;
+    unsigned char length;
+    unsigned short next;
+};
+struct Mp3HuffLookup {
+    std::vector<Mp3HuffEntry> entries;
+};
+
+static void buildHuffLookup(Mp3HuffLookup& h, const unsigned int* codes, const unsigned char* lens, const unsigned char* symbols, int count) {
+    h.entries.assign(1 << HUFF_PRIMARY_BITS, Mp3HuffEntry{ 0, 0, 0 });
+    // Sub-table widths: longest code sharing each primary prefix.
+    int subBits[1 << HUFF_PRIMARY_BITS] = { 0 };
+    for (int i = 0; i < count; i++) {
+        if (lens[i] <= HUFF_PRIMARY_BITS) continue;
+        int prefix = codes[i] >> (lens[i] - HUFF_PRIMARY_BITS);
+        subBits[prefix] = std::max(subBits[prefix], lens[i] - HUFF_PRIMARY_BITS);
+    }
+    for (int p = 0; p < (1 << HUFF_PRIMARY_BITS); p++) {
+        if (!subBits[p]) continue;
+        h.entries[p] = Mp3HuffEntry{ (unsigned char)subBits[p], 0, (unsigned short)h.entries.size() };
+        h.entries.resize(h.entries.size() + (1 << subBits[p]), Mp3HuffEntry{ 0, 0, 0 });
+    }
+    for (int i = 0; i < count; i++) {
+        int len = lens[i];
+        if (len <= HUFF_PRIMARY_BITS) {
+            int first = codes[i] << (HUFF_PRIMARY_BITS - len);
+            for (int r = 0; r < (1 << (HUFF_PRIMARY_BITS - len)); r++)
+                h.entries[first + r] = Mp3HuffEntry{ symbols[i], (unsigned char)len, 0 };
+        } else {
+            const Mp3HuffEntry& link = h.entries[codes[i] >> (len - HUFF_PRIMARY_BITS)];
+            int rest = len - HUFF_PRIMARY_BITS;
+            int first = link.next + ((codes[i] & ((1 << rest) - 1)) << (link.symbol - rest));
+            for (int r = 0; r < (1 << (link.symbol - rest)); r++)
+                h.entries[first + r] = Mp3HuffEntry{ symbols[i], (unsigned char)len, 0 };
+        }
+    }
+}
+
+struct Mp3DerivedTables {
+    Mp3HuffLookup huff[32];
+    Mp3HuffLookup quadA, quadB;
+    float pow43[POW43_SIZE];
+    float imdctLong[4][18][36];     // cosine basis pre-multiplied by the block type's window
+    float imdctShort[6][12];
+    float synthMatrix[32][64];      // N[i][k] stored k-major so each subband is one mulAdd
+    float window[512];
+    float aliasCs[8], aliasCa[8];
+
+    Mp3DerivedTables() {
+        unsigned char symbols[256];
+        for (int t = 0; t < 32; t++) {
+            const Mp3HuffSpec& spec = HUFF_SPECS[t];
+            if (!spec.codes) continue;
+            // 16..23 and 24..31 share code tables; only the linbits differ.
+            if (t > 16 && t < 24) { huff[t] = huff[16]; continue; }
+            if (t > 24) { huff[t] = huff[24]; continue; }
+            for (int x = 0; x < spec.dim; x++)
+                for (int y = 0; y < spec.dim; y++) symbols[x * spec.dim + y] = (unsigned char)((x << 4) | y);
+            buildHuffLookup(huff[t], spec.codes, spec.lens, symbols, spec.dim * spec.dim);
+        }
+        unsigned int quadCodes[16];
+        for (int i = 0; i < 16; i++) { symbols[i] = (unsigned char)i; quadCodes[i] = QUAD_CODES_A[i]; }
+        buildHuffLookup(quadA, quadCodes, QUAD_LENS_A, symbols, 16);
+        for (int i = 0; i < 16; i++) quadCodes[i] = QUAD_CODES_B[i];
+        buildHuffLookup(quadB, quadCodes, QUAD_LENS_B, symbols, 16);
+
+        for (int i = 0; i < POW43_SIZE; i++) pow43[i] = (float)std::pow((double)i, 4.0 / 3.0);
+
+        double win[4][36];
+        for (int i = 0; i < 36; i++) win[0][i] = std::sin(PI / 36 * (i + 0.5));
+        for (int i = 0; i < 18; i++) win[1][i] = win[0][i];
+        for (int i = 18; i < 24; i++) win[1][i] = 1.0;
+        for (int i = 24; i < 30; i++) win[1][i] = std::sin(PI / 12 * (i - 18 + 0.5));
+        for (int i = 30; i < 36; i++) win[1][i] = 0.0;
+        for (int i = 0; i < 6; i++) win[3][i] = 0.0;
+        for (int i = 6; i < 12; i++) win[3][i] = std::sin(PI / 12 * (i - 6 + 0.5));
+        for (int i = 12; i < 18; i++) win[3][i] = 1.0;
+        for (int i = 18; i < 36; i++) win[3][i] = win[0][i];
+        for (int i = 0; i < 36; i++) win[2][i] = 0.0;   // short blocks use imdctShort
+        for (int bt = 0; bt < 4; bt++)
+            for (int k = 0; k < 18; k++)
+                for (int i = 0; i < 36; i++)
+                    imdctLong[bt][k][i] = (float)(std::cos(PI / 72 * (2 * i + 1 + 18) * (2 * k + 1)) * win[bt][i]);
+        for (int k = 0; k < 6; k++)
+            for (int i = 0; i < 12; i++)
+                imdctShort[k][i] = (float)(std::cos(PI / 24 * (2 * i + 1 + 6) * (2 * k + 1)) * std::sin(PI / 12 * (i + 0.5)));
+
+        for (int k = 0; k < 32; k++)
+            for (int i = 0; i < 64; i++)
+                synthMatrix[k][i] = (float)std::cos((16 + i) * (2 * k + 1) * PI / 64);
+        for (int i = 0; i <= 256; i++) window[i] = SYNTH_WINDOW[i] / 65536.0f;
+        for (int i = 257; i < 512; i++) window[i] = (i % 64 == 0) ? window[512 - i] : -window[512 - i];
+
+        static const double ALIAS_C[8] = { -0.6, -0.535, -0.33, -0.185, -0.095, -0.041, -0.0142, -0.0037 };
+        for (int i = 0; i < 8; i++) {
+            double sq = std::sqrt(1.0 + ALIAS_C[i] * ALIAS_C[i]);
+            aliasCs[i] = (float)(1.0 / sq);
+            aliasCa[i] = (float)(ALIAS_C[i] / sq);
+        }
+    }
+};
+
+static const Mp3DerivedTables& tables() {
+    static Mp3DerivedTables t;
+    return t;
+}
+
+// =========================================================
+// FRAME HEADER / SIDE INFO
+// =========================================================
+
+Mp3Decoder::Mp3Decoder() {
+    reset();
+}
+
+void Mp3Decoder::reset() {
+    tables();
+    memset(&header, 0, sizeof(header));
+    memset(&lastHeader, 0, sizeof(lastHeader));
+    memset(gran, 0, sizeof(gran));
+    memset(chan, 0, sizeof(chan));
+    haveLastHeader = false;
+    firstFrame = true;
+    mainDataBegin = 0;
+    granules = 0;
+    curGr = 0;
+    bitPos = 0;
+    reservoir.clear();
+    infoTag = Mp3InfoTag();
+}
+
+bool Mp3Decoder::parseHeader(const unsigned char* p, Header& h) const {
+    static const short BITRATES[2][15] = {
+        { 0, 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320 },
+        { 0, 8, 16, 24, 32, 40, 48, 56, 64, 80, 96, 112, 128, 144, 160 } };
+    static const int RATES[3] = { 44100, 48000, 32000 };
+
+    if (p[0] != 0xFF || (p[1] & 0xE0) != 0xE0) return false;
+    int versionBits = (p[1] >> 3) & 3;   // 0 = 2.5, 1 = reserved, 2 = MPEG-2, 3 = MPEG-1
+    int layerBits = (p[1] >> 1) & 3;     // 1 = Layer III
+    int bitrateIndex = p[2] >> 4;
+    int rateBits = (p[2] >> 2) & 3;
+    // Free-format (bitrate index 0) streams aren't supported.
+    if (versionBits == 1 || layerBits != 1 || bitrateIndex == 0 || bitrateIndex == 15 || rateBits == 3) return false;
+
+    h.version = versionBits == 3 ? 1 : (versionBits == 2 ? 2 : 25);
+    int shift = h.version == 1 ? 0 : (h.version == 2 ? 1 : 2);
+    h.crc = !(p[1] & 1);
+    h.bitrateKbps = BITRATES[h.version == 1 ? 0 : 1][bitrateIndex];
+    h.sampleRate = RATES[rateBits] >> shift;
+    h.rateIndex = shift * 3 + rateBits;
+    h.mode = p[3] >> 6;
+    h.modeExt = (p[3] >> 4) & 3;
+    h.channels = h.mode == 3 ? 1 : 2;
+    h.frameBytes = (h.version == 1 ? 144 : 72) * h.bitrateKbps * 1000 / h.sampleRate + ((p[2] >> 1) & 1);
+    return true;
+}
+
+int Mp3Decoder::findFrame(const unsigned char* data, int size, Header& h) const {
+    for (int i = 0; i + 4 <= size; i++) {
+        if (data[i] != 0xFF || !parseHeader(data + i, h)) continue;
+        if (haveLastHeader) {
+            if (h.version != lastHeader.version || h.sampleRate != lastHeader.sampleRate) continue;
+        } else if (i + h.frameBytes + 4 <= size) {
+            // Not locked on yet: make sure the next header lines up too, so stray
+            // 0xFF bytes in tags don't pass for a frame.
+            Header next;
+            if (!parseHeader(data + i + h.frameBytes, next) || next.version != h.version || next.sampleRate != h.sampleRate) continue;
+        }
+        return i;
+    }
+    return -1;
+}
+
+int Mp3Decoder::sideInfoBytes() const {
+    if (header.version == 1) return header.channels == 1 ? 17 : 32;
+    return header.channels == 1 ? 9 : 17;
+}
+
+// MSB-first reader for the side info / tag bytes (main data uses peekBits/readBits).
+struct Mp3SideReader {
+    const unsigned char* p;
+    int pos;
+    unsigned int read(int n) {
+        unsigned int v = 0;
+        for (; n > 0; n--, pos++) v = (v << 1) | ((p[pos >> 3] >> (7 - (pos & 7))) & 1);
+        return v;
+    }
+};
+
+bool Mp3Decoder::readSideInfo(const unsigned char* p) {
+    Mp3SideReader r = { p, 0 };
+    bool mpeg1 = header.version == 1;
+    int nch = header.channels;
+    const short* longBands = SFB_LONG[header.rateIndex];
+    const short* shortBands = SFB_SHORT[header.rateIndex];
+
+    if (mpeg1) {
+        mainDataBegin = r.read(9);
+        r.read(nch == 1 ? 5 : 3);
+        for (int ch = 0; ch < nch; ch++)
+            for (int i = 0; i < 4; i++) chan[ch].scfsi[i] = r.read(1);
+        granules = 2;
+    } else {
+        mainDataBegin = r.read(8);
+        r.read(nch == 1 ? 1 : 2);
+        for (int ch = 0; ch < nch; ch++)
+            for (int i = 0; i < 4; i++) chan[ch].scfsi[i] = 0;
+        granules = 1;
+    }
+
+    for (int gr = 0; gr < granules; gr++) {
+        for (int ch = 0; ch < nch; ch++) {
+            Granule& g = gran[gr][ch];
+            g.part23Length = r.read(12);
+            g.bigValues = std::min((int)r.read(9), 288);
+            g.globalGain = r.read(8);
+            g.scalefacCompress = r.read(mpeg1 ? 4 : 9);
+            if (r.read(1)) {
+                g.blockType = r.read(2);
+                g.mixed = r.read(1) != 0;
+                g.tableSelect[0] = r.read(5);
+                g.tableSelect[1] = r.read(5);
+                g.tableSelect[2] = 0;
+                for (int w = 0; w < 3; w++) g.subblockGain[w] = r.read(3);
+                if (g.blockType == 0) return false;
+                // Region boundaries are implicit with window switching.
+                if (g.blockType == 2) g.region1Start = g.mixed ? longBands[mpeg1 ? 8 : 6] : shortBands[3] * 3;
+                else g.region1Start = longBands[8];
+                g.region2Start = 576;
+            } else {
+                g.blockType = 0;
+                g.mixed = false;
+                for (int i = 0; i < 3; i++) g.tableSelect[i] = r.read(5);
+                for (int w = 0; w < 3; w++) g.subblockGain[w] = 0;
+                int region0Count = r.read(4);
+                int region1Count = r.read(3);
+                g.region1Start = longBands[std::min(region0Count + 1, 22)];
+                g.region2Start = longBands[std::min(region0Count + region1Count + 2, 22)];
+            }
+            g.preflag = mpeg1 ? r.read(1) : 0;
+            g.scalefacScale = r.read(1);
+            g.count1Table = r.read(1);
+            if (g.part23Length == 0) g.bigValues = 0;
+        }
+    }
+    return true;
+}
+
+static unsigned int readBE32(const unsigned char* p) {
+    return ((unsigned int)p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+}
+
+bool Mp3Decoder::readInfoTag(const unsigned char* frame, int size) {
+    int offset = 4 + (header.crc ? 2 : 0) + sideInfoBytes();
+    if (offset + 8 > size) return false;
+    const unsigned char* p = frame + offset;
+    const unsigned char* end = frame + size;
+    if (memcmp(p, "Xing", 4) != 0 && memcmp(p, "Info", 4) != 0) return false;
+
+    infoTag = Mp3InfoTag();
+    infoTag.present = true;
+    unsigned int flags = readBE32(p + 4);
+    p += 8;
+    if ((flags & 1) && p + 4 <= end) { infoTag.frames = (long)readBE32(p); p += 4; }
+    if (flags & 2) p += 4;      // byte count
+    if (flags & 4) p += 100;    // seek table
+    if (flags & 8) p += 4;      // quality
+    // The LAME extension (also written by libavcodec) carries the gapless info.
+    if (p + 24 <= end && (memcmp(p, "LAME", 4) == 0 || memcmp(p, "Lavc", 4) == 0 || memcmp(p, "Lavf", 4) == 0)) {
+        infoTag.delay = (p[21] << 4) | (p[22] >> 4);
+        infoTag.padding = ((p[22] & 15) << 8) | p[23];
+    }
+    return true;
+}
+
+// =========================================================
+// MAIN DATA
+// =========================================================
+
+unsigned int Mp3Decoder::peekBits(int n) const {
+    size_t byte = (size_t)(bitPos >> 3);
+    unsigned int v;
+    if (byte + 4 <= mainData.size()) {
+        v = readBE32(&mainData[byte]);
+    } else {
+        v = 0;
+        for (size_t i = 0; i < 4; i++) v = (v << 8) | (byte + i < mainData.size() ? mainData[byte + i] : 0);
+    }
+    return (v << (bitPos & 7)) >> (32 - n);
+}
+
+unsigned int Mp3Decoder::readBits(int n) {
+    if (n == 0) return 0;
+    unsigned int v = peekBits(n);
+    bitPos += n;
+    return v;
+}
+
+int Mp3Decoder::decodeHuffman(const Mp3HuffLookup& table) {
+    unsigned int bits = peekBits(HUFF_MAX_BITS);
+    const Mp3HuffEntry* e = &table.entries[bits >> (HUFF_MAX_BITS - HUFF_PRIMARY_BITS)];
+    if (e->length == 0) {
+        int sub = e->symbol;
+        e = &table.entries[e->next + ((bits >> (HUFF_MAX_BITS - HUFF_PRIMARY_BITS - sub)) & ((1 << sub) - 1))];
+    }
+    bitPos += std::max<int>(e->length, 1);
+    return e->symbol;
+}
+
+void Mp3Decoder::readScalefactors(int gr, int ch) {
+    Granule& g = gran[gr][ch];
+    Channel& c = chan[ch];
+    int slen1 = SLEN_MPEG1[g.scalefacCompress][0];
+    int slen2 = SLEN_MPEG1[g.scalefacCompress][1];
+
+    if (g.blockType == 2) {
+        int sfb = 0;
+        if (g.mixed) {
+            for (; sfb < 8; sfb++) c.sfLong[sfb] = (unsigned char)readBits(slen1);
+            sfb = 3;
+        }
+        for (; sfb < 6; sfb++)
+            for (int w = 0; w < 3; w++) c.sfShort[sfb][w] = (unsigned char)readBits(slen1);
+        for (; sfb < 12; sfb++)
+            for (int w = 0; w < 3; w++) c.sfShort[sfb][w] = (unsigned char)readBits(slen2);
+        for (int w = 0; w < 3; w++) c.sfShort[12][w] = 0;
+        return;
+    }
+
+    static const int PARTS[5] = { 0, 6, 11, 16, 21 };
+    for (int part = 0; part < 4; part++) {
+        // scfsi: the second granule reuses this group from the first.
+        if (gr == 1 && c.scfsi[part]) continue;
+        int slen = part < 2 ? slen1 : slen2;
+        for (int sfb = PARTS[part]; sfb < PARTS[part + 1]; sfb++) c.sfLong[sfb] = (unsigned char)readBits(slen);
+    }
+    c.sfLong[21] = 0;
+}
+
+void Mp3Decoder::readScalefactorsLsf(int ch) {
+    Granule& g = gran[0][ch];
+    Channel& c = chan[ch];
+    int slen[4] = { 0, 0, 0, 0 };
+    int table;
+    int sfc = g.scalefacCompress;
+    bool intensityChannel = ch == 1 && header.mode == 1 && (header.modeExt & 1);
+
+    g.preflag = 0;
+    if (!intensityChannel) {
+        if (sfc < 400) {
+            slen[0] = (sfc >> 4) / 5; slen[1] = (sfc >> 4) % 5; slen[2] = (sfc & 15) >> 2; slen[3] = sfc & 3;
+            table = 0;
+        } else if (sfc < 500) {
+            sfc -= 400;
+            slen[0] = (sfc >> 2) / 5; slen[1] = (sfc >> 2) % 5; slen[2] = sfc & 3;
+            table = 1;
+        } else {
+            sfc -= 500;
+            slen[0] = sfc / 3; slen[1] = sfc % 3;
+            g.preflag = 1;
+            table = 2;
+        }
+    } else {
+        sfc >>= 1;
+        if (sfc < 180) {
+            slen[0] = sfc / 36; slen[1] = (sfc % 36) / 6; slen[2] = (sfc % 36) % 6;
+            table = 3;
+        } else if (sfc < 244) {
+            sfc -= 180;
+            slen[0] = (sfc & 63) >> 4; slen[1] = (sfc & 15) >> 2; slen[2] = sfc & 3;
+            table = 4;
+        } else {
+            sfc -= 244;
+            slen[0] = sfc / 3; slen[1] = sfc % 3;
+            table = 5;
+        }
+    }
+
+    int kind = g.blockType == 2 ? (g.mixed ? 2 : 1) : 0;
+    unsigned char sf[39] = { 0 }, maxPos[39] = { 0 };
+    int n = 0;
+    for (int part = 0; part < 4; part++) {
+        for (int i = 0; i < LSF_NR_OF_SFB[table][kind][part]; i++, n++) {
+            sf[n] = (unsigned char)readBits(slen[part]);
+            maxPos[n] = (unsigned char)((1 << slen[part]) - 1);
+        }
+    }
+
+    int k = 0;
+    if (kind == 0) {
+        for (int sfb = 0; sfb < 21; sfb++, k++) { c.sfLong[sfb] = sf[k]; c.isMaxLong[sfb] = maxPos[k]; }
+        c.sfLong[21] = 0;
+        c.isMaxLong[21] = c.isMaxLong[20];
+        return;
+    }
+    int sfb = 0;
+    if (kind == 2) {
+        for (; sfb < 6; sfb++, k++) { c.sfLong[sfb] = sf[k]; c.isMaxLong[sfb] = maxPos[k]; }
+        sfb = 3;
+    }
+    for (; sfb < 12; sfb++)
+        for (int w = 0; w < 3; w++, k++) { c.sfShort[sfb][w] = sf[k]; c.isMaxShort[sfb][w] = maxPos[k]; }
+    for (int w = 0; w < 3; w++) { c.sfShort[12][w] = 0; c.isMaxShort[12][w] = c.isMaxShort[11][w]; }
+}
+
+void Mp3Decoder::readSpectrum(int ch, int endBit, int* values) {
+    const Granule& g = gran[curGr][ch];
+    const Mp3DerivedTables& t = tables();
+    int bigEnd = g.bigValues * 2;
+    int i = 0;
+
+    for (int region = 0; region < 3; region++) {
+        int regionEnd = region == 0 ? g.region1Start : (region == 1 ? g.region2Start : 576);
+        regionEnd = std::min(std::max(regionEnd, i), bigEnd);
+        const Mp3HuffSpec& spec = HUFF_SPECS[g.tableSelect[region]];
+        if (!spec.codes) {
+            for (; i < regionEnd; i++) values[i] = 0;
+            continue;
+        }
+        const Mp3HuffLookup& lookup = t.huff[g.tableSelect[region]];
+        for (; i < regionEnd; i += 2) {
+            int symbol = decodeHuffman(lookup);
+            int x = symbol >> 4, y = symbol & 15;
+            if (spec.linbits && x == 15) x += readBits(spec.linbits);
+            if (x && readBits(1)) x = -x;
+            if (spec.linbits && y == 15) y += readBits(spec.linbits);
+            if (y && readBits(1)) y = -y;
+            values[i] = x;
+            values[i + 1] = y;
+        }
+    }
+
+    // count1 region: quadruples of -1/0/1 until the granule's bits run out.
+    const Mp3HuffLookup& quad = g.count1Table ? t.quadB : t.quadA;
+    while (i + 4 <= 576 && bitPos < endBit) {
+        int v = decodeHuffman(quad);
+        int q[4];
+        for (int k = 0; k < 4; k++) {
+            q[k] = (v >> (3 - k)) & 1;
+            if (q[k] && readBits(1)) q[k] = -1;
+        }
+        if (bitPos > endBit) break;   // overran the granule: the last quad is bogus
+        for (int k = 0; k < 4; k++) values[i + k] = q[k];
+        i += 4;
+    }
+    chan[ch].nonzero = i;
+    for (; i < 576; i++) values[i] = 0;
+}
+
+// =========================================================
+// REQUANTIZATION / STEREO / REORDER
+// =========================================================
+
+void Mp3Decoder::requantize(int ch, const int* values) {
+    const Granule& g = gran[curGr][ch];
+    Channel& c = chan[ch];
+    const float* pow43 = tables().pow43;
+    const short* longBands = SFB_LONG[header.rateIndex];
+    const short* shortBands = SFB_SHORT[header.rateIndex];
+    float sfMult = g.scalefacScale ? 1.0f : 0.5f;
+    float gainExp = 0.25f * (g.globalGain - 210);
+    int limit = c.nonzero;
+
+    auto scaleRange = [&](int start, int end, float exponent) {
+        end = std::min(end, limit);
+        float scale = std::pow(2.0f, exponent);
+        for (int i = start; i < end; i++) {
+            int v = values[i];
+            int a = std::min(v < 0 ? -v : v, POW43_SIZE - 1);
+            c.xr[i] = (v < 0 ? -pow43[a] : pow43[a]) * scale;
+        }
+    };
+
+    int longEnd = 22, shortStart = 13;
+    if (g.blockType == 2) {
+        longEnd = g.mixed ? (header.version == 1 ? 8 : 6) : 0;
+        shortStart = g.mixed ? 3 : 0;
+    }
+    for (int sfb = 0; sfb < longEnd && longBands[sfb] < limit; sfb++) {
+        int sf = c.sfLong[sfb] + (g.preflag ? PRETAB[sfb] : 0);
+        scaleRange(longBands[sfb], longBands[sfb + 1], gainExp - sfMult * sf);
+    }
+    for (int sfb = shortStart; sfb < 13 && shortBands[sfb] * 3 < limit; sfb++) {
+        int width = shortBands[sfb + 1] - shortBands[sfb];
+        int start = shortBands[sfb] * 3;
+        for (int w = 0; w < 3; w++)
+            scaleRange(start + w * width, start + (w + 1) * width, gainExp - 2.0f * g.subblockGain[w] - sfMult * c.sfShort[sfb][w]);
+    }
+    for (int i = limit; i < 576; i++) c.xr[i] = 0.0f;
+}
+
+void Mp3Decoder::stereo() {
+    if (header.channels != 2 || header.mode != 1) return;
+    Channel& left = chan[0];
+    Channel& right = chan[1];
+    const Granule& g = gran[curGr][1];
+    bool ms = (header.modeExt & 2) != 0;
+    bool intensity = (header.modeExt & 1) != 0;
+    bool lsf = header.version != 1;
+    const short* longBands = SFB_LONG[header.rateIndex];
+    const short* shortBands = SFB_SHORT[header.rateIndex];
+    const float invSqrt2 = 0.70710678f;
+    int limit = std::max(left.nonzero, right.nonzero);
+
+    auto midSide = [&](int start, int end) {
+        if (!ms) return;
+        for (int i = start; i < end; i++) {
+            float m = left.xr[i], s = right.xr[i];
+            left.xr[i] = (m + s) * invSqrt2;
+            right.xr[i] = (m - s) * invSqrt2;
+        }
+    };
+    // Intensity band: the right channel is the left scaled by the position's ratio.
+    auto intensityBand = [&](int start, int end, int pos, int maxPos) {
+        if (lsf ? pos == maxPos : pos >= 7) { midSide(start, end); return; }
+        float kl, kr;
+        if (!lsf) {
+            double ratio = std::tan(pos * PI / 12);
+            kl = (float)(ratio / (1 + ratio));
+            kr = (float)(1 / (1 + ratio));
+        } else {
+            double io = (g.scalefacCompress & 1) ? invSqrt2 : 0.840896415;
+            kl = pos & 1 ? (float)std::pow(io, (pos + 1) / 2) : 1.0f;
+            kr = pos & 1 ? 1.0f : (float)std::pow(io, pos / 2);
+        }
+        for (int i = start; i < end; i++) {
+            float x = left.xr[i];
+            left.xr[i] = x * kl;
+            right.xr[i] = x * kr;
+        }
+    };
+    auto rightNonzero = [&](int start, int end) {
+        for (int i = start; i < end; i++)
+            if (right.xr[i] != 0.0f) return true;
+        return false;
+    };
+
+    if (!intensity) {
+        midSide(0, limit);
+    } else if (g.blockType != 2) {
+        int lastBand = -1;
+        for (int sfb = 0; sfb < 22; sfb++)
+            if (rightNonzero(longBands[sfb], longBands[sfb + 1])) lastBand = sfb;
+        for (int sfb = 0; sfb < 22; sfb++) {
+            int idx = std::min(sfb, 20);
+            if (sfb <= lastBand) midSide(longBands[sfb], longBands[sfb + 1]);
+            else intensityBand(longBands[sfb], longBands[sfb + 1], right.sfLong[idx], right.isMaxLong[idx]);
+        }
+        limit = 576;
+    } else {
+        int shortStart = g.mixed ? 3 : 0;
+        bool shortHasData = false;
+        for (int w = 0; w < 3; w++) {
+            int lastBand = -1;
+            for (int sfb = shortStart; sfb < 13; sfb++) {
+                int width = shortBands[sfb + 1] - shortBands[sfb];
+                int start = shortBands[sfb] * 3 + w * width;
+                if (rightNonzero(start, start + width)) lastBand = sfb;
+            }
+            if (lastBand >= 0) shortHasData = true;
+            for (int sfb = shortStart; sfb < 13; sfb++) {
+                int width = shortBands[sfb + 1] - shortBands[sfb];
+                int start = shortBands[sfb] * 3 + w * width;
+                int idx = std::min(sfb, 11);
+                if (sfb <= lastBand) midSide(start, start + width);
+                else intensityBand(start, start + width, right.sfShort[idx][w], right.isMaxShort[idx][w]);
+            }
+        }
+        if (g.mixed) {
+            // The long part is only intensity coded if nothing above it is.
+            int longEnd = lsf ? 6 : 8;
+            int lastBand = -1;
+            for (int sfb = 0; sfb < longEnd; sfb++)
+                if (rightNonzero(longBands[sfb], longBands[sfb + 1])) lastBand = sfb;
+            for (int sfb = 0; sfb < longEnd; sfb++) {
+                if (shortHasData || sfb <= lastBand) midSide(longBands[sfb], longBands[sfb + 1]);
+                else intensityBand(longBands[sfb], longBands[sfb + 1], right.sfLong[sfb], right.isMaxLong[sfb]);
+            }
+        }
+        limit = 576;
+    }
+    left.nonzero = right.nonzero = limit;
+}
+
+void Mp3Decoder::reorderShort(int ch) {
+    const Granule& g = gran[curGr][ch];
+    if (g.blockType != 2) return;
+    Channel& c = chan[ch];
+    const short* shortBands = SFB_SHORT[header.rateIndex];
+    float tmp[576];
+    int sfb = g.mixed ? 3 : 0;
+    int first = shortBands[sfb] * 3;
+    int limit = first;
+    // Coefficients arrive window by window within a band; the IMDCT wants them interleaved.
+    for (; sfb < 13 && shortBands[sfb] * 3 < c.nonzero; sfb++) {
+        int width = shortBands[sfb + 1] - shortBands[sfb];
+        int start = shortBands[sfb] * 3;
+        for (int w = 0; w < 3; w++)
+            for (int j = 0; j < width; j++) tmp[start + 3 * j + w] = c.xr[start + w * width + j];
+        limit = start + 3 * width;
+    }
+    if (limit > first) memcpy(c.xr + first, tmp + first, (limit - first) * sizeof(float));
+    c.nonzero = std::max(c.nonzero, limit);
+}
+
+void Mp3Decoder::antialias(int ch) {
+    const Granule& g = gran[curGr][ch];
+    if (g.blockType == 2 && !g.mixed) return;
+    Channel& c = chan[ch];
+    const Mp3DerivedTables& t = tables();
+    int boundaries = (g.blockType == 2) ? 1 : 31;
+    for (int sb = 1; sb <= boundaries && sb * 18 - 8 < c.nonzero; sb++) {
+        float* x = c.xr + sb * 18;
+        for (int i = 0; i < 8; i++) {
+            float a = x[-1 - i], b = x[i];
+            x[-1 - i] = a * t.aliasCs[i] - b * t.aliasCa[i];
+            x[i] = b * t.aliasCs[i] + a * t.aliasCa[i];
+        }
+    }
+    c.nonzero = std::min(576, c.nonzero + 8);
+}
+
+// =========================================================
+// FILTERBANKS
+// =========================================================
+
+// IMDCT + windowing + overlap-add for all 32 subbands. Output is time-major:
+// sbSamples[t * 32 + sb] for the 18 time slots of the granule.
+void Mp3Decoder::hybridSynthesis(int ch, float* sbSamples) {
+    const Granule& g = gran[curGr][ch];
+    Channel& c = chan[ch];
+    const Mp3DerivedTables& t = tables();
+    int sbLimit = std::min(32, (c.nonzero + 17) / 18);
+    float out[36];
+
+    for (int sb = 0; sb < 32; sb++) {
+        float* prev = c.overlap[sb];
+        memset(out, 0, sizeof(out));
+        if (sb < sbLimit) {
+            const float* x = c.xr + sb * 18;
+            int blockType = (g.mixed && sb < 2) ? 0 : g.blockType;
+            if (blockType != 2) {
+                for (int k = 0; k < 18; k++)
+                    if (x[k] != 0.0f) mulAdd(out, t.imdctLong[blockType][k], x[k], 36);
+            } else {
+                for (int w = 0; w < 3; w++) {
+                    float shortOut[12] = { 0 };
+                    for (int k = 0; k < 6; k++)
+                        if (x[3 * k + w] != 0.0f) mulAdd(shortOut, t.imdctShort[k], x[3 * k + w], 12);
+                    for (int i = 0; i < 12; i++) out[6 + 6 * w + i] += shortOut[i];
+                }
+            }
+        }
+        for (int i = 0; i < 18; i++) {
+            float v = out[i] + prev[i];
+            prev[i] = out[18 + i];
+            // Frequency inversion: odd time slots of odd subbands.
+            sbSamples[i * 32 + sb] = ((sb & i) & 1) ? -v : v;
+        }
+    }
+}
+
+void Mp3Decoder::polyphaseSynthesis(int ch, const float* sbSamples, float* pcm, int stride) {
+    Channel& c = chan[ch];
+    const Mp3DerivedTables& t = tables();
+    float out[32];
+
+    for (int s = 0; s < 18; s++) {
+        const float* subbands = sbSamples + s * 32;
+        c.synthPos = (c.synthPos + 15) & 15;
+        float* v = c.synth[c.synthPos];
+        memset(v, 0, 64 * sizeof(float));
+        for (int k = 0; k < 32; k++)
+            if (subbands[k] != 0.0f) mulAdd(v, t.synthMatrix[k], subbands[k], 64);
+
+        // U is built from alternating halves of the last 16 V vectors; windowing and
+        // the final 16-way sum collapse into one multiply-accumulate per slot.
+        memset(out, 0, sizeof(out));
+        for (int b = 0; b < 16; b++)
+            mulAddVec(out, c.synth[(c.synthPos + b) & 15] + ((b & 1) ? 32 : 0), t.window + 32 * b, 32);
+        for (int j = 0; j < 32; j++) pcm[(s * 32 + j) * stride] = out[j];
+    }
+}
+
+// =========================================================
+// FRAME DECODE
+// =========================================================
+
+int Mp3Decoder::decodeFrame(const unsigned char* data, int size, float* pcm, int& consumed, Mp3FrameInfo& info) {
+    consumed = 0;
+    int offset = findFrame(data, size, header);
+    if (offset < 0) {
+        // Keep the last bytes in case a header straddles the buffer end.
+        consumed = std::max(0, size - 3);
+        return 0;
+    }
+    if (offset + header.frameBytes > size) {
+        consumed = offset;
+        return 0;
+    }
+    const unsigned char* frame = data + offset;
+    consumed = offset + header.frameBytes;
+    haveLastHeader = true;
+    lastHeader = header;
+
+    info.sampleRate = header.sampleRate;
+    info.channels = header.channels;
+    info.bitrateKbps = header.bitrateKbps;
+    info.frameBytes = header.frameBytes;
+
+    int sideStart = 4 + (header.crc ? 2 : 0);
+    int mainStart = sideStart + sideInfoBytes();
+    if (mainStart > header.frameBytes || !readSideInfo(frame + sideStart)) return 0;
+    if (firstFrame) {
+        firstFrame = false;
+        if (readInfoTag(frame, header.frameBytes)) return 0;
+    }
+
+    int nch = header.channels;
+    int samples = granules * 576;
+    const unsigned char* main = frame + mainStart;
+    int mainBytes = header.frameBytes - mainStart;
+    bool haveReservoir = (int)reservoir.size() >= mainDataBegin;
+
+    if (haveReservoir) {
+        mainData.assign(reservoir.end() - mainDataBegin, reservoir.end());
+        mainData.insert(mainData.end(), main, main + mainBytes);
+    }
+    reservoir.insert(reservoir.end(), main, main + mainBytes);
+    if ((int)reservoir.size() > MAX_RESERVOIR) reservoir.erase(reservoir.begin(), reservoir.end() - MAX_RESERVOIR);
+
+    if (!haveReservoir) {
+        // Joined mid-stream: the bits this frame needs are gone. Emit silence to keep timing.
+        memset(pcm, 0, sizeof(float) * samples * nch);
+        return samples;
+    }
+
+    int values[576];
+    float sbSamples[18 * 32];
+    int bit = 0;
+    for (int gr = 0; gr < granules; gr++) {
+        curGr = gr;
+        for (int ch = 0; ch < nch; ch++) {
+            int endBit = bit + gran[gr][ch].part23Length;
+            bitPos = bit;
+            if (header.version == 1) readScalefactors(gr, ch);
+            else readScalefactorsLsf(ch);
+            readSpectrum(ch, endBit, values);
+            requantize(ch, values);
+            bit = endBit;
+        }
+        stereo();
+        for (int ch = 0; ch < nch; ch++) {
+            reorderShort(ch);
+            antialias(ch);
+            hybridSynthesis(ch, sbSamples);
+            polyphaseSynthesis(ch, sbSamples, pcm + gr * 576 * nch + ch, nch);
+        }
+    }
+    return samples;
+}
+
+int Mp3Decoder::decodeFrame(const unsigned char* data, int size, short* pcm, int& consumed, Mp3FrameInfo& info) {
+    floatScratch.resize(MAX_FRAME_SAMPLES * 2);
+    int frames = decodeFrame(data, size, floatScratch.data(), consumed, info);
+    int count = frames * info.channels;
+    for (int i = 0; i < count; i++) {
+        float v = floatScratch[i] * 32768.0f;
+        pcm[i] = (short)std::max(-32768.0f, std::min(32767.0f, v));
+    }
+    return frames;
+}
+
+// =========================================================
+// FILE DECODER
+// =========================================================
+
+Mp3FileDecoder::Mp3FileDecoder()
+    : file(nullptr), dataStart(0), inputPos(0), inputLen(0), eof(false), pcmPos(0), pcmLen(0),
+      rate(0), numChannels(0), position(0), skipUntil(0), endAt(-1) {}
+
+Mp3FileDecoder::~Mp3FileDecoder() {
+    close();
+}
+
+void Mp3FileDecoder::close() {
+    if (file) fclose(file);
+    file = nullptr;
+}
+
+bool Mp3FileDecoder::open(const std::string& path) {
+    close();
+    file = fopen(path.c_str(), "rb");
+    if (!file) return false;
+    input.resize(INPUT_BUFFER_SIZE);
+
+    // ID3v2 tag: 10-byte header, syncsafe size, optional 10-byte footer.
+    unsigned char id3[10];
+    dataStart = 0;
+    if (fread(id3, 1, 10, file) == 10 && memcmp(id3, "ID3", 3) == 0) {
+        dataStart = 10 + ((id3[6] & 127) << 21 | (id3[7] & 127) << 14 | (id3[8] & 127) << 7 | (id3[9] & 127));
+        if (id3[5] & 0x10) dataStart += 10;
+    }
+    // Decode the first audio frame now so the format is known up front.
+    if (!rewind() || !decodeNext()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool Mp3FileDecoder::rewind() {
+    if (!file || fseek(file, dataStart, SEEK_SET) != 0) return false;
+    decoder.reset();
+    inputPos = inputLen = 0;
+    eof = false;
+    pcmPos = pcmLen = 0;
+    position = 0;
+    skipUntil = 0;
+    endAt = -1;
+    return true;
+}
+
+bool Mp3FileDecoder::fillInput() {
+    if (eof) return false;
+    if (inputPos > 0) {
+        memmove(input.data(), input.data() + inputPos, inputLen - inputPos);
+        inputLen -= inputPos;
+        inputPos = 0;
+    }
+    size_t got = fread(input.data() + inputLen, 1, input.size() - inputLen, file);
+    if (got == 0) eof = true;
+    inputLen += (int)got;
+    return got > 0;
+}
+
+bool Mp3FileDecoder::decodeNext() {
+    while (true) {
+        if (endAt >= 0 && position >= endAt) return false;
+        // Keep at least two maximum-size frames buffered so the sync check can look ahead.
+        if (inputLen - inputPos < 2 * 1441 && !eof) fillInput();
+
+        int consumed = 0;
+        Mp3FrameInfo info;
+        int frames = decoder.decodeFrame(input.data() + inputPos, inputLen - inputPos, pcm, consumed, info);
+        inputPos += consumed;
+        if (consumed == 0) {
+            if (eof || !fillInput()) return false;
+            continue;
+        }
+        if (frames == 0) continue;
+
+        if (position == 0) {
+            rate = info.sampleRate;
+            numChannels = info.channels;
+            const Mp3InfoTag& tag = decoder.infoTag;
+            if (tag.present && (tag.delay || tag.padding)) {
+                skipUntil = tag.delay + Mp3Decoder::DECODER_DELAY;
+                if (tag.frames > 0) endAt = (long long)tag.frames * frames + Mp3Decoder::DECODER_DELAY - tag.padding;
+            }
+        }
+        if (info.channels != numChannels) continue;   // mono/stereo switch mid-file: drop the frame
+
+        long long start = std::max(position, skipUntil);
+        long long end = position + frames;
+        if (endAt >= 0) end = std::min(end, endAt);
+        pcmPos = (int)(start - position);
+        pcmLen = (int)std::max(0LL, end - position);
+        position += frames;
+        if (pcmPos < pcmLen) return true;
+    }
+}
+
+int Mp3FileDecoder::read(float* out, int frames) {
+    int done = 0;
+    while (done < frames) {
+        if (pcmPos >= pcmLen && !decodeNext()) break;
+        int take = std::min(frames - done, pcmLen - pcmPos);
+        memcpy(out + (size_t)done * numChannels, pcm + (size_t)pcmPos * numChannels, sizeof(float) * take * numChannels);
+        pcmPos += take;
+        done += take;
+    }
+    return done;
+}
+
+bool mp3DecodeFile(const std::string& path, std::vector<float>& samples, int& sampleRate, int& channels) {
+    Mp3FileDecoder mp3;
+    if (!mp3.open(path)) return false;
+    sampleRate = mp3.sampleRate();
+    channels = mp3.channels();
+    samples.clear();
+    const int CHUNK = 4096;
+    while (true) {
+        size_t used = samples.size();
+        samples.resize(used + (size_t)CHUNK * channels);
+        int got = mp3.read(samples.data() + used, CHUNK);
+        samples.resize(used + (size_t)got * channels);
+        if (got < CHUNK) break;
+    }
+    return !samples.empty();
+}
+
+bool mp3DecodeFile(const std::string& path, std::vector<short>& samples, int& sampleRate, int& channels) {
+    std::vector<float> decoded;
+    if (!mp3DecodeFile(path, decoded, sampleRate, channels)) return false;
+    samples.resize(decoded.size());
+    for (size_t i = 0; i < decoded.size(); i++)
+        samples[i] = (short)std::max(-32768.0f, std::min(32767.0f, decoded[i] * 32768.0f));
+    return true;
+}
@@ -0,0 +1,200 @@
+#include "MusicStream.h"
+#include "AudioEngine.h"
+#include "Mp3Decoder.h"
+#include "Profiler.h"
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <chrono>
+
+// =========================================================
+// WAV STREAM
+// =========================================================
+
+class WavStreamDecoder : public AudioStreamDecoder {
+public:
+    ~WavStreamDecoder() { if (file) fclose(file); }
+
+    bool open(const std::string& path) {
+        file = fopen(path.c_str(), "rb");
+        if (!file) return false;
+        unsigned char riff[12];
+        if (fread(riff, 1, 12, file) != 12 || memcmp(riff, "RIFF", 4) != 0 || memcmp(riff + 8, "WAVE", 4) != 0) return false;
+        unsigned char hdr[8];
+        while (fread(hdr, 1, 8, file) == 8) {
+            unsigned int len = hdr[4] | (hdr[5] << 8) | (hdr[6] << 16) | ((unsigned int)hdr[7] << 24);
+            if (memcmp(hdr, "fmt ", 4) == 0 && len >= 16) {
+                unsigned char fmt[16];
+                if (fread(fmt, 1, 16, file) != 16) return false;
+                format = fmt[0] | (fmt[1] << 8);
+                numChannels = fmt[2] | (fmt[3] << 8);
+                rate = fmt[4] | (fmt[5] << 8) | (fmt[6] << 16) | (fmt[7] << 24);
+                bits = fmt[14] | (fmt[15] << 8);
+                fseek(file, len - 16 + (len & 1), SEEK_CUR);
+            } else if (memcmp(hdr, "data", 4) == 0) {
+                dataStart = ftell(file);
+                dataBytes = len;
+                break;
+            } else {
+                fseek(file, len + (len & 1), SEEK_CUR);
+            }
+        }
+        if (dataStart < 0 || numChannels <= 0 || rate <= 0) return false;
+        if (!((format == 1 && (bits == 16 || bits == 8)) || (format == 3 && bits == 32))) return false;
+        bytesLeft = dataBytes;
+        return true;
+    }
+
+    int sampleRate() const override { return rate; }
+    int channels() const override { return numChannels; }
+
+    int read(float* out, int frames) override {
+        int frameBytes = numChannels * (bits / 8);
+        unsigned int want = std::min<unsigned int>((unsigned int)frames * frameBytes, bytesLeft);
+        raw.resize(want);
+        size_t got = fread(raw.data(), 1, want, file);
+        int framesRead = (int)(got / frameBytes);
+        bytesLeft -= (unsigned int)got;
+        int count = framesRead * numChannels;
+        for (int i = 0; i < count; i++) {
+            if (bits == 16) out[i] = (short)(raw[i * 2] | (raw[i * 2 + 1] << 8)) / 32768.0f;
+            else if (bits == 8) out[i] = (raw[i] - 128) / 128.0f;
+            else memcpy(&out[i], &raw[i * 4], 4);
+        }
+        return framesRead;
+    }
+
+    bool rewind() override {
+        bytesLeft = dataBytes;
+        return fseek(file, dataStart, SEEK_SET) == 0;
+    }
+
+private:
+    FILE* file = nullptr;
+    int format = 0, numChannels = 0, rate = 0, bits = 0;
+    long dataStart = -1;
+    unsigned int dataBytes = 0, bytesLeft = 0;
+    std::vector<unsigned char> raw;
+};
+
+// =========================================================
+// MP3 STREAM
+// =========================================================
+
+class Mp3StreamDecoder : public AudioStreamDecoder {
+public:
+    bool open(const std::string& path) { return mp3.open(path); }
+    int sampleRate() const override { return mp3.sampleRate(); }
+    int channels() const override { return mp3.channels(); }
+    int read(float* out, int frames) override { return mp3.read(out, frames); }
+    bool rewind() override { return mp3.rewind(); }
+
+private:
+    Mp3FileDecoder mp3;
+};
+
+AudioStreamDecoder* openAudioStream(const std::string& path) {
+    std::string ext = path.size() > 4 ? path.substr(path.size() - 4) : "";
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+    if (ext == ".wav") {
+        WavStreamDecoder* wav = new WavStreamDecoder();
+        if (wav->open(path)) return wav;
+        delete wav;
+    } else if (ext == ".mp3") {
+        Mp3StreamDecoder* mp3 = new Mp3StreamDecoder();
+        if (mp3->open(path)) return mp3;
+        delete mp3;
+    }
+    return nullptr;
+}
+
+// =========================================================
+// MUSIC STREAM
+// =========================================================
+
+MusicStream::MusicStream(AudioStreamDecoder* dec, bool shouldLoop)
+    : retired(false), decoder(dec), loop(shouldLoop), readPos(0), writePos(0),
+      quit(false), finished(false) {
+    resampler.setup(decoder->sampleRate(), AudioEngine::SAMPLE_RATE, 2);
+    ring.assign((size_t)RING_FRAMES * 2, 0.0f);
+    nativeBuf.resize((size_t)DECODE_CHUNK * std::max(1, decoder->channels()));
+    decodeThread = std::thread(&MusicStream::decodeThreadMain, this);
+}
+
+MusicStream::~MusicStream() {
+    quit = true;
+    if (decodeThread.joinable()) decodeThread.join();
+}
+
+int MusicStream::readFrames(float* out, int frames) {
+    unsigned int r = readPos.load(std::memory_order_relaxed);
+    int count = (int)std::min<unsigned int>((unsigned int)frames, available());
+    for (int i = 0; i < count; i++) {
+        unsigned int slot = ((r + i) % RING_FRAMES) * 2;
+        out[i * 2] = ring[slot];
+        out[i * 2 + 1] = ring[slot + 1];
+    }
+    readPos.store(r + count, std::memory_order_release);
+    return count;
+}
+
+// Decodes one chunk and converts it to stereo at the engine rate into convertedBuf.
+// Returns -1 at the end of the decoder's data. The resampler keeps its history across
+// chunks and across loop rewinds, so neither leaves a seam.
+int MusicStream::convertChunk(int maxFrames) {
+    ATW_PROFILE_ZONE("Decode chunk");
+    int srcChannels = decoder->channels();
+    int n = decoder->read(nativeBuf.data(), std::min(maxFrames, DECODE_CHUNK));
+    if (n <= 0) return -1;
+
+    stereoBuf.resize((size_t)n * 2);
+    for (int i = 0; i < n; i++) {
+        stereoBuf[(size_t)i * 2] = nativeBuf[(size_t)i * srcChannels];
+        stereoBuf[(size_t)i * 2 + 1] = nativeBuf[(size_t)i * srcChannels + std::min(1, srcChannels - 1)];
+    }
+    convertedBuf.clear();
+    resampler.process(stereoBuf.data(), n, convertedBuf);
+    return (int)(convertedBuf.size() / 2);
+}
+
+void MusicStream::decodeThreadMain() {
+    ATW_PROFILE_THREAD("Music decode");
+    int pendingOffset = 0, pendingFrames = 0;
+    bool rewoundEmpty = false, ending = false;
+    while (!quit) {
+        if (pendingFrames == 0) {
+            if (finished) { std::this_thread::sleep_for(std::chrono::milliseconds(20)); continue; }
+            if (ending) { finished = true; continue; }
+            pendingOffset = 0;
+            pendingFrames = convertChunk(DECODE_CHUNK);
+            if (pendingFrames < 0) {
+                pendingFrames = 0;
+                // End of track: rewind straight away so the next frame follows the last
+                // one with no gap. A track that is still empty after a rewind just ends.
+                if (loop && !rewoundEmpty && decoder->rewind()) { rewoundEmpty = true; continue; }
+                // Otherwise push out the resampler's look-ahead, then finish.
+                convertedBuf.clear();
+                resampler.flush(convertedBuf);
+                pendingFrames = (int)(convertedBuf.size() / 2);
+                ending = true;
+                continue;
+            }
+            rewoundEmpty = false;
+            if (pendingFrames == 0) continue;
+        }
+
+        unsigned int w = writePos.load(std::memory_order_relaxed);
+        unsigned int space = RING_FRAMES - (w - readPos.load(std::memory_order_acquire));
+        if (space == 0) { std::this_thread::sleep_for(std::chrono::milliseconds(5)); continue; }
+
+        int count = (int)std::min<unsigned int>(space, (unsigned int)pendingFrames);
+        for (int i = 0; i < count; i++) {
+            unsigned int slot = ((w + i) % RING_FRAMES) * 2;
+            ring[slot] = convertedBuf[(size_t)(pendingOffset + i) * 2];
+            ring[slot + 1] = convertedBuf[(size_t)(pendingOffset + i) * 2 + 1];
+        }
+        writePos.store(w + count, std::memory_order_release);
+        pendingOffset += count;
+        pendingFrames -= count;
+    }
+}
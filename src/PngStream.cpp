@@ -0,0 +1,481 @@
+#include "PngStream.h"
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+
+static const int READ_BUFFER_SIZE = 16 * 1024;
+static const unsigned int WINDOW_SIZE = 32 * 1024;
+static const unsigned int WINDOW_MASK = WINDOW_SIZE - 1;
+// Hand completed output to the scanline stage every 16 KB so a pending span can
+// never be overwritten by the next back-reference (max match length is 258).
+static const unsigned int FLUSH_THRESHOLD = 16 * 1024;
+
+static const unsigned short LENGTH_BASE[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+static const unsigned char LENGTH_EXTRA[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+static const unsigned short DIST_BASE[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769,
+    1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+static const unsigned char DIST_EXTRA[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+static int reverseBits(int v, int bits) {
+    int r = 0;
+    for (int i = 0; i < bits; i++) { r = (r << 1) | (v & 1); v >>= 1; }
+    return r;
+}
+
+static unsigned char paeth(int a, int b, int c) {
+    int p = a + b - c;
+    int pa = abs(p - a), pb = abs(p - b), pc = abs(p - c);
+    if (pa <= pb && pa <= pc) return (unsigned char)a;
+    if (pb <= pc) return (unsigned char)b;
+    return (unsigned char)c;
+}
+
+PngStreamDecoder::PngStreamDecoder()
+    : headerSent(false), io(nullptr), ioUser(nullptr), readPos(0), readLen(0),
+      idatRemaining(0), idatDone(false), bitBuffer(0), bitCount(0), outPos(0), flushedPos(0),
+      width(0), height(0), colorType(0), srcChannels(0), outChannels(0), stride(0),
+      curFill(0), rowY(0), paletteSize(0), hasTransparency(false) {}
+
+bool PngStreamDecoder::fail(const char* msg) {
+    errorMessage = msg;
+    return false;
+}
+
+// =========================================================
+// INPUT
+// =========================================================
+
+bool PngStreamDecoder::fillReadBuffer() {
+    readPos = 0;
+    readLen = io->read(ioUser, (char*)readBuf.data(), READ_BUFFER_SIZE);
+    return readLen > 0;
+}
+
+bool PngStreamDecoder::readBytes(unsigned char* dst, int n) {
+    while (n > 0) {
+        if (readPos >= readLen && !fillReadBuffer()) return false;
+        int take = std::min(n, readLen - readPos);
+        memcpy(dst, readBuf.data() + readPos, take);
+        readPos += take; dst += take; n -= take;
+    }
+    return true;
+}
+
+bool PngStreamDecoder::skipBytes(unsigned int n) {
+    unsigned int buffered = (unsigned int)(readLen - readPos);
+    if (n <= buffered) { readPos += n; return true; }
+    n -= buffered;
+    readPos = readLen;
+    if (io->skip) { io->skip(ioUser, (int)n); return true; }
+    unsigned char scratch[256];
+    while (n > 0) {
+        int take = (int)std::min<unsigned int>(n, sizeof(scratch));
+        if (!readBytes(scratch, take)) return false;
+        n -= take;
+    }
+    return true;
+}
+
+bool PngStreamDecoder::readU32(unsigned int& out) {
+    unsigned char b[4];
+    if (!readBytes(b, 4)) return false;
+    out = ((unsigned int)b[0] << 24) | ((unsigned int)b[1] << 16) | ((unsigned int)b[2] << 8) | b[3];
+    return true;
+}
+
+// Steps over the CRC of the finished IDAT and opens the next one.
+// Any other chunk type ends the compressed stream.
+bool PngStreamDecoder::nextIdatChunk() {
+    unsigned int len, type;
+    if (!skipBytes(4) || !readU32(len) || !readU32(type)) { idatDone = true; return false; }
+    if (type != 0x49444154) { idatDone = true; return false; } // 'IDAT'
+    idatRemaining = len;
+    return true;
+}
+
+int PngStreamDecoder::nextIdatByte() {
+    while (idatRemaining == 0) {
+        if (idatDone || !nextIdatChunk()) return -1;
+    }
+    if (readPos >= readLen && !fillReadBuffer()) { idatDone = true; return -1; }
+    idatRemaining--;
+    return readBuf[readPos++];
+}
+
+// =========================================================
+// INFLATE
+// =========================================================
+
+bool PngStreamDecoder::fillBits(int n) {
+    while (bitCount < n) {
+        int b = nextIdatByte();
+        // Past the end of the data we feed zeros, like stbi__fill_bits does; a stream that
+        // actually needs them fails on its next symbol.
+        if (b < 0) b = 0;
+        bitBuffer |= (unsigned int)b << bitCount;
+        bitCount += 8;
+    }
+    return true;
+}
+
+int PngStreamDecoder::readBits(int n) {
+    fillBits(n);
+    int v = (int)(bitBuffer & ((1u << n) - 1));
+    bitBuffer >>= n;
+    bitCount -= n;
+    return v;
+}
+
+bool PngStreamDecoder::buildHuffman(Huffman& h, const unsigned char* sizes, int count) {
+    int sizeCount[17] = { 0 };
+    int nextCode[16];
+    memset(h.fast, 0, sizeof(h.fast));
+    for (int i = 0; i < count; i++) sizeCount[sizes[i]]++;
+    sizeCount[0] = 0;
+    for (int i = 1; i < 16; i++)
+        if (sizeCount[i] > (1 << i)) return false;
+
+    int code = 0, k = 0;
+    for (int i = 1; i < 16; i++) {
+        nextCode[i] = code;
+        h.firstCode[i] = (unsigned short)code;
+        h.firstSymbol[i] = (unsigned short)k;
+        code += sizeCount[i];
+        if (sizeCount[i] && code - 1 >= (1 << i)) return false;
+        h.maxCode[i] = code << (16 - i);
+        code <<= 1;
+        k += sizeCount[i];
+    }
+    h.maxCode[16] = 0x10000;
+
+    for (int i = 0; i < count; i++) {
+        int s = sizes[i];
+        if (!s) continue;
+        int c = nextCode[s] - h.firstCode[s] + h.firstSymbol[s];
+        h.size[c] = (unsigned char)s;
+        h.value[c] = (unsigned short)i;
+        if (s <= 9) {
+            int j = reverseBits(nextCode[s], s);
+            while (j < (1 << 9)) {
+                h.fast[j] = (unsigned short)((s << 9) | i);
+                j += (1 << s);
+            }
+        }
+        nextCode[s]++;
+    }
+    return true;
+}
+
+int PngStreamDecoder::decodeSymbol(const Huffman& h) {
+    fillBits(16);
+    int entry = h.fast[bitBuffer & 511];
+    if (entry) {
+        int s = entry >> 9;
+        bitBuffer >>= s;
+        bitCount -= s;
+        return entry & 511;
+    }
+    int k = reverseBits((int)(bitBuffer & 0xFFFF), 16);
+    int s;
+    for (s = 10; ; s++)
+        if (k < h.maxCode[s]) break;
+    if (s >= 16) return -1;
+    int idx = (k >> (16 - s)) - h.firstCode[s] + h.firstSymbol[s];
+    if (idx < 0 || idx >= 288 || h.size[idx] != s) return -1;
+    bitBuffer >>= s;
+    bitCount -= s;
+    return h.value[idx];
+}
+
+void PngStreamDecoder::putByte(unsigned char b) {
+    window[outPos & WINDOW_MASK] = b;
+    outPos++;
+    if (outPos - flushedPos >= FLUSH_THRESHOLD) flushWindow();
+}
+
+void PngStreamDecoder::flushWindow() {
+    while (flushedPos != outPos) {
+        unsigned int start = flushedPos & WINDOW_MASK;
+        unsigned int len = std::min(outPos - flushedPos, WINDOW_SIZE - start);
+        feedRows(window.data() + start, len);
+        flushedPos += len;
+    }
+}
+
+bool PngStreamDecoder::inflateStored() {
+    // Drop to a byte boundary; whole bytes still sitting in the bit buffer are read through it.
+    readBits(bitCount & 7);
+    int len = readBits(16);
+    int nlen = readBits(16);
+    if ((len ^ 0xFFFF) != nlen) return fail("Corrupt PNG (stored block length)");
+    while (len-- > 0) {
+        if (bitCount >= 8) { putByte((unsigned char)readBits(8)); continue; }
+        int b = nextIdatByte();
+        if (b < 0) return fail("Corrupt PNG (truncated stored block)");
+        putByte((unsigned char)b);
+    }
+    return true;
+}
+
+bool PngStreamDecoder::inflateCodes() {
+    for (;;) {
+        int sym = decodeSymbol(litLen);
+        if (sym < 0) return fail("Corrupt PNG (bad literal code)");
+        if (sym < 256) { putByte((unsigned char)sym); continue; }
+        if (sym == 256) return true;
+
+        sym -= 257;
+        if (sym >= 29) return fail("Corrupt PNG (bad length code)");
+        int len = LENGTH_BASE[sym];
+        if (LENGTH_EXTRA[sym]) len += readBits(LENGTH_EXTRA[sym]);
+
+        int dsym = decodeSymbol(dist);
+        if (dsym < 0 || dsym >= 30) return fail("Corrupt PNG (bad distance code)");
+        unsigned int d = DIST_BASE[dsym];
+        if (DIST_EXTRA[dsym]) d += (unsigned int)readBits(DIST_EXTRA[dsym]);
+        if (d > outPos || d > WINDOW_SIZE) return fail("Corrupt PNG (distance too far back)");
+
+        while (len-- > 0) putByte(window[(outPos - d) & WINDOW_MASK]);
+    }
+}
+
+bool PngStreamDecoder::readDynamicTables() {
+    static const unsigned char ORDER[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+    int hlit = readBits(5) + 257;
+    int hdist = readBits(5) + 1;
+    int hclen = readBits(4) + 4;
+
+    unsigned char codeLengthSizes[19] = { 0 };
+    for (int i = 0; i < hclen; i++) codeLengthSizes[ORDER[i]] = (unsigned char)readBits(3);
+    Huffman codeLength;
+    if (!buildHuffman(codeLength, codeLengthSizes, 19)) return fail("Corrupt PNG (bad code lengths)");
+
+    unsigned char lengths[286 + 32];
+    int n = 0, total = hlit + hdist;
+    while (n < total) {
+        int c = decodeSymbol(codeLength);
+        if (c < 0 || c >= 19) return fail("Corrupt PNG (bad code lengths)");
+        if (c < 16) { lengths[n++] = (unsigned char)c; continue; }
+        unsigned char fill = 0;
+        int repeat;
+        if (c == 16) {
+            if (n == 0) return fail("Corrupt PNG (bad code lengths)");
+            repeat = readBits(2) + 3;
+            fill = lengths[n - 1];
+        }
+        else if (c == 17) repeat = readBits(3) + 3;
+        else repeat = readBits(7) + 11;
+        if (total - n < repeat) return fail("Corrupt PNG (bad code lengths)");
+        memset(lengths + n, fill, repeat);
+        n += repeat;
+    }
+    if (!buildHuffman(litLen, lengths, hlit)) return fail("Corrupt PNG (bad literal table)");
+    if (!buildHuffman(dist, lengths + hlit, hdist)) return fail("Corrupt PNG (bad distance table)");
+    return true;
+}
+
+bool PngStreamDecoder::inflateAll() {
+    int cmf = readBits(8);
+    int flg = readBits(8);
+    if ((cmf * 256 + flg) % 31 != 0 || (cmf & 15) != 8 || (flg & 32)) return fail("Corrupt PNG (bad zlib header)");
+
+    bool finalBlock = false;
+    while (!finalBlock) {
+        finalBlock = readBits(1) != 0;
+        int type = readBits(2);
+        if (type == 0) {
+            if (!inflateStored()) return false;
+        } else if (type == 1) {
+            unsigned char sizes[288 + 32];
+            int i = 0;
+            for (; i <= 143; i++) sizes[i] = 8;
+            for (; i <= 255; i++) sizes[i] = 9;
+            for (; i <= 279; i++) sizes[i] = 7;
+            for (; i <= 287; i++) sizes[i] = 8;
+            for (i = 0; i < 32; i++) sizes[288 + i] = 5;
+            buildHuffman(litLen, sizes, 288);
+            buildHuffman(dist, sizes + 288, 32);
+            if (!inflateCodes()) return false;
+        } else if (type == 2) {
+            if (!readDynamicTables() || !inflateCodes()) return false;
+        } else {
+            return fail("Corrupt PNG (bad block type)");
+        }
+    }
+    flushWindow();
+    return true;
+}
+
+// =========================================================
+// SCANLINES
+// =========================================================
+
+void PngStreamDecoder::feedRows(const unsigned char* data, size_t len) {
+    while (len > 0 && rowY < height) {
+        size_t take = std::min(len, curRow.size() - curFill);
+        memcpy(curRow.data() + curFill, data, take);
+        curFill += take; data += take; len -= take;
+        if (curFill == curRow.size()) finishRow();
+    }
+}
+
+void PngStreamDecoder::finishRow() {
+    unsigned char* x = curRow.data() + 1;
+    const unsigned char* p = prevRow.data() + 1;
+    const int bpp = srcChannels;
+    switch (curRow[0]) {
+        case 0: break;
+        case 1: for (size_t i = bpp; i < stride; i++) x[i] += x[i - bpp]; break;
+        case 2: for (size_t i = 0; i < stride; i++) x[i] += p[i]; break;
+        case 3:
+            for (int i = 0; i < bpp; i++) x[i] += p[i] >> 1;
+            for (size_t i = bpp; i < stride; i++) x[i] += (unsigned char)((x[i - bpp] + p[i]) >> 1);
+            break;
+        case 4:
+            for (int i = 0; i < bpp; i++) x[i] += p[i];
+            for (size_t i = bpp; i < stride; i++) x[i] += paeth(x[i - bpp], p[i], p[i - bpp]);
+            break;
+        default:
+            // Keep consuming so the stream stays in sync; decode() reports the error.
+            if (errorMessage.empty()) errorMessage = "Corrupt PNG (bad filter type)";
+            break;
+    }
+
+    const unsigned char* out = x;
+    if (colorType == 0 || colorType == 3 || colorType == 4 || (colorType == 2 && hasTransparency)) {
+        unsigned char* o = outRow.data();
+        for (int i = 0; i < width; i++) {
+            if (colorType == 0) {
+                o[0] = o[1] = o[2] = x[i];
+                if (hasTransparency) o[3] = (x[i] == colorKey[0]) ? 0 : 255;
+                o += outChannels;
+            }
+            else if (colorType == 2) {
+                const unsigned char* c = x + i * 3;
+                o[0] = c[0]; o[1] = c[1]; o[2] = c[2];
+                o[3] = (c[0] == colorKey[0] && c[1] == colorKey[1] && c[2] == colorKey[2]) ? 0 : 255;
+                o += 4;
+            }
+            else if (colorType == 4) { o[0] = o[1] = o[2] = x[i * 2]; o[3] = x[i * 2 + 1]; o += 4; }
+            else { memcpy(o, palette + x[i] * 4, outChannels); o += outChannels; }
+        }
+        out = outRow.data();
+    }
+    if (rowSink) rowSink(rowY, out);
+
+    std::swap(prevRow, curRow);
+    curFill = 0;
+    rowY++;
+}
+
+// =========================================================
+// DRIVER
+// =========================================================
+
+bool PngStreamDecoder::decode(const stbi_io_callbacks& callbacks, void* user, HeaderSink onHeader, RowSink onRow) {
+    io = &callbacks;
+    ioUser = user;
+    readBuf.assign(READ_BUFFER_SIZE, 0);
+    readPos = readLen = 0;
+    idatRemaining = 0;
+    idatDone = false;
+    bitBuffer = 0; bitCount = 0;
+    outPos = flushedPos = 0;
+    rowY = 0; curFill = 0;
+    paletteSize = 0; hasTransparency = false;
+    memset(palette, 0, sizeof(palette));
+    memset(colorKey, 0, sizeof(colorKey));
+    headerSent = false;
+    errorMessage.clear();
+    rowSink = onRow;
+
+    static const unsigned char SIGNATURE[8] = { 137, 80, 78, 71, 13, 10, 26, 10 };
+    unsigned char sig[8];
+    if (!readBytes(sig, 8) || memcmp(sig, SIGNATURE, 8) != 0) return fail("Not a PNG");
+
+    bool seenHeader = false;
+    for (;;) {
+        unsigned int len, type;
+        if (!readU32(len) || !readU32(type)) return fail("Truncated PNG");
+
+        if (type == 0x49484452) { // 'IHDR'
+            unsigned char h[13];
+            if (len != 13 || !readBytes(h, 13)) return fail("Bad IHDR");
+            width = (h[0] << 24) | (h[1] << 16) | (h[2] << 8) | h[3];
+            height = (h[4] << 24) | (h[5] << 16) | (h[6] << 8) | h[7];
+            colorType = h[9];
+            if (width <= 0 || height <= 0 || width > (1 << 24) || height > (1 << 24)) return fail("Bad image size");
+            if (h[8] != 8) return fail("Unsupported bit depth for streaming");
+            if (h[10] != 0 || h[11] != 0) return fail("Bad compression/filter method");
+            if (h[12] != 0) return fail("Interlaced PNGs are not streamed");
+            switch (colorType) {
+                case 0: srcChannels = 1; break;
+                case 2: srcChannels = 3; break;
+                case 3: srcChannels = 1; break;
+                case 4: srcChannels = 2; break;
+                case 6: srcChannels = 4; break;
+                default: return fail("Bad color type");
+            }
+            seenHeader = true;
+            skipBytes(4);
+        }
+        else if (type == 0x504C5445) { // 'PLTE'
+            paletteSize = (int)(len / 3);
+            if (paletteSize > 256 || len % 3) return fail("Bad PLTE");
+            for (int i = 0; i < paletteSize; i++) {
+                if (!readBytes(palette + i * 4, 3)) return fail("Truncated PNG");
+                palette[i * 4 + 3] = 255;
+            }
+            skipBytes(4);
+        }
+        else if (type == 0x74524E53 && colorType == 3) { // 'tRNS'
+            if ((int)len > paletteSize) return fail("Bad tRNS");
+            for (unsigned int i = 0; i < len; i++)
+                if (!readBytes(palette + i * 4 + 3, 1)) return fail("Truncated PNG");
+            hasTransparency = true;
+            skipBytes(4);
+        }
+        else if (type == 0x74524E53 && (colorType == 0 || colorType == 2)) { // 'tRNS' colour key
+            // One 16-bit sample per channel; keep the low byte, as stbi does at 8 bits per sample.
+            const int samples = colorType == 0 ? 1 : 3;
+            unsigned char key[6];
+            if ((int)len != samples * 2 || !readBytes(key, len)) return fail("Bad tRNS");
+            for (int i = 0; i < samples; i++)
+                colorKey[i] = key[i * 2 + 1];
+            hasTransparency = true;
+            skipBytes(4);
+        }
+        else if (type == 0x49444154) { // 'IDAT'
+            if (!seenHeader) return fail("IDAT before IHDR");
+            if (colorType == 3 && paletteSize == 0) return fail("Missing PLTE");
+            idatRemaining = len;
+            break;
+        }
+        else if (type == 0x49454E44) { // 'IEND'
+            return fail("No image data");
+        }
+        else {
+            skipBytes(len + 4);
+        }
+    }
+
+    outChannels = ((colorType == 2 || colorType == 0 || colorType == 3) && !hasTransparency) ? 3 : 4;
+    stride = (size_t)width * srcChannels;
+    curRow.assign(stride + 1, 0);
+    prevRow.assign(stride + 1, 0);
+    outRow.assign((size_t)width * outChannels, 0);
+    window.assign(WINDOW_SIZE, 0);
+
+    if (onHeader && !onHeader(width, height, outChannels)) return fail("Aborted by header sink");
+    headerSent = true;
+
+    if (!inflateAll()) return false;
+    if (!errorMessage.empty()) return false;
+    if (rowY < height) return fail("Corrupt PNG (not enough pixels)");
+    return true;
+}
@@ -0,0 +1,304 @@
+#include "Profiler.h"
+
+#ifdef ATW_PROFILE
+
+#include "imgui.h"
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+
+namespace Profiler {
+
+thread_local ThreadRing* currentRing = nullptr;
+
+// Rings are never freed, they're recycled: a thread that exits puts its ring on the free list and keeps its lane
+// (and its events) until a new thread takes the ring over. There are as many rings as threads alive at once.
+static std::mutex g_registryMutex;
+static std::vector<ThreadRing*> g_rings;
+static std::vector<ThreadRing*> g_freeRings;
+
+// Returns the calling thread's ring to the free list when the thread exits
+struct RingRelease {
+    ThreadRing* ring = nullptr;
+    ~RingRelease() {
+        if (!ring) return;
+        currentRing = nullptr;
+        std::lock_guard<std::mutex> lock(g_registryMutex);
+        g_freeRings.push_back(ring);
+    }
+};
+static thread_local RingRelease t_ringRelease;
+
+// Frame marks written by the main thread only
+static uint64_t g_frameMarks[FRAME_HISTORY + 1];
+static std::atomic<uint64_t> g_frameCount(0);
+
+// Tick calibration: ticks and steady_clock sampled at startup, compared on demand
+static const uint64_t g_startTicks = ticks();
+static const std::chrono::steady_clock::time_point g_startClock = std::chrono::steady_clock::now();
+
+ThreadRing* registerThread() {
+    ThreadRing* ring;
+    {
+        std::lock_guard<std::mutex> lock(g_registryMutex);
+        if (!g_freeRings.empty()) {
+            ring = g_freeRings.back();
+            g_freeRings.pop_back();
+        } else {
+            ring = new ThreadRing();
+            ring->written.store(0, std::memory_order_relaxed);
+            ring->id = (int)g_rings.size();
+            g_rings.push_back(ring);
+        }
+        // 'written' keeps counting across owners so readers' lap checks still hold
+        ring->firstEvent.store(ring->written.load(std::memory_order_relaxed), std::memory_order_release);
+        ring->depth = 0;
+        snprintf(ring->name, sizeof(ring->name), "Thread %d", ring->id);
+    }
+    currentRing = ring;
+    t_ringRelease.ring = ring;
+    return ring;
+}
+
+void setThreadName(const char* name) {
+    ThreadRing& ring = threadRing();
+    std::lock_guard<std::mutex> lock(g_registryMutex);
+    snprintf(ring.name, sizeof(ring.name), "%s", name);
+}
+
+double ticksToMs(uint64_t t) {
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    // The longer the profiler has run, the better the estimate. Before 10 ms have passed, assume 3 GHz.
+    static double ticksPerMs = 3.0e6;
+    double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - g_startClock).count();
+    if (elapsedMs > 10.0) ticksPerMs = (double)(ticks() - g_startTicks) / elapsedMs;
+    return (double)t / ticksPerMs;
+#else
+    return (double)t * std::chrono::steady_clock::period::num * 1000.0 / std::chrono::steady_clock::period::den;
+#endif
+}
+
+void frameMark() {
+    uint64_t n = g_frameCount.load(std::memory_order_relaxed);
+    g_frameMarks[n % (FRAME_HISTORY + 1)] = ticks();
+    g_frameCount.store(n + 1, std::memory_order_release);
+}
+
+bool frameRange(int back, uint64_t* start, uint64_t* end) {
+    uint64_t n = g_frameCount.load(std::memory_order_acquire);
+    if (back < 0 || back >= FRAME_HISTORY || (uint64_t)back + 2 > n) return false;
+    uint64_t last = n - 1 - back;
+    *start = g_frameMarks[(last - 1) % (FRAME_HISTORY + 1)];
+    *end = g_frameMarks[last % (FRAME_HISTORY + 1)];
+    return true;
+}
+
+// Copies the events of 'ring' overlapping [start, end). The writer fills slot
+// 'written % RING_EVENTS' before publishing written + 1, so the slot one ring
+// behind the write count may be half-written at any time. The writer may also
+// lap the copy while it runs, so afterwards everything less than a ring
+// behind the new write count is kept and the rest is treated as torn.
+static void copyRing(ThreadRing& ring, uint64_t start, uint64_t end, std::vector<Event>& out) {
+    uint64_t last = ring.written.load(std::memory_order_acquire);
+    uint64_t first = last >= (uint64_t)RING_EVENTS ? last - RING_EVENTS + 1 : 0;
+    first = std::max(first, ring.firstEvent.load(std::memory_order_acquire));
+    size_t base = out.size();
+    std::vector<uint64_t> indices;
+    for (uint64_t i = first; i < last; i++) {
+        const Event& e = ring.events[i % RING_EVENTS];
+        if (e.end <= start || e.start >= end) continue;
+        out.push_back(e);
+        indices.push_back(i);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    uint64_t now = ring.written.load(std::memory_order_relaxed);
+    uint64_t valid = now >= (uint64_t)RING_EVENTS ? now - RING_EVENTS + 1 : 0;
+    size_t keep = base;
+    for (size_t k = 0; k < indices.size(); k++)
+        if (indices[k] >= valid) out[keep++] = out[base + k];
+    out.resize(keep);
+}
+
+void collect(uint64_t start, uint64_t end, std::vector<ThreadEvents>& out) {
+    std::vector<ThreadRing*> rings;
+    {
+        std::lock_guard<std::mutex> lock(g_registryMutex);
+        rings = g_rings;
+        out.resize(rings.size());
+        for (size_t i = 0; i < rings.size(); i++) {
+            out[i].id = rings[i]->id;
+            out[i].name = rings[i]->name;
+        }
+    }
+    for (size_t i = 0; i < rings.size(); i++) {
+        out[i].events.clear();
+        copyRing(*rings[i], start, end, out[i].events);
+    }
+}
+
+// ==========================================
+// CHROME TRACE EXPORT
+// ==========================================
+// trace_event JSON, opened by chrome://tracing, Perfetto or Speedscope.
+// Complete ("X") events carry their own duration, so nesting comes from the
+// timestamps and the depth isn't written.
+
+static void writeJsonString(FILE* f, const char* s) {
+    fputc('"', f);
+    for (; *s; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\') fprintf(f, "\\%c", c);
+        else if (c < 0x20) fprintf(f, "\\u%04x", c);
+        else fputc(c, f);
+    }
+    fputc('"', f);
+}
+
+bool exportChromeTrace(const char* path) {
+    std::vector<ThreadEvents> threads;
+    collect(0, UINT64_MAX, threads);
+
+    FILE* f = fopen(path, "w");
+    if (!f) return false;
+    double usPerTick = ticksToMs(1000000) / 1000.0;
+    fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    bool first = true;
+    for (const ThreadEvents& t : threads) {
+        fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":", first ? "" : ",\n", t.id);
+        writeJsonString(f, t.name.c_str());
+        fprintf(f, "}}");
+        first = false;
+        for (const Event& e : t.events) {
+            fprintf(f, ",\n{\"name\":");
+            writeJsonString(f, e.name);
+            fprintf(f, ",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                    t.id, (double)(e.start - g_startTicks) * usPerTick, (double)(e.end - e.start) * usPerTick);
+        }
+    }
+    fprintf(f, "\n]}\n");
+    bool ok = !ferror(f);
+    fclose(f);
+    return ok;
+}
+
+// ==========================================
+// OVERLAY
+// ==========================================
+// One lane per thread, one row per nesting depth, showing a single frame
+// (between two frame marks). Paused, the slider steps back through the
+// frames still in the history.
+
+static const float ROW_HEIGHT = 18.0f;
+
+static ImU32 zoneColor(const char* name) {
+    // Same name, same colour from frame to frame: hash the text, not the pointer
+    unsigned int h = 2166136261u;
+    for (const char* p = name; *p; p++) h = (h ^ (unsigned char)*p) * 16777619u;
+    return ImGui::ColorConvertFloat4ToU32(ImVec4(0.35f + (h & 0xFF) / 640.0f, 0.35f + ((h >> 8) & 0xFF) / 640.0f, 0.35f + ((h >> 16) & 0xFF) / 640.0f, 1.0f));
+}
+
+void drawOverlay(bool* open) {
+    static bool paused = false;
+    static int framesBack = 0;
+    static std::vector<ThreadEvents> threads;
+    static uint64_t shownStart = 0, shownEnd = 0;
+    static char exportStatus[96] = "";
+
+    ImGui::SetNextWindowSize(ImVec2(720, 300), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowPos(ImVec2(20, 80), ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("CPU Profiler", open)) {
+        ImGui::End();
+        return;
+    }
+
+    // Paused, the slider counts back from the frame that was current when the pause started
+    static uint64_t pausedAtFrame = 0;
+    if (ImGui::Checkbox("Pause", &paused) && paused) pausedAtFrame = g_frameCount.load(std::memory_order_acquire);
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(180);
+    if (!paused) framesBack = 0;
+    ImGui::BeginDisabled(!paused);
+    ImGui::SliderInt("frames back", &framesBack, 0, FRAME_HISTORY - 1);
+    ImGui::EndDisabled();
+    ImGui::SameLine();
+    if (ImGui::Button("Export trace")) {
+        bool ok = exportChromeTrace("atw_trace.json");
+        snprintf(exportStatus, sizeof(exportStatus), ok ? "Wrote atw_trace.json" : "Couldn't write atw_trace.json");
+    }
+    if (exportStatus[0]) {
+        ImGui::SameLine();
+        ImGui::TextDisabled("%s", exportStatus);
+    }
+
+    uint64_t start, end;
+    int back = framesBack + (paused ? (int)(g_frameCount.load(std::memory_order_acquire) - pausedAtFrame) : 0);
+    if (frameRange(back, &start, &end)) {
+        // Paused, the copy keeps the events after the rings have moved on
+        if (!paused || start != shownStart || end != shownEnd) {
+            collect(start, end, threads);
+            shownStart = start;
+            shownEnd = end;
+        }
+    } else if (paused && shownEnd > shownStart) {
+        start = shownStart;
+        end = shownEnd;
+        ImGui::TextDisabled("That frame has left the history; showing the last one copied.");
+    } else {
+        ImGui::TextDisabled("Waiting for frames...");
+        ImGui::End();
+        return;
+    }
+    double frameMs = ticksToMs(end - start);
+    ImGui::Text("Frame: %.2f ms", frameMs);
+
+    ImGui::BeginChild("timeline", ImVec2(0, 0), false, ImGuiWindowFlags_HorizontalScrollbar);
+    ImDrawList* draw = ImGui::GetWindowDrawList();
+    ImVec2 origin = ImGui::GetCursorScreenPos();
+    float width = std::max(ImGui::GetContentRegionAvail().x, 100.0f);
+    float labelWidth = 110.0f;
+    float timelineWidth = width - labelWidth;
+    double ticksPerPixel = (double)(end - start) / timelineWidth;
+    ImVec2 mouse = ImGui::GetIO().MousePos;
+    const Event* hovered = nullptr;
+
+    float y = origin.y;
+    for (const ThreadEvents& t : threads) {
+        int maxDepth = 0;
+        for (const Event& e : t.events) maxDepth = std::max(maxDepth, e.depth);
+        if (t.events.empty()) continue;
+        float laneHeight = (maxDepth + 1) * ROW_HEIGHT;
+        draw->AddText(ImVec2(origin.x, y + 2), ImGui::GetColorU32(ImGuiCol_Text), t.name.c_str());
+        draw->AddLine(ImVec2(origin.x, y + laneHeight + 2), ImVec2(origin.x + width, y + laneHeight + 2), ImGui::GetColorU32(ImGuiCol_Separator));
+
+        for (const Event& e : t.events) {
+            uint64_t s = std::max(e.start, start), f = std::min(e.end, end);
+            float x0 = origin.x + labelWidth + (float)((s - start) / ticksPerPixel);
+            float x1 = origin.x + labelWidth + (float)((f - start) / ticksPerPixel);
+            if (x1 - x0 < 1.0f) x1 = x0 + 1.0f;
+            ImVec2 a(x0, y + e.depth * ROW_HEIGHT), b(x1, a.y + ROW_HEIGHT - 1);
+            draw->AddRectFilled(a, b, zoneColor(e.name));
+            if (x1 - x0 > 24.0f) {
+                draw->PushClipRect(a, b, true);
+                draw->AddText(ImVec2(x0 + 3, a.y + 2), IM_COL32(0, 0, 0, 255), e.name);
+                draw->PopClipRect();
+            }
+            if (mouse.x >= a.x && mouse.x < b.x && mouse.y >= a.y && mouse.y < b.y) hovered = &e;
+        }
+        y += laneHeight + 6;
+    }
+    ImGui::Dummy(ImVec2(width, y - origin.y));
+
+    if (hovered && ImGui::IsWindowHovered()) {
+        ImGui::BeginTooltip();
+        ImGui::Text("%s", hovered->name);
+        ImGui::Text("%.3f ms (at %.3f ms)", ticksToMs(hovered->end - hovered->start),
+                    hovered->start > start ? ticksToMs(hovered->start - start) : 0.0);
+        ImGui::EndTooltip();
+    }
+    ImGui::EndChild();
+    ImGui::End();
+}
+
+}
+
+#endif
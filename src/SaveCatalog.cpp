@@ -0,0 +1,248 @@
+#include "SaveCatalog.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+namespace fs = std::filesystem;
+
+// ==========================================
+// SAVE HEADER
+// ==========================================
+
+bool readSaveHeader(const std::string& path, SaveHeader& out) {
+    std::ifstream file(path);
+    if (!file.is_open()) return false;
+    std::string line;
+    if (!std::getline(file, line)) return false;
+
+    if (line.compare(0, 4, "#ATW") == 0) {
+        SaveHeader h;
+        int version = 0;
+        int n = sscanf(line.c_str(), "#ATW %d day=%d node=%d health=%d energy=%d hunger=%d reputation=%d time=%lld",
+                       &version, &h.day, &h.node, &h.health, &h.energy, &h.hunger, &h.reputation, &h.savedAt);
+        if (n != 8) return false;
+        out = h;
+        return true;
+    }
+
+    // Saves from before the header: node id, then "health hunger energy reputation day"
+    SaveHeader h;
+    if (sscanf(line.c_str(), "%d", &h.node) != 1) return false;
+    if (!std::getline(file, line)) return false;
+    if (sscanf(line.c_str(), "%d %d %d %d %d", &h.health, &h.hunger, &h.energy, &h.reputation, &h.day) != 5) return false;
+    out = h;
+    return true;
+}
+
+static bool statFile(const std::string& path, long long& modified, long long& size) {
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) return false;
+    modified = (long long)st.st_mtime;
+    size = (long long)st.st_size;
+    return true;
+}
+
+// ==========================================
+// SAVE CATALOG
+// ==========================================
+
+SaveCatalog::SaveCatalog()
+    : scanned(false), wakeEvent(nullptr), hasPublished(false), rescanRequested(false), quit(false), watching(false) {}
+
+SaveCatalog::~SaveCatalog() {
+    stop();
+}
+
+void SaveCatalog::start(const std::string& dir) {
+    stop();
+    directory = dir;
+    quit = false;
+    rescanRequested = false;
+    lastPoll = std::chrono::steady_clock::now();
+#ifdef _WIN32
+    wakeEvent = CreateEventA(NULL, FALSE, FALSE, NULL);
+#endif
+    worker = std::thread(&SaveCatalog::workerMain, this);
+}
+
+void SaveCatalog::stop() {
+    if (!worker.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quit = true;
+    }
+    wakeWorker();
+    worker.join();
+#ifdef _WIN32
+    if (wakeEvent) CloseHandle((HANDLE)wakeEvent);
+    wakeEvent = nullptr;
+#endif
+}
+
+// Call after changing the shared state under the mutex
+void SaveCatalog::wakeWorker() {
+#ifdef _WIN32
+    if (wakeEvent) SetEvent((HANDLE)wakeEvent);
+#else
+    wake.notify_one();
+#endif
+}
+
+std::vector<SaveInfo> SaveCatalog::scan() {
+    ATW_PROFILE_ZONE("Scan saves");
+    std::vector<SaveInfo> found;
+    std::error_code ec;
+    for (fs::directory_iterator it(directory, ec), end; !ec && it != end; it.increment(ec)) {
+        const fs::path& p = it->path();
+        if (p.extension() != ".txt" || p.filename().string().find("save") == std::string::npos) continue;
+        SaveInfo info;
+        info.path = p.string();
+        info.name = p.filename().string();
+        if (!statFile(info.path, info.modified, info.size)) continue;
+        found.push_back(std::move(info));
+    }
+    std::sort(found.begin(), found.end(), [](const SaveInfo& a, const SaveInfo& b) {
+        return a.modified != b.modified ? a.modified > b.modified : a.name < b.name;
+    });
+    return found;
+}
+
+void SaveCatalog::workerMain() {
+    ATW_PROFILE_THREAD("Save catalog");
+#ifdef _WIN32
+    HANDLE change = FindFirstChangeNotificationA(directory.c_str(), FALSE,
+        FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE);
+    watching = change != INVALID_HANDLE_VALUE;
+#endif
+    bool rescan = true;
+
+    while (true) {
+        if (rescan) {
+            std::vector<SaveInfo> found = scan();
+            rescan = false;
+            std::lock_guard<std::mutex> lock(mutex);
+            published.swap(found);
+            hasPublished = true;
+        }
+
+        // Header reads, most recently requested first, until there are none left
+        std::string path;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (quit) break;
+            if (!requests.empty()) {
+                path = requests.back();
+                requests.pop_back();
+            }
+        }
+        if (!path.empty()) {
+            ATW_PROFILE_ZONE("Read save header");
+            SaveInfo result;
+            result.path = path;
+            result.headerRead = true;
+            result.headerOk = statFile(path, result.modified, result.size) && readSaveHeader(path, result.header);
+            std::lock_guard<std::mutex> lock(mutex);
+            results.push_back(std::move(result));
+            continue;
+        }
+
+        // Nothing to do: sleep until the UI wants something or, on Windows, the directory changes.
+        // A save being written fires several notifications; each one costs a single directory listing.
+#ifdef _WIN32
+        HANDLE handles[2] = { (HANDLE)wakeEvent, change };
+        DWORD signaled = WaitForMultipleObjects(watching ? 2 : 1, handles, FALSE, INFINITE);
+        if (signaled == WAIT_OBJECT_0 + 1) {
+            rescan = true;
+            FindNextChangeNotification(change);
+        } else if (signaled == WAIT_FAILED) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(POLL_INTERVAL_MS));   // no wake event; don't spin
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+#else
+        std::unique_lock<std::mutex> lock(mutex);
+        wake.wait(lock, [this] { return quit || rescanRequested || !requests.empty(); });
+#endif
+        if (quit) break;
+        if (rescanRequested) rescan = true;
+        rescanRequested = false;
+    }
+
+#ifdef _WIN32
+    if (watching) FindCloseChangeNotification(change);
+    watching = false;
+#endif
+}
+
+bool SaveCatalog::update() {
+    // Without change notifications the listing is polled, but only while someone is looking at it
+    auto now = std::chrono::steady_clock::now();
+    bool pollDue = !watching && now - lastPoll >= std::chrono::milliseconds(POLL_INTERVAL_MS);
+    if (pollDue) lastPoll = now;
+
+    std::vector<SaveInfo> fresh, done;
+    bool gotList = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (pollDue) rescanRequested = true;
+        if (hasPublished) {
+            fresh.swap(published);
+            hasPublished = false;
+            gotList = true;
+        }
+        done.swap(results);
+    }
+    if (pollDue) wakeWorker();
+
+    if (gotList) {
+        // Files that haven't changed keep the header we already read
+        for (SaveInfo& s : fresh) {
+            auto it = indexByPath.find(s.path);
+            if (it == indexByPath.end()) continue;
+            const SaveInfo& old = list[it->second];
+            if (old.modified != s.modified || old.size != s.size) continue;
+            s.headerRequested = old.headerRequested;
+            s.headerRead = old.headerRead;
+            s.headerOk = old.headerOk;
+            s.header = old.header;
+        }
+        list.swap(fresh);
+        indexByPath.clear();
+        for (int i = 0; i < (int)list.size(); i++) indexByPath[list[i].path] = i;
+        scanned = true;
+    }
+
+    bool headersChanged = false;
+    for (const SaveInfo& r : done) {
+        auto it = indexByPath.find(r.path);
+        if (it == indexByPath.end()) continue;
+        SaveInfo& s = list[it->second];
+        if (r.modified != s.modified || r.size != s.size) {   // rewritten since; ask again when it's next visible
+            s.headerRequested = false;
+            continue;
+        }
+        s.headerRead = true;
+        s.headerOk = r.headerOk;
+        s.header = r.header;
+        headersChanged = true;
+    }
+    return gotList || headersChanged;
+}
+
+void SaveCatalog::requestHeader(int index) {
+    SaveInfo& s = list[index];
+    if (s.headerRequested) return;
+    s.headerRequested = true;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        requests.push_back(s.path);
+    }
+    wakeWorker();
+}
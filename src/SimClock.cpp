@@ -0,0 +1,29 @@
+#include "SimClock.h"
+#include <algorithm>
+#include <cmath>
+
+SimClock::SimClock(double rate) : step(1.0 / rate), accumulator(0.0), steps(0) {}
+
+void SimClock::setRate(double hz) {
+    if (hz <= 0.0) return;
+    // Keep the fraction of a step already accumulated, not its length in seconds
+    accumulator = accumulator / step / hz;
+    step = 1.0 / hz;
+}
+
+int SimClock::advance(double frameSeconds) {
+    accumulator += std::min(std::max(frameSeconds, 0.0), MAX_FRAME_TIME);
+    int n = (int)(accumulator / step);
+    accumulator -= n * step;
+    // Rounding can leave the accumulator a hair below zero or at a full step
+    if (accumulator < 0.0) accumulator = 0.0;
+    if (accumulator >= step) { n++; accumulator -= step; }
+    steps += n;
+    return n;
+}
+
+double SimClock::timeUntil(double simSeconds) const {
+    // A timer is only looked at in a step, and the next step is the earliest that can see it change
+    double stepsNeeded = std::max(1.0, std::ceil(simSeconds / step - 1e-6));
+    return std::max(0.0, stepsNeeded * step - accumulator);
+}
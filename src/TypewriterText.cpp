@@ -0,0 +1,49 @@
+#include "TypewriterText.h"
+#include "imgui.h"
+#include <algorithm>
+
+TypewriterText::TypewriterText() : version(-1), font(nullptr), fontSize(0.0f), wrapWidth(0.0f) {}
+
+void TypewriterText::build(const std::string& text, ImFont* f, float size, float width) {
+    lines.clear();
+    if (text.empty()) lines.push_back({ 0, 0 });       // still one (empty) line tall
+    const char* begin = text.data();
+    const char* end = begin + text.size();
+    const char* s = begin;
+    while (s < end) {
+        // Same line breaks TextWrapped() picks for the full text
+        const char* eol = f->CalcWordWrapPosition(size, s, end, width);
+        lines.push_back({ (size_t)(s - begin), (size_t)(eol - begin) });
+        s = eol;
+        while (s < end && (*s == ' ' || *s == '\t')) s++;
+        if (s < end && *s == '\n') s++;
+    }
+    font = f;
+    fontSize = size;
+    wrapWidth = width;
+}
+
+void TypewriterText::draw(const std::string& text, int textVersion, size_t revealedBytes) {
+    ImFont* f = ImGui::GetFont();
+    float size = ImGui::GetFontSize();
+    float width = std::max(ImGui::GetContentRegionAvail().x, 1.0f);
+    if (textVersion != version || f != font || size != fontSize || width != wrapWidth) {
+        build(text, f, size, width);
+        version = textVersion;
+    }
+
+    // One item per line with no spacing in between, then the spacing once: the same layout as a single TextWrapped()
+    revealedBytes = std::min(revealedBytes, text.size());
+    const char* base = text.data();
+    int shown = 0;
+    ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(ImGui::GetStyle().ItemSpacing.x, 0.0f));
+    for (const Line& line : lines) {
+        if (line.begin >= revealedBytes && shown > 0) break;
+        ImGui::TextUnformatted(base + line.begin, base + std::min(line.end, revealedBytes));
+        shown++;
+    }
+    int hidden = (int)lines.size() - shown;
+    if (hidden > 0) ImGui::Dummy(ImVec2(0.0f, hidden * ImGui::GetTextLineHeight()));
+    ImGui::PopStyleVar();
+    ImGui::Dummy(ImVec2(0.0f, 0.0f));
+}
@@ -2580,12 +2580,47 @@ int ImTextCharFromUtf8(unsigned int* out_char, const char* in_text, const char*
     return wanted;
 }
 
+// Most text is ASCII: text loops skip decoding for whole runs of it.
+// With SSE, 16 bytes are checked at a time: as signed bytes, UTF-8 lead and continuation bytes are negative, so one compare catches both ends of the range.
+const char* ImTextFindAsciiRunEnd(const char* in_text, const char* in_text_end, int min_char)
+{
+    IM_ASSERT(min_char >= 1 && min_char < 0x80);
+    const char* p = in_text;
+#ifdef IMGUI_ENABLE_SSE
+    const __m128i v_min = _mm_set1_epi8((char)min_char);
+    while (in_text_end - p >= 16)
+    {
+        int mask = _mm_movemask_epi8(_mm_cmplt_epi8(_mm_loadu_si128((const __m128i*)(const void*)p), v_min));
+        if (mask != 0)
+        {
+            for (; (mask & 1) == 0; mask >>= 1)
+                p++;
+            return p;
+        }
+        p += 16;
+    }
+#endif
+    while (p < in_text_end && (unsigned char)*p >= (unsigned char)min_char && (unsigned char)*p < 0x80)
+        p++;
+    return p;
+}
+
 int ImTextStrFromUtf8(ImWchar* buf, int buf_size, const char* in_text, const char* in_text_end, const char** in_text_remaining)
 {
     ImWchar* buf_out = buf;
     ImWchar* buf_end = buf + buf_size;
     while (buf_out < buf_end - 1 && (!in_text_end || in_text < in_text_end) && *in_text)
     {
+        if (in_text_end != NULL)
+        {
+            const char* run_end = ImTextFindAsciiRunEnd(in_text, ImMin(in_text_end, in_text + (buf_end - 1 - buf_out)), 1);
+            if (run_end != in_text)
+            {
+                while (in_text < run_end)
+                    *buf_out++ = (ImWchar)(unsigned char)*in_text++;
+                continue;
+            }
+        }
         unsigned int c;
         in_text += ImTextCharFromUtf8(&c, in_text, in_text_end);
         *buf_out++ = (ImWchar)c;
@@ -2601,6 +2636,16 @@ int ImTextCountCharsFromUtf8(const char* in_text, const char* in_text_end)
     int char_count = 0;
     while ((!in_text_end || in_text < in_text_end) && *in_text)
     {
+        if (in_text_end != NULL)
+        {
+            const char* run_end = ImTextFindAsciiRunEnd(in_text, in_text_end, 1);
+            if (run_end != in_text)
+            {
+                char_count += (int)(run_end - in_text);
+                in_text = run_end;
+                continue;
+            }
+        }
         unsigned int c;
         in_text += ImTextCharFromUtf8(&c, in_text, in_text_end);
         char_count++;
@@ -17110,9 +17155,10 @@ void ImGui::DebugNodeDrawList(ImGuiWindow* window, ImGuiViewportP* viewport, con
                 for (int n = 0; n < 3; n++, idx_i++)
                 {
                     const ImDrawVert& v = vtx_buffer[idx_buffer ? idx_buffer[idx_i] : idx_i];
+                    const ImVec2 uv = v.uv;
                     triangle[n] = v.pos;
                     buf_p += ImFormatString(buf_p, buf_end - buf_p, "%s %04d: pos (%8.2f,%8.2f), uv (%.6f,%.6f), col %08X\n",
-                        (n == 0) ? "Vert:" : "     ", idx_i, v.pos.x, v.pos.y, v.uv.x, v.uv.y, v.col);
+                        (n == 0) ? "Vert:" : "     ", idx_i, triangle[n].x, triangle[n].y, uv.x, uv.y, v.col);
                 }
 
                 Selectable(buf, false);
@@ -802,6 +802,204 @@ void ImDrawList::PrimQuadUV(const ImVec2& a, const ImVec2& b, const ImVec2& c, c
 #define IM_FIXNORMAL2F_MAX_INVLEN2          100.0f // 500.0f (see #4053, #3366)
 #define IM_FIXNORMAL2F(VX,VY)               { float d2 = VX*VX + VY*VY; if (d2 > 0.000001f) { float inv_len2 = 1.0f / d2; if (inv_len2 > IM_FIXNORMAL2F_MAX_INVLEN2) inv_len2 = IM_FIXNORMAL2F_MAX_INVLEN2; VX *= inv_len2; VY *= inv_len2; } } (void)0
 
+// SSE2 paths writing ImDrawVert in bulk: AddPolyline() and AddConvexPolyFilled() anti-aliased fringes, RenderText() glyph runs.
+// Only for the default 20-bytes vertex layout (IMGUI_USE_COMPACT_DRAWVERT and custom layouts keep using the scalar loops).
+// Output is bit-identical to the scalar loops: same per-component float operations, in the same order.
+#if defined(IMGUI_ENABLE_SSE) && !defined(IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
+#define IMGUI_ENABLE_SSE_DRAWVERT
+#endif
+
+#ifdef IMGUI_ENABLE_SSE_DRAWVERT
+IM_STATIC_ASSERT(sizeof(ImDrawVert) == 20 && offsetof(ImDrawVert, uv) == 8 && offsetof(ImDrawVert, col) == 16);
+
+// A __m128 holds two ImVec2 (x0, y0, x1, y1). Each lane runs the operations of IM_NORMALIZE2F_OVER_ZERO() and IM_FIXNORMAL2F():
+// with SSE enabled ImRsqrt() is _mm_rsqrt_ss(), which gives the same result as _mm_rsqrt_ps() per lane. Multiplying by 1.0f leaves a value unchanged.
+static inline __m128 ImSseLengthSqr2(__m128 v) // (d2_0, d2_0, d2_1, d2_1)
+{
+    const __m128 sq = _mm_mul_ps(v, v);
+    return _mm_add_ps(sq, _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(2, 3, 0, 1)));
+}
+static inline __m128 ImSseSelect(__m128 mask, __m128 a, __m128 b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+static inline void   ImSseStore2(ImVec2* p, __m128 v) { _mm_storeu_ps(&p->x, v); }
+
+static inline __m128 ImSseNormalize2OverZero(__m128 v)
+{
+    const __m128 d2 = ImSseLengthSqr2(v);
+    return _mm_mul_ps(v, ImSseSelect(_mm_cmpgt_ps(d2, _mm_setzero_ps()), _mm_rsqrt_ps(d2), _mm_set1_ps(1.0f)));
+}
+
+static inline __m128 ImSseFixNormal2(__m128 v)
+{
+    const __m128 d2 = ImSseLengthSqr2(v);
+    const __m128 inv_len2 = _mm_min_ps(_mm_div_ps(_mm_set1_ps(1.0f), d2), _mm_set1_ps(IM_FIXNORMAL2F_MAX_INVLEN2));
+    return _mm_mul_ps(v, ImSseSelect(_mm_cmpgt_ps(d2, _mm_set1_ps(0.000001f)), inv_len2, _mm_set1_ps(1.0f)));
+}
+
+// Normal (dy, -dx) of each segment [points[i], points[i + 1]], 4 segments per iteration. When 'closed' the last one wraps to points[0].
+static void ImDrawListComputeNormals_SSE(const ImVec2* points, int points_count, bool closed, ImVec2* out_normals)
+{
+    const __m128 neg_y = _mm_set_ps(-0.0f, 0.0f, -0.0f, 0.0f);
+    int i = 0;
+    for (; i + 4 < points_count; i += 4)
+    {
+        const __m128 d01 = ImSseNormalize2OverZero(_mm_sub_ps(_mm_loadu_ps(&points[i + 1].x), _mm_loadu_ps(&points[i].x)));
+        const __m128 d23 = ImSseNormalize2OverZero(_mm_sub_ps(_mm_loadu_ps(&points[i + 3].x), _mm_loadu_ps(&points[i + 2].x)));
+        ImSseStore2(&out_normals[i], _mm_xor_ps(_mm_shuffle_ps(d01, d01, _MM_SHUFFLE(2, 3, 0, 1)), neg_y));
+        ImSseStore2(&out_normals[i + 2], _mm_xor_ps(_mm_shuffle_ps(d23, d23, _MM_SHUFFLE(2, 3, 0, 1)), neg_y));
+    }
+    const int count = closed ? points_count : points_count - 1;
+    for (; i < count; i++)
+    {
+        const int i2 = (i + 1) == points_count ? 0 : i + 1;
+        float dx = points[i2].x - points[i].x;
+        float dy = points[i2].y - points[i].y;
+        IM_NORMALIZE2F_OVER_ZERO(dx, dy);
+        out_normals[i].x = dy;
+        out_normals[i].y = -dx;
+    }
+    if (!closed)
+        out_normals[points_count - 1] = out_normals[points_count - 2];
+}
+
+// Offset of each point to the outer edge, before scaling: the averaged normals of the two segments meeting there, 4 points per iteration.
+// An open line keeps the normal of its first segment at points[0], as there is nothing to blend with.
+static void ImDrawListAverageNormals_SSE(const ImVec2* normals, int points_count, bool closed, ImVec2* out_dm)
+{
+    const __m128 half = _mm_set1_ps(0.5f);
+    int i = 1;
+    for (; i + 4 <= points_count; i += 4)
+    {
+        ImSseStore2(&out_dm[i], ImSseFixNormal2(_mm_mul_ps(_mm_add_ps(_mm_loadu_ps(&normals[i - 1].x), _mm_loadu_ps(&normals[i].x)), half)));
+        ImSseStore2(&out_dm[i + 2], ImSseFixNormal2(_mm_mul_ps(_mm_add_ps(_mm_loadu_ps(&normals[i + 1].x), _mm_loadu_ps(&normals[i + 2].x)), half)));
+    }
+    for (; i < points_count; i++)
+    {
+        float dm_x = (normals[i - 1].x + normals[i].x) * 0.5f;
+        float dm_y = (normals[i - 1].y + normals[i].y) * 0.5f;
+        IM_FIXNORMAL2F(dm_x, dm_y);
+        out_dm[i].x = dm_x;
+        out_dm[i].y = dm_y;
+    }
+    if (closed)
+    {
+        float dm_x = (normals[points_count - 1].x + normals[0].x) * 0.5f;
+        float dm_y = (normals[points_count - 1].y + normals[0].y) * 0.5f;
+        IM_FIXNORMAL2F(dm_x, dm_y);
+        out_dm[0].x = dm_x;
+        out_dm[0].y = dm_y;
+    }
+    else
+    {
+        out_dm[0] = normals[0];
+    }
+}
+
+// Write VTX_PER_POINT vertices for each point, two points per iteration: vertex k is at points[i] + dm[i] * scales[k], or at points[i] when scales[k] is 0.0f.
+// A negative scale gives the same result as subtracting the positive one.
+template<int VTX_PER_POINT>
+static ImDrawVert* ImDrawListWriteFringeVertices_SSE(ImDrawVert* vtx_write, const ImVec2* points, const ImVec2* dm, int points_count, const float* scales, const ImVec2* uvs, const ImU32* cols)
+{
+    __m128 scale_v[VTX_PER_POINT], uv_v[VTX_PER_POINT];
+    bool center[VTX_PER_POINT];
+    ImU32 col_v[VTX_PER_POINT];
+    for (int k = 0; k < VTX_PER_POINT; k++)
+    {
+        scale_v[k] = _mm_set1_ps(scales[k]);
+        uv_v[k] = _mm_setr_ps(uvs[k].x, uvs[k].y, uvs[k].x, uvs[k].y);
+        center[k] = (scales[k] == 0.0f);
+        col_v[k] = cols[k];
+    }
+    int i = 0;
+    for (; i + 2 <= points_count; i += 2, vtx_write += VTX_PER_POINT * 2)
+    {
+        const __m128 p = _mm_loadu_ps(&points[i].x);
+        const __m128 d = _mm_loadu_ps(&dm[i].x);
+        for (int k = 0; k < VTX_PER_POINT; k++)
+        {
+            const __m128 pos = center[k] ? p : _mm_add_ps(p, _mm_mul_ps(d, scale_v[k]));
+            _mm_storeu_ps(&vtx_write[k].pos.x, _mm_movelh_ps(pos, uv_v[k]));
+            _mm_storeu_ps(&vtx_write[VTX_PER_POINT + k].pos.x, _mm_movehl_ps(uv_v[k], pos));
+            vtx_write[k].col = col_v[k];
+            vtx_write[VTX_PER_POINT + k].col = col_v[k];
+        }
+    }
+    if (i < points_count)
+    {
+        const __m128 p = _mm_castpd_ps(_mm_load_sd((const double*)(const void*)&points[i]));
+        const __m128 d = _mm_castpd_ps(_mm_load_sd((const double*)(const void*)&dm[i]));
+        for (int k = 0; k < VTX_PER_POINT; k++)
+        {
+            const __m128 pos = center[k] ? p : _mm_add_ps(p, _mm_mul_ps(d, scale_v[k]));
+            _mm_storeu_ps(&vtx_write[k].pos.x, _mm_movelh_ps(pos, uv_v[k]));
+            vtx_write[k].col = col_v[k];
+        }
+        vtx_write += VTX_PER_POINT;
+    }
+    return vtx_write;
+}
+
+// Indices of each segment, from a pattern where values 0..3 are vertices of the first point and 8..11 vertices of the second one.
+// Whole blocks of 8 segments are one precomputed block plus the index of their first vertex. When 'closed' the second point of
+// the last segment is the first point of the line.
+static ImDrawIdx* ImDrawListWriteSegmentIndices_SSE(ImDrawIdx* idx_write, unsigned int vtx_base, int points_count, bool closed, int vtx_per_point, const unsigned char* pattern, int pattern_size)
+{
+    const int BLOCK_SEGMENTS = 8;
+    ImDrawIdx block[BLOCK_SEGMENTS * 18];
+    for (int j = 0; j < BLOCK_SEGMENTS; j++)
+        for (int k = 0; k < pattern_size; k++)
+            block[j * pattern_size + k] = (ImDrawIdx)(j * vtx_per_point + ((pattern[k] >= 8) ? (pattern[k] - 8 + vtx_per_point) : pattern[k]));
+    const int block_size = BLOCK_SEGMENTS * pattern_size; // 48, 96 or 144: a multiple of 16 bytes with 16 or 32-bit indices
+    unsigned int idx1 = vtx_base;
+    int i1 = 0;
+    for (; i1 + BLOCK_SEGMENTS <= points_count - 1; i1 += BLOCK_SEGMENTS, idx1 += BLOCK_SEGMENTS * vtx_per_point, idx_write += block_size)
+    {
+        const __m128i base = (sizeof(ImDrawIdx) == 2) ? _mm_set1_epi16((short)idx1) : _mm_set1_epi32((int)idx1);
+        for (int n = 0; n < block_size; n += 16 / (int)sizeof(ImDrawIdx))
+        {
+            const __m128i v = _mm_loadu_si128((const __m128i*)(const void*)&block[n]);
+            _mm_storeu_si128((__m128i*)(void*)&idx_write[n], (sizeof(ImDrawIdx) == 2) ? _mm_add_epi16(v, base) : _mm_add_epi32(v, base));
+        }
+    }
+    for (; i1 < points_count - 1; i1++, idx1 += vtx_per_point, idx_write += pattern_size)
+        for (int k = 0; k < pattern_size; k++)
+            idx_write[k] = (ImDrawIdx)(idx1 + block[k]);
+    if (closed)
+    {
+        for (int k = 0; k < pattern_size; k++)
+            idx_write[k] = (ImDrawIdx)((pattern[k] >= 8) ? (vtx_base + pattern[k] - 8) : (idx1 + pattern[k]));
+        idx_write += pattern_size;
+    }
+    return idx_write;
+}
+
+// Anti-aliased fringe of a filled shape, same geometry as the loops in AddConvexPolyFilled(): the inner and outer vertices of each point,
+// then two triangles per edge. The fill triangles are up to the caller. Leaves _VtxCurrentIdx alone.
+static void ImDrawListAddFillFringe_SSE(ImDrawList* draw_list, const ImVec2* points, int points_count, ImU32 col)
+{
+    const float AA_SIZE = draw_list->_FringeScale;
+    const ImVec2 uv = draw_list->_Data->TexUvWhitePixel;
+    draw_list->_Data->TempBuffer.reserve_discard(points_count * 2);
+    ImVec2* temp_normals = draw_list->_Data->TempBuffer.Data;
+    ImVec2* temp_dm = temp_normals + points_count;
+    ImDrawListComputeNormals_SSE(points, points_count, true, temp_normals);
+    ImDrawListAverageNormals_SSE(temp_normals, points_count, true, temp_dm);
+    const float scales[2] = { -(AA_SIZE * 0.5f), AA_SIZE * 0.5f };
+    const ImVec2 uvs[2] = { uv, uv };
+    const ImU32 cols[2] = { col, col & ~IM_COL32_A_MASK };
+    draw_list->_VtxWritePtr = ImDrawListWriteFringeVertices_SSE<2>(draw_list->_VtxWritePtr, points, temp_dm, points_count, scales, uvs, cols);
+
+    // Fringe of the edge closing the shape first, then the others in order
+    static const unsigned char idx_pattern_fringe[6] = { 8, 0, 1, 1, 9, 8 };
+    const unsigned int vtx_inner_idx = draw_list->_VtxCurrentIdx;
+    const unsigned int vtx_outer_idx = vtx_inner_idx + 1;
+    const int i0 = points_count - 1;
+    ImDrawIdx* idx_write = draw_list->_IdxWritePtr;
+    idx_write[0] = (ImDrawIdx)(vtx_inner_idx); idx_write[1] = (ImDrawIdx)(vtx_inner_idx + (i0 << 1)); idx_write[2] = (ImDrawIdx)(vtx_outer_idx + (i0 << 1));
+    idx_write[3] = (ImDrawIdx)(vtx_outer_idx + (i0 << 1)); idx_write[4] = (ImDrawIdx)(vtx_outer_idx); idx_write[5] = (ImDrawIdx)(vtx_inner_idx);
+    draw_list->_IdxWritePtr = ImDrawListWriteSegmentIndices_SSE(idx_write + 6, vtx_inner_idx, points_count, false, 2, idx_pattern_fringe, 6);
+}
+#endif // #ifdef IMGUI_ENABLE_SSE_DRAWVERT
+
 // TODO: Thickness anti-aliased lines cap are missing their AA fringe.
 // We avoid using the ImVec2 math operators here to reduce cost to a minimum for debug/non-inlined builds.
 void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32 col, ImDrawFlags flags, float thickness)
@@ -843,6 +1041,46 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
         ImVec2* temp_normals = _Data->TempBuffer.Data;
         ImVec2* temp_points = temp_normals + points_count;
 
+#ifdef IMGUI_ENABLE_SSE_DRAWVERT
+        {
+            // Same geometry as the loops below: normals, then the offset at each point, then vertices written straight to _VtxWritePtr.
+            static const unsigned char idx_pattern_tex[6] = { 8, 0, 1, 9, 1, 8 };
+            static const unsigned char idx_pattern_thin[12] = { 8, 0, 2, 2, 10, 8, 9, 1, 0, 0, 8, 9 };
+            static const unsigned char idx_pattern_thick[18] = { 9, 1, 2, 2, 10, 9, 9, 1, 0, 0, 8, 9, 10, 2, 3, 3, 11, 10 };
+            ImDrawListComputeNormals_SSE(points, points_count, closed, temp_normals);
+            ImDrawListAverageNormals_SSE(temp_normals, points_count, closed, temp_points);
+            if (use_texture)
+            {
+                const ImVec4 tex_uvs = _Data->TexUvLines[integer_thickness];
+                const float half_draw_size = (thickness * 0.5f) + 1;
+                const float scales[2] = { half_draw_size, -half_draw_size };
+                const ImVec2 uvs[2] = { ImVec2(tex_uvs.x, tex_uvs.y), ImVec2(tex_uvs.z, tex_uvs.w) };
+                const ImU32 cols[2] = { col, col };
+                _IdxWritePtr = ImDrawListWriteSegmentIndices_SSE(_IdxWritePtr, _VtxCurrentIdx, points_count, closed, 2, idx_pattern_tex, 6);
+                _VtxWritePtr = ImDrawListWriteFringeVertices_SSE<2>(_VtxWritePtr, points, temp_points, points_count, scales, uvs, cols);
+            }
+            else if (!thick_line)
+            {
+                const float scales[3] = { 0.0f, AA_SIZE, -AA_SIZE };
+                const ImVec2 uvs[3] = { opaque_uv, opaque_uv, opaque_uv };
+                const ImU32 cols[3] = { col, col_trans, col_trans };
+                _IdxWritePtr = ImDrawListWriteSegmentIndices_SSE(_IdxWritePtr, _VtxCurrentIdx, points_count, closed, 3, idx_pattern_thin, 12);
+                _VtxWritePtr = ImDrawListWriteFringeVertices_SSE<3>(_VtxWritePtr, points, temp_points, points_count, scales, uvs, cols);
+            }
+            else
+            {
+                const float half_inner_thickness = (thickness - AA_SIZE) * 0.5f;
+                const float scales[4] = { half_inner_thickness + AA_SIZE, half_inner_thickness, -half_inner_thickness, -(half_inner_thickness + AA_SIZE) };
+                const ImVec2 uvs[4] = { opaque_uv, opaque_uv, opaque_uv, opaque_uv };
+                const ImU32 cols[4] = { col_trans, col, col, col_trans };
+                _IdxWritePtr = ImDrawListWriteSegmentIndices_SSE(_IdxWritePtr, _VtxCurrentIdx, points_count, closed, 4, idx_pattern_thick, 18);
+                _VtxWritePtr = ImDrawListWriteFringeVertices_SSE<4>(_VtxWritePtr, points, temp_points, points_count, scales, uvs, cols);
+            }
+            _VtxCurrentIdx += (ImDrawIdx)vtx_count;
+            return;
+        }
+#endif
+
         // Calculate normals (tangents) for each line segment
         for (int i1 = 0; i1 < count; i1++)
         {
@@ -1046,10 +1284,10 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
             dx *= (thickness * 0.5f);
             dy *= (thickness * 0.5f);
 
-            _VtxWritePtr[0].pos.x = p1.x + dy; _VtxWritePtr[0].pos.y = p1.y - dx; _VtxWritePtr[0].uv = opaque_uv; _VtxWritePtr[0].col = col;
-            _VtxWritePtr[1].pos.x = p2.x + dy; _VtxWritePtr[1].pos.y = p2.y - dx; _VtxWritePtr[1].uv = opaque_uv; _VtxWritePtr[1].col = col;
-            _VtxWritePtr[2].pos.x = p2.x - dy; _VtxWritePtr[2].pos.y = p2.y + dx; _VtxWritePtr[2].uv = opaque_uv; _VtxWritePtr[2].col = col;
-            _VtxWritePtr[3].pos.x = p1.x - dy; _VtxWritePtr[3].pos.y = p1.y + dx; _VtxWritePtr[3].uv = opaque_uv; _VtxWritePtr[3].col = col;
+            _VtxWritePtr[0].pos = ImVec2(p1.x + dy, p1.y - dx); _VtxWritePtr[0].uv = opaque_uv; _VtxWritePtr[0].col = col;
+            _VtxWritePtr[1].pos = ImVec2(p2.x + dy, p2.y - dx); _VtxWritePtr[1].uv = opaque_uv; _VtxWritePtr[1].col = col;
+            _VtxWritePtr[2].pos = ImVec2(p2.x - dy, p2.y + dx); _VtxWritePtr[2].uv = opaque_uv; _VtxWritePtr[2].col = col;
+            _VtxWritePtr[3].pos = ImVec2(p1.x - dy, p1.y + dx); _VtxWritePtr[3].uv = opaque_uv; _VtxWritePtr[3].col = col;
             _VtxWritePtr += 4;
 
             _IdxWritePtr[0] = (ImDrawIdx)(_VtxCurrentIdx); _IdxWritePtr[1] = (ImDrawIdx)(_VtxCurrentIdx + 1); _IdxWritePtr[2] = (ImDrawIdx)(_VtxCurrentIdx + 2);
@@ -1087,6 +1325,12 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
             _IdxWritePtr += 3;
         }
 
+#ifdef IMGUI_ENABLE_SSE_DRAWVERT
+        ImDrawListAddFillFringe_SSE(this, points, points_count, col);
+        _VtxCurrentIdx += (ImDrawIdx)vtx_count;
+        return;
+#endif
+
         // Compute normals
         _Data->TempBuffer.reserve_discard(points_count);
         ImVec2* temp_normals = _Data->TempBuffer.Data;
@@ -1113,8 +1357,8 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
             dm_y *= AA_SIZE * 0.5f;
 
             // Add vertices
-            _VtxWritePtr[0].pos.x = (points[i1].x - dm_x); _VtxWritePtr[0].pos.y = (points[i1].y - dm_y); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
-            _VtxWritePtr[1].pos.x = (points[i1].x + dm_x); _VtxWritePtr[1].pos.y = (points[i1].y + dm_y); _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;  // Outer
+            _VtxWritePtr[0].pos = ImVec2(points[i1].x - dm_x, points[i1].y - dm_y); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
+            _VtxWritePtr[1].pos = ImVec2(points[i1].x + dm_x, points[i1].y + dm_y); _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;  // Outer
             _VtxWritePtr += 2;
 
             // Add indexes for fringes
@@ -1801,6 +2045,8 @@ void ImDrawList::AddImageRounded(ImTextureRef tex_ref, const ImVec2& p_min, cons
 // Triangulate concave polygons. Based on "Triangulation by Ear Clipping" paper, O(N^2) complexity.
 // Reference: https://www.geometrictools.com/Documentation/TriangulationByEarClipping.pdf
 // Provided as a convenience for user but not used by main library.
+// Large polygons keep their reflex vertices in a uniform grid, so testing an ear only visits the reflexes near it:
+// close to linear for outlines with evenly spread points, same triangles as the plain list.
 //-----------------------------------------------------------------------------
 // - ImTriangulator [Internal]
 // - AddConcavePolyFilled()
@@ -1820,6 +2066,9 @@ struct ImTriangulatorNode
     ImVec2                  Pos;
     ImTriangulatorNode*     Next;
     ImTriangulatorNode*     Prev;
+    int                     SpanIndex;      // Position in _Ears or _Reflexes, according to Type
+    ImTriangulatorNode*     CellNext;       // Reflexes in the same grid cell
+    ImTriangulatorNode*     CellPrev;
 
     void    Unlink()        { Next->Prev = Prev; Prev->Next = Next; }
 };
@@ -1829,14 +2078,25 @@ struct ImTriangulatorNodeSpan
     ImTriangulatorNode**    Data = NULL;
     int                     Size = 0;
 
-    void    push_back(ImTriangulatorNode* node) { Data[Size++] = node; }
-    void    find_erase_unsorted(int idx)        { for (int i = Size - 1; i >= 0; i--) if (Data[i]->Index == idx) { Data[i] = Data[Size - 1]; Size--; return; } }
+    void    push_back(ImTriangulatorNode* node) { node->SpanIndex = Size; Data[Size++] = node; }
+    bool    erase_unsorted(ImTriangulatorNode* node) // The node may not be there (e.g. type left over from before GetNextTriangle() rebuilt the lists)
+    {
+        const int idx = node->SpanIndex;
+        if (idx < 0 || idx >= Size || Data[idx] != node)
+            return false;
+        Data[idx] = Data[Size - 1];
+        Data[idx]->SpanIndex = idx;
+        Size--;
+        return true;
+    }
 };
 
+#define IM_TRIANGULATOR_GRID_MIN_POINTS     64      // Below this, testing every reflex is cheaper than maintaining the grid
+
 struct ImTriangulator
 {
     static int EstimateTriangleCount(int points_count)      { return (points_count < 3) ? 0 : points_count - 2; }
-    static int EstimateScratchBufferSize(int points_count)  { return sizeof(ImTriangulatorNode) * points_count + sizeof(ImTriangulatorNode*) * points_count * 2; }
+    static int EstimateScratchBufferSize(int points_count)  { return sizeof(ImTriangulatorNode) * points_count + sizeof(ImTriangulatorNode*) * points_count * 3; }
 
     void    Init(const ImVec2* points, int points_count, void* scratch_buffer);
     void    GetNextTriangle(unsigned int out_triangle[3]);     // Return relative indexes for next triangle
@@ -1845,15 +2105,25 @@ struct ImTriangulator
     void    BuildNodes(const ImVec2* points, int points_count);
     void    BuildReflexes();
     void    BuildEars();
+    void    BuildGrid(const ImVec2* points, int points_count);
     void    FlipNodeList();
     bool    IsEar(int i0, int i1, int i2, const ImVec2& v0, const ImVec2& v1, const ImVec2& v2) const;
     void    ReclassifyNode(ImTriangulatorNode* node);
+    void    AddReflex(ImTriangulatorNode* node);
+    void    RemoveReflex(ImTriangulatorNode* node);
+    int     GetCellX(float x) const     { return ImClamp((int)((x - _GridMin.x) * _GridScale.x), 0, _GridSizeX - 1); }
+    int     GetCellY(float y) const     { return ImClamp((int)((y - _GridMin.y) * _GridScale.y), 0, _GridSizeY - 1); }
 
     // Internal members
     int                     _TrianglesLeft = 0;
     ImTriangulatorNode*     _Nodes = NULL;
     ImTriangulatorNodeSpan  _Ears;
     ImTriangulatorNodeSpan  _Reflexes;
+    ImTriangulatorNode**    _Grid = NULL;   // _GridSizeX * _GridSizeY lists of reflexes, NULL when not used
+    int                     _GridSizeX = 0;
+    int                     _GridSizeY = 0;
+    ImVec2                  _GridMin;
+    ImVec2                  _GridScale;     // Cells per unit
 };
 
 // Distribute storage for nodes, ears and reflexes.
@@ -1867,6 +2137,7 @@ void ImTriangulator::Init(const ImVec2* points, int points_count, void* scratch_
     _Ears.Data     = (ImTriangulatorNode**)(_Nodes + points_count);                // points_count x Node*
     _Reflexes.Data = (ImTriangulatorNode**)(_Nodes + points_count) + points_count; // points_count x Node*
     BuildNodes(points, points_count);
+    BuildGrid(points, points_count);                                               // up to points_count x Node*
     BuildReflexes();
     BuildEars();
 }
@@ -1880,11 +2151,62 @@ void ImTriangulator::BuildNodes(const ImVec2* points, int points_count)
         _Nodes[i].Pos = points[i];
         _Nodes[i].Next = _Nodes + i + 1;
         _Nodes[i].Prev = _Nodes + i - 1;
+        _Nodes[i].SpanIndex = -1;
     }
     _Nodes[0].Prev = _Nodes + points_count - 1;
     _Nodes[points_count - 1].Next = _Nodes;
 }
 
+// About two points per cell, following the aspect ratio of the bounding box. No grid for small or degenerate polygons.
+void ImTriangulator::BuildGrid(const ImVec2* points, int points_count)
+{
+    _Grid = NULL;
+    if (points_count < IM_TRIANGULATOR_GRID_MIN_POINTS)
+        return;
+    ImVec2 p_min = points[0], p_max = points[0];
+    for (int i = 1; i < points_count; i++)
+    {
+        p_min = ImMin(p_min, points[i]);
+        p_max = ImMax(p_max, points[i]);
+    }
+    const float w = p_max.x - p_min.x;
+    const float h = p_max.y - p_min.y;
+    if (!(w > 0.0f && h > 0.0f && w < FLT_MAX && h < FLT_MAX)) // Also rejects NaN and infinite coordinates
+        return;
+    const int cells = points_count / 2;
+    _GridSizeX = ImClamp((int)ImSqrt(cells * w / h), 1, cells);
+    _GridSizeY = ImClamp(cells / _GridSizeX, 1, cells);
+    _GridMin = p_min;
+    _GridScale = ImVec2(_GridSizeX / w, _GridSizeY / h);
+    _Grid = _Reflexes.Data + points_count;
+    memset(_Grid, 0, sizeof(ImTriangulatorNode*) * _GridSizeX * _GridSizeY);
+}
+
+void ImTriangulator::AddReflex(ImTriangulatorNode* node)
+{
+    _Reflexes.push_back(node);
+    if (_Grid == NULL)
+        return;
+    ImTriangulatorNode** cell = &_Grid[GetCellY(node->Pos.y) * _GridSizeX + GetCellX(node->Pos.x)];
+    node->CellPrev = NULL;
+    node->CellNext = *cell;
+    if (*cell)
+        (*cell)->CellPrev = node;
+    *cell = node;
+}
+
+void ImTriangulator::RemoveReflex(ImTriangulatorNode* node)
+{
+    if (!_Reflexes.erase_unsorted(node) || _Grid == NULL)
+        return;
+    if (node->CellNext)
+        node->CellNext->CellPrev = node->CellPrev;
+    if (node->CellPrev)
+        node->CellPrev->CellNext = node->CellNext;
+    else
+        _Grid[GetCellY(node->Pos.y) * _GridSizeX + GetCellX(node->Pos.x)] = node->CellNext;
+}
+
 void ImTriangulator::BuildReflexes()
 {
     ImTriangulatorNode* n1 = _Nodes;
@@ -1893,7 +2215,7 @@ void ImTriangulator::BuildReflexes()
         if (ImTriangleIsClockwise(n1->Prev->Pos, n1->Pos, n1->Next->Pos))
             continue;
         n1->Type = ImTriangulatorNodeType_Reflex;
-        _Reflexes.push_back(n1);
+        AddReflex(n1);
     }
 }
 
@@ -1921,6 +2243,8 @@ void ImTriangulator::GetNextTriangle(unsigned int out_triangle[3])
         for (int i = _TrianglesLeft; i >= 0; i--, node = node->Next)
             node->Type = ImTriangulatorNodeType_Convex;
         _Reflexes.Size = 0;
+        if (_Grid)
+            memset(_Grid, 0, sizeof(ImTriangulatorNode*) * _GridSizeX * _GridSizeY);
         BuildReflexes();
         BuildEars();
 
@@ -1971,8 +2295,24 @@ void ImTriangulator::FlipNodeList()
 }
 
 // A triangle is an ear is no other vertex is inside it. We can test reflexes vertices only (see reference algorithm)
+// With the grid, only the reflexes in the cells overlapping the bounding box of the triangle.
 bool ImTriangulator::IsEar(int i0, int i1, int i2, const ImVec2& v0, const ImVec2& v1, const ImVec2& v2) const
 {
+    if (_Grid)
+    {
+        const int cx0 = GetCellX(ImMin(ImMin(v0.x, v1.x), v2.x)), cx1 = GetCellX(ImMax(ImMax(v0.x, v1.x), v2.x));
+        const int cy0 = GetCellY(ImMin(ImMin(v0.y, v1.y), v2.y)), cy1 = GetCellY(ImMax(ImMax(v0.y, v1.y), v2.y));
+        if ((cx1 - cx0 + 1) * (cy1 - cy0 + 1) < _Reflexes.Size)
+        {
+            for (int cy = cy0; cy <= cy1; cy++)
+                for (int cx = cx0; cx <= cx1; cx++)
+                    for (ImTriangulatorNode* reflex = _Grid[cy * _GridSizeX + cx]; reflex != NULL; reflex = reflex->CellNext)
+                        if (reflex->Index != i0 && reflex->Index != i1 && reflex->Index != i2)
+                            if (ImTriangleContainsPoint(v0, v1, v2, reflex->Pos))
+                                return false;
+            return true;
+        }
+    }
     ImTriangulatorNode** p_end = _Reflexes.Data + _Reflexes.Size;
     for (ImTriangulatorNode** p = _Reflexes.Data; p < p_end; p++)
     {
@@ -2001,16 +2341,65 @@ void ImTriangulator::ReclassifyNode(ImTriangulatorNode* n1)
     if (type == n1->Type)
         return;
     if (n1->Type == ImTriangulatorNodeType_Reflex)
-        _Reflexes.find_erase_unsorted(n1->Index);
+        RemoveReflex(n1);
     else if (n1->Type == ImTriangulatorNodeType_Ear)
-        _Ears.find_erase_unsorted(n1->Index);
+        _Ears.erase_unsorted(n1);
     if (type == ImTriangulatorNodeType_Reflex)
-        _Reflexes.push_back(n1);
+        AddReflex(n1);
     else if (type == ImTriangulatorNodeType_Ear)
         _Ears.push_back(n1);
     n1->Type = type;
 }
 
+// Fill triangles of a polygon, writing 'idx_base + point_index * idx_stride' for each corner.
+// With ImDrawListSharedData::TriangulationCacheCapacity > 0 the triangles come from the cache, or are triangulated once and kept there.
+static void ImDrawListWriteConcaveFillIndices(ImDrawList* draw_list, const ImVec2* points, int points_count, unsigned int idx_base, unsigned int idx_stride)
+{
+    ImDrawListSharedData* data = draw_list->_Data;
+    ImLruCache<ImDrawListTriangulation>& cache = data->TriangulationCache;
+    ImTriangulator triangulator;
+    unsigned int triangle[3];
+    if (data->TriangulationCacheCapacity <= 0)
+    {
+        if (cache.Entries.Size > 0)
+            cache.Clear();
+        data->TempBuffer.reserve_discard((ImTriangulator::EstimateScratchBufferSize(points_count) + sizeof(ImVec2)) / sizeof(ImVec2));
+        triangulator.Init(points, points_count, data->TempBuffer.Data);
+        ImDrawIdx* idx_write = draw_list->_IdxWritePtr;
+        while (triangulator._TrianglesLeft > 0)
+        {
+            triangulator.GetNextTriangle(triangle);
+            idx_write[0] = (ImDrawIdx)(idx_base + triangle[0] * idx_stride); idx_write[1] = (ImDrawIdx)(idx_base + triangle[1] * idx_stride); idx_write[2] = (ImDrawIdx)(idx_base + triangle[2] * idx_stride);
+            idx_write += 3;
+        }
+        draw_list->_IdxWritePtr = idx_write;
+        return;
+    }
+
+    const int points_size = (int)sizeof(ImVec2) * points_count;
+    ImDrawListTriangulation* found = cache.Find(NULL, 0, points, points_size);
+    if (found != NULL)
+    {
+        data->TriangulationCacheHits++;
+    }
+    else
+    {
+        found = cache.Add(data->TriangulationCacheCapacity, NULL, 0, points, points_size);
+        found->Triangles.resize(ImTriangulator::EstimateTriangleCount(points_count) * 3);
+        data->TempBuffer.reserve_discard((ImTriangulator::EstimateScratchBufferSize(points_count) + sizeof(ImVec2)) / sizeof(ImVec2));
+        triangulator.Init(points, points_count, data->TempBuffer.Data);
+        for (unsigned int* out = found->Triangles.Data; triangulator._TrianglesLeft > 0; out += 3)
+            triangulator.GetNextTriangle(out);
+        data->TriangulationCacheMisses++;
+    }
+
+    ImDrawIdx* idx_write = draw_list->_IdxWritePtr;
+    const unsigned int* tri = found->Triangles.Data;
+    for (int n = found->Triangles.Size; n > 0; n--)
+        *idx_write++ = (ImDrawIdx)(idx_base + *tri++ * idx_stride);
+    draw_list->_IdxWritePtr = idx_write;
+}
+
 // Use ear-clipping algorithm to triangulate a simple polygon (no self-interaction, no holes).
 // (Reminder: we don't perform any coarse clipping/culling in ImDrawList layer!
 // It is up to caller to ensure not making costly calls that will be outside of visible area.
@@ -2022,8 +2411,6 @@ void ImDrawList::AddConcavePolyFilled(const ImVec2* points, const int points_cou
         return;
 
     const ImVec2 uv = _Data->TexUvWhitePixel;
-    ImTriangulator triangulator;
-    unsigned int triangle[3];
     if (Flags & ImDrawListFlags_AntiAliasedFill)
     {
         // Anti-aliased Fill
@@ -2036,15 +2423,13 @@ void ImDrawList::AddConcavePolyFilled(const ImVec2* points, const int points_cou
         // Add indexes for fill
         unsigned int vtx_inner_idx = _VtxCurrentIdx;
         unsigned int vtx_outer_idx = _VtxCurrentIdx + 1;
+        ImDrawListWriteConcaveFillIndices(this, points, points_count, vtx_inner_idx, 2);
 
-        _Data->TempBuffer.reserve_discard((ImTriangulator::EstimateScratchBufferSize(points_count) + sizeof(ImVec2)) / sizeof(ImVec2));
-        triangulator.Init(points, points_count, _Data->TempBuffer.Data);
-        while (triangulator._TrianglesLeft > 0)
-        {
-            triangulator.GetNextTriangle(triangle);
-            _IdxWritePtr[0] = (ImDrawIdx)(vtx_inner_idx + (triangle[0] << 1)); _IdxWritePtr[1] = (ImDrawIdx)(vtx_inner_idx + (triangle[1] << 1)); _IdxWritePtr[2] = (ImDrawIdx)(vtx_inner_idx + (triangle[2] << 1));
-            _IdxWritePtr += 3;
-        }
+#ifdef IMGUI_ENABLE_SSE_DRAWVERT
+        ImDrawListAddFillFringe_SSE(this, points, points_count, col);
+        _VtxCurrentIdx += (ImDrawIdx)vtx_count;
+        return;
+#endif
 
         // Compute normals
         _Data->TempBuffer.reserve_discard(points_count);
@@ -2072,8 +2457,8 @@ void ImDrawList::AddConcavePolyFilled(const ImVec2* points, const int points_cou
             dm_y *= AA_SIZE * 0.5f;
 
             // Add vertices
-            _VtxWritePtr[0].pos.x = (points[i1].x - dm_x); _VtxWritePtr[0].pos.y = (points[i1].y - dm_y); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
-            _VtxWritePtr[1].pos.x = (points[i1].x + dm_x); _VtxWritePtr[1].pos.y = (points[i1].y + dm_y); _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;  // Outer
+            _VtxWritePtr[0].pos = ImVec2(points[i1].x - dm_x, points[i1].y - dm_y); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
+            _VtxWritePtr[1].pos = ImVec2(points[i1].x + dm_x, points[i1].y + dm_y); _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;  // Outer
             _VtxWritePtr += 2;
 
             // Add indexes for fringes
@@ -2094,14 +2479,7 @@ void ImDrawList::AddConcavePolyFilled(const ImVec2* points, const int points_cou
             _VtxWritePtr[0].pos = points[i]; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
             _VtxWritePtr++;
         }
-        _Data->TempBuffer.reserve_discard((ImTriangulator::EstimateScratchBufferSize(points_count) + sizeof(ImVec2)) / sizeof(ImVec2));
-        triangulator.Init(points, points_count, _Data->TempBuffer.Data);
-        while (triangulator._TrianglesLeft > 0)
-        {
-            triangulator.GetNextTriangle(triangle);
-            _IdxWritePtr[0] = (ImDrawIdx)(_VtxCurrentIdx + triangle[0]); _IdxWritePtr[1] = (ImDrawIdx)(_VtxCurrentIdx + triangle[1]); _IdxWritePtr[2] = (ImDrawIdx)(_VtxCurrentIdx + triangle[2]);
-            _IdxWritePtr += 3;
-        }
+        ImDrawListWriteConcaveFillIndices(this, points, points_count, _VtxCurrentIdx, 1);
         _VtxCurrentIdx += (ImDrawIdx)vtx_count;
     }
 }
@@ -2391,12 +2769,12 @@ void ImGui::ShadeVertsLinearUV(ImDrawList* draw_list, int vert_start_idx, int ve
         const ImVec2 min = ImMin(uv_a, uv_b);
         const ImVec2 max = ImMax(uv_a, uv_b);
         for (ImDrawVert* vertex = vert_start; vertex < vert_end; ++vertex)
-            vertex->uv = ImClamp(uv_a + ImMul(ImVec2(vertex->pos.x, vertex->pos.y) - a, scale), min, max);
+            vertex->uv = ImClamp(uv_a + ImMul(ImVec2(vertex->pos) - a, scale), min, max);
     }
     else
     {
         for (ImDrawVert* vertex = vert_start; vertex < vert_end; ++vertex)
-            vertex->uv = uv_a + ImMul(ImVec2(vertex->pos.x, vertex->pos.y) - a, scale);
+            vertex->uv = uv_a + ImMul(ImVec2(vertex->pos) - a, scale);
     }
 }
 
@@ -3643,6 +4021,7 @@ bool ImFontAtlasFontInitOutput(ImFontAtlas* atlas, ImFont* font)
 // Keep source/input FontData
 void ImFontAtlasFontDestroyOutput(ImFontAtlas* atlas, ImFont* font)
 {
+    ImFontAtlasWrapCacheClear(atlas);
     font->ClearOutputData();
     for (ImFontConfig* src : font->Sources)
     {
@@ -3916,6 +4295,11 @@ void ImFontAtlasBakedDiscard(ImFontAtlas* atlas, ImFont* font, ImFontBaked* bake
     }
     builder->BakedMap.SetVoidPtr(baked->BakedId, NULL);
     builder->BakedDiscardedCount++;
+    // Only mark its wrap layouts dead: we may be in a glyph load from RenderText() or ImFontGetWrapLayout(), which hold a layout.
+    // The next misses reuse them first.
+    for (ImLruCache<ImFontWrapLayout>::Entry* entry : builder->WrapCache.Entries)
+        if (entry->Value.Params.BakedId == baked->BakedId)
+            builder->WrapCache.Kill(entry);
     baked->ClearOutputData();
     baked->WantDestroy = true;
     font->LastBaked = NULL;
@@ -4215,6 +4599,12 @@ ImVec2i ImFontAtlasTextureGetSizeEstimate(ImFontAtlas* atlas)
 }
 
 // Clear all output. Invalidates all AddCustomRect() return values!
+void ImFontAtlasWrapCacheClear(ImFontAtlas* atlas)
+{
+    if (atlas->Builder != NULL)
+        atlas->Builder->WrapCache.Clear();
+}
+
 void ImFontAtlasBuildClear(ImFontAtlas* atlas)
 {
     ImVec2i new_tex_size = ImFontAtlasTextureGetSizeEstimate(atlas);
@@ -5591,8 +5981,90 @@ const char* ImFontCalcWordWrapPositionEx(ImFont* font, float size, const char* t
     return s;
 }
 
+// Word-wrap layout cache: same line breaks and sizes as the ImFontCalcTextSizeEx() loop below, computed once per text.
+static void ImFontBuildWrapLayout(ImFont* font, ImFontBaked* baked, ImFontWrapLayout* layout, const char* text_begin, const char* text_end)
+{
+    const float size = layout->Params.Size;
+    const float line_height = size;
+    const float scale = size / baked->Size;
+
+    ImVec2 text_size = ImVec2(0, 0);
+    float line_width = 0.0f;
+    layout->Lines.resize(0);
+
+    const char* s = text_begin;
+    while (s < text_end)
+    {
+        const char* word_wrap_eol = ImFontCalcWordWrapPositionEx(font, size, s, text_end, layout->Params.WrapWidth, layout->Params.Flags);
+        ImFontWrapLine line;
+        line.Begin = (int)(s - text_begin);
+        line.End = (int)(word_wrap_eol - text_begin);
+        line_width = 0.0f;
+        while (s < word_wrap_eol && s < text_end) // Never sees a '\n': the wrap position stops before it
+        {
+            unsigned int c = (unsigned int)*s;
+            if (c < 0x80)
+                s += 1;
+            else
+                s += ImTextCharFromUtf8(&c, s, text_end);
+            if (c == '\r')
+                continue;
+            float char_width = (c < (unsigned int)baked->IndexAdvanceX.Size) ? baked->IndexAdvanceX.Data[c] : -1.0f;
+            if (char_width < 0.0f)
+                char_width = BuildLoadGlyphGetAdvanceOrFallback(baked, c);
+            char_width *= scale;
+            line_width += char_width;
+        }
+        line.Width = line_width;
+        layout->Lines.push_back(line);
+        if (text_size.x < line_width)
+            text_size.x = line_width;
+        if (s >= text_end)
+            break;
+        text_size.y += line_height;
+        line_width = 0.0f;
+        s = ImTextCalcWordWrapNextLineStart(s, text_end, layout->Params.Flags);
+    }
+    if (line_width > 0 || text_size.y == 0.0f)
+        text_size.y += line_height;
+    layout->TextSize = text_size;
+}
+
+const ImFontWrapLayout* ImFontGetWrapLayout(ImFont* font, float size, float wrap_width, const char* text_begin, const char* text_end, ImDrawTextFlags flags, bool create)
+{
+    ImFontAtlas* atlas = font->OwnerAtlas;
+    if (atlas == NULL || atlas->WrapCacheCapacity <= 0 || atlas->Builder == NULL || (flags & ImDrawTextFlags_StopOnNewLine))
+        return NULL;
+    ImLruCache<ImFontWrapLayout>& cache = atlas->Builder->WrapCache;
+    ImFontBaked* baked = font->GetFontBaked(size);
+    ImFontWrapParams params;
+    memset(&params, 0, sizeof(params));
+    params.BakedId = baked->BakedId;
+    params.Size = size;
+    params.WrapWidth = wrap_width;
+    params.Flags = flags & ImDrawTextFlags_WrapKeepBlanks; // The only flag that changes line breaks
+    const int text_length = (int)(text_end - text_begin);
+
+    if (ImFontWrapLayout* layout = cache.Find(&params, (int)sizeof(params), text_begin, text_length))
+    {
+        atlas->WrapCacheHits++;
+        return layout;
+    }
+    if (!create)
+        return NULL;
+    ImFontWrapLayout* layout = cache.Add(atlas->WrapCacheCapacity, &params, (int)sizeof(params), text_begin, text_length);
+    layout->Params = params;
+    ImFontBuildWrapLayout(font, baked, layout, text_begin, text_end);
+    atlas->WrapCacheMisses++;
+    return layout;
+}
+
 const char* ImFont::CalcWordWrapPosition(float size, const char* text, const char* text_end, float wrap_width)
 {
+    // Only reuse a layout somebody already drew or measured: a single wrap position is cheaper to find than a whole layout
+    if (const ImFontWrapLayout* layout = ImFontGetWrapLayout(this, size, wrap_width, text, text_end, ImDrawTextFlags_None, false))
+        if (layout->Lines.Size > 0)
+            return text + layout->Lines[0].End;
     return ImFontCalcWordWrapPositionEx(this, size, text, text_end, wrap_width, ImDrawTextFlags_None);
 }
 
@@ -5603,6 +6075,15 @@ ImVec2 ImFontCalcTextSizeEx(ImFont* font, float size, float max_width, float wra
     if (!text_end_display)
         text_end_display = text_end;
 
+    // Whole wrapped text: its size is part of the cached layout
+    if (wrap_width > 0.0f && max_width >= FLT_MAX && text_end_display == text_end && out_offset == NULL)
+        if (const ImFontWrapLayout* layout = ImFontGetWrapLayout(font, size, wrap_width, text_begin, text_end, flags, true))
+        {
+            if (out_remaining != NULL)
+                *out_remaining = text_end;
+            return layout->TextSize;
+        }
+
     ImFontBaked* baked = font->GetFontBaked(size);
     const float line_height = size;
     const float scale = line_height / baked->Size;
@@ -5637,6 +6118,26 @@ ImVec2 ImFontCalcTextSizeEx(ImFont* font, float size, float max_width, float wra
             }
         }
 
+        // Printable ASCII run: no decoding, no '\n' or '\r' to look for
+        const char* run_end = ImTextFindAsciiRunEnd(s, word_wrap_enabled ? ImMin(word_wrap_eol, text_end_display) : text_end_display, 32);
+        if (run_end != s)
+        {
+            for (; s < run_end; s++)
+            {
+                const unsigned int c = (unsigned char)*s;
+                float char_width = (c < (unsigned int)baked->IndexAdvanceX.Size) ? baked->IndexAdvanceX.Data[c] : -1.0f;
+                if (char_width < 0.0f)
+                    char_width = BuildLoadGlyphGetAdvanceOrFallback(baked, c);
+                char_width *= scale;
+                if (line_width + char_width >= max_width)
+                    break;
+                line_width += char_width;
+            }
+            if (s < run_end)
+                break; // Reached max_width
+            continue;
+        }
+
         // Decode and advance source
         const char* prev_s = s;
         unsigned int c = (unsigned int)*s;
@@ -5731,6 +6232,105 @@ void ImFont::RenderChar(ImDrawList* draw_list, float size, const ImVec2& pos, Im
     draw_list->PrimRectUV(ImVec2(x1, y1), ImVec2(x2, y2), ImVec2(u1, v1), ImVec2(u2, v2), col);
 }
 
+// SSE2 path for RenderText(): runs of printable ASCII whose glyphs are already loaded are emitted in bulk.
+// Like the AddPolyline() one, it is only for the default vertex layout (see IMGUI_ENABLE_SSE_DRAWVERT).
+#ifdef IMGUI_ENABLE_SSE_DRAWVERT
+
+// Emit glyphs from 's' up to 's_end' or the first character the scalar loop has to handle: control or non-ASCII characters,
+// glyphs not loaded yet, and glyphs partially clipped with cpu_fine_clip. Return where it stopped.
+static const char* ImFontRenderTextAsciiRun(ImFontBaked* baked, const char* s, const char* s_end, float& x, float y, float scale, const ImVec4& clip_rect, bool cpu_fine_clip,
+    ImU32 col, ImU32 col_untinted, ImDrawVert*& vtx_write, ImDrawIdx*& idx_write, unsigned int& vtx_index)
+{
+    const char* run_end = ImTextFindAsciiRunEnd(s, s_end, 32);
+    const __m128 v_scale = _mm_set1_ps(scale);
+    const __m128 v_sign = _mm_setr_ps(0.0f, 0.0f, -0.0f, -0.0f);
+    const __m128 v_clip_min = _mm_setr_ps(clip_rect.x, clip_rect.y, -clip_rect.z, -clip_rect.w); // Compared against (x1, y1, -x2, -y2)
+    const __m128 v_col = _mm_castsi128_ps(_mm_set1_epi32((int)col));
+    const __m128 v_col_untinted = _mm_castsi128_ps(_mm_set1_epi32((int)col_untinted));
+    const unsigned int vtx_index_begin = vtx_index;
+    const int lookup_size = baked->IndexLookup.Size;
+
+    for (; s < run_end; s++)
+    {
+        const unsigned int c = (unsigned char)*s;
+        if ((int)c >= lookup_size)
+            break;
+        const ImU16 glyph_index = baked->IndexLookup.Data[c];
+        if (glyph_index == IM_FONTGLYPH_INDEX_UNUSED) // Not loaded yet: leave it to FindGlyph()
+            break;
+        const ImFontGlyph* glyph = &baked->Glyphs.Data[(glyph_index == IM_FONTGLYPH_INDEX_NOT_FOUND) ? baked->FallbackGlyphIndex : glyph_index];
+        const float char_width = glyph->AdvanceX * scale;
+        if (glyph->Visible)
+        {
+            // pos = (x1, y1, x2, y2), same operations as 'x + glyph->X0 * scale' etc.
+            const __m128 pos = _mm_add_ps(_mm_setr_ps(x, y, x, y), _mm_mul_ps(_mm_loadu_ps(&glyph->X0), v_scale));
+            if (_mm_movemask_ps(_mm_cmpge_ps(_mm_xor_ps(pos, v_sign), v_clip_min)) != 0x0F)
+            {
+                // Not entirely inside the clip rect: skipped when outside horizontally, like the scalar loop, otherwise emitted as is
+                const float x1 = _mm_cvtss_f32(pos);
+                const float x2 = _mm_cvtss_f32(_mm_movehl_ps(pos, pos));
+                if (!(x1 <= clip_rect.z && x2 >= clip_rect.x))
+                {
+                    x += char_width;
+                    continue;
+                }
+                if (cpu_fine_clip)
+                    break;
+            }
+            else if (cpu_fine_clip && _mm_cvtss_f32(_mm_shuffle_ps(pos, pos, _MM_SHUFFLE(1, 1, 1, 1))) >= _mm_cvtss_f32(_mm_shuffle_ps(pos, pos, _MM_SHUFFLE(3, 3, 3, 3))))
+            {
+                x += char_width; // Empty after fine clipping (y1 >= y2)
+                continue;
+            }
+
+            // Four vertices (pos, uv, col) are 20 floats: x1 y1 u1 v1 | c x2 y1 u2 | v1 c x2 y2 | u2 v2 c x1 | y2 u1 v2 c
+            const __m128 uv = _mm_loadu_ps(&glyph->U0);                                // u1 v1 u2 v2
+            const __m128 glyph_col = glyph->Colored ? v_col_untinted : v_col;
+            const __m128 a = _mm_shuffle_ps(pos, uv, _MM_SHUFFLE(1, 2, 1, 2));         // x2 y1 u2 v1
+            const __m128 b = _mm_shuffle_ps(pos, uv, _MM_SHUFFLE(3, 0, 3, 0));         // x1 y2 u1 v2
+            const __m128 d = _mm_movehl_ps(uv, pos);                                   // x2 y2 u2 v2
+            const __m128 c_a = _mm_shuffle_ps(glyph_col, a, _MM_SHUFFLE(1, 0, 0, 0));  // c c x2 y1
+            const __m128 a_c = _mm_shuffle_ps(a, glyph_col, _MM_SHUFFLE(0, 0, 3, 3));  // v1 v1 c c
+            const __m128 c_b = _mm_shuffle_ps(glyph_col, b, _MM_SHUFFLE(0, 0, 0, 0));  // c c x1 x1
+            const __m128 b_c = _mm_shuffle_ps(b, glyph_col, _MM_SHUFFLE(0, 0, 3, 3));  // v2 v2 c c
+            float* out = (float*)(void*)vtx_write;
+            _mm_storeu_ps(out + 0, _mm_movelh_ps(pos, uv));
+            _mm_storeu_ps(out + 4, _mm_shuffle_ps(c_a, a, _MM_SHUFFLE(2, 1, 2, 0)));
+            _mm_storeu_ps(out + 8, _mm_shuffle_ps(a_c, d, _MM_SHUFFLE(1, 0, 2, 0)));
+            _mm_storeu_ps(out + 12, _mm_shuffle_ps(d, c_b, _MM_SHUFFLE(2, 0, 3, 2)));
+            _mm_storeu_ps(out + 16, _mm_shuffle_ps(b, b_c, _MM_SHUFFLE(2, 0, 2, 1)));
+            vtx_write += 4;
+            vtx_index += 4;
+        }
+        x += char_width;
+    }
+
+    // Indices for the quads written above, 4 quads (24 16-bit indices) per iteration
+    unsigned int quad_vtx = vtx_index_begin;
+    if (sizeof(ImDrawIdx) == 2)
+    {
+        const __m128i v_idx0 = _mm_setr_epi16(0, 1, 2, 0, 2, 3, 4, 5);
+        const __m128i v_idx1 = _mm_setr_epi16(6, 4, 6, 7, 8, 9, 10, 8);
+        const __m128i v_idx2 = _mm_setr_epi16(10, 11, 12, 13, 14, 12, 14, 15);
+        for (; quad_vtx + 16 <= vtx_index; quad_vtx += 16)
+        {
+            const __m128i v_base = _mm_set1_epi16((short)quad_vtx);
+            _mm_storeu_si128((__m128i*)(void*)(idx_write + 0), _mm_add_epi16(v_base, v_idx0));
+            _mm_storeu_si128((__m128i*)(void*)(idx_write + 8), _mm_add_epi16(v_base, v_idx1));
+            _mm_storeu_si128((__m128i*)(void*)(idx_write + 16), _mm_add_epi16(v_base, v_idx2));
+            idx_write += 24;
+        }
+    }
+    for (; quad_vtx < vtx_index; quad_vtx += 4)
+    {
+        idx_write[0] = (ImDrawIdx)(quad_vtx); idx_write[1] = (ImDrawIdx)(quad_vtx + 1); idx_write[2] = (ImDrawIdx)(quad_vtx + 2);
+        idx_write[3] = (ImDrawIdx)(quad_vtx); idx_write[4] = (ImDrawIdx)(quad_vtx + 2); idx_write[5] = (ImDrawIdx)(quad_vtx + 3);
+        idx_write += 6;
+    }
+    return s;
+}
+#endif // #ifdef IMGUI_ENABLE_SSE_DRAWVERT
+
 // Note: as with every ImDrawList drawing function, this expects that the font atlas texture is bound.
 // DO NOT CALL DIRECTLY THIS WILL CHANGE WILDLY IN 2026. Use ImDrawList::AddText().
 void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width, ImDrawTextFlags flags)
@@ -5751,12 +6351,21 @@ begin:
     const float scale = size / baked->Size;
     const float origin_x = x;
     const bool word_wrap_enabled = (wrap_width > 0.0f);
+    const ImFontWrapLayout* wrap_layout = word_wrap_enabled ? ImFontGetWrapLayout(this, size, wrap_width, text_begin, text_end, flags, true) : NULL;
+    int wrap_line = 0;
 
     // Fast-forward to first visible line
     const char* s = text_begin;
     if (y + line_height < clip_rect.y)
         while (y + line_height < clip_rect.y && s < text_end)
         {
+            if (wrap_layout)
+            {
+                wrap_line++;
+                s = (wrap_line < wrap_layout->Lines.Size) ? text_begin + wrap_layout->Lines[wrap_line].Begin : text_end;
+                y += line_height;
+                continue;
+            }
             const char* line_end = (const char*)ImMemchr(s, '\n', text_end - s);
             if (word_wrap_enabled)
             {
@@ -5810,7 +6419,12 @@ begin:
         {
             // Calculate how far we can render. Requires two passes on the string data but keeps the code simple and not intrusive for what's essentially an uncommon feature.
             if (!word_wrap_eol)
-                word_wrap_eol = ImFontCalcWordWrapPositionEx(this, size, s, text_end, wrap_width - (x - origin_x), flags);
+            {
+                if (wrap_layout && wrap_line < wrap_layout->Lines.Size)
+                    word_wrap_eol = text_begin + wrap_layout->Lines[wrap_line++].End;
+                else
+                    word_wrap_eol = ImFontCalcWordWrapPositionEx(this, size, s, text_end, wrap_width - (x - origin_x), flags);
+            }
 
             if (s >= word_wrap_eol)
             {
@@ -5824,6 +6438,18 @@ begin:
             }
         }
 
+#ifdef IMGUI_ENABLE_SSE_DRAWVERT
+        if ((unsigned char)*s - 32u < 96u)
+        {
+            const char* run_end = ImFontRenderTextAsciiRun(baked, s, word_wrap_enabled ? ImMin(word_wrap_eol, text_end) : text_end, x, y, scale, clip_rect, cpu_fine_clip, col, col_untinted, vtx_write, idx_write, vtx_index);
+            if (run_end != s)
+            {
+                s = run_end;
+                continue;
+            }
+        }
+#endif
+
         // Decode and advance source
         unsigned int c = (unsigned int)*s;
         if (c < 0x80)
@@ -5900,10 +6526,10 @@ begin:
 
                 // We are NOT calling PrimRectUV() here because non-inlined causes too much overhead in a debug builds. Inlined here:
                 {
-                    vtx_write[0].pos.x = x1; vtx_write[0].pos.y = y1; vtx_write[0].col = glyph_col; vtx_write[0].uv.x = u1; vtx_write[0].uv.y = v1;
-                    vtx_write[1].pos.x = x2; vtx_write[1].pos.y = y1; vtx_write[1].col = glyph_col; vtx_write[1].uv.x = u2; vtx_write[1].uv.y = v1;
-                    vtx_write[2].pos.x = x2; vtx_write[2].pos.y = y2; vtx_write[2].col = glyph_col; vtx_write[2].uv.x = u2; vtx_write[2].uv.y = v2;
-                    vtx_write[3].pos.x = x1; vtx_write[3].pos.y = y2; vtx_write[3].col = glyph_col; vtx_write[3].uv.x = u1; vtx_write[3].uv.y = v2;
+                    vtx_write[0].pos = ImVec2(x1, y1); vtx_write[0].col = glyph_col; vtx_write[0].uv = ImVec2(u1, v1);
+                    vtx_write[1].pos = ImVec2(x2, y1); vtx_write[1].col = glyph_col; vtx_write[1].uv = ImVec2(u2, v1);
+                    vtx_write[2].pos = ImVec2(x2, y2); vtx_write[2].col = glyph_col; vtx_write[2].uv = ImVec2(u2, v2);
+                    vtx_write[3].pos = ImVec2(x1, y2); vtx_write[3].col = glyph_col; vtx_write[3].uv = ImVec2(u1, v2);
                     idx_write[0] = (ImDrawIdx)(vtx_index); idx_write[1] = (ImDrawIdx)(vtx_index + 1); idx_write[2] = (ImDrawIdx)(vtx_index + 2);
                     idx_write[3] = (ImDrawIdx)(vtx_index); idx_write[4] = (ImDrawIdx)(vtx_index + 2); idx_write[5] = (ImDrawIdx)(vtx_index + 3);
                     vtx_write += 4;
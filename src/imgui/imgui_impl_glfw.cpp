@@ -168,6 +168,11 @@
 #define GLFW_HAS_GETERROR               (GLFW_VERSION_COMBINED >= 3300) // 3.3+ glfwGetError()
 #define GLFW_HAS_GETPLATFORM            (GLFW_VERSION_COMBINED >= 3400) // 3.4+ glfwGetPlatform()
 
+// Scoped CPU zones, empty unless imconfig.h defines IMGUI_IMPL_PROFILE_ZONE(name)
+#ifndef IMGUI_IMPL_PROFILE_ZONE
+#define IMGUI_IMPL_PROFILE_ZONE(_NAME)
+#endif
+
 // Map GLFWWindow* to ImGuiContext*.
 // - Would be simpler if we could use glfwSetWindowUserPointer()/glfwGetWindowUserPointer(), but this is a single and shared resource.
 // - Would be simpler if we could use e.g. std::map<> as well. But we don't.
@@ -198,6 +203,9 @@ struct ImGui_ImplGlfw_Data
     GLFWcursor*             LastMouseCursor;
 #endif
     ImVec2                  LastValidMousePos;
+    ImGui_ImplGlfw_InputTimes InputTimes;
+    double                  PendingOldestInput;     // Oldest arrival since the last NewFrame(), moved to InputTimes.OldestThisFrame there
+    double                  MessageQueueAge;        // Win32: seconds the message being dispatched waited in the queue
     bool                    IsWayland;
     bool                    InstalledCallbacks;
     bool                    CallbacksChainForAllWindows;
@@ -406,6 +414,16 @@ static bool ImGui_ImplGlfw_ShouldChainCallback(ImGui_ImplGlfw_Data* bd, GLFWwind
     return bd->CallbacksChainForAllWindows ? true : (window == bd->Window);
 }
 
+// Stamp an event with the time it reached us rather than the time of the next NewFrame(), so apps can measure input latency.
+static double ImGui_ImplGlfw_StampInputEvent(ImGui_ImplGlfw_Data* bd)
+{
+    double t = glfwGetTime() - bd->MessageQueueAge;
+    bd->InputTimes.LastEvent = t;
+    if (bd->PendingOldestInput == 0.0 || t < bd->PendingOldestInput)
+        bd->PendingOldestInput = t;
+    return t;
+}
+
 void ImGui_ImplGlfw_MouseButtonCallback(GLFWwindow* window, int button, int action, int mods)
 {
     ImGui_ImplGlfw_Data* bd = ImGui_ImplGlfw_GetBackendData(window);
@@ -414,8 +432,12 @@ void ImGui_ImplGlfw_MouseButtonCallback(GLFWwindow* window, int button, int acti
 
     ImGuiIO& io = ImGui::GetIO(bd->Context);
     ImGui_ImplGlfw_UpdateKeyModifiers(io, window);
+    double t = ImGui_ImplGlfw_StampInputEvent(bd);
     if (button >= 0 && button < ImGuiMouseButton_COUNT)
+    {
+        bd->InputTimes.MouseButton[button] = t;
         io.AddMouseButtonEvent(button, action == GLFW_PRESS);
+    }
 }
 
 void ImGui_ImplGlfw_ScrollCallback(GLFWwindow* window, double xoffset, double yoffset)
@@ -430,6 +452,7 @@ void ImGui_ImplGlfw_ScrollCallback(GLFWwindow* window, double xoffset, double yo
 #endif
 
     ImGuiIO& io = ImGui::GetIO(bd->Context);
+    ImGui_ImplGlfw_StampInputEvent(bd);
     io.AddMouseWheelEvent((float)xoffset, (float)yoffset);
 }
 
@@ -478,6 +501,7 @@ void ImGui_ImplGlfw_KeyCallback(GLFWwindow* window, int keycode, int scancode, i
 
     ImGuiIO& io = ImGui::GetIO(bd->Context);
     ImGui_ImplGlfw_UpdateKeyModifiers(io, window);
+    bd->InputTimes.Key = ImGui_ImplGlfw_StampInputEvent(bd);
 
     keycode = ImGui_ImplGlfw_TranslateUntranslatedKey(keycode, scancode);
 
@@ -503,6 +527,7 @@ void ImGui_ImplGlfw_CursorPosCallback(GLFWwindow* window, double x, double y)
         bd->PrevUserCallbackCursorPos(window, x, y);
 
     ImGuiIO& io = ImGui::GetIO(bd->Context);
+    ImGui_ImplGlfw_StampInputEvent(bd);
     io.AddMousePosEvent((float)x, (float)y);
     bd->LastValidMousePos = ImVec2((float)x, (float)y);
 }
@@ -536,6 +561,7 @@ void ImGui_ImplGlfw_CharCallback(GLFWwindow* window, unsigned int c)
         bd->PrevUserCallbackChar(window, c);
 
     ImGuiIO& io = ImGui::GetIO(bd->Context);
+    ImGui_ImplGlfw_StampInputEvent(bd);
     io.AddInputCharacter(c);
 }
 
@@ -591,7 +617,14 @@ static LRESULT CALLBACK ImGui_ImplGlfw_WndProc(HWND hWnd, UINT msg, WPARAM wPara
         break;
     default: break;
     }
-    return ::CallWindowProcW(bd->PrevWndProc, hWnd, msg, wParam, lParam);
+
+    // GLFW only sees input messages when glfwPollEvents() dispatches them, which can be most of a frame after they arrived.
+    // Back-date the callbacks GLFW is about to call by the time the message sat in the queue (GetMessageTime() shares GetTickCount()'s clock).
+    bool is_input = (msg >= WM_KEYFIRST && msg <= WM_KEYLAST) || (msg >= WM_MOUSEFIRST && msg <= WM_MOUSELAST);
+    bd->MessageQueueAge = is_input ? (DWORD)(::GetTickCount() - (DWORD)::GetMessageTime()) / 1000.0 : 0.0;
+    LRESULT result = ::CallWindowProcW(bd->PrevWndProc, hWnd, msg, wParam, lParam);
+    bd->MessageQueueAge = 0.0;
+    return result;
 }
 #endif
 
@@ -991,6 +1024,7 @@ static void ImGui_ImplGlfw_GetWindowSizeAndFramebufferScale(GLFWwindow* window,
 
 void ImGui_ImplGlfw_NewFrame()
 {
+    IMGUI_IMPL_PROFILE_ZONE("ImGui_ImplGlfw_NewFrame");
     ImGuiIO& io = ImGui::GetIO();
     ImGui_ImplGlfw_Data* bd = ImGui_ImplGlfw_GetBackendData();
     IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplGlfw_InitForXXX()?");
@@ -1006,6 +1040,10 @@ void ImGui_ImplGlfw_NewFrame()
     io.DeltaTime = bd->Time > 0.0 ? (float)(current_time - bd->Time) : (float)(1.0f / 60.0f);
     bd->Time = current_time;
 
+    // Events queued since the previous frame are handed to Dear ImGui by this frame's ImGui::NewFrame()
+    bd->InputTimes.OldestThisFrame = bd->PendingOldestInput;
+    bd->PendingOldestInput = 0.0;
+
     ImGui_ImplGlfw_UpdateMouseData();
     ImGui_ImplGlfw_UpdateMouseCursor();
 
@@ -1013,6 +1051,13 @@ void ImGui_ImplGlfw_NewFrame()
     ImGui_ImplGlfw_UpdateGamepads();
 }
 
+const ImGui_ImplGlfw_InputTimes& ImGui_ImplGlfw_GetInputTimes()
+{
+    ImGui_ImplGlfw_Data* bd = ImGui_ImplGlfw_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplGlfw_InitForXXX()?");
+    return bd->InputTimes;
+}
+
 // GLFW doesn't provide a portable sleep function
 void ImGui_ImplGlfw_Sleep(int milliseconds)
 {
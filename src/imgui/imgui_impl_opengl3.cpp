@@ -126,6 +126,7 @@
 #include "imgui_impl_opengl3.h"
 #include <stdio.h>
 #include <stdint.h>     // intptr_t
+#include <chrono>       // frame statistics
 #if defined(__APPLE__)
 #include <TargetConditionals.h>
 #endif
@@ -219,6 +220,26 @@
 #define IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
 #endif
 
+// Desktop GL 4.4+ (or ARB_buffer_storage) has glBufferStorage() for persistently mapped buffers.
+#if !defined(IMGUI_IMPL_OPENGL_ES2) && !defined(IMGUI_IMPL_OPENGL_ES3) && defined(GL_VERSION_4_4)
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+#endif
+
+// Desktop GL 3.2+ and GL ES 3.0+ have glMapBufferRange() and fences, needed by the texture upload ring.
+#if !defined(IMGUI_IMPL_OPENGL_ES2) && (defined(IMGUI_IMPL_OPENGL_ES3) || defined(GL_VERSION_3_2))
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_UPLOAD_RING
+#endif
+
+// Desktop GL 4.1+ (or ARB_get_program_binary) and GL ES 3.0+ have glGetProgramBinary()/glProgramBinary().
+#if !defined(IMGUI_IMPL_OPENGL_ES2) && (defined(IMGUI_IMPL_OPENGL_ES3) || defined(GL_VERSION_4_1))
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_PROGRAM_BINARY
+#endif
+
+// Desktop GL 3.3+ (or ARB_timer_query) has GL_TIME_ELAPSED and GL_TIMESTAMP queries. GL ES only has them through EXT_disjoint_timer_query.
+#if !defined(IMGUI_IMPL_OPENGL_ES2) && !defined(IMGUI_IMPL_OPENGL_ES3) && defined(GL_VERSION_3_3)
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_TIMER_QUERY
+#endif
+
 // [Debugging]
 //#define IMGUI_IMPL_OPENGL_DEBUG
 #ifdef IMGUI_IMPL_OPENGL_DEBUG
@@ -228,6 +249,49 @@
 #define GL_CALL(_CALL)      _CALL   // Call without error check
 #endif
 
+// [Profiling] Scoped CPU zones, empty unless imconfig.h defines IMGUI_IMPL_PROFILE_ZONE(name)
+#ifndef IMGUI_IMPL_PROFILE_ZONE
+#define IMGUI_IMPL_PROFILE_ZONE(_NAME)
+#endif
+
+// Frames of vertex/index data the persistent ring holds. The CPU writes one segment while the GPU may still read the other two.
+static const int RING_SEGMENTS = 3;
+
+// Query sets for GPU timing. A frame's results are read as soon as the GPU has them and given up on when its set is needed again.
+static const int GPU_TIMER_FRAMES = 4;
+
+// Last scissor box, texture and program we know to be current during RenderDrawData(), so unchanged values aren't sent again.
+// Seeded from the state backup at the start of the frame and forgotten after user callbacks, which may change anything.
+struct ImGui_ImplOpenGL3_StateCache
+{
+    bool            ScissorKnown, TextureKnown, ProgramKnown;
+    GLint           Scissor[4];
+    GLuint          Texture;
+    GLuint          Program;
+
+    void            Invalidate() { ScissorKnown = TextureKnown = ProgramKnown = false; }
+};
+
+// App texture upload waiting for ring budget. The pixels live in ImGui_ImplOpenGL3_Data::UploadQueueData.
+struct ImGui_ImplOpenGL3_QueuedUpload
+{
+    GLuint          Texture;                 // 0 once cancelled
+    int             X, Y, W, H;
+    int             Channels;
+    int             DataOffset;
+};
+
+// GPU timer queries of one RenderDrawData() call
+struct ImGui_ImplOpenGL3_GpuTimerFrame
+{
+    GLuint          ElapsedQuery;
+    ImVector<GLuint> Timestamps;             // [0] before the first draw list, [n + 1] after draw list n. Grows with the number of lists.
+    ImVector<ImGui_ImplOpenGL3_GpuListTiming> Lists; // Names and index counts captured while recording
+    int             StampCount;              // Timestamps issued so far
+    int             FrameIndex;
+    bool            Pending;                 // Issued and not read back yet
+};
+
 // OpenGL Data
 struct ImGui_ImplOpenGL3_Data
 {
@@ -251,7 +315,49 @@ struct ImGui_ImplOpenGL3_Data
     bool            HasBindSampler;
     bool            HasClipOrigin;
     bool            UseBufferSubData;
+    bool            HasBufferStorage;
+    bool            UsePersistentBuffers;    // Requested with ImGui_ImplOpenGL3_SetPersistentBuffers()
+    bool            RingActive;              // Current frame is drawn from the ring
     ImVector<char>  TempBuffer;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    GLuint          RingVboHandle, RingElementsHandle;
+    char*           RingVtxData;             // Persistently mapped, RING_SEGMENTS * RingVtxSegmentSize bytes
+    char*           RingIdxData;
+    GLsizeiptr      RingVtxSegmentSize;
+    GLsizeiptr      RingIdxSegmentSize;
+    int             RingSegment;             // Segment the next frame writes to
+    GLsync          RingFences[RING_SEGMENTS];
+    bool            RingFencePending;        // Previous segment still needs its fence (see ReserveRing)
+#endif
+    bool            HasUploadRing;
+    bool            UseUploadRing;           // Requested with ImGui_ImplOpenGL3_SetAsyncTextureUploads()
+    int             UploadBudget;            // Ring bytes per frame, also the size of one ring segment
+    ImVector<ImGui_ImplOpenGL3_QueuedUpload> UploadQueue;
+    ImVector<unsigned char> UploadQueueData;
+    int             UploadQueueHead;         // First UploadQueue entry not sent yet
+    int             UploadBytes;             // Texture bytes sent since the last RenderDrawData()
+    int             UploadRingBytes;
+    double          UploadCpuMs;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_UPLOAD_RING
+    GLuint          UploadPbo;               // RING_SEGMENTS * UploadBudget bytes
+    int             UploadSegment;
+    int             UploadOffset;            // Bytes written to the current segment; non-zero also means it still needs its fence
+    bool            UploadSegmentOpen;       // Current segment belongs to this frame
+    GLsync          UploadFences[RING_SEGMENTS];
+#endif
+    bool            HasTimerQuery;
+    bool            UseGpuTimers;            // Requested with ImGui_ImplOpenGL3_SetGpuTimers()
+    ImGui_ImplOpenGL3_GpuTimerFrame GpuTimerFrames[GPU_TIMER_FRAMES];
+    int             GpuTimerFrameCount;      // Frames recorded since SetGpuTimers(true)
+    ImU64           GpuLastFrameEnd;         // Final timestamp of the last resolved frame, in ns
+    bool            GpuTimingsValid;
+    ImGui_ImplOpenGL3_GpuTimings GpuTimings;
+    bool            HasProgramBinary;
+    ImVector<char>  ProgramCachePath;        // Set with ImGui_ImplOpenGL3_SetProgramCache(), empty when off
+    bool            ProgramFromCache;
+    float           ProgramSetupMs;
+    ImGui_ImplOpenGL3_StateCache StateCache;
+    ImGui_ImplOpenGL3_FrameStats FrameStats;
 
     ImGui_ImplOpenGL3_Data() { memset((void*)this, 0, sizeof(*this)); }
 };
@@ -412,6 +518,15 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
     bd->HasBindSampler = (bd->GlVersion >= 330 || bd->GlProfileIsES3);
 #endif
     bd->HasClipOrigin = (bd->GlVersion >= 450);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    bd->HasBufferStorage = (bd->GlVersion >= 440);
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_TIMER_QUERY
+    bd->HasTimerQuery = (bd->GlVersion >= 330);
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PROGRAM_BINARY
+    bd->HasProgramBinary = (bd->GlVersion >= 410 || bd->GlProfileIsES3);
+#endif
 #ifdef IMGUI_IMPL_OPENGL_HAS_EXTENSIONS
     GLint num_extensions = 0;
     glGetIntegerv(GL_NUM_EXTENSIONS, &num_extensions);
@@ -420,6 +535,43 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
         const char* extension = (const char*)glGetStringi(GL_EXTENSIONS, i);
         if (extension != nullptr && strcmp(extension, "GL_ARB_clip_control") == 0)
             bd->HasClipOrigin = true;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+        if (extension != nullptr && strcmp(extension, "GL_ARB_buffer_storage") == 0 && bd->GlVersion >= 320) // Ring draws need glDrawElementsBaseVertex()
+            bd->HasBufferStorage = true;
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_TIMER_QUERY
+        if (extension != nullptr && strcmp(extension, "GL_ARB_timer_query") == 0)
+            bd->HasTimerQuery = true;
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PROGRAM_BINARY
+        if (extension != nullptr && strcmp(extension, "GL_ARB_get_program_binary") == 0)
+            bd->HasProgramBinary = true;
+#endif
+    }
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_UPLOAD_RING
+    bd->HasUploadRing = (bd->GlVersion >= 320 || bd->GlProfileIsES3);
+#endif
+#if defined(IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE) && defined(IMGUI_IMPL_OPENGL_LOADER_IMGL3W)
+    if (glBufferStorage == nullptr || glMapBufferRange == nullptr || glFenceSync == nullptr)
+        bd->HasBufferStorage = false;
+    if (glMapBufferRange == nullptr || glFenceSync == nullptr)
+        bd->HasUploadRing = false;
+#endif
+#if defined(IMGUI_IMPL_OPENGL_MAY_HAVE_TIMER_QUERY) && defined(IMGUI_IMPL_OPENGL_LOADER_IMGL3W)
+    if (glGenQueries == nullptr || glQueryCounter == nullptr || glGetQueryObjectui64v == nullptr)
+        bd->HasTimerQuery = false;
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PROGRAM_BINARY
+#ifdef IMGUI_IMPL_OPENGL_LOADER_IMGL3W
+    if (glGetProgramBinary == nullptr || glProgramBinary == nullptr || glProgramParameteri == nullptr)
+        bd->HasProgramBinary = false;
+#endif
+    if (bd->HasProgramBinary)
+    {
+        GLint num_binary_formats = 0; // Drivers may support the entry points without offering any format
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &num_binary_formats);
+        bd->HasProgramBinary = (num_binary_formats > 0);
     }
 #endif
 
@@ -455,6 +607,478 @@ void    ImGui_ImplOpenGL3_NewFrame()
             IM_ASSERT(0 && "ImGui_ImplOpenGL3_CreateDeviceObjects() failed!");
 }
 
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+static void ImGui_ImplOpenGL3_DestroyRing(ImGui_ImplOpenGL3_Data* bd)
+{
+    for (int n = 0; n < RING_SEGMENTS; n++)
+        if (bd->RingFences[n]) { glDeleteSync(bd->RingFences[n]); bd->RingFences[n] = nullptr; }
+    // Deleting a mapped buffer unmaps it.
+    if (bd->RingVboHandle)      { glDeleteBuffers(1, &bd->RingVboHandle); bd->RingVboHandle = 0; }
+    if (bd->RingElementsHandle) { glDeleteBuffers(1, &bd->RingElementsHandle); bd->RingElementsHandle = 0; }
+    bd->RingVtxData = bd->RingIdxData = nullptr;
+    bd->RingVtxSegmentSize = bd->RingIdxSegmentSize = 0;
+    bd->RingSegment = 0;
+    bd->RingFencePending = false;
+}
+
+static GLsizeiptr ImGui_ImplOpenGL3_RingSegmentSize(GLsizeiptr needed, GLsizeiptr current, GLsizeiptr min_size)
+{
+    GLsizeiptr size = current > min_size ? current : min_size;
+    while (size < needed)
+        size *= 2;
+    return size;
+}
+
+static char* ImGui_ImplOpenGL3_CreateMappedBuffer(GLuint* handle, GLsizeiptr size)
+{
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    GL_CALL(glGenBuffers(1, handle));
+    GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, *handle)); // Storage is target-agnostic; GL_ARRAY_BUFFER avoids touching the bound VAO's element buffer
+    GL_CALL(glBufferStorage(GL_ARRAY_BUFFER, size, nullptr, flags));
+    return (char*)glMapBufferRange(GL_ARRAY_BUFFER, 0, size, flags);
+}
+
+// Makes room for this frame's vertices/indices in the ring and waits (rarely) until the GPU is done with the segment we are about to overwrite.
+// Returns false when the ring can't be used, in which case the caller uploads with glBufferData() as usual.
+static bool ImGui_ImplOpenGL3_ReserveRing(ImGui_ImplOpenGL3_Data* bd, GLsizeiptr vtx_size, GLsizeiptr idx_size)
+{
+    // Fence last frame's segment now rather than at the end of last frame's RenderDrawData(): by this point the app has swapped,
+    // so drivers that flush on glFenceSync() (Mesa's llvmpipe flushes and rasterizes the whole frame) have nothing left to flush.
+    if (bd->RingFencePending)
+    {
+        bd->RingFences[(bd->RingSegment + RING_SEGMENTS - 1) % RING_SEGMENTS] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        bd->RingFencePending = false;
+    }
+    if (vtx_size > bd->RingVtxSegmentSize || idx_size > bd->RingIdxSegmentSize)
+    {
+        // Grow. The driver keeps the old storage alive for draws still in flight, so there is nothing to wait for.
+        GLsizeiptr vtx_segment = ImGui_ImplOpenGL3_RingSegmentSize(vtx_size, bd->RingVtxSegmentSize, (GLsizeiptr)(16384 * sizeof(ImDrawVert)));
+        GLsizeiptr idx_segment = ImGui_ImplOpenGL3_RingSegmentSize(idx_size, bd->RingIdxSegmentSize, (GLsizeiptr)(32768 * sizeof(ImDrawIdx)));
+        ImGui_ImplOpenGL3_DestroyRing(bd);
+        bd->RingVtxData = ImGui_ImplOpenGL3_CreateMappedBuffer(&bd->RingVboHandle, vtx_segment * RING_SEGMENTS);
+        bd->RingIdxData = ImGui_ImplOpenGL3_CreateMappedBuffer(&bd->RingElementsHandle, idx_segment * RING_SEGMENTS);
+        if (bd->RingVtxData == nullptr || bd->RingIdxData == nullptr)
+        {
+            ImGui_ImplOpenGL3_DestroyRing(bd);
+            bd->UsePersistentBuffers = false;
+            return false;
+        }
+        bd->RingVtxSegmentSize = vtx_segment;
+        bd->RingIdxSegmentSize = idx_segment;
+    }
+
+    if (GLsync fence = bd->RingFences[bd->RingSegment])
+    {
+        GLenum result = glClientWaitSync(fence, 0, 0);
+        if (result == GL_TIMEOUT_EXPIRED)
+        {
+            bd->FrameStats.FenceWaits++;
+            while (result == GL_TIMEOUT_EXPIRED)
+                result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000); // 1 ms
+        }
+        glDeleteSync(fence);
+        bd->RingFences[bd->RingSegment] = nullptr;
+    }
+    return true;
+}
+#endif
+
+bool ImGui_ImplOpenGL3_SetPersistentBuffers(bool enable)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplOpenGL3_Init()?");
+    bd->UsePersistentBuffers = enable && bd->HasBufferStorage;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    if (!bd->UsePersistentBuffers)
+        ImGui_ImplOpenGL3_DestroyRing(bd);
+#endif
+    return bd->UsePersistentBuffers;
+}
+
+const ImGui_ImplOpenGL3_FrameStats& ImGui_ImplOpenGL3_GetFrameStats()
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplOpenGL3_Init()?");
+    return bd->FrameStats;
+}
+
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_TIMER_QUERY
+static void ImGui_ImplOpenGL3_DestroyGpuTimers(ImGui_ImplOpenGL3_Data* bd)
+{
+    for (ImGui_ImplOpenGL3_GpuTimerFrame& frame : bd->GpuTimerFrames)
+    {
+        if (frame.ElapsedQuery) { glDeleteQueries(1, &frame.ElapsedQuery); frame.ElapsedQuery = 0; }
+        if (frame.Timestamps.Size > 0) { glDeleteQueries(frame.Timestamps.Size, frame.Timestamps.Data); frame.Timestamps.clear(); }
+        frame.Pending = false;
+    }
+    bd->GpuTimerFrameCount = 0;
+    bd->GpuTimingsValid = false;
+    bd->GpuTimings.DroppedFrames = 0;
+}
+
+// Reads 'frame' back if the GPU has finished it. Its elapsed query ends after the last timestamp, so it is checked last.
+static bool ImGui_ImplOpenGL3_ResolveGpuTimerFrame(ImGui_ImplOpenGL3_Data* bd, ImGui_ImplOpenGL3_GpuTimerFrame* frame)
+{
+    GLint available = 0;
+    glGetQueryObjectiv(frame->Timestamps[frame->StampCount - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+    if (available)
+        glGetQueryObjectiv(frame->ElapsedQuery, GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available)
+        return false;
+
+    ImGui_ImplOpenGL3_GpuTimings& out = bd->GpuTimings;
+    GLuint64 elapsed = 0, prev = 0, stamp = 0;
+    glGetQueryObjectui64v(frame->ElapsedQuery, GL_QUERY_RESULT, &elapsed);
+    glGetQueryObjectui64v(frame->Timestamps[0], GL_QUERY_RESULT, &prev);
+    out.Lists.resize(frame->Lists.Size);
+    for (int n = 0; n < frame->Lists.Size; n++)
+    {
+        glGetQueryObjectui64v(frame->Timestamps[n + 1], GL_QUERY_RESULT, &stamp);
+        out.Lists[n] = frame->Lists[n];
+        out.Lists[n].GpuMs = (float)((double)(stamp - prev) / 1000000.0);
+        prev = stamp;
+    }
+    const bool follows_last = bd->GpuTimingsValid && out.FrameIndex == frame->FrameIndex - 1;
+    out.FrameIntervalGpuMs = follows_last ? (float)((double)(prev - bd->GpuLastFrameEnd) / 1000000.0) : 0.0f;
+    out.RenderGpuMs = (float)((double)elapsed / 1000000.0);
+    out.FrameIndex = frame->FrameIndex;
+    bd->GpuLastFrameEnd = prev;
+    bd->GpuTimingsValid = true;
+    frame->Pending = false;
+    return true;
+}
+
+// Resolves whatever earlier frames the GPU has finished (oldest first, never waiting), then starts recording this one.
+static ImGui_ImplOpenGL3_GpuTimerFrame* ImGui_ImplOpenGL3_BeginGpuTimerFrame(ImGui_ImplOpenGL3_Data* bd, ImDrawData* draw_data)
+{
+    for (int age = GPU_TIMER_FRAMES - 1; age >= 1; age--)
+    {
+        const int index = bd->GpuTimerFrameCount - age;
+        if (index < 0)
+            continue;
+        ImGui_ImplOpenGL3_GpuTimerFrame* pending = &bd->GpuTimerFrames[index % GPU_TIMER_FRAMES];
+        if (pending->Pending && !ImGui_ImplOpenGL3_ResolveGpuTimerFrame(bd, pending))
+            break;
+    }
+
+    ImGui_ImplOpenGL3_GpuTimerFrame* frame = &bd->GpuTimerFrames[bd->GpuTimerFrameCount % GPU_TIMER_FRAMES];
+    if (frame->Pending)
+        bd->GpuTimings.DroppedFrames++;
+    if (frame->ElapsedQuery == 0)
+        glGenQueries(1, &frame->ElapsedQuery);
+    const int stamps_needed = draw_data->CmdLists.Size + 1;
+    if (frame->Timestamps.Size < stamps_needed)
+    {
+        const int old_size = frame->Timestamps.Size;
+        frame->Timestamps.resize(stamps_needed);
+        glGenQueries(stamps_needed - old_size, frame->Timestamps.Data + old_size);
+    }
+    frame->Lists.resize(draw_data->CmdLists.Size);
+    for (int n = 0; n < draw_data->CmdLists.Size; n++)
+    {
+        const ImDrawList* draw_list = draw_data->CmdLists[n];
+        ImGui_ImplOpenGL3_GpuListTiming& list = frame->Lists[n];
+        strncpy(list.Name, draw_list->_OwnerName ? draw_list->_OwnerName : "", IM_ARRAYSIZE(list.Name) - 1);
+        list.Name[IM_ARRAYSIZE(list.Name) - 1] = 0;
+        list.GpuMs = 0.0f;
+        list.ElemCount = draw_list->IdxBuffer.Size;
+    }
+    frame->FrameIndex = bd->GpuTimerFrameCount++;
+    frame->Pending = true;
+    frame->StampCount = 0;
+    glBeginQuery(GL_TIME_ELAPSED, frame->ElapsedQuery);
+    glQueryCounter(frame->Timestamps[frame->StampCount++], GL_TIMESTAMP);
+    return frame;
+}
+#endif
+
+bool ImGui_ImplOpenGL3_SetGpuTimers(bool enable)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplOpenGL3_Init()?");
+    const bool use_timers = enable && bd->HasTimerQuery;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_TIMER_QUERY
+    if (use_timers != bd->UseGpuTimers)
+        ImGui_ImplOpenGL3_DestroyGpuTimers(bd);
+#endif
+    bd->UseGpuTimers = use_timers;
+    return use_timers;
+}
+
+const ImGui_ImplOpenGL3_GpuTimings* ImGui_ImplOpenGL3_GetGpuTimings()
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplOpenGL3_Init()?");
+    return bd->GpuTimingsValid ? &bd->GpuTimings : nullptr;
+}
+
+bool ImGui_ImplOpenGL3_SetProgramCache(const char* path)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplOpenGL3_Init()?");
+    bd->ProgramCachePath.clear();
+    if (path == nullptr || path[0] == 0 || !bd->HasProgramBinary)
+        return false;
+    bd->ProgramCachePath.resize((int)strlen(path) + 1);
+    memcpy(bd->ProgramCachePath.Data, path, (size_t)bd->ProgramCachePath.Size);
+    return true;
+}
+
+float ImGui_ImplOpenGL3_GetProgramSetupMs(bool* out_from_cache)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplOpenGL3_Init()?");
+    if (out_from_cache)
+        *out_from_cache = bd->ProgramFromCache;
+    return bd->ProgramSetupMs;
+}
+
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_UPLOAD_RING
+static void ImGui_ImplOpenGL3_DestroyUploadRing(ImGui_ImplOpenGL3_Data* bd)
+{
+    for (int n = 0; n < RING_SEGMENTS; n++)
+        if (bd->UploadFences[n]) { glDeleteSync(bd->UploadFences[n]); bd->UploadFences[n] = nullptr; }
+    if (bd->UploadPbo) { glDeleteBuffers(1, &bd->UploadPbo); bd->UploadPbo = 0; }
+    bd->UploadSegment = bd->UploadOffset = 0;
+    bd->UploadSegmentOpen = false;
+}
+
+// First ring upload of a frame: fence the segment the previous frame wrote to, move to the next one and wait (rarely) until the GPU is done reading it.
+// Expects the ring PBO (or nothing, before it exists) to be bound to GL_PIXEL_UNPACK_BUFFER.
+static void ImGui_ImplOpenGL3_OpenUploadSegment(ImGui_ImplOpenGL3_Data* bd)
+{
+    if (bd->UploadPbo == 0)
+    {
+        GL_CALL(glGenBuffers(1, &bd->UploadPbo));
+        GL_CALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, bd->UploadPbo));
+        GL_CALL(glBufferData(GL_PIXEL_UNPACK_BUFFER, (GLsizeiptr)bd->UploadBudget * RING_SEGMENTS, nullptr, GL_STREAM_DRAW));
+    }
+    else if (bd->UploadOffset > 0)
+    {
+        bd->UploadFences[bd->UploadSegment] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        bd->UploadSegment = (bd->UploadSegment + 1) % RING_SEGMENTS;
+        bd->UploadOffset = 0;
+    }
+    if (GLsync fence = bd->UploadFences[bd->UploadSegment])
+    {
+        while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED) // 1 ms
+            ;
+        glDeleteSync(fence);
+        bd->UploadFences[bd->UploadSegment] = nullptr;
+    }
+    bd->UploadSegmentOpen = true;
+}
+#endif
+
+// Sends one region through the upload ring: copy it into the current segment, then glTexSubImage2D() from the buffer offset, which the driver
+// performs asynchronously. The texture must be bound to GL_TEXTURE_2D and GL_UNPACK_ROW_LENGTH must be 0.
+// Returns false when the ring is off or the region doesn't fit in what is left of this frame's budget.
+static bool ImGui_ImplOpenGL3_UploadThroughRing(ImGui_ImplOpenGL3_Data* bd, int x, int y, int w, int h, GLenum format, int bytes_per_pixel, const unsigned char* src, int src_pitch)
+{
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_UPLOAD_RING
+    const int row_bytes = w * bytes_per_pixel;
+    const int size = row_bytes * h;
+    int offset = bd->UploadSegmentOpen ? ((bd->UploadOffset + 15) & ~15) : 0;
+    if (!bd->UseUploadRing || size <= 0 || offset + size > bd->UploadBudget)
+        return false;
+
+    GLint last_pixel_unpack_buffer; glGetIntegerv(GL_PIXEL_UNPACK_BUFFER_BINDING, &last_pixel_unpack_buffer);
+    GL_CALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, bd->UploadPbo));
+    if (!bd->UploadSegmentOpen)
+        ImGui_ImplOpenGL3_OpenUploadSegment(bd);
+    offset = (bd->UploadOffset + 15) & ~15;
+
+    // Unsynchronized is safe: the fence wait in OpenUploadSegment() guarantees the GPU is done with this segment.
+    const GLintptr buffer_offset = (GLintptr)bd->UploadSegment * bd->UploadBudget + offset;
+    unsigned char* dst = (unsigned char*)glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, buffer_offset, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    if (dst == nullptr)
+    {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, last_pixel_unpack_buffer);
+        return false;
+    }
+    if (src_pitch == row_bytes)
+        memcpy(dst, src, (size_t)size);
+    else
+        for (int row = 0; row < h; row++)
+            memcpy(dst + (size_t)row * row_bytes, src + (size_t)row * src_pitch, (size_t)row_bytes);
+    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, w, h, format, GL_UNSIGNED_BYTE, (const void*)(intptr_t)buffer_offset));
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, last_pixel_unpack_buffer);
+
+    bd->UploadOffset = offset + size;
+    bd->UploadRingBytes += size;
+    return true;
+#else
+    IM_UNUSED(bd); IM_UNUSED(x); IM_UNUSED(y); IM_UNUSED(w); IM_UNUSED(h); IM_UNUSED(format); IM_UNUSED(bytes_per_pixel); IM_UNUSED(src); IM_UNUSED(src_pitch);
+    return false;
+#endif
+}
+
+// Binds 'texture' and sends one tightly packed app region, through the ring when it fits.
+// Without 'allow_direct' nothing is sent when the ring has no room, and false is returned.
+static bool ImGui_ImplOpenGL3_SendTextureRegion(ImGui_ImplOpenGL3_Data* bd, GLuint texture, int x, int y, int w, int h, int channels, const unsigned char* pixels, bool allow_direct)
+{
+    const GLenum format = (channels == 4) ? GL_RGBA : GL_RGB;
+    GLint last_texture; glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture);
+    GLint last_unpack_alignment; glGetIntegerv(GL_UNPACK_ALIGNMENT, &last_unpack_alignment);
+    GL_CALL(glBindTexture(GL_TEXTURE_2D, texture));
+    GL_CALL(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+    bool sent = ImGui_ImplOpenGL3_UploadThroughRing(bd, x, y, w, h, format, channels, pixels, w * channels);
+    if (!sent && allow_direct)
+    {
+        GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, w, h, format, GL_UNSIGNED_BYTE, pixels));
+        sent = true;
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, last_unpack_alignment);
+    glBindTexture(GL_TEXTURE_2D, last_texture);
+    return sent;
+}
+
+// Sends queued app uploads, oldest first, until this frame's ring budget runs out.
+// Regions larger than a whole segment, and everything once the ring is off, go out directly when they reach the front.
+static void ImGui_ImplOpenGL3_DrainUploadQueue(ImGui_ImplOpenGL3_Data* bd)
+{
+    while (bd->UploadQueueHead < bd->UploadQueue.Size)
+    {
+        const ImGui_ImplOpenGL3_QueuedUpload& upload = bd->UploadQueue[bd->UploadQueueHead];
+        const int size = upload.W * upload.H * upload.Channels;
+        if (upload.Texture != 0)
+        {
+            const bool allow_direct = !bd->UseUploadRing || size > bd->UploadBudget;
+            if (!ImGui_ImplOpenGL3_SendTextureRegion(bd, upload.Texture, upload.X, upload.Y, upload.W, upload.H, upload.Channels, bd->UploadQueueData.Data + upload.DataOffset, allow_direct))
+                break;
+            bd->UploadBytes += size;
+        }
+        bd->UploadQueueHead++;
+    }
+    if (bd->UploadQueueHead == bd->UploadQueue.Size)
+    {
+        bd->UploadQueue.resize(0);
+        bd->UploadQueueData.resize(0);
+        bd->UploadQueueHead = 0;
+    }
+}
+
+bool ImGui_ImplOpenGL3_SetAsyncTextureUploads(bool enable, int budget_bytes)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplOpenGL3_Init()?");
+    IM_ASSERT(budget_bytes > 0);
+    ImGui_ImplOpenGL3_InitLoader();
+    const bool use_ring = enable && bd->HasUploadRing;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_UPLOAD_RING
+    if (!use_ring || budget_bytes != bd->UploadBudget)
+        ImGui_ImplOpenGL3_DestroyUploadRing(bd); // Buffers still read by pending copies stay alive in the driver
+#endif
+    bd->UseUploadRing = use_ring;
+    bd->UploadBudget = budget_bytes;
+    if (!use_ring)
+        ImGui_ImplOpenGL3_DrainUploadQueue(bd);
+    return use_ring;
+}
+
+void ImGui_ImplOpenGL3_UploadTextureRegion(ImTextureID tex_id, int x, int y, int w, int h, int channels, const void* pixels)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplOpenGL3_Init()?");
+    IM_ASSERT(channels == 3 || channels == 4);
+    if (w <= 0 || h <= 0)
+        return;
+    ImGui_ImplOpenGL3_InitLoader();
+
+    const std::chrono::steady_clock::time_point upload_start = std::chrono::steady_clock::now();
+    const GLuint texture = (GLuint)(intptr_t)tex_id;
+    const int size = w * h * channels;
+    const bool allow_direct = !bd->UseUploadRing || size > bd->UploadBudget;
+    if (bd->UploadQueueHead == bd->UploadQueue.Size && ImGui_ImplOpenGL3_SendTextureRegion(bd, texture, x, y, w, h, channels, (const unsigned char*)pixels, allow_direct))
+    {
+        bd->UploadBytes += size;
+    }
+    else
+    {
+        // Out of budget this frame, or older uploads are still waiting: keep a copy and send it in order later.
+        // Drop what was already sent first, so a backlog doesn't keep growing the buffer.
+        if (bd->UploadQueueHead > 0)
+        {
+            const int sent_bytes = bd->UploadQueue[bd->UploadQueueHead].DataOffset;
+            memmove(bd->UploadQueueData.Data, bd->UploadQueueData.Data + sent_bytes, (size_t)(bd->UploadQueueData.Size - sent_bytes));
+            bd->UploadQueueData.resize(bd->UploadQueueData.Size - sent_bytes);
+            bd->UploadQueue.erase(bd->UploadQueue.Data, bd->UploadQueue.Data + bd->UploadQueueHead);
+            for (ImGui_ImplOpenGL3_QueuedUpload& queued : bd->UploadQueue)
+                queued.DataOffset -= sent_bytes;
+            bd->UploadQueueHead = 0;
+        }
+        ImGui_ImplOpenGL3_QueuedUpload upload = { texture, x, y, w, h, channels, bd->UploadQueueData.Size };
+        bd->UploadQueue.push_back(upload);
+        bd->UploadQueueData.resize(bd->UploadQueueData.Size + size);
+        memcpy(bd->UploadQueueData.Data + upload.DataOffset, pixels, (size_t)size);
+    }
+    bd->UploadCpuMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - upload_start).count();
+}
+
+bool ImGui_ImplOpenGL3_IsTextureUploadPending(ImTextureID tex_id)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplOpenGL3_Init()?");
+    const GLuint texture = (GLuint)(intptr_t)tex_id;
+    for (int n = bd->UploadQueueHead; n < bd->UploadQueue.Size; n++)
+        if (bd->UploadQueue[n].Texture == texture)
+            return true;
+    return false;
+}
+
+void ImGui_ImplOpenGL3_CancelTextureUploads(ImTextureID tex_id)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplOpenGL3_Init()?");
+    const GLuint texture = (GLuint)(intptr_t)tex_id;
+    for (int n = bd->UploadQueueHead; n < bd->UploadQueue.Size; n++)
+        if (bd->UploadQueue[n].Texture == texture)
+            bd->UploadQueue[n].Texture = 0;
+}
+
+static void ImGui_ImplOpenGL3_SetScissor(ImGui_ImplOpenGL3_Data* bd, GLint x, GLint y, GLint w, GLint h)
+{
+    ImGui_ImplOpenGL3_StateCache& cache = bd->StateCache;
+    if (cache.ScissorKnown && cache.Scissor[0] == x && cache.Scissor[1] == y && cache.Scissor[2] == w && cache.Scissor[3] == h)
+    {
+        bd->FrameStats.RedundantSkipped++;
+        return;
+    }
+    GL_CALL(glScissor(x, y, (GLsizei)w, (GLsizei)h));
+    cache.Scissor[0] = x; cache.Scissor[1] = y; cache.Scissor[2] = w; cache.Scissor[3] = h;
+    cache.ScissorKnown = true;
+    bd->FrameStats.ScissorChanges++;
+}
+
+static void ImGui_ImplOpenGL3_BindTexture(ImGui_ImplOpenGL3_Data* bd, GLuint texture)
+{
+    ImGui_ImplOpenGL3_StateCache& cache = bd->StateCache;
+    if (cache.TextureKnown && cache.Texture == texture)
+    {
+        bd->FrameStats.RedundantSkipped++;
+        return;
+    }
+    GL_CALL(glBindTexture(GL_TEXTURE_2D, texture));
+    cache.Texture = texture;
+    cache.TextureKnown = true;
+    bd->FrameStats.TextureBinds++;
+}
+
+static void ImGui_ImplOpenGL3_UseProgram(ImGui_ImplOpenGL3_Data* bd, GLuint program)
+{
+    ImGui_ImplOpenGL3_StateCache& cache = bd->StateCache;
+    if (cache.ProgramKnown && cache.Program == program)
+    {
+        bd->FrameStats.RedundantSkipped++;
+        return;
+    }
+    GL_CALL(glUseProgram(program));
+    cache.Program = program;
+    cache.ProgramKnown = true;
+    bd->FrameStats.ProgramBinds++;
+}
+
 static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_width, int fb_height, GLuint vertex_array_object)
 {
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
@@ -496,15 +1120,20 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
     float B = draw_data->DisplayPos.y + draw_data->DisplaySize.y;
 #if defined(GL_CLIP_ORIGIN)
     if (!clip_origin_lower_left) { float tmp = T; T = B; B = tmp; } // Swap top and bottom if origin is upper left
+#endif
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+    const float S = 1.0f / IM_DRAWVERT_POS_SUBPIXELS; // Compact vertices hold positions in sub-pixel steps, the projection scales them back
+#else
+    const float S = 1.0f;
 #endif
     const float ortho_projection[4][4] =
     {
-        { 2.0f/(R-L),   0.0f,         0.0f,   0.0f },
-        { 0.0f,         2.0f/(T-B),   0.0f,   0.0f },
+        { 2.0f/(R-L)*S, 0.0f,         0.0f,   0.0f },
+        { 0.0f,         2.0f/(T-B)*S, 0.0f,   0.0f },
         { 0.0f,         0.0f,        -1.0f,   0.0f },
         { (R+L)/(L-R),  (T+B)/(B-T),  0.0f,   1.0f },
     };
-    glUseProgram(bd->ShaderHandle);
+    ImGui_ImplOpenGL3_UseProgram(bd, bd->ShaderHandle);
     glUniform1i(bd->AttribLocationTex, 0);
     glUniformMatrix4fv(bd->AttribLocationProjMtx, 1, GL_FALSE, &ortho_projection[0][0]);
 
@@ -519,13 +1148,28 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
 #endif
 
     // Bind vertex/index buffers and setup attributes for ImDrawVert
-    GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, bd->VboHandle));
-    GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, bd->ElementsHandle));
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    if (bd->RingActive)
+    {
+        GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, bd->RingVboHandle));
+        GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, bd->RingElementsHandle));
+    }
+    else
+#endif
+    {
+        GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, bd->VboHandle));
+        GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, bd->ElementsHandle));
+    }
     GL_CALL(glEnableVertexAttribArray(bd->AttribLocationVtxPos));
     GL_CALL(glEnableVertexAttribArray(bd->AttribLocationVtxUV));
     GL_CALL(glEnableVertexAttribArray(bd->AttribLocationVtxColor));
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+    GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxPos,   2, GL_SHORT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)offsetof(ImDrawVert, pos)));
+    GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxUV,    2, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(ImDrawVert), (GLvoid*)offsetof(ImDrawVert, uv)));
+#else
     GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxPos,   2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)offsetof(ImDrawVert, pos)));
     GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxUV,    2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)offsetof(ImDrawVert, uv)));
+#endif
     GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxColor, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ImDrawVert), (GLvoid*)offsetof(ImDrawVert, col)));
 }
 
@@ -539,10 +1183,19 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
     int fb_height = (int)(draw_data->DisplaySize.y * draw_data->FramebufferScale.y);
     if (fb_width <= 0 || fb_height <= 0)
         return;
+    IMGUI_IMPL_PROFILE_ZONE("ImGui_ImplOpenGL3_RenderDrawData");
 
     ImGui_ImplOpenGL3_InitLoader();
 
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != nullptr && "Context or backend not initialized! Did you call ImGui_ImplOpenGL3_Init()?");
+    typedef std::chrono::steady_clock Clock;
+    const Clock::time_point render_start = Clock::now();
+    double upload_ms = 0.0;
+    memset((void*)&bd->FrameStats, 0, sizeof(bd->FrameStats));
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_TIMER_QUERY
+    ImGui_ImplOpenGL3_GpuTimerFrame* gpu_frame = bd->UseGpuTimers ? ImGui_ImplOpenGL3_BeginGpuTimerFrame(bd, draw_data) : nullptr;
+#endif
 
     // Catch up with texture updates. Most of the times, the list will have 1 element with an OK status, aka nothing to do.
     // (This almost always points to ImGui::GetPlatformIO().Textures[] but is part of ImDrawData to allow overriding or disabling texture updates).
@@ -551,6 +1204,15 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
             if (tex->Status != ImTextureStatus_OK)
                 ImGui_ImplOpenGL3_UpdateTexture(tex);
 
+    // App uploads that didn't fit earlier frames' budget get whatever the font atlas left of this one
+    if (bd->UploadQueueHead < bd->UploadQueue.Size)
+    {
+        IMGUI_IMPL_PROFILE_ZONE("Drain upload queue");
+        const Clock::time_point upload_start = Clock::now();
+        ImGui_ImplOpenGL3_DrainUploadQueue(bd);
+        bd->UploadCpuMs += std::chrono::duration<double, std::milli>(Clock::now() - upload_start).count();
+    }
+
     // Backup GL state
     GLenum last_active_texture; glGetIntegerv(GL_ACTIVE_TEXTURE, (GLint*)&last_active_texture);
     glActiveTexture(GL_TEXTURE0);
@@ -590,6 +1252,13 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
     GLboolean last_enable_primitive_restart = (!bd->GlProfileIsES3 && bd->GlVersion >= 310) ? glIsEnabled(GL_PRIMITIVE_RESTART) : GL_FALSE;
 #endif
 
+    // The backup tells us which scissor box, texture and program are current
+    ImGui_ImplOpenGL3_StateCache& cache = bd->StateCache;
+    memcpy(cache.Scissor, last_scissor_box, sizeof(cache.Scissor));
+    cache.Texture = last_texture;
+    cache.Program = last_program;
+    cache.ScissorKnown = cache.TextureKnown = cache.ProgramKnown = true;
+
     // Setup desired GL state
     // Recreate the VAO every time (this is to easily allow multiple GL contexts to be rendered to. VAO are not shared among GL contexts)
     // The renderer would actually work without any VAO bound, but then our VertexAttrib calls would overwrite the default one currently bound.
@@ -597,6 +1266,32 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
 #ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
     GL_CALL(glGenVertexArrays(1, &vertex_array_object));
 #endif
+
+    // Persistent ring: copy every draw list into this frame's segment up front, one memcpy per list and buffer.
+    const GLsizeiptr total_vtx_size = (GLsizeiptr)draw_data->TotalVtxCount * (int)sizeof(ImDrawVert);
+    const GLsizeiptr total_idx_size = (GLsizeiptr)draw_data->TotalIdxCount * (int)sizeof(ImDrawIdx);
+    bd->RingActive = false;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    if (bd->UsePersistentBuffers && total_vtx_size > 0)
+    {
+        IMGUI_IMPL_PROFILE_ZONE("Copy to vertex ring");
+        const Clock::time_point upload_start = Clock::now();
+        bd->RingActive = ImGui_ImplOpenGL3_ReserveRing(bd, total_vtx_size, total_idx_size);
+        if (bd->RingActive)
+        {
+            char* vtx_dst = bd->RingVtxData + bd->RingSegment * bd->RingVtxSegmentSize;
+            char* idx_dst = bd->RingIdxData + bd->RingSegment * bd->RingIdxSegmentSize;
+            for (const ImDrawList* draw_list : draw_data->CmdLists)
+            {
+                memcpy(vtx_dst, draw_list->VtxBuffer.Data, (size_t)draw_list->VtxBuffer.Size * sizeof(ImDrawVert));
+                memcpy(idx_dst, draw_list->IdxBuffer.Data, (size_t)draw_list->IdxBuffer.Size * sizeof(ImDrawIdx));
+                vtx_dst += draw_list->VtxBuffer.Size * sizeof(ImDrawVert);
+                idx_dst += draw_list->IdxBuffer.Size * sizeof(ImDrawIdx);
+            }
+        }
+        upload_ms += std::chrono::duration<double, std::milli>(Clock::now() - upload_start).count();
+    }
+#endif
     ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
 
     // Will project scissor/clipping rectangles into framebuffer space
@@ -604,6 +1299,16 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
     ImVec2 clip_scale = draw_data->FramebufferScale; // (1,1) unless using retina display which are often (2,2)
 
     // Render command lists
+    // (With the ring active, each list's data sits at these offsets inside the current segment.)
+    GLint ring_vtx_base = 0;
+    GLsizeiptr ring_idx_offset = 0;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    if (bd->RingActive)
+    {
+        ring_vtx_base = (GLint)(bd->RingSegment * bd->RingVtxSegmentSize / (GLsizeiptr)sizeof(ImDrawVert));
+        ring_idx_offset = bd->RingSegment * bd->RingIdxSegmentSize;
+    }
+#endif
     for (const ImDrawList* draw_list : draw_data->CmdLists)
     {
         // Upload vertex/index buffers
@@ -616,7 +1321,17 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
         // - See https://github.com/ocornut/imgui/issues/4468 and please report any corruption issues.
         const GLsizeiptr vtx_buffer_size = (GLsizeiptr)draw_list->VtxBuffer.Size * (int)sizeof(ImDrawVert);
         const GLsizeiptr idx_buffer_size = (GLsizeiptr)draw_list->IdxBuffer.Size * (int)sizeof(ImDrawIdx);
-        if (bd->UseBufferSubData)
+        const GLint list_vtx_base = ring_vtx_base;
+        const GLsizeiptr list_idx_offset = ring_idx_offset;
+        IM_UNUSED(list_vtx_base); IM_UNUSED(list_idx_offset); // Only used with glDrawElementsBaseVertex()
+        const Clock::time_point upload_start = Clock::now();
+        if (bd->RingActive)
+        {
+            // Already copied into the ring above
+            ring_vtx_base += draw_list->VtxBuffer.Size;
+            ring_idx_offset += idx_buffer_size;
+        }
+        else if (bd->UseBufferSubData)
         {
             if (bd->VertexBufferSize < vtx_buffer_size)
             {
@@ -636,6 +1351,8 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
             GL_CALL(glBufferData(GL_ARRAY_BUFFER, vtx_buffer_size, (const GLvoid*)draw_list->VtxBuffer.Data, GL_STREAM_DRAW));
             GL_CALL(glBufferData(GL_ELEMENT_ARRAY_BUFFER, idx_buffer_size, (const GLvoid*)draw_list->IdxBuffer.Data, GL_STREAM_DRAW));
         }
+        if (!bd->RingActive)
+            upload_ms += std::chrono::duration<double, std::milli>(Clock::now() - upload_start).count();
 
         for (int cmd_i = 0; cmd_i < draw_list->CmdBuffer.Size; cmd_i++)
         {
@@ -644,6 +1361,7 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
             {
                 // User callback, registered via ImDrawList::AddCallback()
                 // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
+                cache.Invalidate();
                 if (pcmd->UserCallback == ImDrawCallback_ResetRenderState)
                     ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
                 else
@@ -651,25 +1369,46 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
             }
             else
             {
+                bd->FrameStats.DrawCmds++;
+
                 // Project scissor/clipping rectangles into framebuffer space
                 ImVec2 clip_min((pcmd->ClipRect.x - clip_off.x) * clip_scale.x, (pcmd->ClipRect.y - clip_off.y) * clip_scale.y);
                 ImVec2 clip_max((pcmd->ClipRect.z - clip_off.x) * clip_scale.x, (pcmd->ClipRect.w - clip_off.y) * clip_scale.y);
                 if (clip_max.x <= clip_min.x || clip_max.y <= clip_min.y)
                     continue;
 
+                // Merge the following commands into this draw while they use the same clip rect, texture and vertex offset and their indices follow on
+                GLsizei elem_count = (GLsizei)pcmd->ElemCount;
+                while (cmd_i + 1 < draw_list->CmdBuffer.Size)
+                {
+                    const ImDrawCmd* next_cmd = &draw_list->CmdBuffer[cmd_i + 1];
+                    if (next_cmd->UserCallback != nullptr || next_cmd->GetTexID() != pcmd->GetTexID() || next_cmd->VtxOffset != pcmd->VtxOffset || next_cmd->IdxOffset != pcmd->IdxOffset + (unsigned int)elem_count)
+                        break;
+                    if (next_cmd->ClipRect.x != pcmd->ClipRect.x || next_cmd->ClipRect.y != pcmd->ClipRect.y || next_cmd->ClipRect.z != pcmd->ClipRect.z || next_cmd->ClipRect.w != pcmd->ClipRect.w)
+                        break;
+                    elem_count += (GLsizei)next_cmd->ElemCount;
+                    bd->FrameStats.DrawCmds++;
+                    cmd_i++;
+                }
+
                 // Apply scissor/clipping rectangle (Y is inverted in OpenGL)
-                GL_CALL(glScissor((int)clip_min.x, (int)((float)fb_height - clip_max.y), (int)(clip_max.x - clip_min.x), (int)(clip_max.y - clip_min.y)));
+                ImGui_ImplOpenGL3_SetScissor(bd, (int)clip_min.x, (int)((float)fb_height - clip_max.y), (int)(clip_max.x - clip_min.x), (int)(clip_max.y - clip_min.y));
 
                 // Bind texture, Draw
-                GL_CALL(glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->GetTexID()));
+                ImGui_ImplOpenGL3_BindTexture(bd, (GLuint)(intptr_t)pcmd->GetTexID());
+                bd->FrameStats.DrawCalls++;
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
                 if (bd->GlVersion >= 320)
-                    GL_CALL(glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx)), (GLint)pcmd->VtxOffset));
+                    GL_CALL(glDrawElementsBaseVertex(GL_TRIANGLES, elem_count, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(list_idx_offset + pcmd->IdxOffset * sizeof(ImDrawIdx)), list_vtx_base + (GLint)pcmd->VtxOffset));
                 else
 #endif
-                GL_CALL(glDrawElements(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx))));
+                GL_CALL(glDrawElements(GL_TRIANGLES, elem_count, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx))));
             }
         }
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_TIMER_QUERY
+        if (gpu_frame != nullptr)
+            glQueryCounter(gpu_frame->Timestamps[gpu_frame->StampCount++], GL_TIMESTAMP);
+#endif
     }
 
     // Destroy the temporary VAO
@@ -677,10 +1416,21 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
     GL_CALL(glDeleteVertexArrays(1, &vertex_array_object));
 #endif
 
+    // The segment we just drew from gets its fence at the start of the next frame; ReserveRing() checks it when the ring wraps around to it again.
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    if (bd->RingActive)
+    {
+        bd->RingFencePending = true;
+        bd->RingSegment = (bd->RingSegment + 1) % RING_SEGMENTS;
+        bd->RingActive = false;
+        bd->FrameStats.PersistentBuffers = true;
+    }
+#endif
+
     // Restore modified GL state
     // This "glIsProgram()" check is required because if the program is "pending deletion" at the time of binding backup, it will have been deleted by now and will cause an OpenGL error. See #6220.
-    if (last_program == 0 || glIsProgram(last_program)) glUseProgram(last_program);
-    glBindTexture(GL_TEXTURE_2D, last_texture);
+    if (last_program == 0 || glIsProgram(last_program)) ImGui_ImplOpenGL3_UseProgram(bd, last_program);
+    ImGui_ImplOpenGL3_BindTexture(bd, last_texture);
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
     if (bd->HasBindSampler)
         glBindSampler(0, last_sampler);
@@ -713,8 +1463,28 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
 #endif // IMGUI_IMPL_OPENGL_MAY_HAVE_POLYGON_MODE
 
     glViewport(last_viewport[0], last_viewport[1], (GLsizei)last_viewport[2], (GLsizei)last_viewport[3]);
-    glScissor(last_scissor_box[0], last_scissor_box[1], (GLsizei)last_scissor_box[2], (GLsizei)last_scissor_box[3]);
-    (void)bd; // Not all compilation paths use this
+    ImGui_ImplOpenGL3_SetScissor(bd, last_scissor_box[0], last_scissor_box[1], last_scissor_box[2], last_scissor_box[3]);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_TIMER_QUERY
+    if (gpu_frame != nullptr)
+        glEndQuery(GL_TIME_ELAPSED);
+#endif
+
+    ImGui_ImplOpenGL3_FrameStats& stats = bd->FrameStats;
+    stats.VtxBytes = (int)total_vtx_size;
+    stats.IdxBytes = (int)total_idx_size;
+    stats.UploadCpuMs = (float)upload_ms;
+    stats.TexUploadBytes = bd->UploadBytes;
+    stats.TexUploadRingBytes = bd->UploadRingBytes;
+    stats.TexUploadCpuMs = (float)bd->UploadCpuMs;
+    for (int n = bd->UploadQueueHead; n < bd->UploadQueue.Size; n++)
+        if (bd->UploadQueue[n].Texture != 0)
+            stats.TexUploadQueuedBytes += bd->UploadQueue[n].W * bd->UploadQueue[n].H * bd->UploadQueue[n].Channels;
+    bd->UploadBytes = bd->UploadRingBytes = 0;
+    bd->UploadCpuMs = 0.0;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_UPLOAD_RING
+    bd->UploadSegmentOpen = false; // Next frame's uploads start a new segment
+#endif
+    stats.RenderCpuMs = (float)std::chrono::duration<double, std::milli>(Clock::now() - render_start).count();
 }
 
 static void ImGui_ImplOpenGL3_DestroyTexture(ImTextureData* tex)
@@ -729,6 +1499,7 @@ static void ImGui_ImplOpenGL3_DestroyTexture(ImTextureData* tex)
 
 void ImGui_ImplOpenGL3_UpdateTexture(ImTextureData* tex)
 {
+    IMGUI_IMPL_PROFILE_ZONE("ImGui_ImplOpenGL3_UpdateTexture");
     // FIXME: Consider backing up and restoring
     if (tex->Status == ImTextureStatus_WantCreate || tex->Status == ImTextureStatus_WantUpdates)
     {
@@ -772,21 +1543,26 @@ void ImGui_ImplOpenGL3_UpdateTexture(ImTextureData* tex)
     {
         // Update selected blocks. We only ever write to textures regions which have never been used before!
         // This backend choose to use tex->Updates[] but you can use tex->UpdateRect to upload a single region.
+        ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+        const std::chrono::steady_clock::time_point upload_start = std::chrono::steady_clock::now();
         GLint last_texture;
         GL_CALL(glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture));
 
         GLuint gl_tex_id = (GLuint)(intptr_t)tex->TexID;
         GL_CALL(glBindTexture(GL_TEXTURE_2D, gl_tex_id));
-#if GL_UNPACK_ROW_LENGTH // Not on WebGL/ES
-        GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, tex->Width));
         for (ImTextureRect& r : tex->Updates)
+        {
+            bd->UploadBytes += r.w * r.h * tex->BytesPerPixel;
+
+            // Through the upload ring while this frame's budget lasts, directly otherwise (glyphs can't wait for the next frame)
+            if (ImGui_ImplOpenGL3_UploadThroughRing(bd, r.x, r.y, r.w, r.h, GL_RGBA, tex->BytesPerPixel, (const unsigned char*)tex->GetPixelsAt(r.x, r.y), tex->GetPitch()))
+                continue;
+#if GL_UNPACK_ROW_LENGTH // Not on WebGL/ES
+            GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, tex->Width));
             GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, r.x, r.y, r.w, r.h, GL_RGBA, GL_UNSIGNED_BYTE, tex->GetPixelsAt(r.x, r.y)));
-        GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+            GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
 #else
-        // GL ES doesn't have GL_UNPACK_ROW_LENGTH, so we need to (A) copy to a contiguous buffer or (B) upload line by line.
-        ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
-        for (ImTextureRect& r : tex->Updates)
-        {
+            // GL ES doesn't have GL_UNPACK_ROW_LENGTH, so we need to (A) copy to a contiguous buffer or (B) upload line by line.
             const int src_pitch = r.w * tex->BytesPerPixel;
             bd->TempBuffer.resize(r.h * src_pitch);
             char* out_p = bd->TempBuffer.Data;
@@ -794,8 +1570,9 @@ void ImGui_ImplOpenGL3_UpdateTexture(ImTextureData* tex)
                 memcpy(out_p, tex->GetPixelsAt(r.x, r.y + y), src_pitch);
             IM_ASSERT(out_p == bd->TempBuffer.end());
             GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, r.x, r.y, r.w, r.h, GL_RGBA, GL_UNSIGNED_BYTE, bd->TempBuffer.Data));
-        }
 #endif
+        }
+        bd->UploadCpuMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - upload_start).count();
         tex->SetStatus(ImTextureStatus_OK);
         GL_CALL(glBindTexture(GL_TEXTURE_2D, last_texture)); // Restore state
     }
@@ -841,6 +1618,100 @@ static bool CheckProgram(GLuint handle, const char* desc)
     return (GLboolean)status == GL_TRUE;
 }
 
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PROGRAM_BINARY
+// Program cache file: magic, key length + key, binary format, binary length, FNV-1a checksum of the binary, binary.
+static const char PROGRAM_CACHE_MAGIC[8] = { 'I', 'M', 'G', 'L', 'P', 'B', '0', '1' };
+
+static ImU64 ImGui_ImplOpenGL3_HashBytes(const void* data, size_t size, ImU64 hash = 14695981039346656037ULL)
+{
+    const unsigned char* bytes = (const unsigned char*)data;
+    for (size_t n = 0; n < size; n++)
+        hash = (hash ^ bytes[n]) * 1099511628211ULL;
+    return hash;
+}
+
+// Everything that changes the binary the driver hands back. Drivers are meant to reject stale binaries themselves, but not all do.
+static void ImGui_ImplOpenGL3_GetProgramCacheKey(ImGui_ImplOpenGL3_Data* bd, const GLchar* vertex_shader, const GLchar* fragment_shader, char* out, size_t out_size)
+{
+    ImU64 hash = ImGui_ImplOpenGL3_HashBytes(bd->GlslVersionString, strlen(bd->GlslVersionString));
+    hash = ImGui_ImplOpenGL3_HashBytes(vertex_shader, strlen(vertex_shader) + 1, hash);
+    hash = ImGui_ImplOpenGL3_HashBytes(fragment_shader, strlen(fragment_shader) + 1, hash);
+    const char* vendor = (const char*)glGetString(GL_VENDOR);
+    const char* renderer = (const char*)glGetString(GL_RENDERER);
+    const char* version = (const char*)glGetString(GL_VERSION);
+    snprintf(out, out_size, "%s|%s|%s|%016llx", vendor ? vendor : "", renderer ? renderer : "", version ? version : "", (unsigned long long)hash);
+}
+
+// Returns a linked program, or 0 when the file is missing, doesn't match 'key' or the driver won't take the binary.
+static GLuint ImGui_ImplOpenGL3_LoadCachedProgram(ImGui_ImplOpenGL3_Data* bd, const char* key)
+{
+    FILE* f = fopen(bd->ProgramCachePath.Data, "rb");
+    if (f == nullptr)
+        return 0;
+    const ImU32 key_size = (ImU32)strlen(key);
+    char magic[8];
+    ImU32 file_key_size = 0, binary_format = 0, binary_size = 0;
+    ImU64 checksum = 0;
+    ImVector<char> file_key, binary;
+    bool ok = fread(magic, sizeof(magic), 1, f) == 1 && memcmp(magic, PROGRAM_CACHE_MAGIC, sizeof(magic)) == 0
+        && fread(&file_key_size, sizeof(file_key_size), 1, f) == 1 && file_key_size == key_size;
+    if (ok)
+    {
+        file_key.resize((int)key_size);
+        ok = fread(file_key.Data, 1, key_size, f) == key_size && memcmp(file_key.Data, key, key_size) == 0
+            && fread(&binary_format, sizeof(binary_format), 1, f) == 1 && fread(&binary_size, sizeof(binary_size), 1, f) == 1
+            && fread(&checksum, sizeof(checksum), 1, f) == 1 && binary_size > 0 && binary_size < 64 * 1024 * 1024;
+    }
+    if (ok)
+    {
+        binary.resize((int)binary_size);
+        ok = fread(binary.Data, 1, binary_size, f) == binary_size && ImGui_ImplOpenGL3_HashBytes(binary.Data, binary_size) == checksum;
+    }
+    fclose(f);
+    if (!ok)
+        return 0;
+
+    GLuint program = glCreateProgram();
+    glProgramBinary(program, (GLenum)binary_format, binary.Data, (GLsizei)binary_size);
+    GLint status = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+    if ((GLboolean)status != GL_TRUE)
+    {
+        glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+static void ImGui_ImplOpenGL3_SaveCachedProgram(ImGui_ImplOpenGL3_Data* bd, GLuint program, const char* key)
+{
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return;
+    ImVector<char> binary;
+    binary.resize(length);
+    GLenum format = 0;
+    glGetProgramBinary(program, length, &length, &format, binary.Data);
+    if (length <= 0)
+        return;
+
+    FILE* f = fopen(bd->ProgramCachePath.Data, "wb");
+    if (f == nullptr)
+        return;
+    const ImU32 key_size = (ImU32)strlen(key), binary_format = (ImU32)format, binary_size = (ImU32)length;
+    const ImU64 checksum = ImGui_ImplOpenGL3_HashBytes(binary.Data, binary_size);
+    fwrite(PROGRAM_CACHE_MAGIC, sizeof(PROGRAM_CACHE_MAGIC), 1, f);
+    fwrite(&key_size, sizeof(key_size), 1, f);
+    fwrite(key, 1, key_size, f);
+    fwrite(&binary_format, sizeof(binary_format), 1, f);
+    fwrite(&binary_size, sizeof(binary_size), 1, f);
+    fwrite(&checksum, sizeof(checksum), 1, f);
+    fwrite(binary.Data, 1, binary_size, f);
+    fclose(f);
+}
+#endif
+
 bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
 {
     ImGui_ImplOpenGL3_InitLoader();
@@ -987,35 +1858,61 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
         fragment_shader = fragment_shader_glsl_130;
     }
 
-    // Create shaders
-    const GLchar* vertex_shader_with_version[2] = { bd->GlslVersionString, vertex_shader };
-    GLuint vert_handle;
-    GL_CALL(vert_handle = glCreateShader(GL_VERTEX_SHADER));
-    glShaderSource(vert_handle, 2, vertex_shader_with_version, nullptr);
-    glCompileShader(vert_handle);
-    if (!CheckShader(vert_handle, "vertex shader"))
-        return false;
-
-    const GLchar* fragment_shader_with_version[2] = { bd->GlslVersionString, fragment_shader };
-    GLuint frag_handle;
-    GL_CALL(frag_handle = glCreateShader(GL_FRAGMENT_SHADER));
-    glShaderSource(frag_handle, 2, fragment_shader_with_version, nullptr);
-    glCompileShader(frag_handle);
-    if (!CheckShader(frag_handle, "fragment shader"))
-        return false;
-
-    // Link
-    bd->ShaderHandle = glCreateProgram();
-    glAttachShader(bd->ShaderHandle, vert_handle);
-    glAttachShader(bd->ShaderHandle, frag_handle);
-    glLinkProgram(bd->ShaderHandle);
-    if (!CheckProgram(bd->ShaderHandle, "shader program"))
-        return false;
-
-    glDetachShader(bd->ShaderHandle, vert_handle);
-    glDetachShader(bd->ShaderHandle, frag_handle);
-    glDeleteShader(vert_handle);
-    glDeleteShader(frag_handle);
+    // Reuse the program binary from the last run when the cache matches, otherwise compile and link
+    typedef std::chrono::steady_clock Clock;
+    const Clock::time_point program_start = Clock::now();
+    bd->ProgramFromCache = false;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PROGRAM_BINARY
+    const bool use_cache = bd->ProgramCachePath.Size > 0;
+    char cache_key[512] = "";
+    if (use_cache)
+    {
+        ImGui_ImplOpenGL3_GetProgramCacheKey(bd, vertex_shader, fragment_shader, cache_key, sizeof(cache_key));
+        bd->ShaderHandle = ImGui_ImplOpenGL3_LoadCachedProgram(bd, cache_key);
+        bd->ProgramFromCache = (bd->ShaderHandle != 0);
+    }
+#endif
+    if (!bd->ProgramFromCache)
+    {
+        // Create shaders
+        const GLchar* vertex_shader_with_version[2] = { bd->GlslVersionString, vertex_shader };
+        GLuint vert_handle;
+        GL_CALL(vert_handle = glCreateShader(GL_VERTEX_SHADER));
+        glShaderSource(vert_handle, 2, vertex_shader_with_version, nullptr);
+        glCompileShader(vert_handle);
+        if (!CheckShader(vert_handle, "vertex shader"))
+            return false;
+
+        const GLchar* fragment_shader_with_version[2] = { bd->GlslVersionString, fragment_shader };
+        GLuint frag_handle;
+        GL_CALL(frag_handle = glCreateShader(GL_FRAGMENT_SHADER));
+        glShaderSource(frag_handle, 2, fragment_shader_with_version, nullptr);
+        glCompileShader(frag_handle);
+        if (!CheckShader(frag_handle, "fragment shader"))
+            return false;
+
+        // Link
+        bd->ShaderHandle = glCreateProgram();
+        glAttachShader(bd->ShaderHandle, vert_handle);
+        glAttachShader(bd->ShaderHandle, frag_handle);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PROGRAM_BINARY
+        if (use_cache)
+            glProgramParameteri(bd->ShaderHandle, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+#endif
+        glLinkProgram(bd->ShaderHandle);
+        if (!CheckProgram(bd->ShaderHandle, "shader program"))
+            return false;
+
+        glDetachShader(bd->ShaderHandle, vert_handle);
+        glDetachShader(bd->ShaderHandle, frag_handle);
+        glDeleteShader(vert_handle);
+        glDeleteShader(frag_handle);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PROGRAM_BINARY
+        if (use_cache)
+            ImGui_ImplOpenGL3_SaveCachedProgram(bd, bd->ShaderHandle, cache_key);
+#endif
+    }
+    bd->ProgramSetupMs = (float)std::chrono::duration<double, std::milli>(Clock::now() - program_start).count();
 
     bd->AttribLocationTex = glGetUniformLocation(bd->ShaderHandle, "Texture");
     bd->AttribLocationProjMtx = glGetUniformLocation(bd->ShaderHandle, "ProjMtx");
@@ -1047,6 +1944,18 @@ void    ImGui_ImplOpenGL3_DestroyDeviceObjects()
     if (bd->VboHandle)      { glDeleteBuffers(1, &bd->VboHandle); bd->VboHandle = 0; }
     if (bd->ElementsHandle) { glDeleteBuffers(1, &bd->ElementsHandle); bd->ElementsHandle = 0; }
     if (bd->ShaderHandle)   { glDeleteProgram(bd->ShaderHandle); bd->ShaderHandle = 0; }
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    ImGui_ImplOpenGL3_DestroyRing(bd);
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_UPLOAD_RING
+    ImGui_ImplOpenGL3_DestroyUploadRing(bd);
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_TIMER_QUERY
+    ImGui_ImplOpenGL3_DestroyGpuTimers(bd);
+#endif
+    bd->UploadQueue.clear();
+    bd->UploadQueueData.clear();
+    bd->UploadQueueHead = 0;
 
     // Destroy all textures
     for (ImTextureData* tex : ImGui::GetPlatformIO().Textures)
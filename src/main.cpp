@@ -6,8 +6,20 @@
 #include <vector>
 #include <string>
 #include <filesystem> 
+#include <cstdlib>
+#include <chrono>
+#include <ctime>
 
 #include "GameEngine.h"
+#include "GpuTimeOverlay.h"
+#include "InputLatency.h"
+#include "FrameScheduler.h"
+#include "AllocTracker.h"
+#include "GameUI.h"
+#include "SaveCatalog.h"
+#include "Profiler.h"
+#include "InputRecording.h"
+#include "SimClock.h"
 
 namespace fs = std::filesystem;
 
@@ -15,58 +27,23 @@ const int WINDOW_WIDTH = 1920;
 const int WINDOW_HEIGHT = 1080;
 
 GameEngine engine;
-bool showInventory = false;
-bool showMap = false;
-
-// Popup States
-bool showSavePopup = false;
-bool showLoadPopup = false;
-char saveFileNameBuffer[128] = "savegame"; 
-std::string statusMessage = "";
-float statusTimer = 0.0f;
-
-// Helpers
-void setupImGuiStyle() {
-    ImGuiStyle& style = ImGui::GetStyle();
-    style.Colors[ImGuiCol_WindowBg] = ImVec4(0.1f, 0.1f, 0.15f, 0.95f);
-    style.Colors[ImGuiCol_Text] = ImVec4(0.9f, 0.9f, 0.9f, 1.0f);
-    style.Colors[ImGuiCol_Button] = ImVec4(0.3f, 0.3f, 0.4f, 1.0f);
-    style.FrameRounding = 5.0f;
-}
-
-void DrawBackgroundCover(unsigned int texID, int screenW, int screenH) {
-    if (texID == 0) {
-        ImGui::GetBackgroundDrawList()->AddRectFilled(ImVec2(0,0), ImVec2((float)screenW, (float)screenH), IM_COL32(20,20,20,255));
-        return;
-    }
-    ImTextureID my_tex_id = (ImTextureID)(intptr_t)texID;
-    
-    // Maintain Aspect Ratio
-    float imgW = 1920.0f; 
-    float imgH = 1080.0f;
-    float screenAspect = (float)screenW / (float)screenH;
-    float imgAspect = imgW / imgH;
-    float drawW, drawH;
-
-    if (screenAspect > imgAspect) {
-        drawW = (float)screenW;
-        drawH = drawW / imgAspect;
-    } else {
-        drawH = (float)screenH;
-        drawW = drawH * imgAspect;
-    }
-
-    float x = (screenW - drawW) * 0.5f;
-    float y = (screenH - drawH) * 0.5f;
-
-    ImGui::GetBackgroundDrawList()->AddImage(my_tex_id, 
-        ImVec2(x, y), 
-        ImVec2(x + drawW, y + drawH), 
-        ImVec2(0, 0), ImVec2(1, 1), 
-        IM_COL32(255, 255, 255, 255));
-}
-
-int main() {
+bool showGpuTimes = false;
+GpuTimeOverlay gpuTimes;
+bool showInputLatency = false;
+InputLatencyOverlay inputLatency;
+LateLatch lateLatch;
+FrameScheduler frameScheduler;
+bool showAllocStats = false;
+bool showProfiler = false;
+SaveCatalog saveCatalog;
+GameUI ui(engine, saveCatalog);
+InputRecorder inputRecorder;
+InputReplayer inputReplayer;
+SimClock simClock;
+
+int main(int argc, char** argv) {
+    const auto launchTime = std::chrono::steady_clock::now();
+    ATW_PROFILE_THREAD("Main");
     if (!glfwInit()) return -1;
     
     GLFWwindow* window = glfwCreateWindow(WINDOW_WIDTH, WINDOW_HEIGHT, "Alex The Wolf", NULL, NULL);
@@ -74,6 +51,14 @@ int main() {
     glfwMakeContextCurrent(window);
     glfwSwapInterval(1); 
 
+    // ATW_ALLOC_STATS=1 counts heap allocations per frame and per UI scope (F5 shows them). ImGui's allocator is hooked before its context exists.
+    const char* allocStats = getenv("ATW_ALLOC_STATS");
+    if (allocStats && allocStats[0] == '1') {
+        AllocTracker::install();
+        AllocTracker::setEnabled(true);
+        showAllocStats = true;
+    }
+
     IMGUI_CHECKVERSION();
     ImGui::CreateContext();
     ImGuiIO& io = ImGui::GetIO(); (void)io;
@@ -88,511 +73,239 @@ int main() {
     ImGui_ImplOpenGL3_Init("#version 130");
     setupImGuiStyle();
 
+    // ATW_GL_PERSISTENT=1 streams UI geometry through a persistently mapped ring (GL 4.4 / ARB_buffer_storage).
+    // ATW_GL_ASYNC_UPLOADS=0 turns off the pixel-buffer upload ring used for the font atlas and scene textures.
+    // ATW_GL_STATS=1 prints the backend's average CPU time per frame on exit.
+    // ATW_GL_GPU_TIMERS=1 opens the GPU frame-time overlay at startup (F3 toggles it at any time).
+    // ATW_GL_PROGRAM_CACHE=0 always compiles the UI shaders instead of loading imgui_program.bin next to the exe.
+    // ATW_LATE_LATCH=1 polls input as late as the previous frames' build time allows instead of right after the swap.
+    // ATW_INPUT_LATENCY=1 opens the click-to-present latency overlay at startup (F4 toggles it at any time).
+    // ATW_IDLE_RENDER=0 redraws every vblank instead of sleeping while nothing on screen changes.
+    // ATW_WRAP_CACHE=0 measures and lays out wrapped text every frame instead of reusing the line breaks of the last 64 texts.
+    // ATW_SIM_HZ=<rate> steps the game's timers (typewriter, slideshow, status message) at that rate instead of 100 Hz.
+    // ATW_RECORD=<file> records this session's input, frame times, RNG seed and sim rate; ATW_REPLAY=<file> plays one back
+    // in the window, at the recorded sim rate whatever ATW_SIM_HZ says.
+    // (ui_state_bench --replay <file> plays it back headless, as fast as it goes.)
+    // Builds with ATW_PROFILE (the "Build game (profiler)" task) add a CPU profiler timeline on F6 that exports atw_trace.json.
+    const char* glPersistent = getenv("ATW_GL_PERSISTENT");
+    if (glPersistent && glPersistent[0] == '1' && !ImGui_ImplOpenGL3_SetPersistentBuffers(true))
+        std::cout << "ATW_GL_PERSISTENT: buffer storage not available, using glBufferData" << std::endl;
+    const char* glAsyncUploads = getenv("ATW_GL_ASYNC_UPLOADS");
+    if (!(glAsyncUploads && glAsyncUploads[0] == '0'))
+        ImGui_ImplOpenGL3_SetAsyncTextureUploads(true, 4 * 1024 * 1024);
+    const char* glProgramCache = getenv("ATW_GL_PROGRAM_CACHE");
+    if (!(glProgramCache && glProgramCache[0] == '0')) {
+        fs::path exeDir = (argc > 0 && argv[0][0]) ? fs::absolute(fs::path(argv[0])).parent_path() : fs::current_path();
+        ImGui_ImplOpenGL3_SetProgramCache((exeDir / "imgui_program.bin").string().c_str());
+    }
+    const char* wrapCache = getenv("ATW_WRAP_CACHE");
+    if (!(wrapCache && wrapCache[0] == '0'))
+        io.Fonts->WrapCacheCapacity = 64;
+    const char* glStats = getenv("ATW_GL_STATS");
+    bool printGlStats = glStats && glStats[0] == '1';
+    double glRenderMsTotal = 0.0, glUploadMsTotal = 0.0;
+    long long glFrames = 0, glDrawCallsTotal = 0, glStateChangesTotal = 0, glTexBytesTotal = 0;
+    double glTexUploadMsTotal = 0.0;
+    double firstFrameMs = 0.0;
+    const char* glGpuTimers = getenv("ATW_GL_GPU_TIMERS");
+    if (glGpuTimers && glGpuTimers[0] == '1') {
+        showGpuTimes = true;
+        if (!gpuTimes.enable(true))
+            std::cout << "ATW_GL_GPU_TIMERS: timer queries not available on this context" << std::endl;
+    }
+    const char* lateLatchEnv = getenv("ATW_LATE_LATCH");
+    if (lateLatchEnv && lateLatchEnv[0] == '1') {
+        const GLFWvidmode* mode = glfwGetVideoMode(glfwGetPrimaryMonitor());
+        lateLatch.enable(true, mode ? mode->refreshRate : 60);
+    }
+    const char* inputLatencyEnv = getenv("ATW_INPUT_LATENCY");
+    showInputLatency = inputLatencyEnv && inputLatencyEnv[0] == '1';
+    const char* idleRender = getenv("ATW_IDLE_RENDER");
+    frameScheduler.enable(!(idleRender && idleRender[0] == '0'));
+    const char* simHz = getenv("ATW_SIM_HZ");
+    double simRate = (simHz && atof(simHz) > 0.0) ? atof(simHz) : SimClock::DEFAULT_RATE;
+    simClock.setRate(simRate);
+    double lastInputSeen = 0.0;
+    int lastDisplayW = 0, lastDisplayH = 0;
+
+    const char* recordPath = getenv("ATW_RECORD");
+    const char* replayPath = getenv("ATW_REPLAY");
+    if (replayPath && replayPath[0]) {
+        if (inputReplayer.open(replayPath)) {
+            engine.rngSeed = inputReplayer.seed();
+            if (inputReplayer.simRate() > 0.0) simClock.setRate(inputReplayer.simRate());
+        } else {
+            std::cout << "ATW_REPLAY: couldn't read a recording from " << replayPath << std::endl;
+        }
+    } else if (recordPath && recordPath[0]) {
+        engine.rngSeed = (unsigned int)time(0);
+        if (!inputRecorder.start(recordPath, engine.rngSeed, simRate))
+            std::cout << "ATW_RECORD: couldn't create " << recordPath << std::endl;
+    }
+
     // INITIALIZE GAME
     engine.initGame(); 
     // Start music immediately
     engine.updateMusicSystem(); 
+    // Save list for the Load popup, kept up to date in the background
+    saveCatalog.start(".");
 
-    // LOAD TEXTURES
-    unsigned int menuBg = engine.getGeneralTexture("start_screen.png"); 
-    
-    // UI Icons
-    unsigned int iconMap = engine.getGeneralTexture("map_icon.png");       
-    unsigned int overlayMap = engine.getGeneralTexture("map.png");   
-    unsigned int iconInventory = engine.getGeneralTexture("inventory.png");
-    unsigned int iconScavenge = engine.getGeneralTexture("scavenge.png");
-    unsigned int iconRest = engine.getGeneralTexture("rest.png");
-    unsigned int iconUndo = engine.getGeneralTexture("undo.png");
-    unsigned int iconSave = engine.getGeneralTexture("save.png");
-    unsigned int iconMute = engine.getGeneralTexture("mute.png"); // NEW
-
-    // Stat Icons
-    unsigned int iconHealth = engine.getGeneralTexture("health.png");
-    unsigned int iconEnergy = engine.getGeneralTexture("energy.png");
-    unsigned int iconHunger = engine.getGeneralTexture("hunger.png");
-    unsigned int iconRep = engine.getGeneralTexture("reputation.png");
-
-    // Background vars
-    std::string cachedImageName = "";
-    unsigned int cachedTextureID = 0;
-    int slideIndex = 0;
-    float slideTimer = 0.0f;
+    ui.init(titleFont, bodyFont);
 
     while (!glfwWindowShouldClose(window)) {
-        glfwPollEvents();
-
-        ImGui_ImplOpenGL3_NewFrame();
-        ImGui_ImplGlfw_NewFrame();
-        ImGui::NewFrame();
+        ATW_PROFILE_FRAME();
+        {
+            ATW_PROFILE_ZONE("Wait for input");
+            frameScheduler.waitForNextFrame();
+            lateLatch.pollEvents();
+        }
+        AllocTracker::beginFrame();
 
+        {
+            ATW_PROFILE_ZONE("Backend NewFrame");
+            ImGui_ImplOpenGL3_NewFrame();
+            ImGui_ImplGlfw_NewFrame();
+        }
         int display_w, display_h;
         glfwGetFramebufferSize(window, &display_w, &display_h);
-
-        // Update Global Typewriter Logic
-        engine.updateTypewriter(io.DeltaTime);
-
-        // Status Message Timer
-        if (!statusMessage.empty()) {
-            statusTimer += io.DeltaTime;
-            if (statusTimer > 3.0f) { statusMessage = ""; statusTimer = 0; }
+        // The screens lay out for the recorded window size; the real window only changes the viewport
+        int ui_w = display_w, ui_h = display_h;
+        if (inputRecorder.isRecording()) inputRecorder.recordFrame(display_w, display_h);
+        if (inputReplayer.isOpen()) {
+            if (!inputReplayer.applyFrame(&ui_w, &ui_h)) break;
+            frameScheduler.keepAwake();
         }
-
-        // ==========================================
-        // 1. MENU STATE
-        // ==========================================
-        if (engine.currentState == STATE_MENU) {
-            DrawBackgroundCover(menuBg, display_w, display_h);
-
-            ImGui::SetNextWindowPos(ImVec2(display_w/2 - 150, display_h/2 - 100));
-            ImGui::SetNextWindowSize(ImVec2(300, 250));
-            ImGui::PushStyleColor(ImGuiCol_WindowBg, ImVec4(0, 0, 0, 0.8f));
-            
-            if (ImGui::Begin("MainMenu", nullptr, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize)) {
-                ImGui::PushFont(titleFont);
-                float textW = ImGui::CalcTextSize("ALEX THE WOLF").x;
-                ImGui::SetCursorPosX((300 - textW) * 0.5f);
-                ImGui::Text("ALEX THE WOLF");
-                ImGui::PopFont();
-                ImGui::Spacing(); ImGui::Separator(); ImGui::Spacing();
-
-                if (ImGui::Button("NEW GAME", ImVec2(280, 50))) {
-                    engine.initGame(); 
-                    engine.currentState = STATE_INTRO;
-                    
-                    // Setup Intro Text
-                    engine.introLineIndex = 0;
-                    if (!engine.introLines.empty()) {
-                        engine.targetText = engine.introLines[0];
-                        engine.textCharIndex = 0;
-                        engine.currentDisplayedText = "";
-                        engine.textFinished = false;
-                    }
-                    engine.updateMusicSystem();
-                }
-                ImGui::Spacing();
-                
-                if (ImGui::Button("LOAD GAME", ImVec2(280, 50))) {
-                    showLoadPopup = true; 
-                }
-                ImGui::Spacing();
-
-                if (ImGui::Button("QUIT", ImVec2(280, 50))) {
-                    glfwSetWindowShouldClose(window, true);
-                }
-            }
-            ImGui::End();
-            ImGui::PopStyleColor();
+        {
+            ATW_PROFILE_ZONE("NewFrame");
+            ImGui::NewFrame();
         }
-
-        // ==========================================
-        // 2. INTRO STORY (With Typewriter)
-        // ==========================================
-        else if (engine.currentState == STATE_INTRO) {
-            DrawBackgroundCover(menuBg, display_w, display_h);
-            
-            ImGui::SetNextWindowPos(ImVec2(50, display_h - 250));
-            ImGui::SetNextWindowSize(ImVec2(display_w - 100, 200));
-            ImGui::PushStyleColor(ImGuiCol_WindowBg, ImVec4(0, 0, 0, 0.9f));
-            
-            if (ImGui::Begin("IntroBox", nullptr, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize)) {
-                
-                ImGui::PushFont(bodyFont);
-                ImGui::TextWrapped("%s", engine.currentDisplayedText.c_str());
-                ImGui::PopFont();
-
-                ImGui::SetCursorPosY(150);
-                
-                // Next Button
-                if (ImGui::Button("NEXT >>", ImVec2(100, 30))) {
-                    if (!engine.textFinished) {
-                        engine.skipTypewriter(); 
-                    } else {
-                        engine.introLineIndex++;
-                        if (engine.introLineIndex >= engine.introLines.size()) {
-                            engine.currentState = STATE_GAMEPLAY;
-                            engine.updateMusicSystem();
-                            
-                            if(engine.currentNode) {
-                                engine.targetText = engine.currentNode->text;
-                                engine.textCharIndex = 0;
-                                engine.currentDisplayedText = "";
-                                engine.textFinished = false;
-                            }
-                        } else {
-                            engine.targetText = engine.introLines[engine.introLineIndex];
-                            engine.textCharIndex = 0;
-                            engine.currentDisplayedText = "";
-                            engine.textFinished = false;
-                        }
-                    }
-                }
-            }
-            ImGui::End();
-            ImGui::PopStyleColor();
+        inputLatency.frameStarted(glfwGetTime());
+
+        // Game timers run on the fixed-step clock, whatever the frame rate; the frame's time is paid for in whole steps
+        {
+            ATW_PROFILE_ZONE("Simulation");
+            int steps = simClock.advance(io.DeltaTime);
+            for (int i = 0; i < steps; i++)
+                if (ui.update((float)simClock.stepSeconds())) frameScheduler.markDirty();
         }
 
-        // ==========================================
-        // 3. GAMEPLAY
-        // ==========================================
-        else if (engine.currentState == STATE_GAMEPLAY || engine.currentState == STATE_OUTRO) {
-            
-        // --- BACKGROUND LOGIC ---
-            if (engine.currentNode) {
-                // 1. Reset logic when moving to a new node
-                static int lastNodeID = -1;
-                if (engine.currentNode->id != lastNodeID) {
-                    slideIndex = 0;      // Reset index
-                    slideTimer = 0.0f;   // Reset timer
-                    lastNodeID = engine.currentNode->id;
-                    cachedImageName = engine.currentNode->mainImage; // Default to main image
-                }
-
-                // 2. Safety Check: Does this node actually have a slideshow?
-                bool hasSlides = !engine.currentNode->slideshow.empty();
-
-                if (hasSlides) {
-                    // Update Timer
-                    slideTimer += io.DeltaTime;
-                    if (slideTimer > 1.5f) { 
-                        slideTimer = 0.0f;
-                        // Safe Modulo Arithmetic
-                        size_t sz = engine.currentNode->slideshow.size();
-                        if (sz > 0) {
-                             slideIndex = (slideIndex + 1) % sz;
-                        }
-                    }
-                    
-                    // Safe Access
-                    if (slideIndex < engine.currentNode->slideshow.size()) {
-                        cachedImageName = engine.currentNode->slideshow[slideIndex];
-                    } else {
-                        // Fallback if index somehow went out of bounds
-                        slideIndex = 0;
-                        if (!engine.currentNode->slideshow.empty())
-                            cachedImageName = engine.currentNode->slideshow[0];
-                    }
-                } 
-                else {
-                    // 3. Fallback: No slideshow, ensure we show the main image
-                    if (cachedImageName != engine.currentNode->mainImage) {
-                        cachedImageName = engine.currentNode->mainImage;
-                    }
-                }
-                
-                // 4. Load and Draw
-                cachedTextureID = engine.getNodeTexture(cachedImageName);
-                DrawBackgroundCover(cachedTextureID, display_w, display_h);
-            }
-
-            // --- HUD (STATS) ---
-            ImGui::SetNextWindowPos(ImVec2(20, 20));
-            ImGui::SetNextWindowSize(ImVec2(350, 220));
-            ImGui::PushStyleColor(ImGuiCol_WindowBg, ImVec4(0, 0, 0, 0.5f));
-            if (ImGui::Begin("Stats", nullptr, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize)) {
-                ImGui::PushFont(bodyFont);
-                
-                ImGui::TextColored(ImVec4(1, 0.8f, 0, 1), "Day: %d", engine.currentStats.dayCount);
-                
-                if(!statusMessage.empty()) 
-                    ImGui::TextColored(ImVec4(0.2f, 1.0f, 0.2f, 1.0f), ">> %s", statusMessage.c_str());
-                else 
-                    ImGui::Spacing();
-
-                ImGui::Separator(); 
-
-                // HEALTH
-                if(iconHealth) ImGui::Image((ImTextureID)(intptr_t)iconHealth, ImVec2(24,24)); 
-                else ImGui::Text("HP ");
-                ImGui::SameLine(); 
-                ImGui::ProgressBar(engine.currentStats.health / 100.0f, ImVec2(200, 24), std::to_string(engine.currentStats.health).c_str());
-
-                // ENERGY
-                if(iconEnergy) ImGui::Image((ImTextureID)(intptr_t)iconEnergy, ImVec2(24,24)); 
-                else ImGui::Text("EN ");
-                ImGui::SameLine(); 
-                ImGui::PushStyleColor(ImGuiCol_PlotHistogram, ImVec4(0.2f, 0.7f, 0.9f, 1.0f)); 
-                ImGui::ProgressBar(engine.currentStats.energy / 100.0f, ImVec2(200, 24), std::to_string(engine.currentStats.energy).c_str());
-                ImGui::PopStyleColor();
-
-                // HUNGER
-                if(iconHunger) ImGui::Image((ImTextureID)(intptr_t)iconHunger, ImVec2(24,24)); 
-                else ImGui::Text("FD ");
-                ImGui::SameLine(); 
-                ImGui::PushStyleColor(ImGuiCol_PlotHistogram, ImVec4(0.8f, 0.4f, 0.1f, 1.0f)); 
-                ImGui::ProgressBar(engine.currentStats.hunger / 100.0f, ImVec2(200, 24), std::to_string(engine.currentStats.hunger).c_str());
-                ImGui::PopStyleColor();
-
-                ImGui::Spacing();
-                
-                // REPUTATION
-                if(iconRep) ImGui::Image((ImTextureID)(intptr_t)iconRep, ImVec2(24,24)); 
-                else ImGui::Text("REP");
-                ImGui::SameLine();
-                ImGui::PushStyleColor(ImGuiCol_PlotHistogram, ImVec4(0.6f, 0.2f, 0.8f, 1.0f)); 
-                char repBuf[16]; sprintf(repBuf, "%d", engine.currentStats.reputation);
-                ImGui::ProgressBar(engine.currentStats.reputation / 100.0f, ImVec2(200, 24), repBuf);
-                ImGui::PopStyleColor();
-                
-                ImGui::SetCursorPosX(55);
-                ImGui::Text("Rank: %s", engine.getFinalTitle().c_str());
-
-                ImGui::PopFont();
-            }
-            ImGui::End();
-            ImGui::PopStyleColor();
-
-            // --- ACTION BAR ---
-            ImGui::SetNextWindowPos(ImVec2(display_w - 480, 20)); // WIDENED
-            ImGui::SetNextWindowSize(ImVec2(460, 80));           // WIDENED
-            ImGui::PushStyleColor(ImGuiCol_WindowBg, ImVec4(0,0,0,0));
-            if (ImGui::Begin("Actions", nullptr, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize)) {
-                float iconSize = 48.0f;
-                ImVec2 btnSize = ImVec2(50, 40);
-
-                // Inventory
-                if (iconInventory && ImGui::ImageButton("inv_btn", (ImTextureID)(intptr_t)iconInventory, ImVec2(iconSize, iconSize))) showInventory = !showInventory;
-                else if (!iconInventory && ImGui::Button("INV", btnSize)) showInventory = !showInventory;
-                ImGui::SameLine();
-
-                // Map
-                if (iconMap && ImGui::ImageButton("map_btn", (ImTextureID)(intptr_t)iconMap, ImVec2(iconSize, iconSize))) showMap = !showMap;
-                else if (!iconMap && ImGui::Button("MAP", btnSize)) showMap = !showMap;
-                ImGui::SameLine();
-
-                // Scavenge
-                if (iconScavenge && ImGui::ImageButton("scav_btn", (ImTextureID)(intptr_t)iconScavenge, ImVec2(iconSize, iconSize))) engine.performGlobalScavenge();
-                else if (!iconScavenge && ImGui::Button("HUNT", btnSize)) engine.performGlobalScavenge();
-                ImGui::SameLine();
-
-                // Rest
-                if (iconRest && ImGui::ImageButton("rest_btn", (ImTextureID)(intptr_t)iconRest, ImVec2(iconSize, iconSize))) engine.performGlobalRest();
-                else if (!iconRest && ImGui::Button("REST", btnSize)) engine.performGlobalRest();
-                ImGui::SameLine();
-
-                // Undo
-                if (iconUndo && ImGui::ImageButton("undo_btn", (ImTextureID)(intptr_t)iconUndo, ImVec2(iconSize, iconSize))) { 
-                    engine.undoLastAction(); 
-                    statusMessage = "Undo Performed"; 
-                } 
-                else if (!iconUndo && ImGui::Button("UNDO", btnSize)) { 
-                    engine.undoLastAction(); 
-                    statusMessage = "Undo Performed"; 
-                }
-                ImGui::SameLine();
-
-                // Save
-                if (iconSave && ImGui::ImageButton("save_btn", (ImTextureID)(intptr_t)iconSave, ImVec2(iconSize, iconSize))) showSavePopup = true;
-                else if (!iconSave && ImGui::Button("SAVE", btnSize)) showSavePopup = true;
-
-                // --- MUTE BUTTON ---
-                ImGui::SameLine();
-                // Check if we have the icon
-                unsigned int iconMute = engine.getGeneralTexture("mute.png");
-                if (iconMute) {
-                    // Tint red if muted
-                    ImVec4 tint = engine.isMuted ? ImVec4(1, 0.5f, 0.5f, 1) : ImVec4(1, 1, 1, 1);
-                    if (ImGui::ImageButton("mute_btn", (ImTextureID)(intptr_t)iconMute, ImVec2(iconSize, iconSize), ImVec2(0,0), ImVec2(1,1), ImVec4(0,0,0,0), tint)) {
-                        engine.toggleMute();
-                    }
-                } else {
-                    // Fallback Text Button
-                    std::string muteLabel = engine.isMuted ? "UNMUTE" : "MUTE";
-                    if (ImGui::Button(muteLabel.c_str(), ImVec2(60, 40))) engine.toggleMute();
-                }
-            }
-            ImGui::End();
-            ImGui::PopStyleColor();
-
-            // --- STORY BOX (TYPEWRITER) ---
-            ImGui::SetNextWindowPos(ImVec2(50, display_h - 250));
-            ImGui::SetNextWindowSize(ImVec2(display_w - 100, 200));
-            ImGui::PushStyleColor(ImGuiCol_WindowBg, ImVec4(0, 0, 0, 0.85f)); 
-            if (ImGui::Begin("StoryBox", nullptr, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize)) {
-                
-                ImGui::PushFont(titleFont);
-                ImGui::TextWrapped("%s", engine.currentDisplayedText.c_str());
-                ImGui::PopFont();
-                
-                ImGui::Spacing(); ImGui::Separator(); ImGui::Spacing();
-
-                // Choices
-                if (engine.currentNode) {
-                    ImGui::PushFont(bodyFont);
-                    for (int i = 0; i < engine.currentNode->children.size(); i++) {
-                        ImGui::PushID(i); 
-                        if (ImGui::Button(engine.currentNode->children[i].first.c_str(), ImVec2(0, 40))) {
-                            engine.makeChoice(i);
-                        }
-                        ImGui::PopID();
-                        if (i < engine.currentNode->children.size() - 1) ImGui::SameLine();
-                    }
-                    ImGui::PopFont();
-                }
-            }
-            ImGui::End();
-            ImGui::PopStyleColor();
-
-            // --- INVENTORY OVERLAY ---
-            if (showInventory) {
-                ImGui::SetNextWindowPos(ImVec2(display_w/2 - 200, display_h/2 - 200));
-                ImGui::SetNextWindowSize(ImVec2(400, 400));
-                ImGui::PushStyleColor(ImGuiCol_WindowBg, ImVec4(0.05f, 0.05f, 0.05f, 0.98f));
-                
-                if (ImGui::Begin("Backpack", &showInventory, ImGuiWindowFlags_NoCollapse)) {
-                    ImGui::PushFont(titleFont); 
-                    ImGui::Text("Pack Contents"); 
-                    ImGui::PopFont(); 
-                    ImGui::Separator();
-                    
-                    ImGui::PushFont(bodyFont);
-                    std::vector<Item> items = engine.inventory.toVector();
-                    if (items.empty()) {
-                        ImGui::TextDisabled("Empty.");
-                    } else {
-                        for (int i = 0; i < items.size(); i++) {
-                            ImGui::PushID(i);
-                            ImGui::Text("%s x%d", items[i].name.c_str(), items[i].quantity); 
-                            ImGui::SameLine(300);
-                            
-                            // HERB Logic Added Here
-                            if (items[i].type == FOOD || items[i].type == HERB) { 
-                                if (ImGui::Button("USE")) engine.useItem(items[i].name); 
-                            } else {
-                                ImGui::TextDisabled("[TOOL]");
-                            }
-                            ImGui::PopID();
-                        }
-                    }
-                    ImGui::PopFont();
-                }
-                ImGui::End();
-                ImGui::PopStyleColor();
-            }
-
-            // --- MAP OVERLAY ---
-            if (showMap) {
-                ImGui::SetNextWindowPos(ImVec2(50, 50));
-                ImGui::SetNextWindowSize(ImVec2(display_w - 100, display_h - 100));
-                ImGui::PushStyleColor(ImGuiCol_WindowBg, ImVec4(0,0,0,0.95f));
-                
-                if (ImGui::Begin("MapOverlay", &showMap, ImGuiWindowFlags_NoDecoration)) {
-                    ImGui::PushFont(titleFont);
-                    ImGui::Text("World Map");
-                    ImGui::SameLine(display_w - 400);
-                    ImGui::Text("Current Location: %s", engine.currentNode ? engine.currentNode->text.substr(0, 15).c_str() : "Unknown");
-                    ImGui::PopFont();
-                    ImGui::Separator();
-
-                    if (overlayMap) {
-                        float mapH = display_h - 200; 
-                        float mapW = mapH * (1920.0f/1080.0f); 
-                        ImGui::SetCursorPosX((display_w - 100 - mapW) * 0.5f);
-                        ImGui::Image((ImTextureID)(intptr_t)overlayMap, ImVec2(mapW, mapH));
-                    } else {
-                        ImGui::SetCursorPos(ImVec2(display_w/2 - 100, display_h/2));
-                        ImGui::Text("Map Image Not Found.");
-                    }
-
-                    ImGui::SetCursorPosY(display_h - 160);
-                    if (ImGui::Button("CLOSE MAP", ImVec2(display_w - 140, 40))) showMap = false;
-                }
-                ImGui::End();
-                ImGui::PopStyleColor();
-            }
+        // Idle rendering: report what will change on screen so the next wait knows how long it may sleep
+        if (ImGui_ImplGlfw_GetInputTimes().LastEvent != lastInputSeen) {
+            lastInputSeen = ImGui_ImplGlfw_GetInputTimes().LastEvent;
+            frameScheduler.inputReceived(glfwGetTime());
         }
-
-        // ==========================================
-        // 4. REST & SCAVENGE SCREENS
-        // ==========================================
-        else if (engine.currentState == STATE_REST || engine.currentState == STATE_SCAVENGE) {
-            
-            unsigned int bgTex = 0;
-            if (engine.currentState == STATE_REST) bgTex = engine.getGeneralTexture("resting.png");
-            else bgTex = engine.getGeneralTexture("scavenging.png");
-
-            if (bgTex == 0) bgTex = menuBg; 
-            DrawBackgroundCover(bgTex, display_w, display_h);
-
-            ImGui::GetBackgroundDrawList()->AddRectFilled(ImVec2(0,0), ImVec2((float)display_w, (float)display_h), IM_COL32(0,0,0,100));
-
-            ImGui::SetNextWindowPos(ImVec2(display_w/2 - 200, display_h/2 - 100));
-            ImGui::SetNextWindowSize(ImVec2(400, 200));
-            ImGui::PushStyleColor(ImGuiCol_WindowBg, ImVec4(0.1f, 0.1f, 0.1f, 0.95f));
-            
-            if (ImGui::Begin("Popup", nullptr, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize)) {
-                ImGui::PushFont(titleFont);
-                ImGui::Text(engine.currentState == STATE_REST ? "RESTING..." : "SCAVENGING...");
-                ImGui::PopFont(); 
-                ImGui::Separator();
-                
-                ImGui::PushFont(bodyFont);
-                if (!engine.gameLog.empty()) ImGui::TextWrapped("%s", engine.gameLog.back().c_str());
-                ImGui::PopFont();
-                
-                ImGui::SetCursorPosY(150);
-                if (ImGui::Button("CONTINUE", ImVec2(380, 40))) engine.currentState = STATE_GAMEPLAY;
-            }
-            ImGui::End();
-            ImGui::PopStyleColor();
+        if (display_w != lastDisplayW || display_h != lastDisplayH) {
+            lastDisplayW = display_w; lastDisplayH = display_h;
+            frameScheduler.markDirty();
         }
-
-        // ==========================================
-        // 5. SAVE POPUP
-        // ==========================================
-        if (showSavePopup) ImGui::OpenPopup("Save Game");
-        if (ImGui::BeginPopupModal("Save Game", &showSavePopup, ImGuiWindowFlags_AlwaysAutoResize)) {
-            ImGui::Text("Enter name for your save file:");
-            ImGui::InputText("##savename", saveFileNameBuffer, 128);
-            ImGui::Separator();
-            if (ImGui::Button("SAVE", ImVec2(120, 0))) { 
-                engine.saveGameToFile(saveFileNameBuffer); 
-                statusMessage = "Game Saved!";
-                showSavePopup = false; 
-                ImGui::CloseCurrentPopup(); 
-            }
-            ImGui::SameLine();
-            if (ImGui::Button("CANCEL", ImVec2(120, 0))) { showSavePopup = false; ImGui::CloseCurrentPopup(); }
-            ImGui::EndPopup();
+        if (engine.uiDirty) {
+            engine.uiDirty = false;
+            frameScheduler.markDirty();
         }
-
-        // ==========================================
-        // 6. LOAD POPUP
-        // ==========================================
-        if (showLoadPopup) ImGui::OpenPopup("Load Game");
-        if (ImGui::BeginPopupModal("Load Game", &showLoadPopup, ImGuiWindowFlags_AlwaysAutoResize)) {
-            ImGui::Text("Select a file to load:");
-            ImGui::Separator();
-            ImGui::BeginChild("FileList", ImVec2(300, 200), true);
-            
-            try {
-                for (const auto& entry : fs::directory_iterator(".")) {
-                    if (entry.path().extension() == ".txt" && entry.path().string().find("save") != std::string::npos) {
-                        if (ImGui::Button(entry.path().filename().string().c_str(), ImVec2(280, 0))) {
-                            engine.loadGameFromFile(entry.path().string());
-                            if (engine.currentState == STATE_MENU) engine.currentState = STATE_GAMEPLAY;
-                            statusMessage = "Game Loaded!";
-                            showLoadPopup = false;
-                            ImGui::CloseCurrentPopup();
-                        }
-                    }
-                }
-            } catch (...) {
-                ImGui::TextColored(ImVec4(1,0,0,1), "Error scanning files.");
-            }
-            ImGui::EndChild();
-            ImGui::Separator();
-            if (ImGui::Button("CANCEL", ImVec2(300, 0))) { showLoadPopup = false; ImGui::CloseCurrentPopup(); }
-            ImGui::EndPopup();
+        float typewriterWait = engine.typewriterTimeToNextChar();
+        if (typewriterWait >= 0.0f) frameScheduler.animateIn(simClock.timeUntil(typewriterWait));
+        if (io.WantTextInput) frameScheduler.animateIn(0.1);      // text cursor blink
+        if (showGpuTimes || showInputLatency || showAllocStats || showProfiler) frameScheduler.keepAwake();
+
+        // Debug overlay: queries only run while it's open
+        if (ImGui::IsKeyPressed(ImGuiKey_F3, false)) {
+            showGpuTimes = !showGpuTimes;
+            if (showGpuTimes) gpuTimes.enable(true);
+        }
+        if (!showGpuTimes && gpuTimes.isEnabled()) gpuTimes.enable(false);
+        if (ImGui::IsKeyPressed(ImGuiKey_F4, false)) showInputLatency = !showInputLatency;
+        if (ImGui::IsKeyPressed(ImGuiKey_F5, false)) showAllocStats = !showAllocStats;
+#ifdef ATW_PROFILE
+        if (ImGui::IsKeyPressed(ImGuiKey_F6, false)) showProfiler = !showProfiler;
+#endif
+
+        {
+            ATW_PROFILE_ZONE("Screens");
+            ui.drawFrame(ui_w, ui_h, (float)simClock.alpha());
         }
+        const UiFrameRequests& uiRequests = ui.requests;
+        if (uiRequests.dirty) frameScheduler.markDirty();
+        if (uiRequests.keepAwake) frameScheduler.keepAwake();
+        if (uiRequests.animateIn >= 0.0) frameScheduler.animateIn(simClock.timeUntil(uiRequests.animateIn));
+        if (uiRequests.choiceMade) inputLatency.choiceMade();
+        if (uiRequests.quit) glfwSetWindowShouldClose(window, true);
+
+        if (showGpuTimes) gpuTimes.draw(&showGpuTimes);
+        if (showInputLatency) inputLatency.draw(&showInputLatency, lateLatch.isEnabled());
+        if (showAllocStats) AllocTracker::drawOverlay(&showAllocStats);
+#ifdef ATW_PROFILE
+        if (showProfiler) Profiler::drawOverlay(&showProfiler);
+#endif
+
+        {
+            AllocScope allocScope("Render");
+            ATW_PROFILE_ZONE("Render");
+            ImGui::Render();
+            glViewport(0, 0, display_w, display_h);
+            glClearColor(0.1f, 0.1f, 0.15f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT);
+            ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        }
+        lateLatch.frameSubmitted();
+        {
+            ATW_PROFILE_ZONE("Swap buffers");
+            glfwSwapBuffers(window);
+            lateLatch.presented();
+        }
+        inputLatency.presented(glfwGetTime());
+        gpuTimes.collect();
+        if (glFrames == 0)
+            firstFrameMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - launchTime).count();
+
+        const ImGui_ImplOpenGL3_FrameStats& glFrameStats = ImGui_ImplOpenGL3_GetFrameStats();
+        glRenderMsTotal += glFrameStats.RenderCpuMs;
+        glUploadMsTotal += glFrameStats.UploadCpuMs;
+        glDrawCallsTotal += glFrameStats.DrawCalls;
+        glStateChangesTotal += glFrameStats.ScissorChanges + glFrameStats.TextureBinds + glFrameStats.ProgramBinds;
+        glTexBytesTotal += glFrameStats.TexUploadBytes;
+        glTexUploadMsTotal += glFrameStats.TexUploadCpuMs;
+        glFrames++;
+    }
+
+    if (inputRecorder.isRecording()) {
+        inputRecorder.stop(engine.stateChecksum());
+        std::cout << "ATW_RECORD: " << inputRecorder.frameCount() << " frames written to " << recordPath << std::endl;
+    }
+    if (inputReplayer.isOpen()) {
+        std::cout << "ATW_REPLAY: " << inputReplayer.framesPlayed() << " frames played";
+        if (!inputReplayer.hasTrailer()) std::cout << ", recording ended early (no trailer)";
+        else if (inputReplayer.framesPlayed() < inputReplayer.recordedFrames()) std::cout << ", window closed before the end";
+        else std::cout << (inputReplayer.recordedChecksum() == engine.stateChecksum() ? ", game state matches the recording"
+                                                                                    : ", game state DIFFERS from the recording");
+        std::cout << std::endl;
+    }
+
+    if (printGlStats && glFrames > 0) {
+        std::cout << "GL " << (ImGui_ImplOpenGL3_GetFrameStats().PersistentBuffers ? "persistent ring" : "glBufferData")
+                  << ": render " << glRenderMsTotal / glFrames << " ms/frame, upload " << glUploadMsTotal / glFrames
+                  << " ms/frame, " << glDrawCallsTotal / glFrames << " draw calls and " << glStateChangesTotal / glFrames
+                  << " state changes/frame over " << glFrames << " frames" << std::endl;
+        std::cout << "Frames drawn: " << frameScheduler.framesDrawn() << ", idle " << frameScheduler.idleSeconds() << " s"
+                  << (frameScheduler.isEnabled() ? "" : " (idle rendering off)") << std::endl;
+        std::cout << "GL texture uploads: " << glTexBytesTotal / 1024 << " KB in " << glTexUploadMsTotal << " ms" << std::endl;
+        std::cout << "Wrapped text layouts: " << io.Fonts->WrapCacheHits << " reused, " << io.Fonts->WrapCacheMisses << " computed"
+                  << (io.Fonts->WrapCacheCapacity > 0 ? "" : " (cache off)") << std::endl;
+        bool programFromCache = false;
+        float programMs = ImGui_ImplOpenGL3_GetProgramSetupMs(&programFromCache);
+        std::cout << "GL shader program " << (programFromCache ? "loaded from cache" : "compiled") << " in " << programMs
+                  << " ms, first frame presented " << firstFrameMs << " ms after launch" << std::endl;
+    }
 
-        ImGui::Render();
-        glViewport(0, 0, display_w, display_h);
-        glClearColor(0.1f, 0.1f, 0.15f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT);
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
-        glfwSwapBuffers(window);
+    if (inputLatency.sampleCount() > 0) {
+        float avgMs, p95Ms, choiceAvgMs, choiceP95Ms;
+        inputLatency.summary(false, &avgMs, &p95Ms);
+        inputLatency.summary(true, &choiceAvgMs, &choiceP95Ms);
+        std::cout << "Click to present (late latch " << (lateLatch.isEnabled() ? "on" : "off") << "): avg " << avgMs << " ms, p95 " << p95Ms
+                  << " ms over " << inputLatency.sampleCount() << " clicks; choices avg " << choiceAvgMs << " ms, p95 " << choiceP95Ms << " ms" << std::endl;
     }
 
+    saveCatalog.stop();
+    engine.shutdownAudio();
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplGlfw_Shutdown();
     ImGui::DestroyContext();